@@ -0,0 +1,510 @@
+#include "AABBTree.h"
+
+#include <stdlib.h>
+
+///
+//Allocates memory for a new dynamic AABB tree
+//
+//Returns:
+//	Pointer to a newly allocated dynamic AABB tree
+AABBTree* AABBTree_Allocate(void)
+{
+	AABBTree* tree = (AABBTree*)malloc(sizeof(AABBTree));
+	return tree;
+}
+
+///
+//Initializes a dynamic AABB tree
+//
+//Parameters:
+//	tree: A pointer to the tree to initialize
+//	margin: The distance to enlarge the bounds of leaves by on each side.
+//		Objects are only re-inserted once they move out of their enlarged bounds.
+void AABBTree_Initialize(AABBTree* tree, float margin)
+{
+	tree->nodes = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->nodes, sizeof(AABBTree_Node));
+
+	tree->root = AABBTree_NULL_NODE;
+	tree->freeList = AABBTree_NULL_NODE;
+
+	tree->proxies = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->proxies, sizeof(AABBTree_Proxy));
+
+	tree->stack = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->stack, sizeof(unsigned int));
+
+	tree->margin = margin;
+}
+
+///
+//Frees resources allocated by a dynamic AABB tree
+//Does not free the objects being tracked.
+//
+//Parameters:
+//	tree: A pointer to the tree to free
+void AABBTree_Free(AABBTree* tree)
+{
+	DynamicArray_Free(tree->nodes);
+	DynamicArray_Free(tree->proxies);
+	DynamicArray_Free(tree->stack);
+	free(tree);
+}
+
+///
+//Adds an object to a dynamic AABB tree
+//
+//Parameters:
+//	tree: A pointer to the tree to add the object to
+//	obj: A pointer to the object to add (Must have collider attached)
+void AABBTree_Add(AABBTree* tree, GObject* obj)
+{
+	AABBTree_Proxy proxy;
+	proxy.obj = obj;
+	AABBTree_UpdateProxy(&proxy);
+
+	//Create a leaf holding the enlarged bounds of the object
+	proxy.leaf = AABBTree_AllocateNode(tree);
+	AABBTree_Node* leaf = (AABBTree_Node*)tree->nodes->data + proxy.leaf;
+	for(int i = 0; i < 6; i++)
+	{
+		leaf->bounds[i] = proxy.bounds[i] + (i % 2 == 0 ? -tree->margin : tree->margin);
+	}
+	leaf->height = 0;
+	leaf->proxy = tree->proxies->size;
+
+	DynamicArray_Append(tree->proxies, &proxy);
+	AABBTree_InsertLeaf(tree, proxy.leaf);
+}
+
+///
+//Removes an object from a dynamic AABB tree
+//
+//Parameters:
+//	tree: A pointer to the tree to remove the object from
+//	obj: A pointer to the object to remove
+void AABBTree_Remove(AABBTree* tree, GObject* obj)
+{
+	AABBTree_Proxy* proxies = (AABBTree_Proxy*)tree->proxies->data;
+
+	unsigned int index;
+	for(index = 0; index < tree->proxies->size; index++)
+	{
+		if(proxies[index].obj == obj) break;
+	}
+	if(index == tree->proxies->size) return;
+
+	AABBTree_RemoveLeaf(tree, proxies[index].leaf);
+	AABBTree_FreeNode(tree, proxies[index].leaf);
+
+	//Move the last proxy into the removed proxy's place and point it's leaf at it's new index
+	unsigned int last = tree->proxies->size - 1;
+	proxies[index] = proxies[last];
+	((AABBTree_Node*)tree->nodes->data)[proxies[index].leaf].proxy = index;
+	tree->proxies->size--;
+}
+
+///
+//Updates the bounds of all objects in a dynamic AABB tree,
+//re-inserting the objects which have moved out of the enlarged bounds of their leaves
+//
+//Parameters:
+//	tree: A pointer to the tree to update
+void AABBTree_Update(AABBTree* tree)
+{
+	AABBTree_Proxy* proxies = (AABBTree_Proxy*)tree->proxies->data;
+	for(unsigned int i = 0; i < tree->proxies->size; i++)
+	{
+		AABBTree_UpdateProxy(proxies + i);
+
+		AABBTree_Node* leaf = (AABBTree_Node*)tree->nodes->data + proxies[i].leaf;
+		if(AABBTree_DoesContain(leaf->bounds, proxies[i].bounds))
+		{
+			continue;
+		}
+
+		//The object has left it's enlarged bounds, re-insert it with new ones
+		AABBTree_RemoveLeaf(tree, proxies[i].leaf);
+		for(int j = 0; j < 6; j++)
+		{
+			leaf->bounds[j] = proxies[i].bounds[j] + (j % 2 == 0 ? -tree->margin : tree->margin);
+		}
+		AABBTree_InsertLeaf(tree, proxies[i].leaf);
+	}
+}
+
+///
+//Finds all pairs of objects in a dynamic AABB tree whose bounds overlap
+//
+//Parameters:
+//	tree: A pointer to the tree to query
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to,
+//		each two consecutive objects appended form a pair
+void AABBTree_QueryPairs(AABBTree* tree, DynamicArray* dest)
+{
+	if(tree->root == AABBTree_NULL_NODE) return;
+
+	AABBTree_Node* nodes = (AABBTree_Node*)tree->nodes->data;
+	AABBTree_Proxy* proxies = (AABBTree_Proxy*)tree->proxies->data;
+
+	//Query the tree with the bounds of every object
+	for(unsigned int i = 0; i < tree->proxies->size; i++)
+	{
+		const float* bounds = proxies[i].bounds;
+
+		tree->stack->size = 0;
+		DynamicArray_Append(tree->stack, &tree->root);
+		while(tree->stack->size > 0)
+		{
+			unsigned int index = ((unsigned int*)tree->stack->data)[--tree->stack->size];
+			AABBTree_Node* node = nodes + index;
+
+			if(!AABBTree_DoesOverlap(node->bounds, bounds)) continue;
+
+			if(node->height == 0)
+			{
+				//Each pair is found from both of it's objects, only keep it from the one with the lower index
+				if(node->proxy > i && AABBTree_DoesOverlap(proxies[node->proxy].bounds, bounds))
+				{
+					DynamicArray_Append(dest, &proxies[i].obj);
+					DynamicArray_Append(dest, &proxies[node->proxy].obj);
+				}
+			}
+			else
+			{
+				DynamicArray_Append(tree->stack, node->children);
+				DynamicArray_Append(tree->stack, node->children + 1);
+			}
+		}
+	}
+}
+
+///
+//Takes an unused node from the pool of a dynamic AABB tree, growing the pool if none are left
+//
+//Parameters:
+//	tree: A pointer to the tree to allocate a node from
+//
+//Returns:
+//	The index of the node
+static unsigned int AABBTree_AllocateNode(AABBTree* tree)
+{
+	unsigned int index;
+	if(tree->freeList != AABBTree_NULL_NODE)
+	{
+		index = tree->freeList;
+		tree->freeList = ((AABBTree_Node*)tree->nodes->data)[index].parent;
+	}
+	else
+	{
+		AABBTree_Node node;
+		index = tree->nodes->size;
+		DynamicArray_Append(tree->nodes, &node);
+	}
+
+	AABBTree_Node* node = (AABBTree_Node*)tree->nodes->data + index;
+	node->parent = AABBTree_NULL_NODE;
+	node->children[0] = node->children[1] = AABBTree_NULL_NODE;
+	node->proxy = AABBTree_NULL_NODE;
+	node->height = 0;
+
+	return index;
+}
+
+///
+//Returns a node to the pool of unused nodes of a dynamic AABB tree
+//
+//Parameters:
+//	tree: A pointer to the tree to return the node to
+//	index: The index of the node to return
+static void AABBTree_FreeNode(AABBTree* tree, unsigned int index)
+{
+	AABBTree_Node* node = (AABBTree_Node*)tree->nodes->data + index;
+	node->parent = tree->freeList;
+	node->height = -1;
+	tree->freeList = index;
+}
+
+///
+//Inserts a leaf into a dynamic AABB tree next to the node which increases the surface area of the tree the least
+//
+//Parameters:
+//	tree: A pointer to the tree to insert the leaf into
+//	leaf: The index of the leaf to insert
+static void AABBTree_InsertLeaf(AABBTree* tree, unsigned int leaf)
+{
+	if(tree->root == AABBTree_NULL_NODE)
+	{
+		tree->root = leaf;
+		((AABBTree_Node*)tree->nodes->data)[leaf].parent = AABBTree_NULL_NODE;
+		return;
+	}
+
+	AABBTree_Node* nodes = (AABBTree_Node*)tree->nodes->data;
+	const float* leafBounds = nodes[leaf].bounds;
+	float combined[6];
+
+	//Descend the tree choosing the child whose cost of containing the leaf is lowest,
+	//until making the leaf a sibling of the current node is cheaper than descending
+	unsigned int index = tree->root;
+	while(nodes[index].height > 0)
+	{
+		AABBTree_CombineBounds(combined, nodes[index].bounds, leafBounds);
+		float combinedArea = AABBTree_GetSurfaceArea(combined);
+
+		//Cost of making the leaf a sibling of this node
+		float cost = 2.0f * combinedArea;
+		//Cost every ancestor below this node will grow by if the leaf is pushed further down
+		float inheritedCost = 2.0f * (combinedArea - AABBTree_GetSurfaceArea(nodes[index].bounds));
+
+		float childCosts[2];
+		for(int i = 0; i < 2; i++)
+		{
+			AABBTree_Node* child = nodes + nodes[index].children[i];
+			AABBTree_CombineBounds(combined, child->bounds, leafBounds);
+			childCosts[i] = AABBTree_GetSurfaceArea(combined) + inheritedCost;
+			if(child->height > 0)
+			{
+				childCosts[i] -= AABBTree_GetSurfaceArea(child->bounds);
+			}
+		}
+
+		if(cost < childCosts[0] && cost < childCosts[1]) break;
+
+		index = childCosts[0] < childCosts[1] ? nodes[index].children[0] : nodes[index].children[1];
+	}
+
+	//Create a new parent for the leaf and it's sibling
+	unsigned int sibling = index;
+	unsigned int newParent = AABBTree_AllocateNode(tree);
+	//Allocating may have moved the pool
+	nodes = (AABBTree_Node*)tree->nodes->data;
+
+	unsigned int oldParent = nodes[sibling].parent;
+	nodes[newParent].parent = oldParent;
+	nodes[newParent].children[0] = sibling;
+	nodes[newParent].children[1] = leaf;
+	nodes[newParent].height = nodes[sibling].height + 1;
+	AABBTree_CombineBounds(nodes[newParent].bounds, nodes[sibling].bounds, nodes[leaf].bounds);
+
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+
+	if(oldParent != AABBTree_NULL_NODE)
+	{
+		if(nodes[oldParent].children[0] == sibling) nodes[oldParent].children[0] = newParent;
+		else nodes[oldParent].children[1] = newParent;
+
+		AABBTree_Refit(tree, oldParent);
+	}
+	else
+	{
+		tree->root = newParent;
+	}
+}
+
+///
+//Removes a leaf from a dynamic AABB tree, the leaf itself is not freed
+//
+//Parameters:
+//	tree: A pointer to the tree to remove the leaf from
+//	leaf: The index of the leaf to remove
+static void AABBTree_RemoveLeaf(AABBTree* tree, unsigned int leaf)
+{
+	if(leaf == tree->root)
+	{
+		tree->root = AABBTree_NULL_NODE;
+		return;
+	}
+
+	AABBTree_Node* nodes = (AABBTree_Node*)tree->nodes->data;
+
+	//The leaf's sibling takes the place of it's parent
+	unsigned int parent = nodes[leaf].parent;
+	unsigned int grandParent = nodes[parent].parent;
+	unsigned int sibling = nodes[parent].children[0] == leaf ? nodes[parent].children[1] : nodes[parent].children[0];
+
+	nodes[sibling].parent = grandParent;
+	if(grandParent != AABBTree_NULL_NODE)
+	{
+		if(nodes[grandParent].children[0] == parent) nodes[grandParent].children[0] = sibling;
+		else nodes[grandParent].children[1] = sibling;
+
+		AABBTree_FreeNode(tree, parent);
+		AABBTree_Refit(tree, grandParent);
+	}
+	else
+	{
+		tree->root = sibling;
+		AABBTree_FreeNode(tree, parent);
+	}
+
+	nodes[leaf].parent = AABBTree_NULL_NODE;
+}
+
+///
+//Refits the bounds & heights of every ancestor of a node, rotating them to keep the tree balanced
+//
+//Parameters:
+//	tree: A pointer to the tree containing the node
+//	index: The index of the first ancestor to refit
+static void AABBTree_Refit(AABBTree* tree, unsigned int index)
+{
+	AABBTree_Node* nodes = (AABBTree_Node*)tree->nodes->data;
+	while(index != AABBTree_NULL_NODE)
+	{
+		index = AABBTree_Balance(tree, index);
+
+		AABBTree_Node* node = nodes + index;
+		AABBTree_Node* child1 = nodes + node->children[0];
+		AABBTree_Node* child2 = nodes + node->children[1];
+
+		node->height = 1 + (child1->height > child2->height ? child1->height : child2->height);
+		AABBTree_CombineBounds(node->bounds, child1->bounds, child2->bounds);
+
+		index = node->parent;
+	}
+}
+
+///
+//Performs a rotation about a node if the heights of it's subtrees differ by more than one
+//
+//Parameters:
+//	tree: A pointer to the tree containing the node
+//	index: The index of the node to balance
+//
+//Returns:
+//	The index of the node which now takes the place of the balanced node
+static unsigned int AABBTree_Balance(AABBTree* tree, unsigned int index)
+{
+	AABBTree_Node* nodes = (AABBTree_Node*)tree->nodes->data;
+	AABBTree_Node* node = nodes + index;
+	if(node->height < 2) return index;
+
+	//Determine which child is taller, only a difference greater than one needs a rotation
+	int balance = nodes[node->children[1]].height - nodes[node->children[0]].height;
+	if(balance >= -1 && balance <= 1) return index;
+
+	//The taller child is rotated up to take the place of the node
+	unsigned int tallSide = balance > 1 ? 1 : 0;
+	unsigned int shortSide = 1 - tallSide;
+	unsigned int up = node->children[tallSide];
+	AABBTree_Node* upNode = nodes + up;
+
+	//The taller grandchild stays under the rotated child, the shorter one moves under the node
+	unsigned int grandChild1 = upNode->children[0];
+	unsigned int grandChild2 = upNode->children[1];
+	unsigned int keep = nodes[grandChild1].height > nodes[grandChild2].height ? grandChild1 : grandChild2;
+	unsigned int move = keep == grandChild1 ? grandChild2 : grandChild1;
+
+	//Swap the child with the node
+	upNode->children[0] = index;
+	upNode->parent = node->parent;
+	node->parent = up;
+
+	if(upNode->parent != AABBTree_NULL_NODE)
+	{
+		AABBTree_Node* parent = nodes + upNode->parent;
+		if(parent->children[0] == index) parent->children[0] = up;
+		else parent->children[1] = up;
+	}
+	else
+	{
+		tree->root = up;
+	}
+
+	upNode->children[1] = keep;
+	node->children[tallSide] = move;
+	nodes[move].parent = index;
+
+	AABBTree_Node* shortChild = nodes + node->children[shortSide];
+	AABBTree_CombineBounds(node->bounds, shortChild->bounds, nodes[move].bounds);
+	node->height = 1 + (shortChild->height > nodes[move].height ? shortChild->height : nodes[move].height);
+
+	AABBTree_CombineBounds(upNode->bounds, node->bounds, nodes[keep].bounds);
+	upNode->height = 1 + (node->height > nodes[keep].height ? node->height : nodes[keep].height);
+
+	return up;
+}
+
+///
+//Determines the bounds containing two bounds
+//
+//Parameters:
+//	dest: An array of 6 floats to store the combined bounds
+//	bounds1: The first bounds to contain
+//	bounds2: The second bounds to contain
+static void AABBTree_CombineBounds(float* dest, const float* bounds1, const float* bounds2)
+{
+	for(int i = 0; i < 6; i += 2)
+	{
+		dest[i] = bounds1[i] < bounds2[i] ? bounds1[i] : bounds2[i];
+		dest[i + 1] = bounds1[i + 1] > bounds2[i + 1] ? bounds1[i + 1] : bounds2[i + 1];
+	}
+}
+
+///
+//Determines the surface area of a set of bounds
+//
+//Parameters:
+//	bounds: The bounds to determine the surface area of
+//
+//Returns:
+//	The surface area of the bounds
+static float AABBTree_GetSurfaceArea(const float* bounds)
+{
+	float width = bounds[1] - bounds[0];
+	float height = bounds[3] - bounds[2];
+	float depth = bounds[5] - bounds[4];
+	return 2.0f * (width * height + height * depth + depth * width);
+}
+
+///
+//Determines if a set of bounds completely contains another
+//
+//Parameters:
+//	outer: The bounds which may contain the inner bounds
+//	inner: The bounds which may be contained
+//
+//Returns:
+//	0 if the inner bounds are not completely contained
+//	1 if the inner bounds are completely contained
+static unsigned char AABBTree_DoesContain(const float* outer, const float* inner)
+{
+	for(int i = 0; i < 6; i += 2)
+	{
+		if(inner[i] < outer[i] || inner[i + 1] > outer[i + 1]) return 0;
+	}
+	return 1;
+}
+
+///
+//Determines if two sets of bounds overlap
+//
+//Parameters:
+//	bounds1: The first bounds
+//	bounds2: The second bounds
+//
+//Returns:
+//	0 if the bounds do not overlap
+//	1 if the bounds overlap
+static unsigned char AABBTree_DoesOverlap(const float* bounds1, const float* bounds2)
+{
+	for(int i = 0; i < 6; i += 2)
+	{
+		if(bounds1[i] > bounds2[i + 1] || bounds2[i] > bounds1[i + 1]) return 0;
+	}
+	return 1;
+}
+
+///
+//Determines the world space bounds of a proxy's object
+//
+//Parameters:
+//	proxy: A pointer to the proxy to update the bounds of
+static void AABBTree_UpdateProxy(AABBTree_Proxy* proxy)
+{
+	GObject* obj = proxy->obj;
+	FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+	Collider_GetWorldBounds(proxy->bounds, obj->collider, frame);
+}
@@ -0,0 +1,214 @@
+#ifndef AABBTREE_H
+#define AABBTREE_H
+
+#include <limits.h>
+
+#include "GObject.h"
+#include "DynamicArray.h"
+
+//Index denoting the absence of a node
+#define AABBTree_NULL_NODE UINT_MAX
+
+//A node of a dynamic AABB tree.
+//Leaves hold a single object, internal nodes always have two children.
+typedef struct AABBTree_Node
+{
+	float bounds[6];			//Bounds containing the node's subtree in the order minX, maxX, minY, maxY, minZ, maxZ. Leaves hold enlarged bounds of their object
+	unsigned int parent;		//Index of the parent node, or of the next free node while the node is unused
+	unsigned int children[2];	//Indices of the child nodes, AABBTree_NULL_NODE for leaves
+	unsigned int proxy;			//Index of the proxy held by a leaf
+	int height;					//Height of the node's subtree, 0 for leaves and -1 for unused nodes
+} AABBTree_Node;
+
+//An object tracked by a dynamic AABB tree
+typedef struct AABBTree_Proxy
+{
+	GObject* obj;				//The object being tracked (Must have collider attached)
+	unsigned int leaf;			//Index of the leaf holding the object
+	float bounds[6];			//World space bounds of the object's collider in the order minX, maxX, minY, maxY, minZ, maxZ
+} AABBTree_Proxy;
+
+//A bounding volume hierarchy of axis aligned bounding boxes which is updated incrementally as objects move.
+//Leaves are given bounds enlarged by a margin so objects moving a small distance need not be re-inserted,
+//and the tree is rotated as leaves are inserted & removed to keep it balanced.
+typedef struct AABBTree
+{
+	DynamicArray* nodes;		//Pool of nodes stored by value, referenced by index
+	unsigned int root;			//Index of the root node
+	unsigned int freeList;		//Index of the first unused node in the pool
+
+	DynamicArray* proxies;		//Proxies of the tracked objects, stored by value
+	DynamicArray* stack;		//Scratch stack of node indices used when traversing the tree
+
+	float margin;				//Distance leaf bounds are enlarged by on each side
+} AABBTree;
+
+///
+//Internals
+///
+
+///
+//Takes an unused node from the pool of a dynamic AABB tree, growing the pool if none are left
+//
+//Parameters:
+//	tree: A pointer to the tree to allocate a node from
+//
+//Returns:
+//	The index of the node
+static unsigned int AABBTree_AllocateNode(AABBTree* tree);
+
+///
+//Returns a node to the pool of unused nodes of a dynamic AABB tree
+//
+//Parameters:
+//	tree: A pointer to the tree to return the node to
+//	index: The index of the node to return
+static void AABBTree_FreeNode(AABBTree* tree, unsigned int index);
+
+///
+//Inserts a leaf into a dynamic AABB tree next to the node which increases the surface area of the tree the least
+//
+//Parameters:
+//	tree: A pointer to the tree to insert the leaf into
+//	leaf: The index of the leaf to insert
+static void AABBTree_InsertLeaf(AABBTree* tree, unsigned int leaf);
+
+///
+//Removes a leaf from a dynamic AABB tree, the leaf itself is not freed
+//
+//Parameters:
+//	tree: A pointer to the tree to remove the leaf from
+//	leaf: The index of the leaf to remove
+static void AABBTree_RemoveLeaf(AABBTree* tree, unsigned int leaf);
+
+///
+//Refits the bounds & heights of every ancestor of a node, rotating them to keep the tree balanced
+//
+//Parameters:
+//	tree: A pointer to the tree containing the node
+//	index: The index of the first ancestor to refit
+static void AABBTree_Refit(AABBTree* tree, unsigned int index);
+
+///
+//Performs a rotation about a node if the heights of it's subtrees differ by more than one
+//
+//Parameters:
+//	tree: A pointer to the tree containing the node
+//	index: The index of the node to balance
+//
+//Returns:
+//	The index of the node which now takes the place of the balanced node
+static unsigned int AABBTree_Balance(AABBTree* tree, unsigned int index);
+
+///
+//Determines the bounds containing two bounds
+//
+//Parameters:
+//	dest: An array of 6 floats to store the combined bounds
+//	bounds1: The first bounds to contain
+//	bounds2: The second bounds to contain
+static void AABBTree_CombineBounds(float* dest, const float* bounds1, const float* bounds2);
+
+///
+//Determines the surface area of a set of bounds
+//
+//Parameters:
+//	bounds: The bounds to determine the surface area of
+//
+//Returns:
+//	The surface area of the bounds
+static float AABBTree_GetSurfaceArea(const float* bounds);
+
+///
+//Determines if a set of bounds completely contains another
+//
+//Parameters:
+//	outer: The bounds which may contain the inner bounds
+//	inner: The bounds which may be contained
+//
+//Returns:
+//	0 if the inner bounds are not completely contained
+//	1 if the inner bounds are completely contained
+static unsigned char AABBTree_DoesContain(const float* outer, const float* inner);
+
+///
+//Determines if two sets of bounds overlap
+//
+//Parameters:
+//	bounds1: The first bounds
+//	bounds2: The second bounds
+//
+//Returns:
+//	0 if the bounds do not overlap
+//	1 if the bounds overlap
+static unsigned char AABBTree_DoesOverlap(const float* bounds1, const float* bounds2);
+
+///
+//Determines the world space bounds of a proxy's object
+//
+//Parameters:
+//	proxy: A pointer to the proxy to update the bounds of
+static void AABBTree_UpdateProxy(AABBTree_Proxy* proxy);
+
+///
+//Functions
+///
+
+///
+//Allocates memory for a new dynamic AABB tree
+//
+//Returns:
+//	Pointer to a newly allocated dynamic AABB tree
+AABBTree* AABBTree_Allocate(void);
+
+///
+//Initializes a dynamic AABB tree
+//
+//Parameters:
+//	tree: A pointer to the tree to initialize
+//	margin: The distance to enlarge the bounds of leaves by on each side.
+//		Objects are only re-inserted once they move out of their enlarged bounds.
+void AABBTree_Initialize(AABBTree* tree, float margin);
+
+///
+//Frees resources allocated by a dynamic AABB tree
+//Does not free the objects being tracked.
+//
+//Parameters:
+//	tree: A pointer to the tree to free
+void AABBTree_Free(AABBTree* tree);
+
+///
+//Adds an object to a dynamic AABB tree
+//
+//Parameters:
+//	tree: A pointer to the tree to add the object to
+//	obj: A pointer to the object to add (Must have collider attached)
+void AABBTree_Add(AABBTree* tree, GObject* obj);
+
+///
+//Removes an object from a dynamic AABB tree
+//
+//Parameters:
+//	tree: A pointer to the tree to remove the object from
+//	obj: A pointer to the object to remove
+void AABBTree_Remove(AABBTree* tree, GObject* obj);
+
+///
+//Updates the bounds of all objects in a dynamic AABB tree,
+//re-inserting the objects which have moved out of the enlarged bounds of their leaves
+//
+//Parameters:
+//	tree: A pointer to the tree to update
+void AABBTree_Update(AABBTree* tree);
+
+///
+//Finds all pairs of objects in a dynamic AABB tree whose bounds overlap
+//
+//Parameters:
+//	tree: A pointer to the tree to query
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to,
+//		each two consecutive objects appended form a pair
+void AABBTree_QueryPairs(AABBTree* tree, DynamicArray* dest);
+
+#endif
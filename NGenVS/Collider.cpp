@@ -1,6 +1,7 @@
 #include "Collider.h"
 
 #include <stdlib.h>
+#include <math.h>
 
 ///
 //Gets the a pointer to the collider_Initialize function
@@ -50,10 +51,13 @@ void Collider_Free(Collider* collider)
 	case COLLIDER_CONVEXHULL:
 		ConvexHullCollider_FreeData(collider->data->convexHullData);
 		break;
+	case COLLIDER_COMPOUND:
+		CompoundCollider_FreeData(collider->data->compoundData);
+		break;
+	default:
+		break;
 	}
 
-	LinkedList_Free(collider->currentCollisions);
-
 	//Free the color matrix of the collider
 	Matrix_Free(collider->colorMatrix);
 
@@ -61,3 +65,308 @@ void Collider_Free(Collider* collider)
 	free(collider->data);
 	free(collider);
 }
+
+///
+//Determines the world space axis aligned bounds of a collider of any type
+//
+//Parameters:
+//	dest: An array of 6 floats to store the bounds in the order minX, maxX, minY, maxY, minZ, maxZ
+//	collider: A pointer to the collider to determine the bounds of
+//	frame: A pointer to the frame of reference with which to orient the collider
+void Collider_GetWorldBounds(float* dest, const Collider* collider, const FrameOfReference* frame)
+{
+	//Half extents of the bounds along each axis
+	float halfExtents[3];
+	//Center of the bounds relative to the frame's position
+	float center[3] = { 0.0f, 0.0f, 0.0f };
+
+	ColliderData_AABB AABB;
+
+	switch(collider->type)
+	{
+	case COLLIDER_SPHERE:
+		halfExtents[0] = halfExtents[1] = halfExtents[2] = SphereCollider_GetScaledRadius(collider->data->sphereData, frame);
+		break;
+	case COLLIDER_AABB:
+		AABBCollider_GetScaledDimensions(&AABB, collider->data->AABBData, frame);
+		halfExtents[0] = AABB.width / 2.0f;
+		halfExtents[1] = AABB.height / 2.0f;
+		halfExtents[2] = AABB.depth / 2.0f;
+		for(int i = 0; i < 3; i++) center[i] = collider->data->AABBData->centroid->components[i];
+		break;
+	case COLLIDER_CONVEXHULL:
+		{
+			//Use the minimum AABB containing the oriented convex hull
+			Vector AABBCentroid;
+			Vector_INIT_ON_STACK(AABBCentroid, 3);
+			AABB.centroid = &AABBCentroid;
+			ConvexHullCollider_GenerateMinimumAABB(&AABB, collider->data->convexHullData, frame);
+			AABBCollider_GetScaledDimensions(&AABB, &AABB, frame);
+			halfExtents[0] = AABB.width / 2.0f;
+			halfExtents[1] = AABB.height / 2.0f;
+			halfExtents[2] = AABB.depth / 2.0f;
+			for(int i = 0; i < 3; i++) center[i] = AABBCentroid.components[i];
+		}
+		break;
+	case COLLIDER_COMPOUND:
+		{
+			//Use the minimum AABB containing every oriented piece
+			Vector AABBCentroid;
+			Vector_INIT_ON_STACK(AABBCentroid, 3);
+			AABB.centroid = &AABBCentroid;
+			CompoundCollider_GenerateMinimumAABB(&AABB, collider->data->compoundData, frame);
+			AABBCollider_GetScaledDimensions(&AABB, &AABB, frame);
+			halfExtents[0] = AABB.width / 2.0f;
+			halfExtents[1] = AABB.height / 2.0f;
+			halfExtents[2] = AABB.depth / 2.0f;
+			for(int i = 0; i < 3; i++) center[i] = AABBCentroid.components[i];
+		}
+		break;
+	default:
+		break;
+	}
+
+	for(int i = 0; i < 3; i++)
+	{
+		dest[2 * i] = frame->position->components[i] + center[i] - halfExtents[i];
+		dest[2 * i + 1] = frame->position->components[i] + center[i] + halfExtents[i];
+	}
+}
+
+///
+//Computes the world space bounding sphere & axis aligned bounds of a collider of any type without allocating memory.
+//Convex hulls read their world space cache when it is current, else their points are oriented one at a time.
+//
+//Parameters:
+//	dest: A pointer to the world bounds to store the bounds in, the snapshot is left untouched
+//	collider: A pointer to the collider to bound
+//	frame: A pointer to the frame of reference with which to orient the collider
+void Collider_ComputeWorldBounds(Collider_WorldBounds* dest, const Collider* collider, const FrameOfReference* frame)
+{
+	switch(collider->type)
+	{
+	case COLLIDER_SPHERE:
+		Vector_CopyArray(dest->center, frame->position->components, 3);
+		dest->radius = SphereCollider_GetScaledRadius(collider->data->sphereData, frame);
+		for(int i = 0; i < 3; i++)
+		{
+			dest->min[i] = dest->center[i] - dest->radius;
+			dest->max[i] = dest->center[i] + dest->radius;
+		}
+		break;
+	case COLLIDER_CONVEXHULL:
+		{
+			const ColliderData_ConvexHull* convexHull = collider->data->convexHullData;
+			unsigned int numPoints = convexHull->points->size;
+			if(numPoints == 0)
+			{
+				Vector_CopyArray(dest->center, frame->position->components, 3);
+				Vector_CopyArray(dest->min, dest->center, 3);
+				Vector_CopyArray(dest->max, dest->center, 3);
+				dest->radius = 0.0f;
+				break;
+			}
+
+			//Read the world space points from the hull's cache if it is current, else orient them one at a time
+			const ConvexHullCollider_WorldCache* cache = &convexHull->worldCache;
+			unsigned char cached = ConvexHullCollider_HasWorldCache(convexHull, frame);
+
+			Matrix trans;
+			Matrix_INIT_ON_STACK(trans, 3, 3);
+			float point[3];
+
+			//The cache already holds the bounds of the points
+			if(cached)
+			{
+				Vector_CopyArray(dest->min, cache->min, 3);
+				Vector_CopyArray(dest->max, cache->max, 3);
+			}
+			else
+			{
+				Matrix_GetProductMatrix(&trans, frame->rotation, frame->scale);
+
+				LinkedList_Node* currentPoint = convexHull->points->head;
+				for(unsigned int i = 0; i < numPoints; i++)
+				{
+					Matrix_GetProductVectorArray(point, trans.components, ((Vector*)currentPoint->data)->components, 3, 3);
+					Vector_IncrementArray(point, frame->position->components, 3);
+					currentPoint = currentPoint->next;
+
+					for(int j = 0; j < 3; j++)
+					{
+						if(i == 0 || point[j] < dest->min[j]) dest->min[j] = point[j];
+						if(i == 0 || point[j] > dest->max[j]) dest->max[j] = point[j];
+					}
+				}
+			}
+
+			//Center the sphere on the bounds & reach the furthest point
+			for(int i = 0; i < 3; i++)
+			{
+				dest->center[i] = (dest->min[i] + dest->max[i]) / 2.0f;
+			}
+
+			float radiusSq = 0.0f;
+			LinkedList_Node* currentPoint = convexHull->points->head;
+			for(unsigned int i = 0; i < numPoints; i++)
+			{
+				const float* worldPoint = point;
+				if(cached)
+				{
+					worldPoint = cache->points[i]->components;
+				}
+				else
+				{
+					Matrix_GetProductVectorArray(point, trans.components, ((Vector*)currentPoint->data)->components, 3, 3);
+					Vector_IncrementArray(point, frame->position->components, 3);
+					currentPoint = currentPoint->next;
+				}
+
+				float offset[3];
+				Vector_SubtractArray(offset, worldPoint, dest->center, 3);
+				float distanceSq = Vector_GetMagSqFromArray(offset, 3);
+				if(distanceSq > radiusSq) radiusSq = distanceSq;
+			}
+			dest->radius = sqrtf(radiusSq);
+		}
+		break;
+	case COLLIDER_COMPOUND:
+		if(collider->data->compoundData->pieces->size > 0)
+		{
+			//Bound the bounds of every piece, the pieces share the frame of reference of the compound collider
+			DynamicArray* pieces = collider->data->compoundData->pieces;
+			for(unsigned int i = 0; i < pieces->size; i++)
+			{
+				const Collider* piece = *(Collider**)DynamicArray_Index(pieces, i);
+
+				Collider_WorldBounds scratch;
+				const Collider_WorldBounds* pieceBounds = Collider_GetWorldBoundsCache(&scratch, piece, frame);
+				for(int j = 0; j < 3; j++)
+				{
+					if(i == 0 || pieceBounds->min[j] < dest->min[j]) dest->min[j] = pieceBounds->min[j];
+					if(i == 0 || pieceBounds->max[j] > dest->max[j]) dest->max[j] = pieceBounds->max[j];
+				}
+			}
+
+			CompoundCollider_GetWorldBoundingSphere(dest->center, &dest->radius, collider->data->compoundData, frame);
+		}
+		else
+		{
+			//A compound collider without pieces can't touch anything
+			Vector_CopyArray(dest->center, frame->position->components, 3);
+			Vector_CopyArray(dest->min, dest->center, 3);
+			Vector_CopyArray(dest->max, dest->center, 3);
+			dest->radius = 0.0f;
+		}
+		break;
+	default:
+		{
+			//Bound the world space bounds of the collider
+			float bounds[6];
+			Collider_GetWorldBounds(bounds, collider, frame);
+
+			float radiusSq = 0.0f;
+			for(int i = 0; i < 3; i++)
+			{
+				dest->min[i] = bounds[2 * i];
+				dest->max[i] = bounds[2 * i + 1];
+				dest->center[i] = (dest->min[i] + dest->max[i]) / 2.0f;
+				radiusSq += (dest->max[i] - dest->center[i]) * (dest->max[i] - dest->center[i]);
+			}
+			dest->radius = sqrtf(radiusSq);
+		}
+		break;
+	}
+}
+
+///
+//Refreshes the cached world bounds of a collider if the frame of reference has changed since they were last computed
+//Refreshes the world space cache of a convex hull first, so its bounds are read from the cache
+//
+//Parameters:
+//	collider: A pointer to the collider to refresh the bounds of
+//	frame: A pointer to the frame of reference with which to orient the collider
+void Collider_RefreshWorldBounds(Collider* collider, const FrameOfReference* frame)
+{
+	if(Collider_HasWorldBounds(collider, frame)) return;
+
+	//Bound a convex hull by it's world space cache, so it's points are oriented once for both
+	if(collider->type == COLLIDER_CONVEXHULL) ConvexHullCollider_RefreshWorldCache(collider->data->convexHullData, frame);
+
+	Collider_ComputeWorldBounds(&collider->worldBounds, collider, frame);
+
+	FrameOfReference_TakeSnapshot(collider->worldBounds.snapshot, frame);
+	collider->worldBounds.valid = 1;
+}
+
+///
+//Determines if the cached world bounds of a collider were computed with a frame of reference matching the one given
+//
+//Parameters:
+//	collider: A pointer to the collider to check the bounds of
+//	frame: A pointer to the frame of reference to check against
+//
+//Returns:
+//	1 if the cached bounds can be read in place of bounding the collider oriented by the frame of reference, else 0
+unsigned char Collider_HasWorldBounds(const Collider* collider, const FrameOfReference* frame)
+{
+	return collider->worldBounds.valid && !FrameOfReference_HasChanged(collider->worldBounds.snapshot, frame);
+}
+
+///
+//Marks the cached world bounds of a collider as out of date.
+//Must be called after changing the shape of a collider in place.
+//
+//Parameters:
+//	collider: A pointer to the collider to invalidate the bounds of
+void Collider_InvalidateWorldBounds(Collider* collider)
+{
+	collider->worldBounds.valid = 0;
+}
+
+///
+//Gets the world bounds of a collider without changing it, so it is safe to call while other threads read the collider.
+//
+//Parameters:
+//	scratch: A pointer to world bounds to compute the bounds into if the cached bounds are out of date
+//	collider: A pointer to the collider to bound
+//	frame: A pointer to the frame of reference with which to orient the collider
+//
+//Returns:
+//	A pointer to the cached bounds of the collider if they are current, else scratch
+const Collider_WorldBounds* Collider_GetWorldBoundsCache(Collider_WorldBounds* scratch, const Collider* collider, const FrameOfReference* frame)
+{
+	if(Collider_HasWorldBounds(collider, frame))
+	{
+		return &collider->worldBounds;
+	}
+
+	Collider_ComputeWorldBounds(scratch, collider, frame);
+	return scratch;
+}
+
+///
+//Determines if the world bounds of two colliders overlap.
+//Both the bounding spheres & the axis aligned bounds must overlap, to within Collider_BOUNDS_MARGIN.
+//
+//Parameters:
+//	bounds1: A pointer to the world bounds of the first collider
+//	bounds2: A pointer to the world bounds of the second collider
+//
+//Returns:
+//	1 if the bounds overlap, else 0
+unsigned char Collider_DoWorldBoundsOverlap(const Collider_WorldBounds* bounds1, const Collider_WorldBounds* bounds2)
+{
+	for(int i = 0; i < 3; i++)
+	{
+		if(bounds1->min[i] > bounds2->max[i] + Collider_BOUNDS_MARGIN || bounds2->min[i] > bounds1->max[i] + Collider_BOUNDS_MARGIN)
+		{
+			return 0;
+		}
+	}
+
+	float offset[3];
+	Vector_SubtractArray(offset, bounds1->center, bounds2->center, 3);
+	float reach = bounds1->radius + bounds2->radius + Collider_BOUNDS_MARGIN;
+	return Vector_GetMagSqFromArray(offset, 3) <= reach * reach;
+}
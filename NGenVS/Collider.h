@@ -4,13 +4,16 @@
 #include "SphereCollider.h"
 #include "AABBCollider.h"
 #include "ConvexHullCollider.h"
+#include "CompoundCollider.h"
 
 //Dictates the type of a collider
 enum ColliderType
 {
 	COLLIDER_SPHERE,
 	COLLIDER_AABB,
-	COLLIDER_CONVEXHULL
+	COLLIDER_CONVEXHULL,
+	COLLIDER_COMPOUND,
+	COLLIDER_NUM_TYPES			//Number of types of collider, not a type itself
 };
 
 //union for the data different colliders will provide
@@ -19,15 +22,35 @@ union ColliderData
 	struct ColliderData_Sphere* sphereData;
 	struct ColliderData_AABB* AABBData;
 	struct ColliderData_ConvexHull* convexHullData;
+	struct ColliderData_Compound* compoundData;
 };
 
+//How far apart the world bounds of two colliders may be & still be reported as overlapping,
+//so rounding in the bounds never culls a pair the narrow phase would find touching
+#define Collider_BOUNDS_MARGIN 0.001f
+
+//The world space bounding sphere & axis aligned bounds of a collider.
+//Refreshed at most once for each transform of the collider so every pair the collider is tested in can share them.
+typedef struct Collider_WorldBounds
+{
+	float snapshot[FrameOfReference_SNAPSHOT_SIZE];	//Frame of reference the bounds were computed with
+	unsigned char valid;							//Do the bounds hold the collider oriented by the snapshot
+	float center[3];								//World space center of the bounding sphere
+	float radius;									//Radius of the bounding sphere
+	float min[3];									//World space minimum of the collider along each axis
+	float max[3];									//World space maximum of the collider along each axis
+} Collider_WorldBounds;
+
 //Defines a collider
 typedef struct Collider
 {
 	ColliderType type;				//Type of collider
 	union ColliderData* data;		//Data of collider
 
-	LinkedList* currentCollisions;	//List of all collisions which occurred with this collider last frame
+	unsigned int collisionsStart;	//Start of this collider's range of collisions in the collision buffer which occurred last frame
+	unsigned int numCollisions;		//Number of collisions which occurred with this collider last frame
+
+	Collider_WorldBounds worldBounds;	//Bounds of the collider oriented by the frame of reference it was last refreshed with
 
 	unsigned char debug;			//Is collider in debug mode?
 	Mesh* representation;			//ptr to Mesh representation of collider
@@ -55,8 +78,9 @@ static void Collider_Initialize(Collider* collider, ColliderType type, Mesh* rep
 	collider->data = (ColliderData*)malloc(sizeof(ColliderData));
 	collider->type = type;
 
-	collider->currentCollisions = LinkedList_Allocate();
-	LinkedList_Initialize(collider->currentCollisions);
+	collider->collisionsStart = 0;
+	collider->numCollisions = 0;
+	collider->worldBounds.valid = 0;
 
 	//Initialize with debug mode on & setup debug settings
 	collider->debug = 0;
@@ -92,4 +116,76 @@ void Collider_DestroyInitializerPtr(void);
 //	collider: The collider to free
 void Collider_Free(Collider* collider);
 
+///
+//Determines the world space axis aligned bounds of a collider of any type
+//
+//Parameters:
+//	dest: An array of 6 floats to store the bounds in the order minX, maxX, minY, maxY, minZ, maxZ
+//	collider: A pointer to the collider to determine the bounds of
+//	frame: A pointer to the frame of reference with which to orient the collider
+void Collider_GetWorldBounds(float* dest, const Collider* collider, const FrameOfReference* frame);
+
+
+///
+//Computes the world space bounding sphere & axis aligned bounds of a collider of any type without allocating memory.
+//Convex hulls read their world space cache when it is current, else their points are oriented one at a time.
+//
+//Parameters:
+//	dest: A pointer to the world bounds to store the bounds in, the snapshot is left untouched
+//	collider: A pointer to the collider to bound
+//	frame: A pointer to the frame of reference with which to orient the collider
+void Collider_ComputeWorldBounds(Collider_WorldBounds* dest, const Collider* collider, const FrameOfReference* frame);
+
+///
+//Refreshes the cached world bounds of a collider if the frame of reference has changed since they were last computed
+//Refreshes the world space cache of a convex hull first, so its bounds are read from the cache
+//
+//Parameters:
+//	collider: A pointer to the collider to refresh the bounds of
+//	frame: A pointer to the frame of reference with which to orient the collider
+void Collider_RefreshWorldBounds(Collider* collider, const FrameOfReference* frame);
+
+///
+//Determines if the cached world bounds of a collider were computed with a frame of reference matching the one given
+//
+//Parameters:
+//	collider: A pointer to the collider to check the bounds of
+//	frame: A pointer to the frame of reference to check against
+//
+//Returns:
+//	1 if the cached bounds can be read in place of bounding the collider oriented by the frame of reference, else 0
+unsigned char Collider_HasWorldBounds(const Collider* collider, const FrameOfReference* frame);
+
+///
+//Marks the cached world bounds of a collider as out of date.
+//Must be called after changing the shape of a collider in place.
+//
+//Parameters:
+//	collider: A pointer to the collider to invalidate the bounds of
+void Collider_InvalidateWorldBounds(Collider* collider);
+
+///
+//Gets the world bounds of a collider without changing it, so it is safe to call while other threads read the collider.
+//
+//Parameters:
+//	scratch: A pointer to world bounds to compute the bounds into if the cached bounds are out of date
+//	collider: A pointer to the collider to bound
+//	frame: A pointer to the frame of reference with which to orient the collider
+//
+//Returns:
+//	A pointer to the cached bounds of the collider if they are current, else scratch
+const Collider_WorldBounds* Collider_GetWorldBoundsCache(Collider_WorldBounds* scratch, const Collider* collider, const FrameOfReference* frame);
+
+///
+//Determines if the world bounds of two colliders overlap.
+//Both the bounding spheres & the axis aligned bounds must overlap, to within Collider_BOUNDS_MARGIN.
+//
+//Parameters:
+//	bounds1: A pointer to the world bounds of the first collider
+//	bounds2: A pointer to the world bounds of the second collider
+//
+//Returns:
+//	1 if the bounds overlap, else 0
+unsigned char Collider_DoWorldBoundsOverlap(const Collider_WorldBounds* bounds1, const Collider_WorldBounds* bounds2);
+
 #endif
\ No newline at end of file
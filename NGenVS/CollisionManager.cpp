@@ -1,13 +1,25 @@
 #include "CollisionManager.h"
 #include <stdio.h>
 #include <math.h>
+#include <limits.h>
+#include <float.h>
+#include <xmmintrin.h>
 ///
 //Initializes the Collision Manager
 void CollisionManager_Initialize(void)
 {
+	//Allocate & initialize the worker pool, using one worker per hardware thread
+	workerPool = WorkerPool_Allocate();
+	WorkerPool_Initialize(workerPool, 0);
+
 	//Allocate & initialize collision buffer
 	collisionBuffer = CollisionManager_AllocateBuffer();
-	CollisionManager_InitializeBuffer(collisionBuffer);
+	CollisionManager_InitializeBuffer(collisionBuffer, workerPool->numWorkers);
+
+	//Each thread allocates it's own scratch memory the first time it tests a convex hull
+	scratches = DynamicArray_Allocate();
+	DynamicArray_Initialize(scratches, sizeof(CollisionManager_Scratch*));
+	scratchLock = new std::mutex();
 
 	//Get the Collider_initializer pointer
 	InitializerPtr initializerPtr = Collider_GetInitializer();
@@ -18,6 +30,16 @@ void CollisionManager_Initialize(void)
 	SphereCollider_SetColliderInitializer(initializerPtr);
 	AABBCollider_SetColliderInitializer(initializerPtr);
 	ConvexHullCollider_SetColliderInitializer(initializerPtr);
+	CompoundCollider_SetColliderInitializer(initializerPtr);
+
+	//Test every pair with SAT until told otherwise
+	for(int i = 0; i < COLLIDER_NUM_TYPES; i++)
+	{
+		for(int j = 0; j < COLLIDER_NUM_TYPES; j++)
+		{
+			convexAlgorithms[i][j] = CONVEXALGORITHM_SAT;
+		}
+	}
 }
 
 ///
@@ -25,6 +47,51 @@ void CollisionManager_Initialize(void)
 void CollisionManager_Free(void)
 {
 	CollisionManager_FreeBuffer(collisionBuffer);
+	WorkerPool_Free(workerPool);
+
+	//The workers have stopped, so no thread is using it's scratch memory
+	for(unsigned int i = 0; i < scratches->size; i++)
+	{
+		CollisionManager_FreeScratch(*(CollisionManager_Scratch**)DynamicArray_Index(scratches, i));
+	}
+	DynamicArray_Free(scratches);
+	delete scratchLock;
+	scratch = NULL;
+}
+
+///
+//Sets the algorithm used to test colliders of two types against each other.
+//Only pairs of AABBs & convex hulls other than two AABBs can be tested with GJK, the algorithm of any other pair is ignored.
+//
+//Parameters:
+//	type1: The type of the first collider of the pair
+//	type2: The type of the second collider of the pair
+//	algorithm: The algorithm to test the pair with
+void CollisionManager_SetConvexAlgorithm(enum ColliderType type1, enum ColliderType type2, enum ConvexAlgorithm algorithm)
+{
+	//Only pairs of AABBs & convex hulls have a choice of algorithm, two AABBs are always tested directly
+	if(type1 != COLLIDER_AABB && type1 != COLLIDER_CONVEXHULL) return;
+	if(type2 != COLLIDER_AABB && type2 != COLLIDER_CONVEXHULL) return;
+	if(type1 == COLLIDER_AABB && type2 == COLLIDER_AABB) return;
+
+	//A pair is tested the same way whichever collider comes first
+	convexAlgorithms[type1][type2] = algorithm;
+	convexAlgorithms[type2][type1] = algorithm;
+}
+
+///
+//Gets a collision which occurred last frame involving the given collider
+//
+//Parameters:
+//	collider: A pointer to the collider to get a collision of
+//	index: The index of the collision to get, must be less than collider->numCollisions
+//
+//Returns:
+//	A pointer to the collision in the collision buffer
+Collision* CollisionManager_GetObjectCollision(const Collider* collider, unsigned int index)
+{
+	unsigned int collisionIndex = *(unsigned int*)DynamicArray_Index(collisionBuffer->objectCollisions, collider->collisionsStart + index);
+	return (Collision*)DynamicArray_Index(collisionBuffer->collisions, collisionIndex);
 }
 
 ///
@@ -35,27 +102,25 @@ void CollisionManager_Free(void)
 //	gameObjects: THe list of gameObjects to test
 //
 //Returns:
-//	A pointer to a linked list of collisions which occurred this frame.
-LinkedList* CollisionManager_UpdateList(LinkedList* gameObjects)
+//	A pointer to a dynamic array of collisions which occurred this frame.
+DynamicArray* CollisionManager_UpdateList(LinkedList* gameObjects)
 {
-	//Clear the current list of collisions
-	LinkedList_Node* currentNode = collisionBuffer->collisions->head;
-	LinkedList_Node* nextNode = NULL;
-	while(currentNode != NULL)
+	//Clear the current array of collisions
+	CollisionManager_ClearBuffer(collisionBuffer);
+
+	//Collision to store the result of each test, registered collisions are copied into the buffer
+	Collision collision;
+	CollisionManager_InitializeCollision(&collision);
+
+	//Orient each convex hull once up front rather than once for every pair it is tested in
+	for(LinkedList_Node* node = gameObjects->head; node != NULL; node = node->next)
 	{
-		nextNode = currentNode->next;
-		CollisionManager_FreeCollision((Collision*)currentNode->data);
-		currentNode = nextNode;
+		CollisionManager_RefreshWorldCache((GObject*)node->data);
 	}
-	LinkedList_Clear(collisionBuffer->collisions);
-
-	//Allocates a collision to store the first registered collision
-	Collision* collision = CollisionManager_AllocateCollision();
-	CollisionManager_InitializeCollision(collision);
 
 	//Begin looping through gameObjects
-	currentNode = gameObjects->head;
-	nextNode = NULL;
+	LinkedList_Node* currentNode = gameObjects->head;
+	LinkedList_Node* nextNode = NULL;
 	LinkedList_Node* iterator = NULL;
 	while(currentNode != NULL)
 	{
@@ -76,7 +141,7 @@ LinkedList* CollisionManager_UpdateList(LinkedList* gameObjects)
 				if(iteratorObj->collider != NULL)
 				{
 					CollisionManager_TestCollision( 
-						collision,
+						&collision,
 						currentObj,
 						currentObj->body != NULL ? currentObj->body->frame : currentObj->frameOfReference,		//If there is a rigidbody use that frame of reference, else use the objects
 						iteratorObj,
@@ -85,7 +150,7 @@ LinkedList* CollisionManager_UpdateList(LinkedList* gameObjects)
 
 
 					//If they are not colliding continue to test next obj. Do not register collision or perform second pass
-					if(collision->obj1 == NULL)
+					if(collision.obj1 == NULL)
 					{
 						//Stop any further tests
 						iterator = iterator->next;
@@ -94,8 +159,8 @@ LinkedList* CollisionManager_UpdateList(LinkedList* gameObjects)
 
 
 					//If code reaches this point, all tests detected collision.
-					//add to collided list
-					LinkedList_Append(collisionBuffer->collisions, collision);
+					//add to collided array
+					DynamicArray_Append(collisionBuffer->collisions, &collision);
 
 					//TODO: Remove
 					//Change the color of colliders to red until they are drawn
@@ -107,10 +172,6 @@ LinkedList* CollisionManager_UpdateList(LinkedList* gameObjects)
 					*Matrix_Index(iteratorObj->collider->colorMatrix, 1, 1) = 0.0f;
 					*Matrix_Index(iteratorObj->collider->colorMatrix, 2, 2) = 0.0f;
 
-					//Allocate a new collision for next collision detected
-					collision = CollisionManager_AllocateCollision();
-					CollisionManager_InitializeCollision(collision);
-
 				}
 
 				iterator = iterator->next;
@@ -119,8 +180,8 @@ LinkedList* CollisionManager_UpdateList(LinkedList* gameObjects)
 		currentNode = nextNode;
 	}
 
-	//Delete the last unused allocated collision
-	CollisionManager_FreeCollision(collision);
+	//Group the collisions by the objects involved
+	CollisionManager_IndexObjectCollisions(collisionBuffer);
 
 	return collisionBuffer->collisions;
 }
@@ -131,322 +192,946 @@ LinkedList* CollisionManager_UpdateList(LinkedList* gameObjects)
 //Parameters:
 //	tree: The oct tree holding the game objects to test
 //
-//Returns: A pointer to a linked list of collisions which occurred this frame
-LinkedList* CollisionManager_UpdateOctTree(OctTree* tree)
+//Returns: A pointer to a dynamic array of collisions which occurred this frame
+DynamicArray* CollisionManager_UpdateOctTree(OctTree* tree)
 {
-	//Clear the current linked list of collisions
-	LinkedList_Node* currentNode = collisionBuffer->collisions->head;
-	LinkedList_Node* nextNode = NULL;
-	while(currentNode != NULL)
+	CollisionManager_BeginBroadphase();
+
+	if(tree->looseEntries != NULL)
 	{
-		nextNode = currentNode->next;
-		CollisionManager_FreeCollision((Collision*)currentNode->data);
-		currentNode = nextNode;
+		//Objects of loose trees live in a single node, find the pairs with overlapping bounds across nodes
+		OctTree_QueryLoosePairs(tree, collisionBuffer->candidatePairs);
 	}
-	LinkedList_Clear(collisionBuffer->collisions);
-
-	
+	else
+	{
+		//Report the pairs within every leaf
+		CollisionManager_ReportOctTreeNode(tree->root);
 
-	//Update root node to fill the list of collisions with all collisions in the oct tree
-	CollisionManager_UpdateOctTreeNode(tree->root);
+		//Objects outside of the root are tested against every object they may overlap
+		OctTree_QueryOverflowPairs(tree, collisionBuffer->candidatePairs);
+	}
+	CollisionManager_TestCandidatePairs();
 
-	//Return the list of collisions
-	return collisionBuffer->collisions;
+	//Return the array of collisions
+	return CollisionManager_EndBroadphase();
 }
 
 ///
-//Tests for collisions on all objects within an oct tree node appending to a list of collisions which occur
+//Reports the pairs of objects within each leaf of an oct tree node to the pair cache,
+//appending the pairs which were not yet reported this frame to the reported pairs of the collision buffer
 //
 //Parameters:
-//	node: A pointer to the node of the oct tree to check
-static void CollisionManager_UpdateOctTreeNode(OctTree_Node* node)
+//	node: A pointer to the node of the oct tree to report the pairs of
+static void CollisionManager_ReportOctTreeNode(OctTree_Node* node)
 {
 	if(node->children != NULL)
 	{
 		for(int i = 0; i < 8; i++)
 		{
-			CollisionManager_UpdateOctTreeNode(node->children+i);
+			CollisionManager_ReportOctTreeNode(node->children+i);
 		}
 	}
 	else
 	{
-		if(node->data->size != 0)
+		if(node->data->size > 1)
 		{
-			CollisionManager_UpdateOctTreeNodeArray((GObject**)node->data->data, node->data->size);
-			//PhysicsManager_ResolveCollisions(collisions);
+			CollisionManager_ReportOctTreeNodeArray((GObject**)node->data->data, node->data->size);
 		}
 	}
 }
 
 ///
-//Tests for collisions on an array of objects within an oct tree node appending to a list of collisions which occur
+//Reports the pairs of an array of objects within an oct tree leaf to the pair cache,
+//appending the pairs which were not yet reported this frame to the reported pairs of the collision buffer
 //
 //Parameters:
-//	gameObjects: An array of pointers to game objects to check collisions
+//	gameObjects: An array of pointers to game objects to report the pairs of
 //	numObjects: The number of objects in the array
-static void CollisionManager_UpdateOctTreeNodeArray(GObject** gameObjects, unsigned int numObjects)
+static void CollisionManager_ReportOctTreeNodeArray(GObject** gameObjects, unsigned int numObjects)
 {
-	//Allocates a collision to store the first registered collision
-	Collision* collision = CollisionManager_AllocateCollision();
-	CollisionManager_InitializeCollision(collision);
-
-	for(int i = 0; i < numObjects; i++)
+	for(unsigned int i = 0; i < numObjects; i++)
 	{
 		if(gameObjects[i]->collider != NULL)
 		{
-			for(int j = i+1; j < numObjects; j++)
+			for(unsigned int j = i+1; j < numObjects; j++)
 			{
 				if(gameObjects[j]->collider != NULL)
 				{
-					CollisionManager_TestCollision( 
-						collision,
-						gameObjects[i],
-						gameObjects[i]->body != NULL ? gameObjects[i]->body->frame : gameObjects[i]->frameOfReference,		//If there is a rigidbody use that frame of reference, else use the objects
-						gameObjects[j],
-						gameObjects[j]->body != NULL ? gameObjects[j]->body->frame : gameObjects[j]->frameOfReference);	//If there is a rigidbody use that frame of reference, else use the objects
-
-					if(collision->obj1 == NULL)
-					{
-						continue;
-					}
+					CollisionManager_ReportPair(gameObjects[i], gameObjects[j]);
+				}
+			}
+		}
+	}
+}
 
-					unsigned char duplicate = 0;
+///
+//Tests for collisions on all objects in a sweep and prune broadphase compiling a list of collisions which occur
+//
+//Parameters:
+//	sweepAndPrune: The sweep and prune broadphase holding the game objects to test
+//
+//Returns: A pointer to a dynamic array of collisions which occurred this frame
+DynamicArray* CollisionManager_UpdateSweepAndPrune(SweepAndPrune* sweepAndPrune)
+{
+	CollisionManager_BeginBroadphase();
 
-					//Loop through the current collisions for one object
-					LinkedList_Node* current = collision->obj1->collider->currentCollisions->head;
-					while(current != NULL)
-					{
-						Collision* currentCollision = (Collision*)current->data;
-						if(currentCollision->obj1 == collision->obj1 || currentCollision->obj2 == collision->obj1)
-						{
-							if(currentCollision->obj1 == collision->obj2 || currentCollision->obj2 == collision->obj2)
-							{
-								duplicate = 1;
-							}
-						}
-
-						current = current->next;
-					}
+	//Get the pairs of objects with overlapping bounds
+	SweepAndPrune_QueryPairs(sweepAndPrune, collisionBuffer->candidatePairs);
+	CollisionManager_TestCandidatePairs();
 
-					if(duplicate)
-					{
-						collision->obj1 = NULL;
-						collision->obj2 = NULL;
-						collision->overlap = 0.0f;
-						collision->obj1Frame = NULL;
-						collision->obj2Frame = NULL;
-						continue;
-					}
+	return CollisionManager_EndBroadphase();
+}
 
-					//If code reaches this point, all tests detected collision.
-					//add to collided list
-					LinkedList_Append(collisionBuffer->collisions, collision);
-					
+///
+//Tests for collisions on all objects in a dynamic AABB tree compiling a list of collisions which occur
+//
+//Parameters:
+//	tree: The dynamic AABB tree holding the game objects to test
+//
+//Returns: A pointer to a dynamic array of collisions which occurred this frame
+DynamicArray* CollisionManager_UpdateAABBTree(AABBTree* tree)
+{
+	CollisionManager_BeginBroadphase();
 
-					LinkedList_Append(collision->obj1->collider->currentCollisions, collision);
-					LinkedList_Append(collision->obj2->collider->currentCollisions, collision);
+	//Get the pairs of objects with overlapping bounds
+	AABBTree_QueryPairs(tree, collisionBuffer->candidatePairs);
+	CollisionManager_TestCandidatePairs();
 
-					//TODO: Remove
-					//Change the color of colliders to red until they are drawn
-					*Matrix_Index(gameObjects[i]->collider->colorMatrix, 0, 0) = 1.0f;
-					*Matrix_Index(gameObjects[i]->collider->colorMatrix, 1, 1) = 0.0f;
-					*Matrix_Index(gameObjects[i]->collider->colorMatrix, 2, 2) = 0.0f;
+	return CollisionManager_EndBroadphase();
+}
 
-					*Matrix_Index(gameObjects[j]->collider->colorMatrix, 0, 0) = 1.0f;
-					*Matrix_Index(gameObjects[j]->collider->colorMatrix, 1, 1) = 0.0f;
-					*Matrix_Index(gameObjects[j]->collider->colorMatrix, 2, 2) = 0.0f;
+///
+//Tests for collisions on all objects in a spatial hash grid compiling a list of collisions which occur
+//
+//Parameters:
+//	grid: The spatial hash grid holding the game objects to test
+//
+//Returns: A pointer to a dynamic array of collisions which occurred this frame
+DynamicArray* CollisionManager_UpdateSpatialHashGrid(SpatialHashGrid* grid)
+{
+	CollisionManager_BeginBroadphase();
 
-					//Allocate a new collision for next collision detected
-					collision = CollisionManager_AllocateCollision();
-					CollisionManager_InitializeCollision(collision);
-				}
-			}
-		}
-	}
+	//Get the pairs of objects with overlapping bounds
+	SpatialHashGrid_QueryPairs(grid, collisionBuffer->candidatePairs);
+	CollisionManager_TestCandidatePairs();
 
-	//Delete the last unused allocated collision
-	CollisionManager_FreeCollision(collision);
+	return CollisionManager_EndBroadphase();
 }
 
-
 ///
-//Tests for collisions on all objects which have colliders
-//compiling a list of collisions which occur
+//Tests for collisions on all objects in a linear oct tree compiling a list of collisions which occur
 //
 //Parameters:
-//	gameObjects: An array of game objects to test
+//	tree: The linear oct tree holding the game objects to test
+//
+//Returns: A pointer to a dynamic array of collisions which occurred this frame
+DynamicArray* CollisionManager_UpdateLinearOctTree(LinearOctTree* tree)
+{
+	CollisionManager_BeginBroadphase();
+
+	//Get the pairs of objects with overlapping bounds
+	LinearOctTree_QueryPairs(tree, collisionBuffer->candidatePairs, workerPool);
+	CollisionManager_TestCandidatePairs();
+
+	return CollisionManager_EndBroadphase();
+}
+
+///
+//Prepares the collision buffer & pair cache for a broadphase to report it's candidate pairs
+static void CollisionManager_BeginBroadphase(void)
+{
+	//Clear the current array of collisions
+	CollisionManager_ClearBuffer(collisionBuffer);
+	collisionBuffer->candidatePairs->size = 0;
+	collisionBuffer->reportedPairs->size = 0;
+	PairCache_BeginFrame(collisionBuffer->pairCache);
+}
+
+///
+//Finishes the collisions registered from the candidate pairs reported by a broadphase
 //
 //Returns:
-//	A pointer to a linked list of collisions which occurred this frame
-LinkedList* CollisionManager_UpdateArray(GObject** gameObjects, unsigned int numObjects)
+//	A pointer to a dynamic array of collisions which occurred this frame
+static DynamicArray* CollisionManager_EndBroadphase(void)
 {
-	//Clear the current list of collisions
-	LinkedList_Node* currentNode = collisionBuffer->collisions->head;
-	LinkedList_Node* nextNode = NULL;
-	while(currentNode != NULL)
+	//Remove the pairs which are no longer reported & link the collisions to their pairs
+	PairCache_EndFrame(collisionBuffer->pairCache);
+	CollisionManager_BindCollisionPairs(collisionBuffer);
+
+	//Group the collisions by the objects involved
+	CollisionManager_IndexObjectCollisions(collisionBuffer);
+
+	return collisionBuffer->collisions;
+}
+
+///
+//Tests all pairs of objects which were queried from a broadphase into the candidate pairs of the collision buffer,
+//along with any pairs which were already reported directly
+static void CollisionManager_TestCandidatePairs(void)
+{
+	GObject** candidates = (GObject**)collisionBuffer->candidatePairs->data;
+	for(unsigned int i = 0; i < collisionBuffer->candidatePairs->size; i += 2)
 	{
-		nextNode = currentNode->next;
-		Collision* currentCollision = (Collision*)currentNode->data;
-		CollisionManager_FreeCollision(currentCollision);
-		currentNode = nextNode;
+		CollisionManager_ReportPair(candidates[i], candidates[i + 1]);
 	}
-	LinkedList_Clear(collisionBuffer->collisions);
 
-	//Allocates a collision to store the first registered collision
-	Collision* collision = CollisionManager_AllocateCollision();
-	CollisionManager_InitializeCollision(collision);
+	CollisionManager_TestReportedPairs();
+}
 
-	for(int i = 0; i < numObjects; i++)
+///
+//Reports a pair of objects which a broadphase found as potentially colliding to the pair cache,
+//appending the pair to the reported pairs of the collision buffer to be tested.
+//Pairs which were already reported this frame are ignored.
+//
+//Parameters:
+//	obj1: A pointer to the first object of the pair (Must have collider attached)
+//	obj2: A pointer to the second object of the pair (Must have collider attached)
+static void CollisionManager_ReportPair(GObject* obj1, GObject* obj2)
+{
+	//Objects residing in multiple nodes may have already been reported from another node
+	CollisionBuffer_ReportedPair reported;
+	if(PairCache_Report(collisionBuffer->pairCache, obj1, obj2, &reported.pairIndex))
 	{
-		if(gameObjects[i]->collider != NULL)
+		reported.first = obj1;
+		DynamicArray_Append(collisionBuffer->reportedPairs, &reported);
+	}
+}
+
+///
+//Tests the reported pairs of the collision buffer on the worker pool,
+//registering the collisions in the order the pairs were reported
+static void CollisionManager_TestReportedPairs(void)
+{
+	for(unsigned int i = 0; i < collisionBuffer->numWorkers; i++)
+	{
+		collisionBuffer->workerCollisions[i]->size = 0;
+	}
+
+	//Orient the convex hulls of the reported pairs before the workers start, so the workers only ever read them
+	const CollisionBuffer_ReportedPair* reportedPairs = (CollisionBuffer_ReportedPair*)collisionBuffer->reportedPairs->data;
+	for(unsigned int i = 0; i < collisionBuffer->reportedPairs->size; i++)
+	{
+		PairCache_Pair* pair = PairCache_GetPair(collisionBuffer->pairCache, reportedPairs[i].pairIndex);
+		CollisionManager_RefreshWorldCache(pair->obj1);
+		CollisionManager_RefreshWorldCache(pair->obj2);
+	}
+
+	WorkerPool_Run(workerPool, CollisionManager_TestReportedPairRange, collisionBuffer, collisionBuffer->reportedPairs->size, CollisionManager_PAIRS_PER_BATCH);
+
+	//Any worker may have tested any pair, so look each pair's collision up in the worker which tested it.
+	//Registering the collisions in report order keeps the results the same regardless of the number of workers.
+	for(unsigned int i = 0; i < collisionBuffer->reportedPairs->size; i++)
+	{
+		if(reportedPairs[i].collisionIndex != UINT_MAX)
 		{
-			for(int j = i+1; j < numObjects; j++)
-			{
-				if(gameObjects[j]->collider != NULL)
-				{
-					CollisionManager_TestCollision( 
-						collision,
-						gameObjects[i],
-						gameObjects[i]->body != NULL ? gameObjects[i]->body->frame : gameObjects[i]->frameOfReference,		//If there is a rigidbody use that frame of reference, else use the objects
-						gameObjects[j],
-						gameObjects[j]->body != NULL ? gameObjects[j]->body->frame : gameObjects[j]->frameOfReference);	//If there is a rigidbody use that frame of reference, else use the objects
+			CollisionManager_RegisterCollision((Collision*)DynamicArray_Index(collisionBuffer->workerCollisions[reportedPairs[i].worker], reportedPairs[i].collisionIndex));
+		}
+	}
+}
 
-					if(collision->obj1 == NULL)
-					{
-						continue;
-					}
+///
+//Tests a range of the reported pairs of a collision buffer into the collisions of a worker
+//
+//Parameters:
+//	data: A pointer to the collision buffer holding the reported pairs
+//	begin: The index of the first reported pair to test
+//	end: The index one past the last reported pair to test
+//	worker: The index of the worker testing the pairs
+static void CollisionManager_TestReportedPairRange(void* data, unsigned int begin, unsigned int end, unsigned int worker)
+{
+	CollisionBuffer* buffer = (CollisionBuffer*)data;
+	CollisionBuffer_ReportedPair* reportedPairs = (CollisionBuffer_ReportedPair*)buffer->reportedPairs->data;
+	DynamicArray* dest = buffer->workerCollisions[worker];
 
-					//If code reaches this point, all tests detected collision.
-					//add to collided list
-					LinkedList_Append(collisionBuffer->collisions, collision);
-					
-					//Make copies of the collision to add to object's colliders
-					Collision* objCollision = CollisionManager_AllocateCollision();
-					CollisionManager_InitializeCollision(objCollision);
-
-					//objCollision->minimumTranslationVector = collision->minimumTranslationVector;
-					Vector_Copy(objCollision->minimumTranslationVector, collision->minimumTranslationVector);
-					objCollision->obj1 = collision->obj1;
-					objCollision->obj1Frame = collision->obj1Frame;
-					objCollision->obj2 = collision->obj2;
-					objCollision->obj2Frame = collision->obj2Frame;
-					objCollision->overlap = collision->overlap;
-
-					LinkedList_Append(collision->obj1->collider->currentCollisions, objCollision);
-
-					 objCollision = CollisionManager_AllocateCollision();
-					CollisionManager_InitializeCollision(objCollision);
-
-					//objCollision->minimumTranslationVector = collision->minimumTranslationVector;
-					Vector_Copy(objCollision->minimumTranslationVector, collision->minimumTranslationVector);
-					objCollision->obj1 = collision->obj1;
-					objCollision->obj1Frame = collision->obj1Frame;
-					objCollision->obj2 = collision->obj2;
-					objCollision->obj2Frame = collision->obj2Frame;
-					objCollision->overlap = collision->overlap;
-
-					LinkedList_Append(collision->obj2->collider->currentCollisions, objCollision);
+	//Collision to store the result of each test, registered collisions are copied into the worker's collisions
+	Collision collision;
+	CollisionManager_InitializeCollision(&collision);
 
-					//TODO: Remove
-					//Change the color of colliders to red until they are drawn
-					*Matrix_Index(gameObjects[i]->collider->colorMatrix, 0, 0) = 1.0f;
-					*Matrix_Index(gameObjects[i]->collider->colorMatrix, 1, 1) = 0.0f;
-					*Matrix_Index(gameObjects[i]->collider->colorMatrix, 2, 2) = 0.0f;
+	//Pairs of spheres & pairs of AABBs which must be retested are set aside to be tested together.
+	//The worker pool never passes more than CollisionManager_PAIRS_PER_BATCH pairs at once, so the batches can't overflow.
+	CollisionManager_ShapeBatch sphereBatch;
+	CollisionManager_ShapeBatch AABBBatch;
+	sphereBatch.count = AABBBatch.count = 0;
 
-					*Matrix_Index(gameObjects[j]->collider->colorMatrix, 0, 0) = 1.0f;
-					*Matrix_Index(gameObjects[j]->collider->colorMatrix, 1, 1) = 0.0f;
-					*Matrix_Index(gameObjects[j]->collider->colorMatrix, 2, 2) = 0.0f;
+	//Pairs whose bounds don't overlap can't collide, so only the rest go on to the narrow phase
+	unsigned char overlaps[CollisionManager_PAIRS_PER_BATCH];
+	CollisionManager_PrefilterPairs(overlaps, buffer, begin, end);
 
-					//Allocate a new collision for next collision detected
-					collision = CollisionManager_AllocateCollision();
-					CollisionManager_InitializeCollision(collision);
-				}
+	for(unsigned int i = begin; i < end; i++)
+	{
+		PairCache_Pair* pair = PairCache_GetPair(buffer->pairCache, reportedPairs[i].pairIndex);
+
+		if(!overlaps[i - begin])
+		{
+			FrameOfReference* pairFrame1 = pair->obj1->body != NULL ? pair->obj1->body->frame : pair->obj1->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+			FrameOfReference* pairFrame2 = pair->obj2->body != NULL ? pair->obj2->body->frame : pair->obj2->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+
+			collision.obj1 = NULL;
+			collision.obj1Frame = NULL;
+			collision.obj2 = NULL;
+			collision.obj2Frame = NULL;
+			collision.overlap = 0.0f;
+
+			CollisionManager_StorePairResult(pair, &collision);
+			PairCache_MarkTested(buffer->pairCache, pair, pairFrame1, pairFrame2);
+			CollisionManager_RecordResult(reportedPairs + i, &collision, dest, worker);
+			continue;
+		}
+
+		enum ColliderType shape = pair->obj1->collider->type;
+		if(shape == pair->obj2->collider->type && (shape == COLLIDER_SPHERE || shape == COLLIDER_AABB))
+		{
+			FrameOfReference* pairFrame1 = pair->obj1->body != NULL ? pair->obj1->body->frame : pair->obj1->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+			FrameOfReference* pairFrame2 = pair->obj2->body != NULL ? pair->obj2->body->frame : pair->obj2->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+
+			if(PairCache_HasMoved(pair, pairFrame1, pairFrame2))
+			{
+				CollisionManager_AddToBatch(shape == COLLIDER_SPHERE ? &sphereBatch : &AABBBatch, i, pair, reportedPairs[i].first, pairFrame1, pairFrame2);
+				continue;
 			}
 		}
-	}
 
-	//Delete the last unused allocated collision
-	CollisionManager_FreeCollision(collision);
+		CollisionManager_TestPair(&collision, pair, reportedPairs[i].first);
+		CollisionManager_RecordResult(reportedPairs + i, &collision, dest, worker);
+	}
 
-	return collisionBuffer->collisions;
+	CollisionManager_TestBatch(&sphereBatch, COLLIDER_SPHERE, buffer, worker);
+	CollisionManager_TestBatch(&AABBBatch, COLLIDER_AABB, buffer, worker);
 }
 
 ///
-//Tests for a collision between two objects which have colliders
+//Tests the world bounds of both objects of a range of reported pairs four pairs at a time.
+//Follows the same steps as Collider_DoWorldBoundsOverlap, so only pairs whose bounds overlap need go on to the narrow phase.
 //
 //Parameters:
-//	dest: Collision to store the results of test in
-//	obj1: First game object to test (Must have collider attached)
-//	obj1FoR: Pointer to frame of reference to use to orient Object 1
-//	obj2: Second game object to test (Must have collider attached)
-//	obj2FoR: Pointer to frame of reference to use to orient Object 2
-void CollisionManager_TestCollision(Collision* dest, GObject* obj1, FrameOfReference* obj1FoR, GObject* obj2, FrameOfReference* obj2FoR)
+//	overlaps: An array with room for a flag for each pair in the range, set to 1 if the bounds of the pair overlap else 0
+//	buffer: A pointer to the collision buffer holding the reported pairs
+//	begin: The index of the first reported pair to test, the range may hold at most CollisionManager_PAIRS_PER_BATCH pairs
+//	end: The index one past the last reported pair to test
+static void CollisionManager_PrefilterPairs(unsigned char* overlaps, CollisionBuffer* buffer, unsigned int begin, unsigned int end)
 {
-	//Test the types of the colliders
-	switch(obj1->collider->type)
+	const CollisionBuffer_ReportedPair* reportedPairs = (CollisionBuffer_ReportedPair*)buffer->reportedPairs->data;
+
+	//Gather the bounds of every pair, the bounds were refreshed before the workers started so they are only read here
+	CollisionManager_BoundsBatch batch;
+	batch.count = end - begin;
+	for(unsigned int i = 0; i < batch.count; i++)
 	{
-	case COLLIDER_SPHERE:
-		switch(obj2->collider->type)
-		{
-		case COLLIDER_SPHERE:						//Sphere on Sphere case
-			CollisionManager_TestConvexCollision(
-				dest,
-				obj1, 
-				obj1FoR,
-				obj2,
-				obj2FoR);
+		PairCache_Pair* pair = PairCache_GetPair(buffer->pairCache, reportedPairs[begin + i].pairIndex);
+		FrameOfReference* pairFrame1 = pair->obj1->body != NULL ? pair->obj1->body->frame : pair->obj1->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+		FrameOfReference* pairFrame2 = pair->obj2->body != NULL ? pair->obj2->body->frame : pair->obj2->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
 
-			break;
-		case COLLIDER_AABB:							//Sphere on AABB case
-			CollisionManager_TestAABBSphereCollision(
-				dest,
-				obj2,
-				obj2FoR,
-				obj1,
-				obj1FoR);
-			break;
-		case COLLIDER_CONVEXHULL:					//Sphere on Convex Hull case
-			CollisionManager_TestConvexSphereCollision(
-				dest,
-				obj2,
-				obj2FoR,
-				obj1,
-				obj1FoR);
+		Collider_WorldBounds scratch1;
+		Collider_WorldBounds scratch2;
+		const Collider_WorldBounds* bounds1 = Collider_GetWorldBoundsCache(&scratch1, pair->obj1->collider, pairFrame1);
+		const Collider_WorldBounds* bounds2 = Collider_GetWorldBoundsCache(&scratch2, pair->obj2->collider, pairFrame2);
 
-			break;
+		for(int j = 0; j < 3; j++)
+		{
+			batch.centers1[j][i] = bounds1->center[j];
+			batch.mins1[j][i] = bounds1->min[j];
+			batch.maxs1[j][i] = bounds1->max[j];
+			batch.centers2[j][i] = bounds2->center[j];
+			batch.mins2[j][i] = bounds2->min[j];
+			batch.maxs2[j][i] = bounds2->max[j];
 		}
+		batch.radii1[i] = bounds1->radius;
+		batch.radii2[i] = bounds2->radius;
+	}
 
-		break;
-	case COLLIDER_AABB:
-		switch(obj2->collider->type)
+	//Pad the batch to a whole number of registers so the unused lanes hold defined values
+	for(unsigned int i = batch.count; i % 4 != 0; i++)
+	{
+		for(int j = 0; j < 3; j++)
 		{
-		case COLLIDER_SPHERE:						//AABB on Sphere case
-			CollisionManager_TestAABBSphereCollision(
-				dest,
-				obj1,
-				obj1FoR,
-				obj2,
-				obj2FoR);
-
-			break;
-		case COLLIDER_AABB:							//AABB on AABB case
-			CollisionManager_TestAABBCollision(
-				dest,
-				obj1,
-				obj1FoR,
-				obj2,
-				obj2FoR);
+			batch.centers1[j][i] = batch.mins1[j][i] = batch.maxs1[j][i] = 0.0f;
+			batch.centers2[j][i] = batch.mins2[j][i] = batch.maxs2[j][i] = 0.0f;
+		}
+		batch.radii1[i] = batch.radii2[i] = 0.0f;
+	}
 
-			break;
-		case COLLIDER_CONVEXHULL:					//AABB on Convex Hull case
-			CollisionManager_TestAABBConvexCollision(
-				dest,
-				obj1,
-				obj1FoR,
-				obj2,
-				obj2FoR);
+	const __m128 margin = _mm_set1_ps(Collider_BOUNDS_MARGIN);
+	for(unsigned int i = 0; i < batch.count; i += 4)
+	{
+		//The bounding spheres must overlap
+		__m128 distanceSq = _mm_setzero_ps();
+		for(int j = 0; j < 3; j++)
+		{
+			__m128 offset = _mm_sub_ps(_mm_loadu_ps(batch.centers1[j] + i), _mm_loadu_ps(batch.centers2[j] + i));
+			distanceSq = _mm_add_ps(distanceSq, _mm_mul_ps(offset, offset));
+		}
+		__m128 reach = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(batch.radii1 + i), _mm_loadu_ps(batch.radii2 + i)), margin);
+		__m128 overlapping = _mm_cmple_ps(distanceSq, _mm_mul_ps(reach, reach));
 
-			break;
+		//And so must the axis aligned bounds along every axis
+		for(int j = 0; j < 3; j++)
+		{
+			__m128 min1 = _mm_loadu_ps(batch.mins1[j] + i);
+			__m128 max1 = _mm_loadu_ps(batch.maxs1[j] + i);
+			__m128 min2 = _mm_loadu_ps(batch.mins2[j] + i);
+			__m128 max2 = _mm_loadu_ps(batch.maxs2[j] + i);
+			overlapping = _mm_and_ps(overlapping, _mm_cmple_ps(min1, _mm_add_ps(max2, margin)));
+			overlapping = _mm_and_ps(overlapping, _mm_cmple_ps(min2, _mm_add_ps(max1, margin)));
+		}
+
+		int mask = _mm_movemask_ps(overlapping);
+		for(unsigned int j = 0; j < 4 && i + j < batch.count; j++)
+		{
+			overlaps[i + j] = (mask >> j) & 1;
+		}
+	}
+}
+
+///
+//Tests a pair of objects reported to the pair cache this frame.
+//Retests the pair only if either object moved since it was last tested, otherwise loads the last result.
+//Only touches the pair itself, so different pairs may be tested on different threads.
+//
+//Parameters:
+//	dest: A pointer to a collision to store the result of the test in
+//	pair: A pointer to the pair to test
+//	first: The object of the pair which was reported first
+static void CollisionManager_TestPair(Collision* dest, PairCache_Pair* pair, GObject* first)
+{
+	FrameOfReference* pairFrame1 = pair->obj1->body != NULL ? pair->obj1->body->frame : pair->obj1->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+	FrameOfReference* pairFrame2 = pair->obj2->body != NULL ? pair->obj2->body->frame : pair->obj2->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+
+	if(PairCache_HasMoved(pair, pairFrame1, pairFrame2))
+	{
+		//Let the narrow phase use what it remembers about the pair
+		dest->pair = pair;
+
+		//Test in the order the objects were reported
+		if(first == pair->obj1)
+		{
+			CollisionManager_TestCollision(dest, pair->obj1, pairFrame1, pair->obj2, pairFrame2);
+		}
+		else
+		{
+			CollisionManager_TestCollision(dest, pair->obj2, pairFrame2, pair->obj1, pairFrame1);
+		}
+
+		CollisionManager_StorePairResult(pair, dest);
+		PairCache_MarkTested(collisionBuffer->pairCache, pair, pairFrame1, pairFrame2);
+	}
+	else
+	{
+		//Neither object has moved since the pair was last tested, the last result still holds
+		CollisionManager_LoadPairResult(dest, pair, pairFrame1, pairFrame2);
+	}
+}
+
+///
+//Registers a detected collision in the collision buffer
+//
+//Parameters:
+//	collision: A pointer to the collision to register
+static void CollisionManager_RegisterCollision(const Collision* collision)
+{
+	//add to collided array
+	DynamicArray_Append(collisionBuffer->collisions, (void*)collision);
+
+	//TODO: Remove
+	//Change the color of colliders to red until they are drawn
+	*Matrix_Index(collision->obj1->collider->colorMatrix, 0, 0) = 1.0f;
+	*Matrix_Index(collision->obj1->collider->colorMatrix, 1, 1) = 0.0f;
+	*Matrix_Index(collision->obj1->collider->colorMatrix, 2, 2) = 0.0f;
+
+	*Matrix_Index(collision->obj2->collider->colorMatrix, 0, 0) = 1.0f;
+	*Matrix_Index(collision->obj2->collider->colorMatrix, 1, 1) = 0.0f;
+	*Matrix_Index(collision->obj2->collider->colorMatrix, 2, 2) = 0.0f;
+}
+
+
+///
+//Records the result of testing a reported pair, appending the collision to a worker's collisions if the objects collide
+//
+//Parameters:
+//	reportedPair: A pointer to the reported pair which was tested
+//	collision: A pointer to the result of the test
+//	dest: A pointer to the dynamic array of collisions of the worker which tested the pair
+//	worker: The index of the worker which tested the pair
+static void CollisionManager_RecordResult(CollisionBuffer_ReportedPair* reportedPair, const Collision* collision, DynamicArray* dest, unsigned int worker)
+{
+	reportedPair->worker = worker;
+	if(collision->obj1 != NULL)
+	{
+		reportedPair->collisionIndex = dest->size;
+		DynamicArray_Append(dest, (void*)collision);
+	}
+	else
+	{
+		reportedPair->collisionIndex = UINT_MAX;
+	}
+}
+
+///
+//Adds a reported pair whose colliders share a shape to a batch to be tested with the other pairs of that shape
+//
+//Parameters:
+//	batch: A pointer to the shape batch to add the pair to, must have room for another pair
+//	reportedPairIndex: The index of the pair in the reported pairs
+//	pair: A pointer to the pair to add
+//	first: The object of the pair which was reported first
+//	obj1Frame: The frame of reference currently orienting obj1 of the pair
+//	obj2Frame: The frame of reference currently orienting obj2 of the pair
+static void CollisionManager_AddToBatch(CollisionManager_ShapeBatch* batch, unsigned int reportedPairIndex, PairCache_Pair* pair, GObject* first, const FrameOfReference* obj1Frame, const FrameOfReference* obj2Frame)
+{
+	unsigned int index = batch->count++;
+	batch->reportedPairs[index] = reportedPairIndex;
+	batch->reversed[index] = first != pair->obj1;
+
+	//Test in the order the objects were reported
+	GObject* objects[2] = { pair->obj1, pair->obj2 };
+	const FrameOfReference* frames[2] = { obj1Frame, obj2Frame };
+	float (*centers[2])[CollisionManager_PAIRS_PER_BATCH] = { batch->centers1, batch->centers2 };
+	float (*extents[2])[CollisionManager_PAIRS_PER_BATCH] = { batch->extents1, batch->extents2 };
+
+	for(int i = 0; i < 2; i++)
+	{
+		GObject* obj = objects[i ^ batch->reversed[index]];
+		const FrameOfReference* frame = frames[i ^ batch->reversed[index]];
+
+		if(obj->collider->type == COLLIDER_SPHERE)
+		{
+			for(int j = 0; j < 3; j++)
+			{
+				centers[i][j][index] = frame->position->components[j];
+			}
+			extents[i][0][index] = SphereCollider_GetScaledRadius(obj->collider->data->sphereData, frame);
+		}
+		else
+		{
+			ColliderData_AABB* AABB = obj->collider->data->AABBData;
+			ColliderData_AABB scaledAABB;
+			AABBCollider_GetScaledDimensions(&scaledAABB, AABB, frame);
+
+			float dimensions[3] = { scaledAABB.width, scaledAABB.height, scaledAABB.depth };
+			for(int j = 0; j < 3; j++)
+			{
+				centers[i][j][index] = frame->position->components[j] + AABB->centroid->components[j];
+				extents[i][j][index] = dimensions[j] / 2.0f;
+			}
+		}
+	}
+}
+
+///
+//Tests the pairs of a shape batch, storing the result in each pair & recording it in a worker's collisions
+//
+//Parameters:
+//	batch: A pointer to the shape batch to test
+//	shape: The type of the colliders in the batch, either COLLIDER_SPHERE or COLLIDER_AABB
+//	buffer: A pointer to the collision buffer holding the reported pairs of the batch
+//	worker: The index of the worker testing the batch
+static void CollisionManager_TestBatch(CollisionManager_ShapeBatch* batch, enum ColliderType shape, CollisionBuffer* buffer, unsigned int worker)
+{
+	if(batch->count == 0) return;
+
+	//Pad the batch to a whole number of registers so the unused lanes hold defined values
+	for(unsigned int i = batch->count; i % 4 != 0; i++)
+	{
+		for(int j = 0; j < 3; j++)
+		{
+			batch->centers1[j][i] = batch->extents1[j][i] = batch->centers2[j][i] = batch->extents2[j][i] = 0.0f;
+		}
+	}
+
+	CollisionManager_BatchHit hits[CollisionManager_PAIRS_PER_BATCH];
+	unsigned int numHits = shape == COLLIDER_SPHERE ? CollisionManager_TestSphereBatch(batch, hits) : CollisionManager_TestAABBBatch(batch, hits);
+
+	CollisionBuffer_ReportedPair* reportedPairs = (CollisionBuffer_ReportedPair*)buffer->reportedPairs->data;
+	DynamicArray* dest = buffer->workerCollisions[worker];
+
+	Collision collision;
+	CollisionManager_InitializeCollision(&collision);
+
+	unsigned int hit = 0;
+	for(unsigned int i = 0; i < batch->count; i++)
+	{
+		CollisionBuffer_ReportedPair* reportedPair = reportedPairs + batch->reportedPairs[i];
+		PairCache_Pair* pair = PairCache_GetPair(buffer->pairCache, reportedPair->pairIndex);
+		FrameOfReference* pairFrame1 = pair->obj1->body != NULL ? pair->obj1->body->frame : pair->obj1->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+		FrameOfReference* pairFrame2 = pair->obj2->body != NULL ? pair->obj2->body->frame : pair->obj2->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+
+		if(hit < numHits && hits[hit].index == i)
+		{
+			//The sphere test reports the objects in the order they were tested, the AABB test in the opposite order
+			unsigned char firstIsObj1 = (batch->reversed[i] != 0) == (shape == COLLIDER_AABB);
+			collision.obj1 = firstIsObj1 ? pair->obj1 : pair->obj2;
+			collision.obj1Frame = firstIsObj1 ? pairFrame1 : pairFrame2;
+			collision.obj2 = firstIsObj1 ? pair->obj2 : pair->obj1;
+			collision.obj2Frame = firstIsObj1 ? pairFrame2 : pairFrame1;
+			collision.obj1Collider = collision.obj1->collider;
+			collision.obj2Collider = collision.obj2->collider;
+
+			Vector_CopyArray(collision.minimumTranslationVector, hits[hit].normal, 3);
+			collision.overlap = hits[hit].overlap;
+			hit++;
+		}
+		else
+		{
+			collision.overlap = 0.0f;
+			collision.obj1 = NULL;
+			collision.obj2 = NULL;
+			collision.obj1Frame = NULL;
+			collision.obj2Frame = NULL;
+		}
+
+		CollisionManager_StorePairResult(pair, &collision);
+		PairCache_MarkTested(buffer->pairCache, pair, pairFrame1, pairFrame2);
+		CollisionManager_RecordResult(reportedPair, &collision, dest, worker);
+	}
+}
+
+///
+//Tests a batch of pairs of spheres four at a time.
+//Follows the same steps as CollisionManager_TestSphereCollision, so the results are exactly the same.
+//
+//Parameters:
+//	batch: A pointer to the shape batch of spheres to test
+//	hits: An array of at least batch->count hits to store the detected collisions in, in the order of the batch
+//
+//Returns:
+//	The number of collisions detected
+static unsigned int CollisionManager_TestSphereBatch(const CollisionManager_ShapeBatch* batch, CollisionManager_BatchHit* hits)
+{
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 signBit = _mm_set1_ps(-0.0f);
+
+	unsigned int numHits = 0;
+	for(unsigned int i = 0; i < batch->count; i += 4)
+	{
+		__m128 radius1 = _mm_loadu_ps(batch->extents1[0] + i);
+		__m128 radius2 = _mm_loadu_ps(batch->extents2[0] + i);
+
+		//Displacement will always be facing towards obj1
+		__m128 displacement[3];
+		__m128 distanceSq = zero;
+		for(int j = 0; j < 3; j++)
+		{
+			displacement[j] = _mm_sub_ps(_mm_loadu_ps(batch->centers1[j] + i), _mm_loadu_ps(batch->centers2[j] + i));
+			distanceSq = _mm_add_ps(distanceSq, _mm_mul_ps(displacement[j], displacement[j]));
+		}
+		__m128 distance = _mm_sqrt_ps(distanceSq);
+
+		int mask = _mm_movemask_ps(_mm_cmplt_ps(distance, _mm_add_ps(radius1, radius2)));
+		//Drop the padding past the end of the batch
+		if(batch->count - i < 4) mask &= (1 << (batch->count - i)) - 1;
+		if(mask == 0) continue;
+
+		//Normalize the displacement unless the centers coincide, in which case it is left as the zero vector
+		__m128 nonZero = _mm_cmpneq_ps(distance, zero);
+		__m128 normal[3];
+		for(int j = 0; j < 3; j++)
+		{
+			normal[j] = _mm_or_ps(_mm_and_ps(nonZero, _mm_div_ps(displacement[j], distance)), _mm_andnot_ps(nonZero, displacement[j]));
+		}
+
+		//Get the overlaps between the projection bounds of the spheres on the normal
+		__m128 negRadius1 = _mm_xor_ps(radius1, signBit);
+		__m128 negRadius2 = _mm_xor_ps(radius2, signBit);
+		__m128 overlap1Sq = zero;
+		__m128 overlap2Sq = zero;
+		for(int j = 0; j < 3; j++)
+		{
+			__m128 center1 = _mm_loadu_ps(batch->centers1[j] + i);
+			__m128 center2 = _mm_loadu_ps(batch->centers2[j] + i);
+
+			__m128 overlap1 = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(normal[j], radius1), center1), _mm_add_ps(_mm_mul_ps(normal[j], negRadius2), center2));
+			__m128 overlap2 = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(normal[j], radius2), center2), _mm_add_ps(_mm_mul_ps(normal[j], negRadius1), center1));
+			overlap1Sq = _mm_add_ps(overlap1Sq, _mm_mul_ps(overlap1, overlap1));
+			overlap2Sq = _mm_add_ps(overlap2Sq, _mm_mul_ps(overlap2, overlap2));
+		}
+		__m128 overlap = _mm_min_ps(_mm_sqrt_ps(overlap1Sq), _mm_sqrt_ps(overlap2Sq));
+
+		float normals[3][4];
+		float overlaps[4];
+		for(int j = 0; j < 3; j++)
+		{
+			_mm_storeu_ps(normals[j], normal[j]);
+		}
+		_mm_storeu_ps(overlaps, overlap);
+
+		for(int lane = 0; lane < 4; lane++)
+		{
+			if(mask & (1 << lane))
+			{
+				CollisionManager_BatchHit* hit = hits + numHits++;
+				hit->index = i + lane;
+				hit->normal[0] = normals[0][lane];
+				hit->normal[1] = normals[1][lane];
+				hit->normal[2] = normals[2][lane];
+				hit->overlap = overlaps[lane];
+			}
+		}
+	}
+
+	return numHits;
+}
+
+///
+//Tests a batch of pairs of AABBs four at a time.
+//Follows the same steps as CollisionManager_TestAABBCollision, so the results are exactly the same.
+//The collisions are between the second object and the first object of each pair, in that order.
+//
+//Parameters:
+//	batch: A pointer to the shape batch of AABBs to test
+//	hits: An array of at least batch->count hits to store the detected collisions in, in the order of the batch
+//
+//Returns:
+//	The number of collisions detected
+static unsigned int CollisionManager_TestAABBBatch(const CollisionManager_ShapeBatch* batch, CollisionManager_BatchHit* hits)
+{
+	//Face normals of the first object in the order right, left, top, bottom, front, back.
+	//The negative normals are made by scaling the positive ones, which leaves their zero components negative.
+	static const float faceNormals[6][3] =
+	{
+		{ 1.0f, 0.0f, 0.0f }, { -1.0f, -0.0f, -0.0f },
+		{ 0.0f, 1.0f, 0.0f }, { -0.0f, -1.0f, -0.0f },
+		{ 0.0f, 0.0f, 1.0f }, { -0.0f, -0.0f, -1.0f }
+	};
+
+	const __m128 zero = _mm_setzero_ps();
+
+	unsigned int numHits = 0;
+	for(unsigned int i = 0; i < batch->count; i += 4)
+	{
+		//Overlap of each face of obj1 with the opposite face of obj2, any negative overlap separates the boxes
+		__m128 overlaps[6];
+		__m128 separated = zero;
+		for(int j = 0; j < 3; j++)
+		{
+			__m128 center1 = _mm_loadu_ps(batch->centers1[j] + i);
+			__m128 extent1 = _mm_loadu_ps(batch->extents1[j] + i);
+			__m128 center2 = _mm_loadu_ps(batch->centers2[j] + i);
+			__m128 extent2 = _mm_loadu_ps(batch->extents2[j] + i);
+
+			overlaps[2 * j] = _mm_sub_ps(_mm_add_ps(center1, extent1), _mm_sub_ps(center2, extent2));
+			overlaps[2 * j + 1] = _mm_sub_ps(_mm_add_ps(center2, extent2), _mm_sub_ps(center1, extent1));
+			separated = _mm_or_ps(separated, _mm_or_ps(_mm_cmplt_ps(overlaps[2 * j], zero), _mm_cmplt_ps(overlaps[2 * j + 1], zero)));
+		}
+
+		int mask = ~_mm_movemask_ps(separated) & 0xF;
+		//Drop the padding past the end of the batch
+		if(batch->count - i < 4) mask &= (1 << (batch->count - i)) - 1;
+		if(mask == 0) continue;
+
+		float faceOverlaps[6][4];
+		for(int j = 0; j < 6; j++)
+		{
+			_mm_storeu_ps(faceOverlaps[j], overlaps[j]);
+		}
+
+		for(int lane = 0; lane < 4; lane++)
+		{
+			if(mask & (1 << lane))
+			{
+				//The MTV is the face normal with the least overlap, the first face wins ties
+				int face = 0;
+				for(int j = 1; j < 6; j++)
+				{
+					if(faceOverlaps[j][lane] < faceOverlaps[face][lane]) face = j;
+				}
+
+				CollisionManager_BatchHit* hit = hits + numHits++;
+				hit->index = i + lane;
+				hit->normal[0] = faceNormals[face][0];
+				hit->normal[1] = faceNormals[face][1];
+				hit->normal[2] = faceNormals[face][2];
+				hit->overlap = faceOverlaps[face][lane];
+			}
+		}
+	}
+
+	return numHits;
+}
+
+///
+//Tests for collisions on all objects which have colliders
+//compiling a list of collisions which occur
+//
+//Parameters:
+//	gameObjects: An array of game objects to test
+//
+//Returns:
+//	A pointer to a dynamic array of collisions which occurred this frame
+DynamicArray* CollisionManager_UpdateArray(GObject** gameObjects, unsigned int numObjects)
+{
+	//Clear the current array of collisions
+	CollisionManager_ClearBuffer(collisionBuffer);
+
+	//Collision to store the result of each test, registered collisions are copied into the buffer
+	Collision collision;
+	CollisionManager_InitializeCollision(&collision);
+
+	//Orient each convex hull once up front rather than once for every pair it is tested in
+	for(unsigned int i = 0; i < numObjects; i++)
+	{
+		CollisionManager_RefreshWorldCache(gameObjects[i]);
+	}
+
+	for(int i = 0; i < numObjects; i++)
+	{
+		if(gameObjects[i]->collider != NULL)
+		{
+			for(int j = i+1; j < numObjects; j++)
+			{
+				if(gameObjects[j]->collider != NULL)
+				{
+					CollisionManager_TestCollision( 
+						&collision,
+						gameObjects[i],
+						gameObjects[i]->body != NULL ? gameObjects[i]->body->frame : gameObjects[i]->frameOfReference,		//If there is a rigidbody use that frame of reference, else use the objects
+						gameObjects[j],
+						gameObjects[j]->body != NULL ? gameObjects[j]->body->frame : gameObjects[j]->frameOfReference);	//If there is a rigidbody use that frame of reference, else use the objects
+
+					if(collision.obj1 == NULL)
+					{
+						continue;
+					}
+
+					//If code reaches this point, all tests detected collision.
+					//add to collided array
+					DynamicArray_Append(collisionBuffer->collisions, &collision);
+
+					//TODO: Remove
+					//Change the color of colliders to red until they are drawn
+					*Matrix_Index(gameObjects[i]->collider->colorMatrix, 0, 0) = 1.0f;
+					*Matrix_Index(gameObjects[i]->collider->colorMatrix, 1, 1) = 0.0f;
+					*Matrix_Index(gameObjects[i]->collider->colorMatrix, 2, 2) = 0.0f;
+
+					*Matrix_Index(gameObjects[j]->collider->colorMatrix, 0, 0) = 1.0f;
+					*Matrix_Index(gameObjects[j]->collider->colorMatrix, 1, 1) = 0.0f;
+					*Matrix_Index(gameObjects[j]->collider->colorMatrix, 2, 2) = 0.0f;
+				}
+			}
+		}
+	}
+
+	//Group the collisions by the objects involved
+	CollisionManager_IndexObjectCollisions(collisionBuffer);
+
+	return collisionBuffer->collisions;
+}
+
+///
+//Tests for a collision between two objects which have colliders
+//
+//Parameters:
+//	dest: Collision to store the results of test in
+//	obj1: First game object to test (Must have collider attached)
+//	obj1FoR: Pointer to frame of reference to use to orient Object 1
+//	obj2: Second game object to test (Must have collider attached)
+//	obj2FoR: Pointer to frame of reference to use to orient Object 2
+void CollisionManager_TestCollision(Collision* dest, GObject* obj1, FrameOfReference* obj1FoR, GObject* obj2, FrameOfReference* obj2FoR)
+{
+	//Objects whose bounds don't overlap can't collide, so there is no need to run the narrow phase
+	Collider_WorldBounds scratch1;
+	Collider_WorldBounds scratch2;
+	if(!Collider_DoWorldBoundsOverlap(Collider_GetWorldBoundsCache(&scratch1, obj1->collider, obj1FoR), Collider_GetWorldBoundsCache(&scratch2, obj2->collider, obj2FoR)))
+	{
+		dest->obj1 = NULL;
+		dest->obj1Frame = NULL;
+		dest->obj2 = NULL;
+		dest->obj2Frame = NULL;
+		dest->overlap = 0.0f;
+		return;
+	}
+
+	//Compound colliders are tested piece by piece
+	if(obj1->collider->type == COLLIDER_COMPOUND)
+	{
+		CollisionManager_TestCompoundCollision(dest, obj1, obj1FoR, obj2, obj2FoR);
+		return;
+	}
+	if(obj2->collider->type == COLLIDER_COMPOUND)
+	{
+		CollisionManager_TestCompoundCollision(dest, obj2, obj2FoR, obj1, obj1FoR);
+		return;
+	}
+
+	//Test the types of the colliders
+	switch(obj1->collider->type)
+	{
+	case COLLIDER_SPHERE:
+		switch(obj2->collider->type)
+		{
+		case COLLIDER_SPHERE:						//Sphere on Sphere case
+			CollisionManager_TestSphereCollision(
+				dest,
+				obj1, 
+				obj1FoR,
+				obj2,
+				obj2FoR);
+
+			break;
+		case COLLIDER_AABB:							//Sphere on AABB case
+			CollisionManager_TestAABBSphereCollision(
+				dest,
+				obj2,
+				obj2FoR,
+				obj1,
+				obj1FoR);
+			break;
+		case COLLIDER_CONVEXHULL:					//Sphere on Convex Hull case
+			CollisionManager_TestConvexSphereCollision(
+				dest,
+				obj2,
+				obj2FoR,
+				obj1,
+				obj1FoR);
+
+			break;
+		default:									//Compound colliders were tested piece by piece above
+			break;
+		}
+
+		break;
+	case COLLIDER_AABB:
+		switch(obj2->collider->type)
+		{
+		case COLLIDER_SPHERE:						//AABB on Sphere case
+			CollisionManager_TestAABBSphereCollision(
+				dest,
+				obj1,
+				obj1FoR,
+				obj2,
+				obj2FoR);
+
+			break;
+		case COLLIDER_AABB:							//AABB on AABB case
+			CollisionManager_TestAABBCollision(
+				dest,
+				obj1,
+				obj1FoR,
+				obj2,
+				obj2FoR);
+
+			break;
+		case COLLIDER_CONVEXHULL:					//AABB on Convex Hull case
+			if(convexAlgorithms[COLLIDER_AABB][COLLIDER_CONVEXHULL] == CONVEXALGORITHM_GJK)
+			{
+				CollisionManager_TestGJKCollision(
+					dest,
+					obj1,
+					obj1FoR,
+					obj2,
+					obj2FoR);
+
+				break;
+			}
+
+			CollisionManager_TestAABBConvexCollision(
+				dest,
+				obj1,
+				obj1FoR,
+				obj2,
+				obj2FoR);
+
+			break;
+		default:									//Compound colliders were tested piece by piece above
+			break;
 		}
 
 		break;
@@ -463,6 +1148,18 @@ void CollisionManager_TestCollision(Collision* dest, GObject* obj1, FrameOfRefer
 
 			break;
 		case COLLIDER_AABB:							//Convex Hull on AABB case
+			if(convexAlgorithms[COLLIDER_CONVEXHULL][COLLIDER_AABB] == CONVEXALGORITHM_GJK)
+			{
+				CollisionManager_TestGJKCollision(
+					dest,
+					obj2,
+					obj2FoR,
+					obj1,
+					obj1FoR);
+
+				break;
+			}
+
 			CollisionManager_TestAABBConvexCollision(
 				dest,
 				obj2,
@@ -472,6 +1169,18 @@ void CollisionManager_TestCollision(Collision* dest, GObject* obj1, FrameOfRefer
 
 			break;
 		case COLLIDER_CONVEXHULL:					//Convex Hull on  Convex Hull case
+			if(convexAlgorithms[COLLIDER_CONVEXHULL][COLLIDER_CONVEXHULL] == CONVEXALGORITHM_GJK)
+			{
+				CollisionManager_TestGJKCollision(
+					dest,
+					obj1,
+					obj1FoR,
+					obj2,
+					obj2FoR);
+
+				break;
+			}
+
 			CollisionManager_TestConvexCollision(
 				dest,
 				obj1,
@@ -479,11 +1188,84 @@ void CollisionManager_TestCollision(Collision* dest, GObject* obj1, FrameOfRefer
 				obj2,
 				obj2FoR);
 
+			break;
+		default:									//Compound colliders were tested piece by piece above
 			break;
 		}
 
 		break;
+	default:										//Compound colliders were tested piece by piece above
+		break;
+	}
+
+	//Neither object has pieces, so the colliders which were hit are the objects' own
+	if(dest->obj1 != NULL)
+	{
+		dest->obj1Collider = dest->obj1->collider;
+		dest->obj2Collider = dest->obj2->collider;
+	}
+}
+
+///
+//Tests for a collision between an object with a compound collider & any other object.
+//Only the pieces whose bounding spheres reach the bounding sphere of the other object are tested,
+//and the collision with the deepest overlap is kept.
+//
+//Parameters:
+//	dest: Collision to store the results of test in
+//	compoundObj: The object with the compound collider
+//	compoundFoR: Pointer to frame of reference to use to orient the compound object
+//	obj: The other object, may have a compound collider as well
+//	objFoR: Pointer to frame of reference to use to orient the other object
+static void CollisionManager_TestCompoundCollision(Collision* dest, GObject* compoundObj, FrameOfReference* compoundFoR, GObject* obj, FrameOfReference* objFoR)
+{
+	const ColliderData_Compound* compound = compoundObj->collider->data->compoundData;
+
+	//Find the pieces near the other object
+	Collider_WorldBounds scratch;
+	const Collider_WorldBounds* bounds = Collider_GetWorldBoundsCache(&scratch, obj->collider, objFoR);
+	unsigned int candidates[CompoundCollider_MAX_PIECES];
+	unsigned int numCandidates = CompoundCollider_QuerySphere(candidates, compound, compoundFoR, bounds->center, bounds->radius);
+
+	//Each piece is tested as though it were the collider of the compound object
+	GObject proxy = *compoundObj;
+
+	Collision best;
+	CollisionManager_InitializeCollision(&best);
+	Collision pieceCollision;
+	for(unsigned int i = 0; i < numCandidates; i++)
+	{
+		proxy.collider = *(Collider**)DynamicArray_Index(compound->pieces, candidates[i]);
+
+		//The separating axis hints of the pair belong to the compound collider as a whole, so the pieces are tested without them
+		CollisionManager_InitializeCollision(&pieceCollision);
+		CollisionManager_TestCollision(&pieceCollision, &proxy, compoundFoR, obj, objFoR);
+
+		if(pieceCollision.obj1 != NULL && (best.obj1 == NULL || pieceCollision.overlap > best.overlap))
+		{
+			best = pieceCollision;
+		}
 	}
+
+	if(best.obj1 == NULL)
+	{
+		dest->obj1 = NULL;
+		dest->obj1Frame = NULL;
+		dest->obj2 = NULL;
+		dest->obj2Frame = NULL;
+		dest->overlap = 0.0f;
+		return;
+	}
+
+	//Report the compound object itself rather than the proxy
+	dest->obj1 = best.obj1 == &proxy ? compoundObj : best.obj1;
+	dest->obj1Frame = best.obj1Frame;
+	dest->obj2 = best.obj2 == &proxy ? compoundObj : best.obj2;
+	dest->obj2Frame = best.obj2Frame;
+	dest->obj1Collider = best.obj1Collider;
+	dest->obj2Collider = best.obj2Collider;
+	Vector_CopyArray(dest->minimumTranslationVector, best.minimumTranslationVector, 3);
+	dest->overlap = best.overlap;
 }
 
 ///
@@ -528,7 +1310,7 @@ void CollisionManager_TestSphereCollision(Collision* dest, GObject* obj1, FrameO
 		Vector_Normalize(&displacement);
 
 		//Set MTV
-		Vector_Copy(dest->minimumTranslationVector, &displacement);
+		Vector_CopyArray(dest->minimumTranslationVector, displacement.components, 3);
 
 		//Find the projection bounds
 		Vector obj1MinPoint;
@@ -693,6 +1475,31 @@ void CollisionManager_TestAABBSphereCollision(Collision* dest, GObject* AABBObj,
 		return;
 	}
 
+	//The faces alone miss spheres near an edge or corner of the AABB, so test the axis from the closest point of the AABB to the sphere's center too.
+	//The closest point is the sphere's center clamped to the AABB, if the center is inside the AABB the faces give the MTV.
+	float closestDisplacement[3];
+	float halfDimensions[3] = { scaledAABB.width / 2.0f, scaledAABB.height / 2.0f, scaledAABB.depth / 2.0f };
+	for(int i = 0; i < 3; i++)
+	{
+		float displacement = sphereFoR->position->components[i] - (AABBFoR->position->components[i] + AABB->centroid->components[i]);
+		float clamped = displacement < -halfDimensions[i] ? -halfDimensions[i] : (displacement > halfDimensions[i] ? halfDimensions[i] : displacement);
+		closestDisplacement[i] = displacement - clamped;
+	}
+
+	float closestDistance = Vector_GetMagFromArray(closestDisplacement, 3);
+	float overlapClosest = scaledRadius - closestDistance;
+	if(overlapClosest < 0.0f)
+	{
+		//No collision, set the collision attributes to null
+		dest->overlap = 0.0f;
+		dest->obj1 = NULL;
+		dest->obj2 = NULL;
+		dest->obj1Frame = NULL;
+		dest->obj2Frame = NULL;
+
+		return;
+	}
+
 	//If code reaches this point, there is a collision. 
 	//The MTV must always point towards obj1. The MTV will be the face normal of the bounding box,
 	//Therefore obj1 must be the object with the sphere collider
@@ -706,44 +1513,51 @@ void CollisionManager_TestAABBSphereCollision(Collision* dest, GObject* AABBObj,
 	//The MTV will be the axis with the minimum overlap
 	//Righ face
 	dest->overlap = overlapRight;
-	Vector_Copy(dest->minimumTranslationVector, &Vector_E1);
+	Vector_CopyArray(dest->minimumTranslationVector, Vector_E1Components, 3);
 
 	//Left Face
 	if(overlapLeft < dest->overlap)
 	{
 		dest->overlap = overlapLeft;
-		Vector_Copy(dest->minimumTranslationVector, &Vector_E1);
-		Vector_Scale(dest->minimumTranslationVector, -1.0f);
+		Vector_CopyArray(dest->minimumTranslationVector, Vector_E1Components, 3);
+		Vector_ScaleArray(dest->minimumTranslationVector, -1.0f, 3);
 	}
 
 	//Top Face
 	if(overlapTop < dest->overlap)
 	{
 		dest->overlap = overlapTop;
-		Vector_Copy(dest->minimumTranslationVector, &Vector_E2);
+		Vector_CopyArray(dest->minimumTranslationVector, Vector_E2Components, 3);
 	}
 
 	//Bottom face
 	if(overlapBottom < dest->overlap)
 	{
 		dest->overlap = overlapBottom;
-		Vector_Copy(dest->minimumTranslationVector, &Vector_E2);
-		Vector_Scale(dest->minimumTranslationVector, -1.0f);
+		Vector_CopyArray(dest->minimumTranslationVector, Vector_E2Components, 3);
+		Vector_ScaleArray(dest->minimumTranslationVector, -1.0f, 3);
 	}
 
 	//Front face
 	if(overlapFront < dest->overlap)
 	{
 		dest->overlap = overlapFront;
-		Vector_Copy(dest->minimumTranslationVector, &Vector_E3);
+		Vector_CopyArray(dest->minimumTranslationVector, Vector_E3Components, 3);
 	}
 
 	//Back face
 	if(overlapBack < dest->overlap)
 	{
 		dest->overlap = overlapBack;
-		Vector_Copy(dest->minimumTranslationVector, &Vector_E3);
-		Vector_Scale(dest->minimumTranslationVector, -1.0f);
+		Vector_CopyArray(dest->minimumTranslationVector, Vector_E3Components, 3);
+		Vector_ScaleArray(dest->minimumTranslationVector, -1.0f, 3);
+	}
+
+	//Edge or corner
+	if(closestDistance > 0.0f && overlapClosest < dest->overlap)
+	{
+		dest->overlap = overlapClosest;
+		Vector_GetScalarProductFromArray(dest->minimumTranslationVector, closestDisplacement, 1.0f / closestDistance, 3);
 	}
 }
 
@@ -879,44 +1693,44 @@ void CollisionManager_TestAABBCollision(Collision* dest, GObject* obj1, FrameOfR
 	//The MTV will be the axis with the minimum overlap
 	//Righ face
 	dest->overlap = overlapRight;
-	Vector_Copy(dest->minimumTranslationVector, &Vector_E1);
+	Vector_CopyArray(dest->minimumTranslationVector, Vector_E1Components, 3);
 
 	//Left Face
 	if(overlapLeft < dest->overlap)
 	{
 		dest->overlap = overlapLeft;
-		Vector_Copy(dest->minimumTranslationVector, &Vector_E1);
-		Vector_Scale(dest->minimumTranslationVector, -1.0f);
+		Vector_CopyArray(dest->minimumTranslationVector, Vector_E1Components, 3);
+		Vector_ScaleArray(dest->minimumTranslationVector, -1.0f, 3);
 	}
 
 	//Top Face
 	if(overlapTop < dest->overlap)
 	{
 		dest->overlap = overlapTop;
-		Vector_Copy(dest->minimumTranslationVector, &Vector_E2);
+		Vector_CopyArray(dest->minimumTranslationVector, Vector_E2Components, 3);
 	}
 
 	//Bottom face
 	if(overlapBottom < dest->overlap)
 	{
 		dest->overlap = overlapBottom;
-		Vector_Copy(dest->minimumTranslationVector, &Vector_E2);
-		Vector_Scale(dest->minimumTranslationVector, -1.0f);
+		Vector_CopyArray(dest->minimumTranslationVector, Vector_E2Components, 3);
+		Vector_ScaleArray(dest->minimumTranslationVector, -1.0f, 3);
 	}
 
 	//Front face
 	if(overlapFront < dest->overlap)
 	{
 		dest->overlap = overlapFront;
-		Vector_Copy(dest->minimumTranslationVector, &Vector_E3);
+		Vector_CopyArray(dest->minimumTranslationVector, Vector_E3Components, 3);
 	}
 
 	//Back face
 	if(overlapBack < dest->overlap)
 	{
 		dest->overlap = overlapBack;
-		Vector_Copy(dest->minimumTranslationVector, &Vector_E3);
-		Vector_Scale(dest->minimumTranslationVector, -1.0f);
+		Vector_CopyArray(dest->minimumTranslationVector, Vector_E3Components, 3);
+		Vector_ScaleArray(dest->minimumTranslationVector, -1.0f, 3);
 	}
 }
 
@@ -939,54 +1753,15 @@ void CollisionManager_TestAABBConvexCollision(Collision* dest, GObject* AABBObj,
 	ColliderData_AABB scaledAABB;
 	AABBCollider_GetScaledDimensions(&scaledAABB, AABB, AABBObjFrame);
 
-	//We must convert the AABB to a convex hull and get the oriented axis and oriented points from both objects
-	Vector** orientedPointsAABB = (Vector**)malloc(sizeof(Vector*) * 8);
-	Vector** orientedPointsConvex = (Vector**)malloc(sizeof(Vector*) * convexHull->points->size);
-
-	Vector** orientedAxesAABB = (Vector**)malloc(sizeof(Vector*) * 3);
-	Vector** orientedAxesConvex = (Vector**)malloc(sizeof(Vector*) * convexHull->axes->size);
-
-	Vector** orientedEdgesAABB = (Vector**)malloc(sizeof(Vector*) * 3);
-	Vector** orientedEdgesConvex = (Vector**)malloc(sizeof(Vector*) * convexHull->edges->size);
+	//We must convert the AABB to a convex hull and get the oriented axis and oriented points from both objects.
+	//The AABB is oriented into the scratch memory of this thread, as is the convex hull unless it's world space cache is current.
+	CollisionManager_Scratch* scratch = CollisionManager_GetScratch();
+	Vector** orientedPointsAABB = CollisionManager_ReserveScratchVectors(scratch, 14 + convexHull->points->size + convexHull->axes->size + convexHull->edges->size);
+	Vector** orientedAxesAABB = orientedPointsAABB + 8;
+	Vector** orientedEdgesAABB = orientedAxesAABB + 3;
 
-
-	//Allocate an initialize individual vectors in array of oriented points for AABB
-	for(int i = 0; i < 8; i++)
-	{
-		orientedPointsAABB[i] = Vector_Allocate();
-		Vector_Initialize(orientedPointsAABB[i], 3);
-	}
-
-	//Allocate and initialize individual vectors in array of oriented points for convex hull
-	for(unsigned int i = 0; i < convexHull->points->size; i++)
-	{
-		orientedPointsConvex[i] = Vector_Allocate();
-		Vector_Initialize(orientedPointsConvex[i], 3);
-	}
-
-	//Allocate and initialize individual vectors in array of oriented axes & edges for AABB
-	for(int i = 0; i < 3; i++)
-	{
-		orientedAxesAABB[i] = Vector_Allocate();
-		Vector_Initialize(orientedAxesAABB[i], 3);
-
-		orientedEdgesAABB[i] = Vector_Allocate();
-		Vector_Initialize(orientedEdgesAABB[i], 3);
-	}
-
-	//Allocate and initialize individual vectors in array of oriented axes for convex hull
-	for(unsigned int i = 0; i < convexHull->axes->size; i++)
-	{
-		orientedAxesConvex[i] = Vector_Allocate();
-		Vector_Initialize(orientedAxesConvex[i], 3);
-	}
-
-	//Allocate and initialize individual vectors in array of oriented edges for convex hull
-	for(unsigned int i = 0; i < convexHull->axes->size; i++)
-	{
-		orientedEdgesConvex[i] = Vector_Allocate();
-		Vector_Initialize(orientedEdgesConvex[i], 3);
-	}
+	OrientedHull orientedConvex;
+	CollisionManager_GetOrientedHull(&orientedConvex, orientedEdgesAABB + 3, convexHull, convexObjFrame);
 
 	//Get oriented points of AABB
 	//Right Bottom Front
@@ -1061,86 +1836,29 @@ void CollisionManager_TestAABBConvexCollision(Collision* dest, GObject* AABBObj,
 	//Translate point to position of obj
 	Vector_Increment(orientedPointsAABB[7], AABBObjFrame->position);
 
-	//Get oriented points of Convex Hull
-	ConvexHullCollider_GetOrientedWorldPoints(orientedPointsConvex, convexHull, convexObjFrame);
-
 	//Get oriented axes of AABB
 	Vector_Copy(orientedAxesAABB[0], &Vector_E1);
 	Vector_Copy(orientedAxesAABB[1], &Vector_E2);
 	Vector_Copy(orientedAxesAABB[2], &Vector_E3);
 
-	//Get oriented axes of convex hull
-	ConvexHullCollider_GetOrientedAxes(orientedAxesConvex, convexHull, convexObjFrame);
-
 	//Get oriented edges of AABB
 	Vector_Copy(orientedEdgesAABB[0], &Vector_E1);
 	Vector_Copy(orientedEdgesAABB[1], &Vector_E2);
 	Vector_Copy(orientedEdgesAABB[2], &Vector_E3);
 
-	//Get oriented edges of convex hull
-	ConvexHullCollider_GetOrientedEdges(orientedEdgesConvex, convexHull, convexObjFrame);
 
+	//Gather the points to project, the AABB's corners have no hull to climb
+	ProjectedPoints pointsAABB = { (const Vector**)orientedPointsAABB, 8, NULL, { 0, 0 } };
+	ProjectedPoints pointsConvex = { (const Vector**)orientedConvex.points, convexHull->points->size, ConvexHullCollider_CanClimb(convexHull) ? convexHull : NULL, { 0, 0 } };
 
-	//Perform SAT Alorithm for face normals
-	unsigned char detected = CollisionManager_PerformSATFaces(dest,
-		(const Vector**)orientedAxesAABB, 3, (const Vector**)orientedPointsAABB, 8,
-		(const Vector**)orientedAxesConvex, convexHull->axes->size, (const Vector**)orientedPointsConvex, convexHull->points->size);
+	//Perform SAT Alorithm for face normals & edge normals
+	unsigned char detected = CollisionManager_PerformSAT(dest, AABBObj,
+		(const Vector**)orientedAxesAABB, 3, (const Vector**)orientedEdgesAABB, 3, &pointsAABB,
+		(const Vector**)orientedConvex.axes, convexHull->axes->size, (const Vector**)orientedConvex.edges, convexHull->edges->size, &pointsConvex,
+		NULL);
 
-	//If a collisionn is detected, check edge normals
 	if(detected)
 	{
-		detected = CollisionManager_PerformSATEdges(dest,
-			(const Vector**)orientedEdgesAABB, 3, (const Vector**)orientedPointsAABB, 8,
-			(const Vector**)orientedEdgesConvex, convexHull->edges->size, (const Vector**)orientedPointsConvex, convexHull->points->size);
-	}
-
-	//Delete oriented arrays
-	for(int i = 0; i < 8; i++)
-	{
-		Vector_Free(orientedPointsAABB[i]);
-	}
-	free(orientedPointsAABB);
-	for(unsigned int i = 0; i < convexHull->points->size; i++)
-	{
-		Vector_Free(orientedPointsConvex[i]);
-	}
-	free(orientedPointsConvex);
-	for(int i = 0; i < 3; i++)
-	{
-		Vector_Free(orientedAxesAABB[i]);
-	}
-	free(orientedAxesAABB);
-	for(unsigned int i = 0; i < convexHull->axes->size; i++)
-	{
-		Vector_Free(orientedAxesConvex[i]);
-	}
-	free(orientedAxesConvex);
-	for(int i = 0; i < 3; i++)
-	{
-		Vector_Free(orientedEdgesAABB[i]);
-	}
-	free(orientedEdgesAABB);
-	for(unsigned int i = 0; i < convexHull->edges->size; i++)
-	{
-		Vector_Free(orientedEdgesConvex[i]);
-	}
-	free(orientedEdgesConvex);
-
-
-	if(detected)
-	{
-		//MTV must always face obj1
-		Vector bToa;
-		Vector_INIT_ON_STACK(bToa, 3);
-
-		Vector_Subtract(&bToa, AABBObjFrame->position, convexObjFrame->position);
-
-		//Check if MTV must be reversed to face Obj 1
-		if(Vector_DotProduct(&bToa, dest->minimumTranslationVector) < 0.0f)
-		{
-			Vector_Scale(dest->minimumTranslationVector, -1.0f);
-		}
-
 		dest->obj1 = AABBObj;
 		dest->obj1Frame = AABBObjFrame;
 		dest->obj2 = convexObj;
@@ -1178,133 +1896,32 @@ void CollisionManager_TestConvexCollision(Collision* dest, GObject* obj1, FrameO
 	ColliderData_ConvexHull* convexHull1 = obj1->collider->data->convexHullData;
 	ColliderData_ConvexHull* convexHull2 = obj2->collider->data->convexHullData;
 
-	//Create array of pointers to vectors to hold the oriented points of the colliders of objects in collision
-	Vector** orientedPoints1 = (Vector**)malloc(sizeof(Vector*) * convexHull1->points->size);
-	Vector** orientedPoints2 = (Vector**)malloc(sizeof(Vector*) * convexHull2->points->size);
-
-	//Create array of pointers to vectors to hold the oriented axes of the colliders of objects in collision
-	Vector** orientedAxes1 = (Vector**)malloc(sizeof(Vector*) * convexHull1->axes->size);
-	Vector** orientedAxes2 = (Vector**)malloc(sizeof(Vector*) * convexHull2->axes->size);
-
-	//Create array of pointers to hold oriented edges of colliders of objects in collision
-	Vector** orientedEdges1 = (Vector**)malloc(sizeof(Vector*) * convexHull1->edges->size);
-	Vector** orientedEdges2 = (Vector**)malloc(sizeof(Vector*) * convexHull2->edges->size);
-
-	//Allocate & initialize individual vectors in array of point vectors for obj1
-	for(unsigned int i = 0; i < convexHull1->points->size; i++)
-	{
-		orientedPoints1[i] = Vector_Allocate();
-		Vector_Initialize(orientedPoints1[i], 3);
-	}
+	//Read the oriented points, axes & edges of the colliders of objects in collision from their world space caches,
+	//orienting any collider whose cache is not current into the scratch memory of this thread
+	CollisionManager_Scratch* scratch = CollisionManager_GetScratch();
+	Vector** scratchVectors = CollisionManager_ReserveScratchVectors(scratch,
+		convexHull1->points->size + convexHull2->points->size + convexHull1->axes->size + convexHull2->axes->size + convexHull1->edges->size + convexHull2->edges->size);
 
-	//Allocate & initialize individual vectors in array in array of point vectors for obj2
-	for(unsigned int i = 0; i < convexHull2->points->size; i++)
-	{
-		orientedPoints2[i] = Vector_Allocate();
-		Vector_Initialize(orientedPoints2[i], 3);
-	}
-
-	//Allocate & initialize individual vectors in array of axes vectors for obj1
-	for(unsigned int i = 0; i < convexHull1->axes->size; i++)
-	{
-		orientedAxes1[i] = Vector_Allocate();
-		Vector_Initialize(orientedAxes1[i], 3);
-	}
-
-	//Allocate & initialize individual vectors in array in array of axes vectors for obj2
-	for(unsigned int i = 0; i < convexHull2->axes->size; i++)
-	{
-		orientedAxes2[i] = Vector_Allocate();
-		Vector_Initialize(orientedAxes2[i], 3);
-	}
-
-	//Allocate & initialize individual vectors in array of edges vectors for obj1
-	for(unsigned int i = 0; i < convexHull1->edges->size; i++)
-	{
-		orientedEdges1[i] = Vector_Allocate();
-		Vector_Initialize(orientedEdges1[i], 3);
-	}
-
-	//Allocate & initialize individual vectors in array in array of axes vectors for obj2
-	for(unsigned int i = 0; i < convexHull2->edges->size; i++)
-	{
-		orientedEdges2[i] = Vector_Allocate();
-		Vector_Initialize(orientedEdges2[i], 3);
-	}
-
-	//Get oriented points of objects
-	ConvexHullCollider_GetOrientedWorldPoints(orientedPoints1, convexHull1, obj1FoR);
-	ConvexHullCollider_GetOrientedWorldPoints(orientedPoints2, convexHull2, obj2FoR);
-
-	//Get oriented axes of objects
-	ConvexHullCollider_GetOrientedAxes(orientedAxes1, convexHull1, obj1FoR);
-	ConvexHullCollider_GetOrientedAxes(orientedAxes2, convexHull2, obj2FoR);
-
-	//Get oriented edges of objects
-	ConvexHullCollider_GetOrientedEdges(orientedEdges1, convexHull1, obj1FoR);
-	ConvexHullCollider_GetOrientedEdges(orientedEdges2, convexHull2, obj2FoR);
-
-	//Perform SAT Algorithm for face normals
-	detected = CollisionManager_PerformSATFaces(dest, 
-		(const Vector**)orientedAxes1, convexHull1->axes->size, (const Vector**)orientedPoints1, convexHull1->points->size,
-		(const Vector**)orientedAxes2, convexHull2->axes->size, (const Vector**)orientedPoints2, convexHull2->points->size);
-
-	//If there is a collision detection, test the edge normals
-	if(detected)
-	{
-		detected = CollisionManager_PerformSATEdges(dest, 
-			(const Vector**)orientedEdges1, convexHull1->edges->size, (const Vector**)orientedPoints1, convexHull1->points->size,
-			(const Vector**)orientedEdges2, convexHull2->edges->size, (const Vector**)orientedPoints2, convexHull2->points->size);
-	}
+	OrientedHull oriented1;
+	OrientedHull oriented2;
+	CollisionManager_GetOrientedHull(&oriented1, scratchVectors, convexHull1, obj1FoR);
+	CollisionManager_GetOrientedHull(&oriented2, scratchVectors + convexHull1->points->size + convexHull1->axes->size + convexHull1->edges->size, convexHull2, obj2FoR);
 
+	//Find which pairs of edges can form the edge axes
+	unsigned char* minkowskiFaces = CollisionManager_GetMinkowskiFaces(scratch, convexHull1, obj1FoR, convexHull2, obj2FoR);
 
+	//Gather the points to project
+	ProjectedPoints points1 = { (const Vector**)oriented1.points, convexHull1->points->size, ConvexHullCollider_CanClimb(convexHull1) ? convexHull1 : NULL, { 0, 0 } };
+	ProjectedPoints points2 = { (const Vector**)oriented2.points, convexHull2->points->size, ConvexHullCollider_CanClimb(convexHull2) ? convexHull2 : NULL, { 0, 0 } };
 
-	//Delete oriented arrays
-	for(unsigned int i = 0; i < convexHull1->points->size; i++)
-	{
-		Vector_Free(orientedPoints1[i]);
-	}
-	free(orientedPoints1);
-	for(unsigned int i = 0; i < convexHull2->points->size; i++)
-	{
-		Vector_Free(orientedPoints2[i]);
-	}
-	free(orientedPoints2);
-	for(unsigned int i = 0; i < convexHull1->axes->size; i++)
-	{
-		Vector_Free(orientedAxes1[i]);
-	}
-	free(orientedAxes1);
-	for(unsigned int i = 0; i < convexHull2->axes->size; i++)
-	{
-		Vector_Free(orientedAxes2[i]);
-	}
-	free(orientedAxes2);
-	for(unsigned int i = 0; i < convexHull1->edges->size; i++)
-	{
-		Vector_Free(orientedEdges1[i]);
-	}
-	free(orientedEdges1);
-	for(unsigned int i = 0; i < convexHull2->edges->size; i++)
-	{
-		Vector_Free(orientedEdges2[i]);
-	}
-	free(orientedEdges2);
+	//Perform SAT Algorithm for face normals & edge normals
+	detected = CollisionManager_PerformSAT(dest, obj1,
+		(const Vector**)oriented1.axes, convexHull1->axes->size, (const Vector**)oriented1.edges, convexHull1->edges->size, &points1,
+		(const Vector**)oriented2.axes, convexHull2->axes->size, (const Vector**)oriented2.edges, convexHull2->edges->size, &points2,
+		minkowskiFaces);
 
 	if(detected)
 	{
-		//MTV must always face obj1
-		Vector bToa;
-		Vector_INIT_ON_STACK(bToa, 3);
-
-		Vector_Subtract(&bToa, obj1FoR->position, obj2FoR->position);
-
-		//Check if MTV must be reversed to face Obj 1
-		if(Vector_DotProduct(&bToa, dest->minimumTranslationVector) < 0.0f)
-		{
-			Vector_Scale(dest->minimumTranslationVector, -1.0f);
-		}
-
 		dest->obj1 = obj1;
 		dest->obj1Frame = obj1FoR;
 		dest->obj2 = obj2;
@@ -1341,38 +1958,23 @@ void CollisionManager_TestConvexSphereCollision(Collision* dest, GObject* convex
 	//Get the convex hull data
 	ColliderData_ConvexHull* convexHull = convexObj->collider->data->convexHullData;
 	//Get the sphere data
-	ColliderData_Sphere* sphere = sphereObj->collider->data->sphereData;
-
-	//Create array of pointers to vectors to hold the oriented points of the collider of convex obj in collision
-	Vector** orientedPoints = (Vector**)malloc(sizeof(Vector*) * convexHull->points->size);
-	//Create array of pointers to vectors to hold the oriented axes of the collider of convex object in collision
-	Vector** orientedAxes = (Vector**)malloc(sizeof(Vector*) * convexHull->axes->size);
-
-	//Allocate & initialize individual vectors in array of point vectors for convex obj
-	for(unsigned int i = 0; i < convexHull->points->size; i++)
-	{
-		orientedPoints[i] = Vector_Allocate();
-		Vector_Initialize(orientedPoints[i], 3);
-	}
-
-	//Allocate & initialize individual vectors in array of axes vectors for convex obj
-	for(unsigned int i = 0; i < convexHull->axes->size; i++)
-	{
-		orientedAxes[i] = Vector_Allocate();
-		Vector_Initialize(orientedAxes[i], 3);
-	}
+	ColliderData_Sphere* sphere = sphereObj->collider->data->sphereData;
 
-	ConvexHullCollider_GetOrientedAxes(orientedAxes, convexHull, convexFoR);
-	ConvexHullCollider_GetOrientedWorldPoints(orientedPoints, convexHull, convexFoR);
+	//Read the oriented points & axes of the convex hull from it's world space cache,
+	//orienting it into the scratch memory of this thread if the cache is not current
+	CollisionManager_Scratch* scratch = CollisionManager_GetScratch();
+	OrientedHull orientedConvex;
+	CollisionManager_GetOrientedHull(&orientedConvex, CollisionManager_ReserveScratchVectors(scratch, convexHull->points->size + convexHull->axes->size + convexHull->edges->size), convexHull, convexFoR);
+	Vector** orientedPoints = orientedConvex.points;
+	Vector** orientedAxes = orientedConvex.axes;
 
 	ProjectionBounds bounds[2];
 
-	Vector** sphereSurfacePoints = (Vector**)malloc(sizeof(Vector*) * 2);
-	for(int i = 0; i < 2; i++)
-	{
-		sphereSurfacePoints[i] = Vector_Allocate();
-		Vector_Initialize(sphereSurfacePoints[i], 3);
-	}
+	Vector sphereSurfacePoint1;
+	Vector sphereSurfacePoint2;
+	Vector_INIT_ON_STACK(sphereSurfacePoint1, 3);
+	Vector_INIT_ON_STACK(sphereSurfacePoint2, 3);
+	Vector* sphereSurfacePoints[2] = { &sphereSurfacePoint1, &sphereSurfacePoint2 };
 
 	Vector normalizedAxis;
 	Vector_INIT_ON_STACK(normalizedAxis, 3);
@@ -1409,7 +2011,9 @@ void CollisionManager_TestConvexSphereCollision(Collision* dest, GObject* convex
 				//Assign the minimum overlap to the smallest of the two overlaps
 				minOverlap = smallerOverlap;
 				//Assign the MTV to the current axis
-				Vector_Copy(dest->minimumTranslationVector, orientedAxes[i]);
+				Vector_CopyArray(dest->minimumTranslationVector, orientedAxes[i]->components, 3);
+				//MTV must always face obj1
+				if(overlap2 < overlap1) Vector_ScaleArray(dest->minimumTranslationVector, -1.0f, 3);
 			}
 		}
 		else
@@ -1421,6 +2025,48 @@ void CollisionManager_TestConvexSphereCollision(Collision* dest, GObject* convex
 
 	}
 
+	//The faces alone miss spheres near an edge or corner of the convex hull, so test the axis from the closest point on the edges of the hull to the sphere's center too.
+	//If the closest point of the hull to the sphere's center is on an edge or corner this axis separates them whenever they are apart, otherwise a face does.
+	if(detected)
+	{
+		float closestPoint[3];
+		CollisionManager_GetClosestHullEdgePoint(closestPoint, convexHull, (const Vector**)orientedPoints, sphereFoR->position->components);
+
+		Vector_SubtractArray(normalizedAxis.components, sphereFoR->position->components, closestPoint, 3);
+		float distance = Vector_GetMagFromArray(normalizedAxis.components, 3);
+
+		//A sphere centered on an edge of the convex hull can't be separated from it
+		if(distance > 0.0f)
+		{
+			Vector_ScaleArray(normalizedAxis.components, 1.0f / distance, 3);
+
+			float scaledRad = SphereCollider_GetScaledRadius(sphere, sphereFoR);
+			float center = Vector_DotProductArray(normalizedAxis.components, sphereFoR->position->components, 3);
+			bounds[1].min = center - scaledRad;
+			bounds[1].max = center + scaledRad;
+			CollisionManager_GetProjectionBounds(bounds, &normalizedAxis, (const Vector**)orientedPoints, convexHull->points->size);
+
+			if(bounds[0].min <= bounds[1].max && bounds[0].max >= bounds[1].min)
+			{
+				float overlap1 = bounds[1].max - bounds[0].min;
+				float overlap2 = bounds[0].max - bounds[1].min;
+				float smallerOverlap = overlap1 < overlap2 ? overlap1 : overlap2;
+
+				if(smallerOverlap < minOverlap || convexHull->axes->size == 0)
+				{
+					minOverlap = smallerOverlap;
+					Vector_CopyArray(dest->minimumTranslationVector, normalizedAxis.components, 3);
+					//MTV must always face obj1
+					if(overlap2 < overlap1) Vector_ScaleArray(dest->minimumTranslationVector, -1.0f, 3);
+				}
+			}
+			else
+			{
+				detected = 0;
+			}
+		}
+	}
+
 	if(detected)
 	{
 		//If there is a collision assign collision attributes
@@ -1431,19 +2077,7 @@ void CollisionManager_TestConvexSphereCollision(Collision* dest, GObject* convex
 		dest->obj2Frame = sphereFoR;
 
 		//Make sure MTV is normalized
-		Vector_Normalize(dest->minimumTranslationVector);
-
-		//By convention MTV must always point towards obj1
-		Vector bToa;
-		Vector_INIT_ON_STACK(bToa, 3);
-
-		//Vector_Subtract(&bToa, sphereFoR->position, convexFoR->position);
-		Vector_Subtract(&bToa, convexFoR->position, sphereFoR->position);
-		//Check if MTV must be reversed to face Obj 1
-		if(Vector_DotProduct(&bToa, dest->minimumTranslationVector) < 0.0f)
-		{
-			Vector_Scale(dest->minimumTranslationVector, -1.0f);
-		}
+		Vector_NormalizeArray(dest->minimumTranslationVector, 3);
 	}
 	else
 	{
@@ -1454,51 +2088,202 @@ void CollisionManager_TestConvexSphereCollision(Collision* dest, GObject* convex
 		dest->obj2 = NULL;
 		dest->obj2Frame = NULL;
 	}
+}
+
+///
+//Finds the point on the edges of a convex hull closest to a point.
+//The edges are read from the neighbours of each point of the hull, a hull without them only has it's points searched.
+//
+//Parameters:
+//	dest: An array of 3 floats to store the closest point in
+//	convexHull: A pointer to the convex hull to search the edges of
+//	orientedPoints: The points of the convex hull oriented into world space
+//	point: An array of 3 floats containing the point to find the closest point to
+static void CollisionManager_GetClosestHullEdgePoint(float* dest, const ColliderData_ConvexHull* convexHull, const Vector** orientedPoints, const float* point)
+{
+	float minDistanceSq = FLT_MAX;
+	unsigned int numPoints = convexHull->points->size;
+	unsigned char hasEdges = convexHull->neighbours->size == numPoints;
 
-	//Delete heap allocated variables
-	for(unsigned int i = 0; i < convexHull->points->size; i++)
+	for(unsigned int i = 0; i < numPoints; i++)
 	{
-		Vector_Free(orientedPoints[i]);
+		const float* start = orientedPoints[i]->components;
+
+		float displacement[3];
+		Vector_SubtractArray(displacement, point, start, 3);
+		float distanceSq = Vector_GetMagSqFromArray(displacement, 3);
+		if(distanceSq < minDistanceSq)
+		{
+			minDistanceSq = distanceSq;
+			Vector_CopyArray(dest, start, 3);
+		}
+
+		if(!hasEdges) continue;
+
+		//Each edge is searched once, from the point with the lower index
+		DynamicArray* neighbours = *(DynamicArray**)DynamicArray_Index(convexHull->neighbours, i);
+		for(unsigned int j = 0; j < neighbours->size; j++)
+		{
+			unsigned int neighbour = *(unsigned int*)DynamicArray_Index(neighbours, j);
+			if(neighbour <= i) continue;
+
+			float edge[3];
+			Vector_SubtractArray(edge, orientedPoints[neighbour]->components, start, 3);
+			float lengthSq = Vector_GetMagSqFromArray(edge, 3);
+			if(lengthSq <= 0.0f) continue;
+
+			//Only the inside of the edge is left to check, the ends are points of the hull
+			float t = Vector_DotProductArray(displacement, edge, 3) / lengthSq;
+			if(t <= 0.0f || t >= 1.0f) continue;
+
+			float closest[3];
+			for(int k = 0; k < 3; k++) closest[k] = start[k] + edge[k] * t;
+
+			float offset[3];
+			Vector_SubtractArray(offset, point, closest, 3);
+			distanceSq = Vector_GetMagSqFromArray(offset, 3);
+			if(distanceSq < minDistanceSq)
+			{
+				minDistanceSq = distanceSq;
+				Vector_CopyArray(dest, closest, 3);
+			}
+		}
 	}
-	free(orientedPoints);
+}
 
-	for(unsigned int i = 0; i < convexHull->axes->size; i++)
+///
+//Tests if two game objects with AABB or convex hull colliders are colliding
+//Utilizes GJK to detect the collision & EPA to find the minimum translation vector
+//If there is no collision, or the objects are only touching, collision.obj1 and obj2 will be set to null upon
+//The end of this function
+//
+//Parameters:
+//	dest: Collision to store the results of test in
+//	obj1: First game object to test (Must have an AABB or convex hull collider attached)
+//	obj1FoR: Pointer to frame of reference to use to orient Object 1
+//	obj2: Second game object to test (Must have an AABB or convex hull collider attached)
+//	obj2FoR: Pointer to frame of reference to use to orient Object 2
+void CollisionManager_TestGJKCollision(Collision* dest, GObject* obj1, FrameOfReference* obj1FoR, GObject* obj2, FrameOfReference* obj2FoR)
+{
+	//Make room in scratch memory for the points of both colliders, in case a convex hull's world space cache does not match its frame
+	unsigned int numHullPoints1 = obj1->collider->type == COLLIDER_CONVEXHULL ? obj1->collider->data->convexHullData->points->size : 0;
+	unsigned int numHullPoints2 = obj2->collider->type == COLLIDER_CONVEXHULL ? obj2->collider->data->convexHullData->points->size : 0;
+	Vector** vectors = CollisionManager_ReserveScratchVectors(CollisionManager_GetScratch(), numHullPoints1 + numHullPoints2);
+
+	//Get the world space points of both colliders, the corners of an AABB are kept on the stack
+	GJK_Shape shape1, shape2;
+	float corners1[24], corners2[24];
+	shape1.points = CollisionManager_GetGJKPoints(corners1, vectors, obj1, obj1FoR, &shape1.numPoints);
+	shape2.points = CollisionManager_GetGJKPoints(corners2, vectors + numHullPoints1, obj2, obj2FoR, &shape2.numPoints);
+
+	//Start searching along the displacement between the objects
+	float direction[3];
+	Vector_SubtractArray(direction, obj1FoR->position->components, obj2FoR->position->components, 3);
+
+	GJK_Simplex simplex;
+	unsigned char detected = GJK_TestIntersection(&simplex, &shape1, &shape2, direction);
+
+	if(detected)
+	{
+		//EPA gives the direction obj1 must move to separate the objects, so the MTV already faces obj1
+		GJK_GetPenetration(dest->minimumTranslationVector, &dest->overlap, &simplex, &shape1, &shape2);
+
+		//EPA finds no valid face when the shapes are only touching, there is nothing to resolve
+		if(dest->overlap <= 0.0f) detected = 0;
+	}
+
+	if(detected)
+	{
+		dest->obj1 = obj1;
+		dest->obj1Frame = obj1FoR;
+		dest->obj2 = obj2;
+		dest->obj2Frame = obj2FoR;
+	}
+	else
 	{
-		Vector_Free(orientedAxes[i]);
+		//If there is no collision set collision atributes to null
+		dest->overlap = 0.0f;
+		dest->obj1 = NULL;
+		dest->obj2 = NULL;
+		dest->obj1Frame = NULL;
+		dest->obj2Frame = NULL;
 	}
-	free(orientedAxes);
+}
 
-	for(unsigned int i = 0; i < 2; i++)
+///
+//Gets the points of an AABB or convex hull collider in world space as an array of floats
+//The points of a convex hull come from its world space cache, or are oriented into scratch vectors
+//when the cache does not match the frame, so no memory is allocated per test.
+//
+//Parameters:
+//	corners: An array of 24 floats to store the corners of an AABB in
+//	vectors: Scratch vectors with room for the points of a convex hull, their components must be contiguous
+//	obj: The game object with the collider (Must have an AABB or convex hull collider attached)
+//	frame: The frame of reference to orient the collider with
+//	numPoints: A pointer to store the number of points in
+//
+//Returns:
+//	A pointer to 3 floats per point
+static const float* CollisionManager_GetGJKPoints(float* corners, Vector** vectors, GObject* obj, FrameOfReference* frame, unsigned int* numPoints)
+{
+	if(obj->collider->type == COLLIDER_AABB)
 	{
-		Vector_Free(sphereSurfacePoints[i]);
+		ColliderData_AABB* AABB = obj->collider->data->AABBData;
+
+		//Get the scaled dimensions of the AABB
+		ColliderData_AABB scaledAABB;
+		AABBCollider_GetScaledDimensions(&scaledAABB, AABB, frame);
+
+		//An AABB is not rotated, so it's corners lie half of it's dimensions either way of it's center
+		float center[3];
+		Vector_AddArray(center, AABB->centroid->components, frame->position->components, 3);
+		float halfDimensions[3] = { scaledAABB.width / 2.0f, scaledAABB.height / 2.0f, scaledAABB.depth / 2.0f };
+
+		*numPoints = 8;
+		for(int i = 0; i < 8; i++)
+		{
+			for(int j = 0; j < 3; j++)
+			{
+				corners[i * 3 + j] = center[j] + ((i >> j) & 1 ? halfDimensions[j] : -halfDimensions[j]);
+			}
+		}
+		return corners;
 	}
-	free(sphereSurfacePoints);
 
+	ColliderData_ConvexHull* convexHull = obj->collider->data->convexHullData;
+	*numPoints = convexHull->points->size;
+	if(*numPoints == 0) return corners;
+
+	//The components of the cached points are stored contiguously, in order
+	if(ConvexHullCollider_HasWorldCache(convexHull, frame)) return convexHull->worldCache.points[0]->components;
 
+	ConvexHullCollider_GetOrientedWorldPoints(vectors, convexHull, frame);
+	return vectors[0]->components;
 }
 
 ///
 //Performs the Separating Axis Theorem test
 //
 //Parameters:
-//	dest: A pointer to a collision to store the results of the test in. Results will not be stored if the test detects no collision
+//	dest: A pointer to a collision to store the results of the test in. Results will not be stored if the test detects no collision.
+//		The MTV faces obj1, it's sign is taken from whichever side of the axis overlaps least so pushing obj1 along it separates the objects
 //	orientedAxes1: An array of pointers to vectors representing the oriented axes of object 1 involved in the test
 //	numAxes1: The number of axes belonging to object 1
-//	orientedPoints1: An array of pointers to vectors representing the oriented points of object 1 involved in the test
-//	numPoints1: The number of points belonging to object 1
+//	points1: A pointer to the oriented points of object 1, the extremes of each projection are kept in it
 //	orientedAxes2: An array of pointersto vectors representing the oriented axes of object 2 involved in the test
 //	numAxes2: The number of axes belonging to object 2
-//	orientedPoints2: An array of pointers to vectors representing the oriented points of object 2 involved in the test
-//	numPoints2: The number of points belonging to object 2
+//	points2: A pointer to the oriented points of object 2, the extremes of each projection are kept in it
+//	separatingAxis: A pointer to store the axis which separated the objects in, not changed if the test detects a collision
 //
 //Returns:
 //	0 if the test detects no collision
 //	1 if the test detects a collision
 static unsigned char CollisionManager_PerformSATFaces(Collision* dest, 
 													  const Vector** orientedAxes1, unsigned int numAxes1, 
-													  const Vector** orientedPoints1, const unsigned int numPoints1, 
+													  ProjectedPoints* points1,
 													  const Vector** orientedAxes2, const unsigned int numAxes2, 
-													  const Vector** orientedPoints2, const unsigned int numPoints2)
+													  ProjectedPoints* points2,
+													  PairCache_SeparatingAxis* separatingAxis)
 {
 	unsigned char detected = 1;		//Tracks if any axis does not detect a collision
 	float minOverlap = 0.0f;		//Stores the minimum overlap of all axes
@@ -1509,8 +2294,8 @@ static unsigned char CollisionManager_PerformSATFaces(Collision* dest,
 	//Test obj1's axis
 	for(unsigned int i = 0; i < numAxes1; i++)
 	{
-		CollisionManager_GetProjectionBounds(bounds, orientedAxes1[i], orientedPoints1, numPoints1);
-		CollisionManager_GetProjectionBounds(bounds + 1, orientedAxes1[i], orientedPoints2, numPoints2);
+		CollisionManager_ProjectPoints(bounds, orientedAxes1[i], points1);
+		CollisionManager_ProjectPoints(bounds + 1, orientedAxes1[i], points2);
 
 		//Check if the min and max projections overlap on the axis
 		if(bounds[0].min < bounds[1].max && bounds[0].max > bounds[1].min)
@@ -1529,7 +2314,9 @@ static unsigned char CollisionManager_PerformSATFaces(Collision* dest,
 				//Assign the minimum overlap to the smallest of the two overlaps
 				minOverlap = smallerOverlap;
 				//Assign the MTV to the current axis
-				Vector_Copy(dest->minimumTranslationVector, orientedAxes1[i]);
+				Vector_CopyArray(dest->minimumTranslationVector, orientedAxes1[i]->components, 3);
+				//MTV must always face obj1
+				if(overlap2 < overlap1) Vector_ScaleArray(dest->minimumTranslationVector, -1.0f, 3);
 			}
 
 		}
@@ -1537,6 +2324,8 @@ static unsigned char CollisionManager_PerformSATFaces(Collision* dest,
 		{
 			//If any axis is not overlapping, there is no collision
 			detected = 0;
+			separatingAxis->type = PAIRCACHE_AXIS_FACE1;
+			separatingAxis->indices[0] = i;
 			break;
 		}
 	}
@@ -1546,8 +2335,8 @@ static unsigned char CollisionManager_PerformSATFaces(Collision* dest,
 	{
 		for(unsigned int i = 0; i < numAxes2; i++)
 		{
-			CollisionManager_GetProjectionBounds(bounds, orientedAxes2[i], orientedPoints1, numPoints1);
-			CollisionManager_GetProjectionBounds(bounds + 1, orientedAxes2[i], orientedPoints2, numPoints2);
+			CollisionManager_ProjectPoints(bounds, orientedAxes2[i], points1);
+			CollisionManager_ProjectPoints(bounds + 1, orientedAxes2[i], points2);
 
 
 			//Check for overlap
@@ -1558,120 +2347,418 @@ static unsigned char CollisionManager_PerformSATFaces(Collision* dest,
 				float overlap1 = bounds[1].max - bounds[0].min;
 				float overlap2 = bounds[0].max - bounds[1].min;
 
-				//Determine thesmallest overlap
-				float smallerOverlap = overlap1 < overlap2 ? overlap1 : overlap2;
+				//Determine thesmallest overlap
+				float smallerOverlap = overlap1 < overlap2 ? overlap1 : overlap2;
+
+
+				//if the overlap is smaller than the current smallest overlap
+				if(smallerOverlap < minOverlap)
+				{
+					//Assign the minimum overlap to the smallest of the two overlaps
+					minOverlap = smallerOverlap;
+					//Assign the MTV to the current axis
+					Vector_CopyArray(dest->minimumTranslationVector, orientedAxes2[i]->components, 3);
+					//MTV must always face obj1
+					if(overlap2 < overlap1) Vector_ScaleArray(dest->minimumTranslationVector, -1.0f, 3);
+				}
+			}
+			else
+			{
+				//If any axis is not overlapping, there is no collision
+				detected = 0;
+				separatingAxis->type = PAIRCACHE_AXIS_FACE2;
+				separatingAxis->indices[0] = i;
+				break;
+			}
+		}
+	}
+
+	//If a collision was detected, store the minimum overlap in the collision destination
+	if(detected)
+	{
+
+		dest->overlap = minOverlap;
+	}
+
+	return detected;
+}
+
+///
+//Performs the Separating axis theorem test with face normals
+//
+//Parameters:
+//	dest: A pointer to the collision to store the results of the test in. Resultswill not be stored if the test detects no collisions
+//	orientedEdges1: An array of pointers to vectors representing the oriented edges of object 1
+//	numEdges1: The number of edges belonging to object 1
+//	points1: A pointer to the oriented points of object 1, the extremes of each projection are kept in it
+//	orientedEdges2: An array of pointers to vectors representing the oriented edges of object 2
+//	numEdges2: The number of edges belonging to object 2
+//	points2: A pointer to the oriented points of object 2, the extremes of each projection are kept in it
+//	minkowskiFaces: Flags for each pair of edges, row by row for object 1's edges, set for the pairs to test. NULL to test every pair
+//	separatingAxis: A pointer to store the axis which separated the objects in, not changed if the test detects a collision
+static unsigned char CollisionManager_PerformSATEdges(Collision*dest,
+													  const Vector** orientedEdges1, const unsigned int numEdges1,
+													  ProjectedPoints* points1,
+													  const Vector** orientedEdges2, const unsigned int numEdges2,
+													  ProjectedPoints* points2,
+													  const unsigned char* minkowskiFaces, PairCache_SeparatingAxis* separatingAxis)
+{
+	unsigned char detected = 1;		//Tracks if any axis does not detect a collision
+	float minOverlap = dest->overlap;		//Stores the minimum overlap of all axes
+
+	//Stores the projection bounds on each axis of obj1's points and obj2's points
+	ProjectionBounds bounds[2];
+
+	//The normal from the cross product of each edge
+	Vector normal;
+	Vector_INIT_ON_STACK(normal, 3);
+
+	//For each one of OBJ1's edges
+	for(unsigned int i = 0; i < numEdges1; i++)
+	{
+		//And each of OBJ2's edges
+		for(unsigned int j = 0; j < numEdges2; j++)
+		{
+
+			//Edges which do not form a face of the Minkowski difference can be skipped,
+			//the axis of minimum overlap & some separating axis are always found among those which do
+			if(minkowskiFaces != NULL && !minkowskiFaces[i * numEdges2 + j])
+				continue;
+
+			//Calculate the normal from the cross product of the two edges
+			Vector_CrossProduct3Array(normal.components, orientedEdges1[i]->components, orientedEdges2[j]->components);
+
+			//Normalize it!
+			Vector_Normalize(&normal);
+
+			CollisionManager_ProjectPoints(bounds, &normal, points1);
+			CollisionManager_ProjectPoints(bounds + 1, &normal, points2);
+
+			//If the normal vector is the zero vector, skip this axis test
+			if(Vector_GetMag(&normal) == 0)
+				continue;
+
+			//Check if the min and max projections overlap on the axis
+			if(bounds[0].min <= bounds[1].max && bounds[0].max >= bounds[1].min)
+			{
+				//If an axis is overlapping we must track which has the smallest overlap!
+				float overlap1 = bounds[1].max - bounds[0].min;
+				float overlap2 = bounds[0].max - bounds[1].min;
+
+				//Determine the smallest overlap
+				float smallerOverlap = overlap1 < overlap2 ? overlap1 : overlap2;
+
+
+				//If this is the first overlap or the overlap is smaller than the current smallest overlap
+				if(smallerOverlap < minOverlap)
+				{
+					//Assign the minimum overlap to the smallest of the two overlaps
+					minOverlap = smallerOverlap;
+					//Assign the MTV to the current axis
+					Vector_CopyArray(dest->minimumTranslationVector, normal.components, 3);
+					//MTV must always face obj1
+					if(overlap2 < overlap1) Vector_ScaleArray(dest->minimumTranslationVector, -1.0f, 3);
+				}
+
+			}
+			else
+			{
+				//If any axis is not overlapping, there is no collision
+				separatingAxis->type = PAIRCACHE_AXIS_EDGES;
+				separatingAxis->indices[0] = i;
+				separatingAxis->indices[1] = j;
+				return 0;
+			}
+
+		}
+	}
+
+	//If this point is reached there must be a collision
+	dest->overlap = minOverlap;
+	return 1;
+}
+
+///
+//Tests if an axis which separated two objects in an earlier separating axis test still separates them
+//Each kind of axis is tested exactly as CollisionManager_PerformSATFaces & CollisionManager_PerformSATEdges test it.
+//
+//Parameters:
+//	separatingAxis: A pointer to the axis to test, with indices into the arrays of the objects in the order given
+//	orientedAxes1: An array of pointers to vectors representing the oriented axes of object 1
+//	numAxes1: The number of axes belonging to object 1
+//	orientedEdges1: An array of pointers to vectors representing the oriented edges of object 1
+//	numEdges1: The number of edges belonging to object 1
+//	points1: A pointer to the oriented points of object 1, the extremes of each projection are kept in it
+//	orientedAxes2: An array of pointers to vectors representing the oriented axes of object 2
+//	numAxes2: The number of axes belonging to object 2
+//	orientedEdges2: An array of pointers to vectors representing the oriented edges of object 2
+//	numEdges2: The number of edges belonging to object 2
+//	points2: A pointer to the oriented points of object 2, the extremes of each projection are kept in it
+//
+//Returns:
+//	1 if the axis still separates the objects
+//	0 if it does not, or if there is no such axis
+static unsigned char CollisionManager_TestSeparatingAxis(const PairCache_SeparatingAxis* separatingAxis,
+														 const Vector** orientedAxes1, const unsigned int numAxes1,
+														 const Vector** orientedEdges1, const unsigned int numEdges1,
+														 ProjectedPoints* points1,
+														 const Vector** orientedAxes2, const unsigned int numAxes2,
+														 const Vector** orientedEdges2, const unsigned int numEdges2,
+														 ProjectedPoints* points2)
+{
+	//Stores the projection bounds on the axis of obj1's points and obj2's points
+	ProjectionBounds bounds[2];
+
+	switch(separatingAxis->type)
+	{
+	case PAIRCACHE_AXIS_FACE1:
+		//The collider may have changed since the axis was found
+		if(separatingAxis->indices[0] >= numAxes1) return 0;
+
+		CollisionManager_ProjectPoints(bounds, orientedAxes1[separatingAxis->indices[0]], points1);
+		CollisionManager_ProjectPoints(bounds + 1, orientedAxes1[separatingAxis->indices[0]], points2);
+
+		//Obj1's axes only overlap when the projections overlap by more than touching
+		return !(bounds[0].min < bounds[1].max && bounds[0].max > bounds[1].min);
+
+	case PAIRCACHE_AXIS_FACE2:
+		if(separatingAxis->indices[0] >= numAxes2) return 0;
+
+		CollisionManager_ProjectPoints(bounds, orientedAxes2[separatingAxis->indices[0]], points1);
+		CollisionManager_ProjectPoints(bounds + 1, orientedAxes2[separatingAxis->indices[0]], points2);
+
+		return !(bounds[0].min <= bounds[1].max && bounds[0].max >= bounds[1].min);
+
+	case PAIRCACHE_AXIS_EDGES:
+		{
+			if(separatingAxis->indices[0] >= numEdges1 || separatingAxis->indices[1] >= numEdges2) return 0;
+
+			Vector normal;
+			Vector_INIT_ON_STACK(normal, 3);
+
+			Vector_CrossProduct3Array(normal.components, orientedEdges1[separatingAxis->indices[0]]->components, orientedEdges2[separatingAxis->indices[1]]->components);
+			Vector_Normalize(&normal);
+
+			//The edges have become parallel, the axis is skipped by the full test
+			if(Vector_GetMag(&normal) == 0) return 0;
+
+			CollisionManager_ProjectPoints(bounds, &normal, points1);
+			CollisionManager_ProjectPoints(bounds + 1, &normal, points2);
+
+			return !(bounds[0].min <= bounds[1].max && bounds[0].max >= bounds[1].min);
+		}
+	}
+
+	return 0;
+}
+
+///
+//Performs the Separating Axis Theorem test with face normals & edges
+//When the collision is being tested on a persistent pair the axis which separated the pair last time it was tested is tried first,
+//objects which were separated tend to stay separated by the same axis, saving all but one projection.
+//
+//Parameters:
+//	dest: A pointer to the collision to store the results of the test in. Results will not be stored if the test detects no collision
+//	obj1: The first object of the test, used to match the objects with those of the persistent pair
+//	orientedAxes1: An array of pointers to vectors representing the oriented axes of object 1
+//	numAxes1: The number of axes belonging to object 1
+//	orientedEdges1: An array of pointers to vectors representing the oriented edges of object 1
+//	numEdges1: The number of edges belonging to object 1
+//	points1: A pointer to the oriented points of object 1, the extremes of each projection are kept in it
+//	orientedAxes2: An array of pointers to vectors representing the oriented axes of object 2
+//	numAxes2: The number of axes belonging to object 2
+//	orientedEdges2: An array of pointers to vectors representing the oriented edges of object 2
+//	numEdges2: The number of edges belonging to object 2
+//	points2: A pointer to the oriented points of object 2, the extremes of each projection are kept in it
+//	minkowskiFaces: Flags for each pair of edges, row by row for object 1's edges, set for the pairs to test. NULL to test every pair
+//
+//Returns:
+//	0 if the test detects no collision
+//	1 if the test detects a collision
+static unsigned char CollisionManager_PerformSAT(Collision* dest, const GObject* obj1,
+												 const Vector** orientedAxes1, const unsigned int numAxes1,
+												 const Vector** orientedEdges1, const unsigned int numEdges1,
+												 ProjectedPoints* points1,
+												 const Vector** orientedAxes2, const unsigned int numAxes2,
+												 const Vector** orientedEdges2, const unsigned int numEdges2,
+												 ProjectedPoints* points2,
+												 const unsigned char* minkowskiFaces)
+{
+	PairCache_SeparatingAxis separatingAxis;
+	separatingAxis.type = PAIRCACHE_AXIS_NONE;
+
+	//The pair stores the axis with indices of it's own obj1 first
+	unsigned char swapped = dest->pair != NULL && obj1 != dest->pair->obj1;
+
+	if(dest->pair != NULL)
+	{
+		//Climb from where the last test of the pair left off, the extremes of the axis which separated the objects if there was one
+		memcpy(points1->extremes, dest->pair->extremes[swapped], sizeof(points1->extremes));
+		memcpy(points2->extremes, dest->pair->extremes[!swapped], sizeof(points2->extremes));
 
+		separatingAxis = dest->pair->separatingAxis;
+		if(swapped) CollisionManager_SwapSeparatingAxis(&separatingAxis);
 
-				//if the overlap is smaller than the current smallest overlap
-				if(smallerOverlap < minOverlap)
-				{
-					//Assign the minimum overlap to the smallest of the two overlaps
-					minOverlap = smallerOverlap;
-					//Assign the MTV to the current axis
-					Vector_Copy(dest->minimumTranslationVector, orientedAxes2[i]);
-				}
-			}
-			else
-			{
-				//If any axis is not overlapping, there is no collision
-				detected = 0;
-				break;
-			}
+		//Any axis which separates the objects means there is no collision, the full test would find it too
+		if(CollisionManager_TestSeparatingAxis(&separatingAxis,
+			orientedAxes1, numAxes1, orientedEdges1, numEdges1, points1,
+			orientedAxes2, numAxes2, orientedEdges2, numEdges2, points2))
+		{
+			memcpy(dest->pair->extremes[swapped], points1->extremes, sizeof(points1->extremes));
+			memcpy(dest->pair->extremes[!swapped], points2->extremes, sizeof(points2->extremes));
+			return 0;
 		}
+
+		separatingAxis.type = PAIRCACHE_AXIS_NONE;
 	}
 
-	//If a collision was detected, store the minimum overlap in the collision destination
+	//Perform SAT Algorithm for face normals
+	unsigned char detected = CollisionManager_PerformSATFaces(dest,
+		orientedAxes1, numAxes1, points1,
+		orientedAxes2, numAxes2, points2,
+		&separatingAxis);
+
+	//If there is a collision detection, test the edge normals
 	if(detected)
 	{
+		detected = CollisionManager_PerformSATEdges(dest,
+			orientedEdges1, numEdges1, points1,
+			orientedEdges2, numEdges2, points2,
+			minkowskiFaces, &separatingAxis);
+	}
 
-		dest->overlap = minOverlap;
+	//Remember the axis which separated the objects, if any, for the next test of the pair
+	if(dest->pair != NULL)
+	{
+		if(swapped) CollisionManager_SwapSeparatingAxis(&separatingAxis);
+		dest->pair->separatingAxis = separatingAxis;
+
+		memcpy(dest->pair->extremes[swapped], points1->extremes, sizeof(points1->extremes));
+		memcpy(dest->pair->extremes[!swapped], points2->extremes, sizeof(points2->extremes));
 	}
 
 	return detected;
 }
 
 ///
-//Performs the Separating axis theorem test with face normals
+//Determines which pairs of edges of two convex hulls form faces of the Minkowski difference of the hulls from the arcs of their edges.
+//Only these pairs need to be tested by SAT, but testing the arcs costs more than it saves unless the hulls have many edge directions.
 //
 //Parameters:
-//	dest: A pointer to the collision to store the results of the test in. Resultswill not be stored if the test detects no collisions
-//	orientedEdges1: An array of pointers to vectors representing the oriented edges of object 1
-//	numEdges1: The number of edges belonging to object 1
-//	orientedPoints1: An array of pointers to vectors representing the oriented points of object 1
-//	numPoints1: The number of points belonging to object 1
-//	orientedEdges2: An array of pointers to vectors representing the oriented edges of object 2
-//	numEdges2: The number of edges belonging to object 2
-//  orientedPoints2: An array of pointers to vectors representing the oriented points of object 2
-//	numPoints2: the number of points belonging to object 2
-static unsigned char CollisionManager_PerformSATEdges(Collision*dest,
-													  const Vector** orientedEdges1, const unsigned int numEdges1,
-													  const Vector** orientedPoints1, const unsigned int numPoints1,
-													  const Vector** orientedEdges2, const unsigned int numEdges2,
-													  const Vector** orientedPoints2, const unsigned int numPoints2)
+//	scratch: A pointer to the scratch memory of the calling thread to hold the flags in
+//	convexHull1: A pointer to the first convex hull
+//	frame1: A pointer to the frame of reference orienting the first convex hull
+//	convexHull2: A pointer to the second convex hull
+//	frame2: A pointer to the frame of reference orienting the second convex hull
+//
+//Returns:
+//	An array of flags in the scratch memory for each pair of edges, row by row for the first hull's edges, set for the pairs which form faces.
+//	NULL if every pair should be tested.
+static unsigned char* CollisionManager_GetMinkowskiFaces(CollisionManager_Scratch* scratch, const ColliderData_ConvexHull* convexHull1, const FrameOfReference* frame1, const ColliderData_ConvexHull* convexHull2, const FrameOfReference* frame2)
 {
-	unsigned char detected = 1;		//Tracks if any axis does not detect a collision
-	float minOverlap = dest->overlap;		//Stores the minimum overlap of all axes
-
-	//Stores the projection bounds on each axis of obj1's points and obj2's points
-	ProjectionBounds bounds[2];
-
-	//The normal from the cross product of each edge
-	Vector normal;
-	Vector_INIT_ON_STACK(normal, 3);
+	unsigned int numEdges1 = convexHull1->edges->size;
+	unsigned int numEdges2 = convexHull2->edges->size;
+	unsigned int numArcs1 = convexHull1->arcs->size;
+	unsigned int numArcs2 = convexHull2->arcs->size;
 
-	//For each one of OBJ1's edges
-	for(unsigned int i = 0; i < numEdges1; i++)
+	//Testing a pair of arcs costs about as much as projecting four points onto an axis,
+	//so only prune when there are far fewer pairs of arcs than projections they could save.
+	//Boxes have four parallel edges to each direction and never pass.
+	if(numArcs1 == 0 || numArcs2 == 0 ||
+		numArcs1 * numArcs2 * 4 >= numEdges1 * numEdges2 * (convexHull1->points->size + convexHull2->points->size))
 	{
-		//And each of OBJ2's edges
-		for(unsigned int j = 0; j < numEdges2; j++)
-		{
-
-			//Calculate the normal from the cross product of the two edges
-			Vector_CrossProduct(&normal, orientedEdges1[i], orientedEdges2[j]);
+		return NULL;
+	}
 
-			//Normalize it!
-			Vector_Normalize(&normal);
+	//The oriented arcs come first in the scratch memory to keep them aligned, followed by the flags
+	unsigned int arcBytes = sizeof(ConvexHullCollider_Arc) * (numArcs1 + numArcs2);
+	unsigned char* bytes = CollisionManager_ReserveScratchBytes(scratch, arcBytes + numEdges1 * numEdges2 + numEdges1 + numEdges2);
 
-			CollisionManager_GetProjectionBounds(bounds, &normal, orientedPoints1, numPoints1);
-			CollisionManager_GetProjectionBounds(bounds + 1, &normal, orientedPoints2, numPoints2);
+	ConvexHullCollider_Arc* arcs1 = (ConvexHullCollider_Arc*)bytes;
+	ConvexHullCollider_Arc* arcs2 = arcs1 + numArcs1;
 
-			//If the normal vector is the zero vector, skip this axis test
-			if(Vector_GetMag(&normal) == 0)
-				continue;
+	unsigned char* minkowskiFaces = bytes + arcBytes;
+	memset(minkowskiFaces, 0, numEdges1 * numEdges2);
 
-			//Check if the min and max projections overlap on the axis
-			if(bounds[0].min <= bounds[1].max && bounds[0].max >= bounds[1].min)
-			{
-				//If an axis is overlapping we must track which has the smallest overlap!
-				float overlap1 = bounds[1].max - bounds[0].min;
-				float overlap2 = bounds[0].max - bounds[1].min;
+	//Edge directions without arcs can not be pruned
+	unsigned char* hasArcs1 = minkowskiFaces + numEdges1 * numEdges2;
+	unsigned char* hasArcs2 = hasArcs1 + numEdges1;
+	memset(hasArcs1, 0, numEdges1 + numEdges2);
 
-				//Determine the smallest overlap
-				float smallerOverlap = overlap1 < overlap2 ? overlap1 : overlap2;
+	ConvexHullCollider_GetOrientedArcs(arcs1, convexHull1, frame1);
+	ConvexHullCollider_GetOrientedArcs(arcs2, convexHull2, frame2);
 
+	for(unsigned int i = 0; i < numArcs1; i++) hasArcs1[arcs1[i].edge] = 1;
+	for(unsigned int i = 0; i < numArcs2; i++) hasArcs2[arcs2[i].edge] = 1;
 
-				//If this is the first overlap or the overlap is smaller than the current smallest overlap
-				if(smallerOverlap < minOverlap)
-				{
-					//Assign the minimum overlap to the smallest of the two overlaps
-					minOverlap = smallerOverlap;
-					//Assign the MTV to the current axis
-					Vector_Copy(dest->minimumTranslationVector, &normal);
-				}
+	for(unsigned int i = 0; i < numEdges1; i++)
+	{
+		for(unsigned int j = 0; j < numEdges2; j++)
+		{
+			if(!hasArcs1[i] || !hasArcs2[j]) minkowskiFaces[i * numEdges2 + j] = 1;
+		}
+	}
 
-			}
-			else
+	//A pair of edge directions forms a face if the arcs of any of their edges intersect
+	for(unsigned int i = 0; i < numArcs1; i++)
+	{
+		for(unsigned int j = 0; j < numArcs2; j++)
+		{
+			unsigned char* face = minkowskiFaces + arcs1[i].edge * numEdges2 + arcs2[j].edge;
+			if(!*face && ConvexHullCollider_IsMinkowskiFace(arcs1 + i, arcs2 + j))
 			{
-				//If any axis is not overlapping, there is no collision
-				return 0;
+				*face = 1;
 			}
-
 		}
 	}
 
-	//If this point is reached there must be a collision
-	dest->overlap = minOverlap;
-	return 1;
+	return minkowskiFaces;
+}
+
+///
+//Swaps which object of a pair each index of a separating axis refers to
+//
+//Parameters:
+//	separatingAxis: A pointer to the separating axis to swap
+static void CollisionManager_SwapSeparatingAxis(PairCache_SeparatingAxis* separatingAxis)
+{
+	unsigned int index;
+	switch(separatingAxis->type)
+	{
+	case PAIRCACHE_AXIS_FACE1:
+		separatingAxis->type = PAIRCACHE_AXIS_FACE2;
+		break;
+	case PAIRCACHE_AXIS_FACE2:
+		separatingAxis->type = PAIRCACHE_AXIS_FACE1;
+		break;
+	case PAIRCACHE_AXIS_EDGES:
+		index = separatingAxis->indices[0];
+		separatingAxis->indices[0] = separatingAxis->indices[1];
+		separatingAxis->indices[1] = index;
+		break;
+	}
+}
+
+///
+//Projects the points of a collider onto a normalized axis, finding the minimum and maximum values of the projection.
+//The points of a hull which can be climbed are searched from the extremes of the last projection, else every point is scanned.
+//
+//Parameters:
+//	dest: The destination of the projection bounds
+//	axis: The axis projecting onto
+//	points: The points of the collider to project onto the axis
+static void CollisionManager_ProjectPoints(ProjectionBounds* dest, const Vector* axis, ProjectedPoints* points)
+{
+	if(points->hull != NULL)
+	{
+		ConvexHullCollider_GetExtremePoints(points->extremes, points->hull, points->points, axis);
+		dest->min = Vector_DotProduct(axis, points->points[points->extremes[0]]);
+		dest->max = Vector_DotProduct(axis, points->points[points->extremes[1]]);
+	}
+	else
+	{
+		CollisionManager_GetProjectionBounds(dest, axis, points->points, points->numPoints);
+	}
 }
 
 ///
@@ -1698,6 +2785,155 @@ static void CollisionManager_GetProjectionBounds(ProjectionBounds* dest, const V
 }
 
 
+///
+//Refreshes the world bounds of an object's collider, along with the world space cache of it's convex hull or of each piece of it's compound collider,
+//with the frame of reference it is tested in. Objects without a collider are ignored.
+//
+//Parameters:
+//	obj: A pointer to the object to refresh the cache of
+static void CollisionManager_RefreshWorldCache(GObject* obj)
+{
+	if(obj->collider == NULL) return;
+
+	//If there is a rigidbody use that frame of reference, else use the objects
+	FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;
+	if(obj->collider->type == COLLIDER_CONVEXHULL)
+	{
+		ConvexHullCollider_RefreshWorldCache(obj->collider->data->convexHullData, frame);
+	}
+	else if(obj->collider->type == COLLIDER_COMPOUND)
+	{
+		DynamicArray* pieces = obj->collider->data->compoundData->pieces;
+		for(unsigned int i = 0; i < pieces->size; i++)
+		{
+			Collider* piece = *(Collider**)DynamicArray_Index(pieces, i);
+			ConvexHullCollider_RefreshWorldCache(piece->data->convexHullData, frame);
+			Collider_RefreshWorldBounds(piece, frame);
+		}
+	}
+
+	//Bound the collider after orienting the hull so the bounds can be read from the hull's cache
+	Collider_RefreshWorldBounds(obj->collider, frame);
+}
+
+///
+//Gets the points, axes & edges of a convex hull oriented by a frame of reference.
+//They are read from the hull's world space cache if it is current, else they are oriented into the given vectors.
+//
+//Parameters:
+//	dest: A pointer to store the arrays of oriented points, axes & edges in
+//	vectors: An array of pointers to vectors of dimension 3 with room for every point, axis & edge of the hull
+//	convexHull: A pointer to the convex hull to orient
+//	frame: A pointer to the frame of reference to orient the convex hull by
+static void CollisionManager_GetOrientedHull(OrientedHull* dest, Vector** vectors, ColliderData_ConvexHull* convexHull, const FrameOfReference* frame)
+{
+	if(ConvexHullCollider_HasWorldCache(convexHull, frame))
+	{
+		dest->points = convexHull->worldCache.points;
+		dest->axes = convexHull->worldCache.axes;
+		dest->edges = convexHull->worldCache.edges;
+		return;
+	}
+
+	dest->points = vectors;
+	dest->axes = dest->points + convexHull->points->size;
+	dest->edges = dest->axes + convexHull->axes->size;
+
+	ConvexHullCollider_GetOrientedWorldPoints(dest->points, convexHull, frame);
+	ConvexHullCollider_GetOrientedAxes(dest->axes, convexHull, frame);
+	ConvexHullCollider_GetOrientedEdges(dest->edges, convexHull, frame);
+}
+
+///
+//Gets the scratch memory of the calling thread, allocating it the first time the thread asks
+//
+//Returns:
+//	A pointer to the scratch memory of the calling thread
+static CollisionManager_Scratch* CollisionManager_GetScratch(void)
+{
+	if(scratch == NULL)
+	{
+		scratch = (CollisionManager_Scratch*)calloc(1, sizeof(CollisionManager_Scratch));
+
+		//Remember the scratch memory so it can be freed along with the collision manager
+		scratchLock->lock();
+		DynamicArray_Append(scratches, &scratch);
+		scratchLock->unlock();
+	}
+	return scratch;
+}
+
+///
+//Makes room for a number of vectors in scratch memory.
+//The contents of the vectors are not kept when the scratch memory grows.
+//
+//Parameters:
+//	scratch: A pointer to the scratch memory
+//	numVectors: The number of vectors needed
+//
+//Returns:
+//	An array of pointers to at least numVectors vectors of dimension 3
+static Vector** CollisionManager_ReserveScratchVectors(CollisionManager_Scratch* scratch, unsigned int numVectors)
+{
+	if(numVectors > scratch->numVectors)
+	{
+		//Grow geometrically so a thread meeting slightly larger hulls does not reallocate each time
+		unsigned int capacity = scratch->numVectors * 2;
+		if(capacity < numVectors) capacity = numVectors;
+
+		//The pointers, vectors & components share one block
+		free(scratch->vectors);
+		scratch->vectors = (Vector**)malloc((sizeof(Vector*) + sizeof(Vector) + sizeof(float) * 3) * capacity);
+		Vector* vectors = (Vector*)(scratch->vectors + capacity);
+		float* components = (float*)(vectors + capacity);
+
+		for(unsigned int i = 0; i < capacity; i++)
+		{
+			vectors[i].dimension = 3;
+			vectors[i].components = components + 3 * i;
+			scratch->vectors[i] = vectors + i;
+		}
+		scratch->numVectors = capacity;
+	}
+	return scratch->vectors;
+}
+
+///
+//Makes room for a number of bytes in scratch memory.
+//The contents of the bytes are not kept when the scratch memory grows.
+//
+//Parameters:
+//	scratch: A pointer to the scratch memory
+//	numBytes: The number of bytes needed
+//
+//Returns:
+//	A pointer to at least numBytes bytes, aligned for any type
+static unsigned char* CollisionManager_ReserveScratchBytes(CollisionManager_Scratch* scratch, unsigned int numBytes)
+{
+	if(numBytes > scratch->numBytes)
+	{
+		unsigned int capacity = scratch->numBytes * 2;
+		if(capacity < numBytes) capacity = numBytes;
+
+		free(scratch->bytes);
+		scratch->bytes = (unsigned char*)malloc(capacity);
+		scratch->numBytes = capacity;
+	}
+	return scratch->bytes;
+}
+
+///
+//Frees scratch memory
+//
+//Parameters:
+//	scratch: A pointer to the scratch memory to free
+static void CollisionManager_FreeScratch(CollisionManager_Scratch* scratch)
+{
+	free(scratch->vectors);
+	free(scratch->bytes);
+	free(scratch);
+}
+
 ///
 //Allocates memory for a new collision buffer
 //
@@ -1714,10 +2950,31 @@ static CollisionBuffer* CollisionManager_AllocateBuffer(void)
 //
 //Parameters:
 //	buffer: The buffer to initialize
-static void CollisionManager_InitializeBuffer(CollisionBuffer* buffer)
+//	numWorkers: The number of workers which will test reported pairs in parallel
+static void CollisionManager_InitializeBuffer(CollisionBuffer* buffer, unsigned int numWorkers)
 {
-	buffer->collisions = LinkedList_Allocate();
-	LinkedList_Initialize(buffer->collisions);
+	buffer->collisions = DynamicArray_Allocate();
+	DynamicArray_Initialize(buffer->collisions, sizeof(Collision));
+
+	buffer->objectCollisions = DynamicArray_Allocate();
+	DynamicArray_Initialize(buffer->objectCollisions, sizeof(unsigned int));
+
+	buffer->pairCache = PairCache_Allocate();
+	PairCache_Initialize(buffer->pairCache);
+
+	buffer->candidatePairs = DynamicArray_Allocate();
+	DynamicArray_Initialize(buffer->candidatePairs, sizeof(GObject*));
+
+	buffer->reportedPairs = DynamicArray_Allocate();
+	DynamicArray_Initialize(buffer->reportedPairs, sizeof(CollisionBuffer_ReportedPair));
+
+	buffer->numWorkers = numWorkers;
+	buffer->workerCollisions = (DynamicArray**)malloc(sizeof(DynamicArray*) * numWorkers);
+	for(unsigned int i = 0; i < numWorkers; i++)
+	{
+		buffer->workerCollisions[i] = DynamicArray_Allocate();
+		DynamicArray_Initialize(buffer->workerCollisions[i], sizeof(Collision));
+	}
 }
 
 
@@ -1728,19 +2985,29 @@ static void CollisionManager_InitializeBuffer(CollisionBuffer* buffer)
 //	buffer: A pointer to The collision buffer to free
 static void CollisionManager_FreeBuffer(CollisionBuffer* buffer)
 {
-	LinkedList_Free(buffer->collisions);
+	DynamicArray_Free(buffer->collisions);
+	DynamicArray_Free(buffer->objectCollisions);
+	PairCache_Free(buffer->pairCache);
+	DynamicArray_Free(buffer->candidatePairs);
+	DynamicArray_Free(buffer->reportedPairs);
+	for(unsigned int i = 0; i < buffer->numWorkers; i++)
+	{
+		DynamicArray_Free(buffer->workerCollisions[i]);
+	}
+	free(buffer->workerCollisions);
 	free(buffer);
 }
 
 ///
-//Allocates memory for a new collision
+//Clears a collision buffer of all collisions registered last frame
+//Does not lessen the capacity of the buffer
 //
-//Returns:
-//	Pointer to a newly allocated collision
-static Collision* CollisionManager_AllocateCollision(void)
+//Parameters:
+//	buffer: A pointer to the collision buffer to clear
+static void CollisionManager_ClearBuffer(CollisionBuffer* buffer)
 {
-	Collision* collision = (Collision*)malloc(sizeof(Collision));
-	return collision;
+	buffer->collisions->size = 0;
+	buffer->objectCollisions->size = 0;
 }
 
 ///
@@ -1754,19 +3021,160 @@ static void CollisionManager_InitializeCollision(Collision* collision)
 	collision->obj1Frame = NULL;
 	collision->obj2 = NULL;
 	collision->obj2Frame = NULL;
+	collision->overlap = 0.0f;
+	collision->pair = NULL;
+	collision->obj1Collider = NULL;
+	collision->obj2Collider = NULL;
+
+	Vector_ZeroArray(collision->minimumTranslationVector, 3);
+}
+
+///
+//Stores the result of testing a pair of objects in the persistent pair
+//
+//Parameters:
+//	pair: A pointer to the pair which was tested
+//	collision: A pointer to the result of the test
+static void CollisionManager_StorePairResult(PairCache_Pair* pair, const Collision* collision)
+{
+	pair->colliding = collision->obj1 != NULL;
+	if(pair->colliding)
+	{
+		pair->swapped = collision->obj1 == pair->obj2;
+		pair->colliders[0] = collision->obj1Collider;
+		pair->colliders[1] = collision->obj2Collider;
+		Vector_CopyArray(pair->normal, collision->minimumTranslationVector, 3);
+		pair->overlap = collision->overlap;
+	}
+	else
+	{
+		pair->numContacts = 0;
+		pair->normalImpulse = 0.0f;
+	}
+}
+
+///
+//Loads the result of the last test of a pair of objects from the persistent pair
+//
+//Parameters:
+//	dest: A pointer to the collision to load the result into
+//	pair: A pointer to the pair to load the result of
+//	obj1Frame: The frame of reference currently orienting obj1 of the pair
+//	obj2Frame: The frame of reference currently orienting obj2 of the pair
+static void CollisionManager_LoadPairResult(Collision* dest, const PairCache_Pair* pair, FrameOfReference* obj1Frame, FrameOfReference* obj2Frame)
+{
+	if(!pair->colliding)
+	{
+		dest->obj1 = NULL;
+		dest->obj2 = NULL;
+		dest->obj1Frame = NULL;
+		dest->obj2Frame = NULL;
+		dest->overlap = 0.0f;
+		return;
+	}
+
+	if(pair->swapped)
+	{
+		dest->obj1 = pair->obj2;
+		dest->obj1Frame = obj2Frame;
+		dest->obj2 = pair->obj1;
+		dest->obj2Frame = obj1Frame;
+	}
+	else
+	{
+		dest->obj1 = pair->obj1;
+		dest->obj1Frame = obj1Frame;
+		dest->obj2 = pair->obj2;
+		dest->obj2Frame = obj2Frame;
+	}
+
+	dest->obj1Collider = pair->colliders[0];
+	dest->obj2Collider = pair->colliders[1];
+
+	Vector_CopyArray(dest->minimumTranslationVector, pair->normal, 3);
+	dest->overlap = pair->overlap;
+}
 
-	collision->minimumTranslationVector = Vector_Allocate();
-	Vector_Initialize(collision->minimumTranslationVector, 3);
+///
+//Links each collision registered in a collision buffer to the persistent pair it was detected on
+//Must be called after the pair cache has ended it's frame.
+//
+//Parameters:
+//	buffer: A pointer to the collision buffer
+static void CollisionManager_BindCollisionPairs(CollisionBuffer* buffer)
+{
+	Collision* collisions = (Collision*)buffer->collisions->data;
+	for(unsigned int i = 0; i < buffer->collisions->size; i++)
+	{
+		unsigned int pairIndex = PairCache_Find(buffer->pairCache, collisions[i].obj1, collisions[i].obj2);
+		collisions[i].pair = pairIndex != UINT_MAX ? PairCache_GetPair(buffer->pairCache, pairIndex) : NULL;
+	}
 }
 
 ///
-//Frees the memory allocated for a collision.
-//Does not free the objects involved in the collision!
+//Groups the collisions registered in a collision buffer by the objects involved in them.
+//Sets each involved collider's range of collisions in the buffer's object collision indices.
+//Must be called once all collisions for the frame have been registered.
 //
 //Parameters:
-//	collision: The collision being freed
-void CollisionManager_FreeCollision(Collision* collision)
+//	buffer: A pointer to the collision buffer to index
+static void CollisionManager_IndexObjectCollisions(CollisionBuffer* buffer)
 {
-	Vector_Free(collision->minimumTranslationVector);
-	free(collision);
-}
\ No newline at end of file
+	Collision* collisions = (Collision*)buffer->collisions->data;
+	unsigned int numCollisions = buffer->collisions->size;
+
+	//Reset the ranges of the colliders involved
+	for(unsigned int i = 0; i < numCollisions; i++)
+	{
+		collisions[i].obj1->collider->numCollisions = 0;
+		collisions[i].obj2->collider->numCollisions = 0;
+		collisions[i].obj1->collider->collisionsStart = UINT_MAX;
+		collisions[i].obj2->collider->collisionsStart = UINT_MAX;
+	}
+
+	//Count the number of collisions each collider is involved in
+	for(unsigned int i = 0; i < numCollisions; i++)
+	{
+		++collisions[i].obj1->collider->numCollisions;
+		++collisions[i].obj2->collider->numCollisions;
+	}
+
+	//Assign each collider the start of it's range
+	//The count is reset so it can be used as a cursor while filling the range
+	unsigned int start = 0;
+	Collider* colliders[2];
+	for(unsigned int i = 0; i < numCollisions; i++)
+	{
+		colliders[0] = collisions[i].obj1->collider;
+		colliders[1] = collisions[i].obj2->collider;
+		for(int j = 0; j < 2; j++)
+		{
+			if(colliders[j]->collisionsStart == UINT_MAX)
+			{
+				colliders[j]->collisionsStart = start;
+				start += colliders[j]->numCollisions;
+				colliders[j]->numCollisions = 0;
+			}
+		}
+	}
+
+	//Each collision appears once in the range of each object involved
+	while(buffer->objectCollisions->capacity < numCollisions * 2)
+	{
+		DynamicArray_Grow(buffer->objectCollisions);
+	}
+	buffer->objectCollisions->size = numCollisions * 2;
+
+	//Fill the ranges, restoring each collider's count
+	unsigned int* indices = (unsigned int*)buffer->objectCollisions->data;
+	for(unsigned int i = 0; i < numCollisions; i++)
+	{
+		colliders[0] = collisions[i].obj1->collider;
+		colliders[1] = collisions[i].obj2->collider;
+		for(int j = 0; j < 2; j++)
+		{
+			indices[colliders[j]->collisionsStart + colliders[j]->numCollisions] = i;
+			++colliders[j]->numCollisions;
+		}
+	}
+}
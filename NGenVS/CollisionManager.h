@@ -3,8 +3,16 @@
 
 #include "GObject.h"
 #include "LinkedList.h"
+#include "DynamicArray.h"
+#include "PairCache.h"
 
 #include "OctTree.h"
+#include "SweepAndPrune.h"
+#include "AABBTree.h"
+#include "SpatialHashGrid.h"
+#include "LinearOctTree.h"
+#include "WorkerPool.h"
+#include "GJK.h"
 
 struct Collision
 {
@@ -12,13 +20,81 @@ struct Collision
 	FrameOfReference* obj1Frame;
 	GObject* obj2;
 	FrameOfReference* obj2Frame;
-	Vector* minimumTranslationVector;	//Normalized vector describing the collision / contact normal
+	float minimumTranslationVector[3];	//Normalized vector describing the collision / contact normal, held by value so collisions can be copied freely
 	float overlap;						//The magnitude of the overlap on the minimum translation axis
+	PairCache_Pair* pair;				//Persistent pair the collision was detected on, NULL if the collision was not detected through the pair cache
+	Collider* obj1Collider;				//Collider of obj1 which was hit, the piece of a compound collider or else the object's own collider
+	Collider* obj2Collider;				//Collider of obj2 which was hit, the piece of a compound collider or else the object's own collider
 };
 
+//The algorithm used to test a pair of colliders which can be tested as convex hulls
+enum ConvexAlgorithm
+{
+	CONVEXALGORITHM_SAT,		//Separating axis theorem over the face normals & edge cross products of both colliders
+	CONVEXALGORITHM_GJK			//Gilbert-Johnson-Keerthi intersection test followed by the expanding polytope algorithm
+};
+
+//The number of reported pairs a worker tests before checking for more work, must be a multiple of 4
+#define CollisionManager_PAIRS_PER_BATCH 16
+
+//A pair of objects first reported this frame which is waiting to be tested
+typedef struct CollisionBuffer_ReportedPair
+{
+	unsigned int pairIndex;				//Index of the pair in the pair cache
+	GObject* first;						//The object of the pair which was reported first, pairs are tested in the order they were reported
+
+	unsigned int worker;				//Index of the worker which tested the pair
+	unsigned int collisionIndex;		//Index of the pair's collision in the worker's collisions, UINT_MAX if the objects are not colliding
+} CollisionBuffer_ReportedPair;
+
+//Pairs of colliders of the same shape which are tested together, four at a time.
+//The shapes are stored component by component so four pairs can be loaded into a single register.
+typedef struct CollisionManager_ShapeBatch
+{
+	unsigned int count;													//Number of pairs in the batch
+	unsigned int reportedPairs[CollisionManager_PAIRS_PER_BATCH];		//Index of each pair in the reported pairs
+	unsigned char reversed[CollisionManager_PAIRS_PER_BATCH];			//Was the second object of each pair reported first
+
+	float centers1[3][CollisionManager_PAIRS_PER_BATCH];				//World space center of the first object of each pair along each axis
+	float extents1[3][CollisionManager_PAIRS_PER_BATCH];				//Half width of the first object of each pair along each axis, spheres only use the first axis for their radius
+	float centers2[3][CollisionManager_PAIRS_PER_BATCH];				//World space center of the second object of each pair along each axis
+	float extents2[3][CollisionManager_PAIRS_PER_BATCH];				//Half width of the second object of each pair along each axis, spheres only use the first axis for their radius
+} CollisionManager_ShapeBatch;
+
+//The world bounds of both objects of each of a range of reported pairs, tested four pairs at a time before any pair goes on to the narrow phase.
+//The bounds are stored component by component so four pairs can be loaded into a single register.
+typedef struct CollisionManager_BoundsBatch
+{
+	unsigned int count;													//Number of pairs in the batch
+
+	float centers1[3][CollisionManager_PAIRS_PER_BATCH];				//World space center of the bounding sphere of obj1 of each pair along each axis
+	float radii1[CollisionManager_PAIRS_PER_BATCH];						//Radius of the bounding sphere of obj1 of each pair
+	float mins1[3][CollisionManager_PAIRS_PER_BATCH];					//World space minimum of obj1 of each pair along each axis
+	float maxs1[3][CollisionManager_PAIRS_PER_BATCH];					//World space maximum of obj1 of each pair along each axis
+	float centers2[3][CollisionManager_PAIRS_PER_BATCH];				//World space center of the bounding sphere of obj2 of each pair along each axis
+	float radii2[CollisionManager_PAIRS_PER_BATCH];						//Radius of the bounding sphere of obj2 of each pair
+	float mins2[3][CollisionManager_PAIRS_PER_BATCH];					//World space minimum of obj2 of each pair along each axis
+	float maxs2[3][CollisionManager_PAIRS_PER_BATCH];					//World space maximum of obj2 of each pair along each axis
+} CollisionManager_BoundsBatch;
+
+//A collision detected in a shape batch
+typedef struct CollisionManager_BatchHit
+{
+	unsigned int index;					//Index of the pair in the batch
+	float normal[3];					//Minimum translation vector of the collision
+	float overlap;						//Overlap of the collision
+} CollisionManager_BatchHit;
+
 typedef struct CollisionBuffer
 {
-	LinkedList* collisions;		//Contains the list of registered collisions for each frame
+	DynamicArray* collisions;			//Contiguous array of Collisions registered each frame
+	DynamicArray* objectCollisions;		//Indices into collisions grouped by object. Each collider's range is given by it's collisionsStart & numCollisions
+	PairCache* pairCache;				//Persistent pairs of objects reported by the broadphase
+	DynamicArray* candidatePairs;		//Pairs of objects queried from a broadphase, each two consecutive object pointers form a pair
+
+	DynamicArray* reportedPairs;		//CollisionBuffer_ReportedPairs to be tested this frame in the order they were reported
+	unsigned int numWorkers;			//Number of workers testing reported pairs in parallel
+	DynamicArray** workerCollisions;	//Contiguous array of Collisions registered by each worker
 } CollisionBuffer;
 
 ///
@@ -29,7 +105,43 @@ struct ProjectionBounds
 	float min, max;
 };
 
+//The oriented points of a collider being projected onto the axes of a separating axis test
+struct ProjectedPoints
+{
+	const Vector** points;					//Oriented points of the collider
+	unsigned int numPoints;					//Number of points of the collider
+	const ColliderData_ConvexHull* hull;	//Hull the points belong to if it can be climbed, else NULL to scan every point
+	unsigned int extremes[2];				//Indices of the points which projected lowest & highest onto the last axis
+};
+
+//The points, axes & edges of a convex hull oriented by a frame of reference
+struct OrientedHull
+{
+	Vector** points;						//Oriented points of the hull in world space
+	Vector** axes;							//Oriented axes of the hull
+	Vector** edges;							//Oriented edges of the hull
+};
+
+//Memory a thread reuses to orient the convex hulls it tests.
+//It only ever grows, so once it fits the largest hulls the thread tests, testing a pair of hulls does not touch the heap.
+typedef struct CollisionManager_Scratch
+{
+	Vector** vectors;						//Pointers to vectors of dimension 3, the vectors & their components are stored after the pointers
+	unsigned int numVectors;				//Number of vectors there is room for
+	unsigned char* bytes;					//Memory for the oriented arcs & edge flags of a pair of hulls
+	unsigned int numBytes;					//Number of bytes there is room for
+} CollisionManager_Scratch;
+
 static CollisionBuffer* collisionBuffer;
+static WorkerPool* workerPool;
+//The algorithm used to test each pair of collider types, indexed by the types of both colliders
+static enum ConvexAlgorithm convexAlgorithms[COLLIDER_NUM_TYPES][COLLIDER_NUM_TYPES];
+//The scratch memory of the calling thread, NULL until the thread first tests a convex hull
+static thread_local CollisionManager_Scratch* scratch;
+//The scratch memory of every thread, freed along with the collision manager
+static DynamicArray* scratches;
+//Guards the scratch memory of every thread
+static std::mutex* scratchLock;
 
 ///
 //Allocates memory for a new collision buffer
@@ -43,7 +155,8 @@ static CollisionBuffer* CollisionManager_AllocateBuffer(void);
 //
 //Parameters:
 //	buffer: The buffer to initialize
-static void CollisionManager_InitializeBuffer(CollisionBuffer* buffer);
+//	numWorkers: The number of workers which will test reported pairs in parallel
+static void CollisionManager_InitializeBuffer(CollisionBuffer* buffer, unsigned int numWorkers);
 
 ///
 //Frees resources allocated by a collision buffer
@@ -53,27 +166,55 @@ static void CollisionManager_InitializeBuffer(CollisionBuffer* buffer);
 static void CollisionManager_FreeBuffer(CollisionBuffer* buffer);
 
 ///
-//Allocates memory for a new collision
+//Clears a collision buffer of all collisions registered last frame
+//Does not lessen the capacity of the buffer
 //
-//Returns:
-//	Pointer to a newly allocated collision
-static Collision* CollisionManager_AllocateCollision(void);
+//Parameters:
+//	buffer: A pointer to the collision buffer to clear
+static void CollisionManager_ClearBuffer(CollisionBuffer* buffer);
 
 ///
 //Initializes a collision
-//All members of the collision are set to NULL with the exception of the MTV
+//All members of the collision are set to NULL & the MTV is zeroed
 //
 //PArameters:
 //	collision: The collision to initialize
 static void CollisionManager_InitializeCollision(Collision* collision);
 
 ///
-//Frees the memory allocated for a collision.
-//Does not free the objects involved in the collision!
+//Stores the result of testing a pair of objects in the persistent pair
 //
 //Parameters:
-//	collision: The collision being freed
-void CollisionManager_FreeCollision(Collision* collision);
+//	pair: A pointer to the pair which was tested
+//	collision: A pointer to the result of the test
+static void CollisionManager_StorePairResult(PairCache_Pair* pair, const Collision* collision);
+
+///
+//Loads the result of the last test of a pair of objects from the persistent pair
+//
+//Parameters:
+//	dest: A pointer to the collision to load the result into
+//	pair: A pointer to the pair to load the result of
+//	obj1Frame: The frame of reference currently orienting obj1 of the pair
+//	obj2Frame: The frame of reference currently orienting obj2 of the pair
+static void CollisionManager_LoadPairResult(Collision* dest, const PairCache_Pair* pair, FrameOfReference* obj1Frame, FrameOfReference* obj2Frame);
+
+///
+//Links each collision registered in a collision buffer to the persistent pair it was detected on
+//Must be called after the pair cache has ended it's frame.
+//
+//Parameters:
+//	buffer: A pointer to the collision buffer
+static void CollisionManager_BindCollisionPairs(CollisionBuffer* buffer);
+
+///
+//Groups the collisions registered in a collision buffer by the objects involved in them.
+//Sets each involved collider's range of collisions in the buffer's object collision indices.
+//Must be called once all collisions for the frame have been registered.
+//
+//Parameters:
+//	buffer: A pointer to the collision buffer to index
+static void CollisionManager_IndexObjectCollisions(CollisionBuffer* buffer);
 
 ///
 //Initializes the Collision Manager
@@ -83,6 +224,26 @@ void CollisionManager_Initialize(void);
 //Frees any resources allocated by the collision manager
 void CollisionManager_Free(void);
 
+///
+//Sets the algorithm used to test colliders of two types against each other.
+//Only pairs of AABBs & convex hulls other than two AABBs can be tested with GJK, the algorithm of any other pair is ignored.
+//
+//Parameters:
+//	type1: The type of the first collider of the pair
+//	type2: The type of the second collider of the pair
+//	algorithm: The algorithm to test the pair with
+void CollisionManager_SetConvexAlgorithm(enum ColliderType type1, enum ColliderType type2, enum ConvexAlgorithm algorithm);
+
+///
+//Gets a collision which occurred last frame involving the given collider
+//
+//Parameters:
+//	collider: A pointer to the collider to get a collision of
+//	index: The index of the collision to get, must be less than collider->numCollisions
+//
+//Returns:
+//	A pointer to the collision in the collision buffer
+Collision* CollisionManager_GetObjectCollision(const Collider* collider, unsigned int index);
 
 
 ///
@@ -93,8 +254,8 @@ void CollisionManager_Free(void);
 //	gameObjects: THe list of gameObjects to test
 //
 //Returns:
-//	A pointer to a linked list of collisions which occurred this frame.
-LinkedList* CollisionManager_UpdateList(LinkedList* gameObjects);
+//	A pointer to a dynamic array of collisions which occurred this frame.
+DynamicArray* CollisionManager_UpdateList(LinkedList* gameObjects);
 
 ///
 //Tests for collisions on all objects which have colliders
@@ -104,8 +265,8 @@ LinkedList* CollisionManager_UpdateList(LinkedList* gameObjects);
 //	gameObjects: An array of game objects to test
 //
 //Returns:
-//	A pointer to a linked list of collisions which occurred this frame
-LinkedList* CollisionManager_UpdateArray(GObject** gameObjects, unsigned int numObjects);
+//	A pointer to a dynamic array of collisions which occurred this frame
+DynamicArray* CollisionManager_UpdateArray(GObject** gameObjects, unsigned int numObjects);
 
 ///
 //Tests for collisions on all objects in an oct tree compiling a list of collisions which occur
@@ -113,23 +274,188 @@ LinkedList* CollisionManager_UpdateArray(GObject** gameObjects, unsigned int num
 //Parameters:
 //	tree: The oct tree holding the game objects to test
 //
-//Returns: A pointer to a linked list of collisions which occurred this frame
-LinkedList* CollisionManager_UpdateOctTree(OctTree* tree);
+//Returns: A pointer to a dynamic array of collisions which occurred this frame
+DynamicArray* CollisionManager_UpdateOctTree(OctTree* tree);
 
 ///
-//Tests for collisions on all objects within an oct tree node appending to a list of collisions which occur
+//Reports the pairs of objects within each leaf of an oct tree node to the pair cache,
+//appending the pairs which were not yet reported this frame to the reported pairs of the collision buffer
 //
 //Parameters:
-//	node: A pointer to the node of the oct tree to check
-static void CollisionManager_UpdateOctTreeNode(OctTree_Node* node);
+//	node: A pointer to the node of the oct tree to report the pairs of
+static void CollisionManager_ReportOctTreeNode(OctTree_Node* node);
 
 ///
-//Tests for collisions on an array of objects within an oct tree node appending to a list of collisions which occur
+//Reports the pairs of an array of objects within an oct tree leaf to the pair cache,
+//appending the pairs which were not yet reported this frame to the reported pairs of the collision buffer
 //
 //Parameters:
-//	gameObjects: An array of pointers to game objects to check collisions
+//	gameObjects: An array of pointers to game objects to report the pairs of
 //	numObjects: The number of objects in the array
-static void CollisionManager_UpdateOctTreeNodeArray(GObject** gameObjects, unsigned int numObjects);
+static void CollisionManager_ReportOctTreeNodeArray(GObject** gameObjects, unsigned int numObjects);
+
+///
+//Tests for collisions on all objects in a sweep and prune broadphase compiling a list of collisions which occur
+//
+//Parameters:
+//	sweepAndPrune: The sweep and prune broadphase holding the game objects to test
+//
+//Returns: A pointer to a dynamic array of collisions which occurred this frame
+DynamicArray* CollisionManager_UpdateSweepAndPrune(SweepAndPrune* sweepAndPrune);
+
+///
+//Tests for collisions on all objects in a dynamic AABB tree compiling a list of collisions which occur
+//
+//Parameters:
+//	tree: The dynamic AABB tree holding the game objects to test
+//
+//Returns: A pointer to a dynamic array of collisions which occurred this frame
+DynamicArray* CollisionManager_UpdateAABBTree(AABBTree* tree);
+
+///
+//Tests for collisions on all objects in a spatial hash grid compiling a list of collisions which occur
+//
+//Parameters:
+//	grid: The spatial hash grid holding the game objects to test
+//
+//Returns: A pointer to a dynamic array of collisions which occurred this frame
+DynamicArray* CollisionManager_UpdateSpatialHashGrid(SpatialHashGrid* grid);
+
+///
+//Tests for collisions on all objects in a linear oct tree compiling a list of collisions which occur
+//
+//Parameters:
+//	tree: The linear oct tree holding the game objects to test
+//
+//Returns: A pointer to a dynamic array of collisions which occurred this frame
+DynamicArray* CollisionManager_UpdateLinearOctTree(LinearOctTree* tree);
+
+///
+//Prepares the collision buffer & pair cache for a broadphase to report it's candidate pairs
+static void CollisionManager_BeginBroadphase(void);
+
+///
+//Finishes the collisions registered from the candidate pairs reported by a broadphase
+//
+//Returns:
+//	A pointer to a dynamic array of collisions which occurred this frame
+static DynamicArray* CollisionManager_EndBroadphase(void);
+
+///
+//Tests all pairs of objects which were queried from a broadphase into the candidate pairs of the collision buffer,
+//along with any pairs which were already reported directly
+static void CollisionManager_TestCandidatePairs(void);
+
+///
+//Reports a pair of objects which a broadphase found as potentially colliding to the pair cache,
+//appending the pair to the reported pairs of the collision buffer to be tested.
+//Pairs which were already reported this frame are ignored.
+//
+//Parameters:
+//	obj1: A pointer to the first object of the pair (Must have collider attached)
+//	obj2: A pointer to the second object of the pair (Must have collider attached)
+static void CollisionManager_ReportPair(GObject* obj1, GObject* obj2);
+
+///
+//Tests the reported pairs of the collision buffer on the worker pool,
+//registering the collisions in the order the pairs were reported
+static void CollisionManager_TestReportedPairs(void);
+
+///
+//Tests a range of the reported pairs of a collision buffer into the collisions of a worker
+//
+//Parameters:
+//	data: A pointer to the collision buffer holding the reported pairs
+//	begin: The index of the first reported pair to test
+//	end: The index one past the last reported pair to test
+//	worker: The index of the worker testing the pairs
+static void CollisionManager_TestReportedPairRange(void* data, unsigned int begin, unsigned int end, unsigned int worker);
+
+///
+//Tests a pair of objects reported to the pair cache this frame.
+//Retests the pair only if either object moved since it was last tested, otherwise loads the last result.
+//Only touches the pair itself, so different pairs may be tested on different threads.
+//
+//Parameters:
+//	dest: A pointer to a collision to store the result of the test in
+//	pair: A pointer to the pair to test
+//	first: The object of the pair which was reported first
+static void CollisionManager_TestPair(Collision* dest, PairCache_Pair* pair, GObject* first);
+
+///
+//Registers a detected collision in the collision buffer
+//
+//Parameters:
+//	collision: A pointer to the collision to register
+static void CollisionManager_RegisterCollision(const Collision* collision);
+
+///
+//Records the result of testing a reported pair, appending the collision to a worker's collisions if the objects collide
+//
+//Parameters:
+//	reportedPair: A pointer to the reported pair which was tested
+//	collision: A pointer to the result of the test
+//	dest: A pointer to the dynamic array of collisions of the worker which tested the pair
+//	worker: The index of the worker which tested the pair
+static void CollisionManager_RecordResult(CollisionBuffer_ReportedPair* reportedPair, const Collision* collision, DynamicArray* dest, unsigned int worker);
+
+///
+//Tests the world bounds of both objects of a range of reported pairs four pairs at a time.
+//Follows the same steps as Collider_DoWorldBoundsOverlap, so only pairs whose bounds overlap need go on to the narrow phase.
+//
+//Parameters:
+//	overlaps: An array with room for a flag for each pair in the range, set to 1 if the bounds of the pair overlap else 0
+//	buffer: A pointer to the collision buffer holding the reported pairs
+//	begin: The index of the first reported pair to test, the range may hold at most CollisionManager_PAIRS_PER_BATCH pairs
+//	end: The index one past the last reported pair to test
+static void CollisionManager_PrefilterPairs(unsigned char* overlaps, CollisionBuffer* buffer, unsigned int begin, unsigned int end);
+
+///
+//Adds a reported pair whose colliders share a shape to a batch to be tested with the other pairs of that shape
+//
+//Parameters:
+//	batch: A pointer to the shape batch to add the pair to, must have room for another pair
+//	reportedPairIndex: The index of the pair in the reported pairs
+//	pair: A pointer to the pair to add
+//	first: The object of the pair which was reported first
+//	obj1Frame: The frame of reference currently orienting obj1 of the pair
+//	obj2Frame: The frame of reference currently orienting obj2 of the pair
+static void CollisionManager_AddToBatch(CollisionManager_ShapeBatch* batch, unsigned int reportedPairIndex, PairCache_Pair* pair, GObject* first, const FrameOfReference* obj1Frame, const FrameOfReference* obj2Frame);
+
+///
+//Tests the pairs of a shape batch, storing the result in each pair & recording it in a worker's collisions
+//
+//Parameters:
+//	batch: A pointer to the shape batch to test
+//	shape: The type of the colliders in the batch, either COLLIDER_SPHERE or COLLIDER_AABB
+//	buffer: A pointer to the collision buffer holding the reported pairs of the batch
+//	worker: The index of the worker testing the batch
+static void CollisionManager_TestBatch(CollisionManager_ShapeBatch* batch, enum ColliderType shape, CollisionBuffer* buffer, unsigned int worker);
+
+///
+//Tests a batch of pairs of spheres four at a time.
+//Follows the same steps as CollisionManager_TestSphereCollision, so the results are exactly the same.
+//
+//Parameters:
+//	batch: A pointer to the shape batch of spheres to test
+//	hits: An array of at least batch->count hits to store the detected collisions in, in the order of the batch
+//
+//Returns:
+//	The number of collisions detected
+static unsigned int CollisionManager_TestSphereBatch(const CollisionManager_ShapeBatch* batch, CollisionManager_BatchHit* hits);
+
+///
+//Tests a batch of pairs of AABBs four at a time.
+//Follows the same steps as CollisionManager_TestAABBCollision, so the results are exactly the same.
+//The collisions are between the second object and the first object of each pair, in that order.
+//
+//Parameters:
+//	batch: A pointer to the shape batch of AABBs to test
+//	hits: An array of at least batch->count hits to store the detected collisions in, in the order of the batch
+//
+//Returns:
+//	The number of collisions detected
+static unsigned int CollisionManager_TestAABBBatch(const CollisionManager_ShapeBatch* batch, CollisionManager_BatchHit* hits);
 
 ///
 //Tests for a collision between two objects which have colliders
@@ -142,6 +468,19 @@ static void CollisionManager_UpdateOctTreeNodeArray(GObject** gameObjects, unsig
 //	obj2FoR: Pointer to frame of reference to use to orient Object 2
 void CollisionManager_TestCollision(Collision* dest, GObject* obj1, FrameOfReference* obj1FoR, GObject* obj2, FrameOfReference* obj2FoR);
 
+///
+//Tests for a collision between an object with a compound collider & any other object.
+//Only the pieces whose bounding spheres reach the bounding sphere of the other object are tested,
+//and the collision with the deepest overlap is kept.
+//
+//Parameters:
+//	dest: Collision to store the results of test in
+//	compoundObj: The object with the compound collider
+//	compoundFoR: Pointer to frame of reference to use to orient the compound object
+//	obj: The other object, may have a compound collider as well
+//	objFoR: Pointer to frame of reference to use to orient the other object
+static void CollisionManager_TestCompoundCollision(Collision* dest, GObject* compoundObj, FrameOfReference* compoundFoR, GObject* obj, FrameOfReference* objFoR);
+
 ///
 //TEsts if two game objects bounding spheres are colliding.
 //
@@ -213,28 +552,58 @@ void CollisionManager_TestConvexCollision(Collision* dest, GObject* obj1, FrameO
 //	sphereFoR: The frame of reference to use to orient the sphere collider
 void CollisionManager_TestConvexSphereCollision(Collision* dest, GObject* convexObj, FrameOfReference* convexFoR, GObject* sphere, FrameOfReference* sphereFoR);
 
+///
+//Tests if two game objects with AABB or convex hull colliders are colliding
+//Utilizes GJK to detect the collision & EPA to find the minimum translation vector
+//Objects which are only touching are not colliding
+//
+//Parameters:
+//	dest: Collision to store the results of test in
+//	obj1: First game object to test (Must have an AABB or convex hull collider attached)
+//	obj1FoR: Pointer to frame of reference to use to orient Object 1
+//	obj2: Second game object to test (Must have an AABB or convex hull collider attached)
+//	obj2FoR: Pointer to frame of reference to use to orient Object 2
+void CollisionManager_TestGJKCollision(Collision* dest, GObject* obj1, FrameOfReference* obj1FoR, GObject* obj2, FrameOfReference* obj2FoR);
+
+///
+//Gets the points of an AABB or convex hull collider in world space as an array of floats
+//The points of a convex hull come from its world space cache, or are oriented into scratch vectors
+//when the cache does not match the frame, so no memory is allocated per test.
+//
+//Parameters:
+//	corners: An array of 24 floats to store the corners of an AABB in
+//	vectors: Scratch vectors with room for the points of a convex hull, their components must be contiguous
+//	obj: The game object with the collider (Must have an AABB or convex hull collider attached)
+//	frame: The frame of reference to orient the collider with
+//	numPoints: A pointer to store the number of points in
+//
+//Returns:
+//	A pointer to 3 floats per point
+static const float* CollisionManager_GetGJKPoints(float* corners, Vector** vectors, GObject* obj, FrameOfReference* frame, unsigned int* numPoints);
+
 ///
 //Performs the Separating Axis Theorem test with face normals
 //
 //Parameters:
-//	dest: A pointer to a collision to store the results of the test in. Results will not be stored if the test detects no collision
+//	dest: A pointer to a collision to store the results of the test in. Results will not be stored if the test detects no collision.
+//		The MTV faces obj1, it's sign is taken from whichever side of the axis overlaps least so pushing obj1 along it separates the objects
 //	orientedAxes1: An array of pointers to vectors representing the oriented axes of object 1 involved in the test
 //	numAxes1: The number of axes belonging to object 1
-//	orientedPoints1: An array of pointers to vectors representing the oriented points of object 1 involved in the test
-//	numPoints1: The number of points belonging to object 1
+//	points1: A pointer to the oriented points of object 1, the extremes of each projection are kept in it
 //	orientedAxes2: An array of pointersto vectors representing the oriented axes of object 2 involved in the test
 //	numAxes2: The number of axes belonging to object 2
-//	orientedPoints2: An array of pointers to vectors representing the oriented points of object 2 involved in the test
-//	numPoints2: The number of points belonging to object 2
+//	points2: A pointer to the oriented points of object 2, the extremes of each projection are kept in it
+//	separatingAxis: A pointer to store the axis which separated the objects in, not changed if the test detects a collision
 //
 //Returns:
 //	0 if the test detects no collision
 //	1 if the test detects a collision
 static unsigned char CollisionManager_PerformSATFaces(Collision* dest, 
 										const Vector** orientedAxes1, const unsigned int numAxes1, 
-										const Vector** orientedPoints1, const unsigned int numPoints1, 
+										ProjectedPoints* points1,
 										const Vector** orientedAxes2, const unsigned int numAxes2, 
-										const Vector** orientedPoints2, const unsigned int numPoints2);
+										ProjectedPoints* points2,
+										PairCache_SeparatingAxis* separatingAxis);
 
 ///
 //Performs the Separating axis theorem test with face normals
@@ -243,17 +612,111 @@ static unsigned char CollisionManager_PerformSATFaces(Collision* dest,
 //	dest: A pointer to the collision to store the results of the test in. Resultswill not be stored if the test detects no collisions
 //	orientedEdges1: An array of pointers to vectors representing the oriented edges of object 1
 //	numEdges1: The number of edges belonging to object 1
-//	orientedPoints1: An array of pointers to vectors representing the oriented points of object 1
-//	numPoints1: The number of points belonging to object 1
+//	points1: A pointer to the oriented points of object 1, the extremes of each projection are kept in it
 //	orientedEdges2: An array of pointers to vectors representing the oriented edges of object 2
 //	numEdges2: The number of edges belonging to object 2
-//  orientedPoints2: An array of pointers to vectors representing the oriented points of object 2
-//	numPoints2: the number of points belonging to object 2
+//	points2: A pointer to the oriented points of object 2, the extremes of each projection are kept in it
+//	minkowskiFaces: Flags for each pair of edges, row by row for object 1's edges, set for the pairs to test. NULL to test every pair
+//	separatingAxis: A pointer to store the axis which separated the objects in, not changed if the test detects a collision
 static unsigned char CollisionManager_PerformSATEdges(Collision*dest,
 										const Vector** orientedEdges1, const unsigned int numEdges1,
-										const Vector** orientedPoints1, const unsigned int numPoints1,
+										ProjectedPoints* points1,
+										const Vector** orientedEdges2, const unsigned int numEdges2,
+										ProjectedPoints* points2,
+										const unsigned char* minkowskiFaces, PairCache_SeparatingAxis* separatingAxis);
+
+///
+//Tests if an axis which separated two objects in an earlier separating axis test still separates them
+//Each kind of axis is tested exactly as CollisionManager_PerformSATFaces & CollisionManager_PerformSATEdges test it.
+//
+//Parameters:
+//	separatingAxis: A pointer to the axis to test, with indices into the arrays of the objects in the order given
+//	orientedAxes1: An array of pointers to vectors representing the oriented axes of object 1
+//	numAxes1: The number of axes belonging to object 1
+//	orientedEdges1: An array of pointers to vectors representing the oriented edges of object 1
+//	numEdges1: The number of edges belonging to object 1
+//	points1: A pointer to the oriented points of object 1, the extremes of each projection are kept in it
+//	orientedAxes2: An array of pointers to vectors representing the oriented axes of object 2
+//	numAxes2: The number of axes belonging to object 2
+//	orientedEdges2: An array of pointers to vectors representing the oriented edges of object 2
+//	numEdges2: The number of edges belonging to object 2
+//	points2: A pointer to the oriented points of object 2, the extremes of each projection are kept in it
+//
+//Returns:
+//	1 if the axis still separates the objects
+//	0 if it does not, or if there is no such axis
+static unsigned char CollisionManager_TestSeparatingAxis(const PairCache_SeparatingAxis* separatingAxis,
+										const Vector** orientedAxes1, const unsigned int numAxes1,
+										const Vector** orientedEdges1, const unsigned int numEdges1,
+										ProjectedPoints* points1,
+										const Vector** orientedAxes2, const unsigned int numAxes2,
+										const Vector** orientedEdges2, const unsigned int numEdges2,
+										ProjectedPoints* points2);
+
+///
+//Performs the Separating Axis Theorem test with face normals & edges
+//When the collision is being tested on a persistent pair the axis which separated the pair last time it was tested is tried first,
+//objects which were separated tend to stay separated by the same axis, saving all but one projection.
+//
+//Parameters:
+//	dest: A pointer to the collision to store the results of the test in. Results will not be stored if the test detects no collision
+//	obj1: The first object of the test, used to match the objects with those of the persistent pair
+//	orientedAxes1: An array of pointers to vectors representing the oriented axes of object 1
+//	numAxes1: The number of axes belonging to object 1
+//	orientedEdges1: An array of pointers to vectors representing the oriented edges of object 1
+//	numEdges1: The number of edges belonging to object 1
+//	points1: A pointer to the oriented points of object 1, the extremes of each projection are kept in it
+//	orientedAxes2: An array of pointers to vectors representing the oriented axes of object 2
+//	numAxes2: The number of axes belonging to object 2
+//	orientedEdges2: An array of pointers to vectors representing the oriented edges of object 2
+//	numEdges2: The number of edges belonging to object 2
+//	points2: A pointer to the oriented points of object 2, the extremes of each projection are kept in it
+//	minkowskiFaces: Flags for each pair of edges, row by row for object 1's edges, set for the pairs to test. NULL to test every pair
+//
+//Returns:
+//	0 if the test detects no collision
+//	1 if the test detects a collision
+static unsigned char CollisionManager_PerformSAT(Collision* dest, const GObject* obj1,
+										const Vector** orientedAxes1, const unsigned int numAxes1,
+										const Vector** orientedEdges1, const unsigned int numEdges1,
+										ProjectedPoints* points1,
+										const Vector** orientedAxes2, const unsigned int numAxes2,
 										const Vector** orientedEdges2, const unsigned int numEdges2,
-										const Vector** orientedPoints2, const unsigned int numPoints2);
+										ProjectedPoints* points2,
+										const unsigned char* minkowskiFaces);
+
+///
+//Determines which pairs of edges of two convex hulls form faces of the Minkowski difference of the hulls from the arcs of their edges.
+//Only these pairs need to be tested by SAT, but testing the arcs costs more than it saves unless the hulls have many edge directions.
+//
+//Parameters:
+//	scratch: A pointer to the scratch memory of the calling thread to hold the flags in
+//	convexHull1: A pointer to the first convex hull
+//	frame1: A pointer to the frame of reference orienting the first convex hull
+//	convexHull2: A pointer to the second convex hull
+//	frame2: A pointer to the frame of reference orienting the second convex hull
+//
+//Returns:
+//	An array of flags in the scratch memory for each pair of edges, row by row for the first hull's edges, set for the pairs which form faces.
+//	NULL if every pair should be tested.
+static unsigned char* CollisionManager_GetMinkowskiFaces(CollisionManager_Scratch* scratch, const ColliderData_ConvexHull* convexHull1, const FrameOfReference* frame1, const ColliderData_ConvexHull* convexHull2, const FrameOfReference* frame2);
+
+///
+//Swaps which object of a pair each index of a separating axis refers to
+//
+//Parameters:
+//	separatingAxis: A pointer to the separating axis to swap
+static void CollisionManager_SwapSeparatingAxis(PairCache_SeparatingAxis* separatingAxis);
+
+///
+//Projects the points of a collider onto a normalized axis, finding the minimum and maximum values of the projection.
+//The points of a hull which can be climbed are searched from the extremes of the last projection, else every point is scanned.
+//
+//Parameters:
+//	dest: The destination of the projection bounds
+//	axis: The axis projecting onto
+//	points: The points of the collider to project onto the axis
+static void CollisionManager_ProjectPoints(ProjectionBounds* dest, const Vector* axis, ProjectedPoints* points);
 
 ///
 //Projects a set of points onto a normalized axis getting the squared magnitude of the projection vector.
@@ -265,4 +728,72 @@ static unsigned char CollisionManager_PerformSATEdges(Collision*dest,
 //	points: The set of points to project onto the axis
 static void CollisionManager_GetProjectionBounds(ProjectionBounds* dest, const Vector* axis, const Vector** points, const int numPoints);
 
+///
+//Finds the point on the edges of a convex hull closest to a point.
+//The edges are read from the neighbours of each point of the hull, a hull without them only has it's points searched.
+//
+//Parameters:
+//	dest: An array of 3 floats to store the closest point in
+//	convexHull: A pointer to the convex hull to search the edges of
+//	orientedPoints: The points of the convex hull oriented into world space
+//	point: An array of 3 floats containing the point to find the closest point to
+static void CollisionManager_GetClosestHullEdgePoint(float* dest, const ColliderData_ConvexHull* convexHull, const Vector** orientedPoints, const float* point);
+
+///
+//Refreshes the world bounds of an object's collider, along with the world space cache of it's convex hull or of each piece of it's compound collider,
+//with the frame of reference it is tested in. Objects without a collider are ignored.
+//
+//Parameters:
+//	obj: A pointer to the object to refresh the cache of
+static void CollisionManager_RefreshWorldCache(GObject* obj);
+
+///
+//Gets the points, axes & edges of a convex hull oriented by a frame of reference.
+//They are read from the hull's world space cache if it is current, else they are oriented into the given vectors.
+//
+//Parameters:
+//	dest: A pointer to store the arrays of oriented points, axes & edges in
+//	vectors: An array of pointers to vectors of dimension 3 with room for every point, axis & edge of the hull
+//	convexHull: A pointer to the convex hull to orient
+//	frame: A pointer to the frame of reference to orient the convex hull by
+static void CollisionManager_GetOrientedHull(OrientedHull* dest, Vector** vectors, ColliderData_ConvexHull* convexHull, const FrameOfReference* frame);
+
+///
+//Gets the scratch memory of the calling thread, allocating it the first time the thread asks
+//
+//Returns:
+//	A pointer to the scratch memory of the calling thread
+static CollisionManager_Scratch* CollisionManager_GetScratch(void);
+
+///
+//Makes room for a number of vectors in scratch memory.
+//The contents of the vectors are not kept when the scratch memory grows.
+//
+//Parameters:
+//	scratch: A pointer to the scratch memory
+//	numVectors: The number of vectors needed
+//
+//Returns:
+//	An array of pointers to at least numVectors vectors of dimension 3
+static Vector** CollisionManager_ReserveScratchVectors(CollisionManager_Scratch* scratch, unsigned int numVectors);
+
+///
+//Makes room for a number of bytes in scratch memory.
+//The contents of the bytes are not kept when the scratch memory grows.
+//
+//Parameters:
+//	scratch: A pointer to the scratch memory
+//	numBytes: The number of bytes needed
+//
+//Returns:
+//	A pointer to at least numBytes bytes, aligned for any type
+static unsigned char* CollisionManager_ReserveScratchBytes(CollisionManager_Scratch* scratch, unsigned int numBytes);
+
+///
+//Frees scratch memory
+//
+//Parameters:
+//	scratch: A pointer to the scratch memory to free
+static void CollisionManager_FreeScratch(CollisionManager_Scratch* scratch);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,388 @@
+#include "CompoundCollider.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <limits.h>
+
+#include "Collider.h"
+#include "ConvexDecomposition.h"
+
+#include "AssetManager.h"
+
+///
+//Setter for the static Collider_Initialize function
+//
+//Parameters:
+//	funcPtr: Collider_Initialize function pointer
+void CompoundCollider_SetColliderInitializer(InitializerPtr funcPtr)
+{
+	CompoundCollider_ColliderInitializePtr = funcPtr;
+}
+
+///
+//Allocates memory for a new compound collider data set
+//
+//Returns:
+//	Pointer to a newly allocated compound collider data set
+struct ColliderData_Compound* CompoundCollider_AllocateData()
+{
+	struct ColliderData_Compound* colliderData = (struct ColliderData_Compound*)malloc(sizeof(ColliderData_Compound));
+	return colliderData;
+}
+
+///
+//Initializes a compound collider data set without any pieces
+//
+//Parameters:
+//	compoundData: The compound collider data set being initialized
+void CompoundCollider_InitializeData(struct ColliderData_Compound* compoundData)
+{
+	compoundData->pieces = DynamicArray_Allocate();
+	DynamicArray_Initialize(compoundData->pieces, sizeof(Collider*));
+
+	compoundData->bounds = DynamicArray_Allocate();
+	DynamicArray_Initialize(compoundData->bounds, sizeof(float) * 4);
+
+	compoundData->nodes = DynamicArray_Allocate();
+	DynamicArray_Initialize(compoundData->nodes, sizeof(CompoundCollider_Node));
+}
+
+///
+//Initializes a compound collider without any pieces
+//
+//Parameters:
+//	collider: The collider being initialized
+void CompoundCollider_Initialize(Collider* collider)
+{
+	//Initialize the collider
+	CompoundCollider_ColliderInitializePtr(collider, COLLIDER_COMPOUND, AssetManager_LookupMesh("Cube"));
+
+	//Allocate the collider data
+	collider->data->compoundData = CompoundCollider_AllocateData();
+
+	//Initialize the collider data
+	CompoundCollider_InitializeData(collider->data->compoundData);
+}
+
+///
+//Frees a compound collider data set along with each of it's pieces
+//
+//Parameters:
+//	colliderData: A pointer to the compound collider data to free
+void CompoundCollider_FreeData(struct ColliderData_Compound* colliderData)
+{
+	for(unsigned int i = 0; i < colliderData->pieces->size; i++)
+	{
+		Collider_Free(*(Collider**)DynamicArray_Index(colliderData->pieces, i));
+	}
+	DynamicArray_Free(colliderData->pieces);
+	DynamicArray_Free(colliderData->bounds);
+	DynamicArray_Free(colliderData->nodes);
+
+	free(colliderData);
+}
+
+///
+//Adds a piece to a compound collider & rebuilds it's bounding volume hierarchy.
+//The compound collider takes ownership of the piece & frees it along with itself.
+//
+//Parameters:
+//	collider: A pointer to the compound collider to add the piece to
+//	piece: A pointer to an initialized convex hull collider with at least one point, in the model space of the compound collider
+//
+//Returns:
+//	0 if the compound collider already has CompoundCollider_MAX_PIECES pieces & the piece was not added, else 1
+unsigned char CompoundCollider_AddPiece(struct ColliderData_Compound* collider, Collider* piece)
+{
+	if(collider->pieces->size >= CompoundCollider_MAX_PIECES)
+	{
+		printf("CompoundCollider_AddPiece failed! Collider already has %d pieces. Piece not added.\n", CompoundCollider_MAX_PIECES);
+		return 0;
+	}
+
+	//Bound the piece by a sphere around the middle of it's points
+	const LinkedList* points = piece->data->convexHullData->points;
+	float min[3], max[3];
+	for(int i = 0; i < 3; i++)
+	{
+		min[i] = max[i] = ((Vector*)points->head->data)->components[i];
+	}
+	for(LinkedList_Node* current = points->head; current != NULL; current = current->next)
+	{
+		const float* point = ((Vector*)current->data)->components;
+		for(int i = 0; i < 3; i++)
+		{
+			if(point[i] < min[i]) min[i] = point[i];
+			if(point[i] > max[i]) max[i] = point[i];
+		}
+	}
+
+	float sphere[4] = { (min[0] + max[0]) / 2.0f, (min[1] + max[1]) / 2.0f, (min[2] + max[2]) / 2.0f, 0.0f };
+	for(LinkedList_Node* current = points->head; current != NULL; current = current->next)
+	{
+		float offset[3];
+		Vector_SubtractArray(offset, ((Vector*)current->data)->components, sphere, 3);
+		float distance = Vector_GetMagFromArray(offset, 3);
+		if(distance > sphere[3]) sphere[3] = distance;
+	}
+
+	DynamicArray_Append(collider->pieces, &piece);
+	DynamicArray_Append(collider->bounds, sphere);
+
+	//Rebuild the hierarchy from scratch, pieces are only added while building the collider
+	unsigned int pieces[CompoundCollider_MAX_PIECES];
+	for(unsigned int i = 0; i < collider->pieces->size; i++)
+	{
+		pieces[i] = i;
+	}
+	DynamicArray_Clear(collider->nodes);
+	CompoundCollider_BuildNode(collider, pieces, collider->pieces->size);
+
+	return 1;
+}
+
+///
+//Makes a compound collider which approximates a concave mesh from a blank initialized compound collider.
+//The mesh is split into nearly convex parts by ConvexDecomposition, then each part is wrapped in a convex hull.
+//
+//Parameters:
+//	collider: A pointer to a compound collider with no current pieces
+//	mesh: A pointer to the mesh to approximate, in the model space of the collider
+//	maxPieces: The most pieces the collider may have, at most CompoundCollider_MAX_PIECES
+//	maxPoints: The most points each piece may have, at least 4
+//
+//Returns:
+//	0 if the mesh does not enclose a volume & the collider was left blank, else 1
+unsigned char CompoundCollider_MakeMeshCollider(struct ColliderData_Compound* collider, const Mesh* mesh, unsigned int maxPieces, unsigned int maxPoints)
+{
+	if(maxPieces > CompoundCollider_MAX_PIECES) maxPieces = CompoundCollider_MAX_PIECES;
+
+	ConvexDecomposition* decomposition = ConvexDecomposition_Allocate();
+	ConvexDecomposition_Initialize(decomposition);
+	if(!ConvexDecomposition_Decompose(decomposition, mesh, maxPieces, ConvexDecomposition_RESOLUTION, ConvexDecomposition_MAX_CONCAVITY))
+	{
+		printf("CompoundCollider_MakeMeshCollider failed! Mesh does not enclose a volume. Collider not built.\n");
+		ConvexDecomposition_Free(decomposition);
+		return 0;
+	}
+
+	ConvexDecomposition_Part* parts = (ConvexDecomposition_Part*)decomposition->parts->data;
+	for(unsigned int i = 0; i < decomposition->parts->size; i++)
+	{
+		Collider* piece = Collider_Allocate();
+		ConvexHullCollider_Initialize(piece);
+
+		//Parts are made of whole voxels so they always enclose a volume
+		ConvexHullCollider_MakePointCloudCollider(piece->data->convexHullData, parts[i].points, parts[i].numPoints, maxPoints);
+		CompoundCollider_AddPiece(collider, piece);
+	}
+
+	ConvexDecomposition_Free(decomposition);
+	return 1;
+}
+
+///
+//Gets the world space bounding sphere of a compound collider
+//
+//Parameters:
+//	center: An array of 3 floats to store the world space center of the sphere in
+//	radius: A pointer to a float to store the radius of the sphere in
+//	collider: A pointer to the compound collider, must have at least one piece
+//	frame: The frame of reference with which to orient the collider
+void CompoundCollider_GetWorldBoundingSphere(float* center, float* radius, const struct ColliderData_Compound* collider, const FrameOfReference* frame)
+{
+	const CompoundCollider_Node* root = (const CompoundCollider_Node*)collider->nodes->data;
+
+	Matrix trans;
+	Matrix_INIT_ON_STACK(trans, 3, 3);
+	Matrix_GetProductMatrix(&trans, frame->rotation, frame->scale);
+
+	Matrix_GetProductVectorArray(center, trans.components, root->center, 3, 3);
+	Vector_IncrementArray(center, frame->position->components, 3);
+
+	//Scale the radius by the largest scale of the frame
+	float maxScale = 0.0f;
+	for(int i = 0; i < 3; i++)
+	{
+		float scale = fabsf(Matrix_GetIndex(frame->scale, i, i));
+		if(scale > maxScale) maxScale = scale;
+	}
+	*radius = root->radius * maxScale;
+}
+
+///
+//Finds the pieces of a compound collider whose bounding spheres overlap a world space sphere,
+//climbing down the bounding volume hierarchy so whole groups of distant pieces are skipped at once.
+//
+//Parameters:
+//	dest: An array with room for every piece of the collider to store the indices of the overlapping pieces in
+//	collider: A pointer to the compound collider
+//	frame: The frame of reference with which to orient the collider
+//	center: An array of 3 floats containing the world space center of the sphere
+//	radius: The radius of the sphere
+//
+//Returns:
+//	The number of overlapping pieces
+unsigned int CompoundCollider_QuerySphere(unsigned int* dest, const struct ColliderData_Compound* collider, const FrameOfReference* frame, const float* center, float radius)
+{
+	if(collider->nodes->size == 0) return 0;
+	const CompoundCollider_Node* nodes = (const CompoundCollider_Node*)collider->nodes->data;
+
+	Matrix trans;
+	Matrix_INIT_ON_STACK(trans, 3, 3);
+	Matrix_GetProductMatrix(&trans, frame->rotation, frame->scale);
+
+	float maxScale = 0.0f;
+	for(int i = 0; i < 3; i++)
+	{
+		float scale = fabsf(Matrix_GetIndex(frame->scale, i, i));
+		if(scale > maxScale) maxScale = scale;
+	}
+
+	//The hierarchy is balanced, so the stack never holds more than one node for each level
+	unsigned int stack[CompoundCollider_MAX_PIECES];
+	unsigned int stackSize = 1;
+	stack[0] = 0;
+
+	unsigned int numPieces = 0;
+	while(stackSize > 0)
+	{
+		unsigned int index = stack[--stackSize];
+		const CompoundCollider_Node* node = nodes + index;
+
+		//Orient the bounding sphere of the node into world space
+		float nodeCenter[3];
+		Matrix_GetProductVectorArray(nodeCenter, trans.components, node->center, 3, 3);
+		Vector_IncrementArray(nodeCenter, frame->position->components, 3);
+
+		float displacement[3];
+		Vector_SubtractArray(displacement, nodeCenter, center, 3);
+		float reach = node->radius * maxScale + radius;
+		if(Vector_GetMagSqFromArray(displacement, 3) > reach * reach) continue;
+
+		if(node->piece != UINT_MAX)
+		{
+			dest[numPieces++] = node->piece;
+		}
+		else
+		{
+			stack[stackSize++] = node->secondChild;
+			stack[stackSize++] = index + 1;
+		}
+	}
+
+	return numPieces;
+}
+
+///
+//Generates the minimum AABB which contains every piece of a compound collider oriented by a frame of reference.
+//As with ConvexHullCollider_GenerateMinimumAABB, the AABB is rotated but not yet scaled.
+//
+//Parameters:
+//	dest: A pointer to the AABB collider data to store the AABB in, the centroid must be initialized
+//	collider: A pointer to the compound collider, must have at least one piece
+//	frame: The frame of reference with which to orient the collider
+void CompoundCollider_GenerateMinimumAABB(ColliderData_AABB* dest, const struct ColliderData_Compound* collider, const FrameOfReference* frame)
+{
+	float min[3], max[3];
+
+	Vector pieceCentroid;
+	Vector_INIT_ON_STACK(pieceCentroid, 3);
+	ColliderData_AABB pieceAABB;
+	pieceAABB.centroid = &pieceCentroid;
+
+	for(unsigned int i = 0; i < collider->pieces->size; i++)
+	{
+		const Collider* piece = *(Collider**)DynamicArray_Index(collider->pieces, i);
+		ConvexHullCollider_GenerateMinimumAABB(&pieceAABB, piece->data->convexHullData, frame);
+
+		float halfDimensions[3] = { pieceAABB.width / 2.0f, pieceAABB.height / 2.0f, pieceAABB.depth / 2.0f };
+		for(int j = 0; j < 3; j++)
+		{
+			if(i == 0 || pieceCentroid.components[j] - halfDimensions[j] < min[j]) min[j] = pieceCentroid.components[j] - halfDimensions[j];
+			if(i == 0 || pieceCentroid.components[j] + halfDimensions[j] > max[j]) max[j] = pieceCentroid.components[j] + halfDimensions[j];
+		}
+	}
+
+	for(int i = 0; i < 3; i++)
+	{
+		dest->centroid->components[i] = (max[i] + min[i]) / 2.0f;
+	}
+
+	dest->width = max[0] - min[0];
+	dest->height = max[1] - min[1];
+	dest->depth = max[2] - min[2];
+}
+
+///
+//Builds the node of the bounding volume hierarchy of a compound collider holding a range of pieces, then the nodes below it
+//
+//Parameters:
+//	collider: A pointer to the compound collider to build the hierarchy of
+//	pieces: An array of the indices of the pieces, reordered as the hierarchy is built
+//	numPieces: The number of pieces in the range
+static void CompoundCollider_BuildNode(struct ColliderData_Compound* collider, unsigned int* pieces, unsigned int numPieces)
+{
+	const float (*bounds)[4] = (const float (*)[4])collider->bounds->data;
+
+	//Find the bounds of the pieces & of their centers
+	float min[3], max[3], centerMin[3], centerMax[3];
+	for(unsigned int i = 0; i < numPieces; i++)
+	{
+		const float* sphere = bounds[pieces[i]];
+		for(int j = 0; j < 3; j++)
+		{
+			if(i == 0 || sphere[j] - sphere[3] < min[j]) min[j] = sphere[j] - sphere[3];
+			if(i == 0 || sphere[j] + sphere[3] > max[j]) max[j] = sphere[j] + sphere[3];
+			if(i == 0 || sphere[j] < centerMin[j]) centerMin[j] = sphere[j];
+			if(i == 0 || sphere[j] > centerMax[j]) centerMax[j] = sphere[j];
+		}
+	}
+
+	//Bound the spheres of the pieces by a sphere around the middle of them
+	CompoundCollider_Node node;
+	node.radius = 0.0f;
+	for(int i = 0; i < 3; i++)
+	{
+		node.center[i] = (min[i] + max[i]) / 2.0f;
+	}
+	for(unsigned int i = 0; i < numPieces; i++)
+	{
+		float offset[3];
+		Vector_SubtractArray(offset, bounds[pieces[i]], node.center, 3);
+		float reach = Vector_GetMagFromArray(offset, 3) + bounds[pieces[i]][3];
+		if(reach > node.radius) node.radius = reach;
+	}
+
+	node.piece = numPieces == 1 ? pieces[0] : UINT_MAX;
+	node.secondChild = 0;
+
+	unsigned int index = collider->nodes->size;
+	DynamicArray_Append(collider->nodes, &node);
+	if(numPieces == 1) return;
+
+	//Split the pieces in half along the axis their centers are most spread out along
+	int axis = 0;
+	for(int i = 1; i < 3; i++)
+	{
+		if(centerMax[i] - centerMin[i] > centerMax[axis] - centerMin[axis]) axis = i;
+	}
+
+	//There are never many pieces, so an insertion sort will do
+	for(unsigned int i = 1; i < numPieces; i++)
+	{
+		unsigned int piece = pieces[i];
+		unsigned int j = i;
+		for(; j > 0 && bounds[pieces[j - 1]][axis] > bounds[piece][axis]; j--)
+		{
+			pieces[j] = pieces[j - 1];
+		}
+		pieces[j] = piece;
+	}
+
+	unsigned int numFirst = numPieces / 2;
+	CompoundCollider_BuildNode(collider, pieces, numFirst);
+	((CompoundCollider_Node*)DynamicArray_Index(collider->nodes, index))->secondChild = collider->nodes->size;
+	CompoundCollider_BuildNode(collider, pieces + numFirst, numPieces - numFirst);
+}
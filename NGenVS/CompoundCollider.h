@@ -0,0 +1,144 @@
+#ifndef COMPOUNDCOLLIDER_H
+#define COMPOUNDCOLLIDER_H
+
+#include "DynamicArray.h"
+
+#include "FrameOfReference.h"
+#include "Mesh.h"
+
+#include "AABBCollider.h"
+
+//Forward declaration of Collider to avoid circular dependency
+typedef struct Collider Collider;
+enum ColliderType;
+
+
+//Pointer to the static Collider_Initialize function
+static void(*CompoundCollider_ColliderInitializePtr)(struct Collider*, ColliderType, Mesh*);
+///
+//Setter for the static Collider_Initialize function
+//
+//Parameters:
+//	funcPtr: Collider_Initialize function pointer
+void CompoundCollider_SetColliderInitializer(void(*funcPtr)(struct Collider*, ColliderType, Mesh*));
+
+
+//The most pieces a compound collider may have, so the pieces near an object always fit in a fixed array on the stack
+#define CompoundCollider_MAX_PIECES 64
+
+//A node of the bounding volume hierarchy over the pieces of a compound collider.
+//Nodes are stored depth first, so the first child of a node always follows it.
+typedef struct CompoundCollider_Node
+{
+	float center[3];				//Center of the bounding sphere of the node in the model space of the collider
+	float radius;					//Radius of the bounding sphere of the node
+	unsigned int piece;				//Index of the piece of a leaf, UINT_MAX for nodes with children
+	unsigned int secondChild;		//Index of the second child of a node with children
+} CompoundCollider_Node;
+
+struct ColliderData_Compound
+{
+	DynamicArray* pieces;			//Pointers to the convex hull colliders which make up the compound collider, all in the model space of the compound collider
+	DynamicArray* bounds;			//Bounding sphere of each piece in model space, stored as 4 floats holding the center then the radius
+	DynamicArray* nodes;			//CompoundCollider_Nodes of the bounding volume hierarchy over the pieces stored by value, the root first
+};
+
+///
+//Builds the node of the bounding volume hierarchy of a compound collider holding a range of pieces, then the nodes below it
+//
+//Parameters:
+//	collider: A pointer to the compound collider to build the hierarchy of
+//	pieces: An array of the indices of the pieces, reordered as the hierarchy is built
+//	numPieces: The number of pieces in the range
+static void CompoundCollider_BuildNode(struct ColliderData_Compound* collider, unsigned int* pieces, unsigned int numPieces);
+
+///
+//Allocates memory for a new compound collider data set
+//
+//Returns:
+//	Pointer to a newly allocated compound collider data set
+struct ColliderData_Compound* CompoundCollider_AllocateData();
+
+///
+//Initializes a compound collider data set without any pieces
+//
+//Parameters:
+//	compoundData: The compound collider data set being initialized
+void CompoundCollider_InitializeData(struct ColliderData_Compound* compoundData);
+
+///
+//Initializes a compound collider without any pieces
+//
+//Parameters:
+//	collider: The collider being initialized
+void CompoundCollider_Initialize(Collider* collider);
+
+///
+//Frees a compound collider data set along with each of it's pieces
+//
+//Parameters:
+//	colliderData: A pointer to the compound collider data to free
+void CompoundCollider_FreeData(struct ColliderData_Compound* colliderData);
+
+///
+//Adds a piece to a compound collider & rebuilds it's bounding volume hierarchy.
+//The compound collider takes ownership of the piece & frees it along with itself.
+//
+//Parameters:
+//	collider: A pointer to the compound collider to add the piece to
+//	piece: A pointer to an initialized convex hull collider with at least one point, in the model space of the compound collider
+//
+//Returns:
+//	0 if the compound collider already has CompoundCollider_MAX_PIECES pieces & the piece was not added, else 1
+unsigned char CompoundCollider_AddPiece(struct ColliderData_Compound* collider, Collider* piece);
+
+///
+//Makes a compound collider which approximates a concave mesh from a blank initialized compound collider.
+//The mesh is split into nearly convex parts by ConvexDecomposition, then each part is wrapped in a convex hull.
+//
+//Parameters:
+//	collider: A pointer to a compound collider with no current pieces
+//	mesh: A pointer to the mesh to approximate, in the model space of the collider
+//	maxPieces: The most pieces the collider may have, at most CompoundCollider_MAX_PIECES
+//	maxPoints: The most points each piece may have, at least 4
+//
+//Returns:
+//	0 if the mesh does not enclose a volume & the collider was left blank, else 1
+unsigned char CompoundCollider_MakeMeshCollider(struct ColliderData_Compound* collider, const Mesh* mesh, unsigned int maxPieces, unsigned int maxPoints);
+
+///
+//Gets the world space bounding sphere of a compound collider
+//
+//Parameters:
+//	center: An array of 3 floats to store the world space center of the sphere in
+//	radius: A pointer to a float to store the radius of the sphere in
+//	collider: A pointer to the compound collider, must have at least one piece
+//	frame: The frame of reference with which to orient the collider
+void CompoundCollider_GetWorldBoundingSphere(float* center, float* radius, const struct ColliderData_Compound* collider, const FrameOfReference* frame);
+
+///
+//Finds the pieces of a compound collider whose bounding spheres overlap a world space sphere,
+//climbing down the bounding volume hierarchy so whole groups of distant pieces are skipped at once.
+//
+//Parameters:
+//	dest: An array with room for every piece of the collider to store the indices of the overlapping pieces in
+//	collider: A pointer to the compound collider
+//	frame: The frame of reference with which to orient the collider
+//	center: An array of 3 floats containing the world space center of the sphere
+//	radius: The radius of the sphere
+//
+//Returns:
+//	The number of overlapping pieces
+unsigned int CompoundCollider_QuerySphere(unsigned int* dest, const struct ColliderData_Compound* collider, const FrameOfReference* frame, const float* center, float radius);
+
+///
+//Generates the minimum AABB which contains every piece of a compound collider oriented by a frame of reference.
+//As with ConvexHullCollider_GenerateMinimumAABB, the AABB is rotated but not yet scaled.
+//
+//Parameters:
+//	dest: A pointer to the AABB collider data to store the AABB in, the centroid must be initialized
+//	collider: A pointer to the compound collider, must have at least one piece
+//	frame: The frame of reference with which to orient the collider
+void CompoundCollider_GenerateMinimumAABB(ColliderData_AABB* dest, const struct ColliderData_Compound* collider, const FrameOfReference* frame);
+
+#endif
@@ -0,0 +1,574 @@
+#include "ConvexDecomposition.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "Vector.h"
+
+///
+//Allocates memory for a new decomposition
+//
+//Returns:
+//	A pointer to a newly allocated decomposition
+ConvexDecomposition* ConvexDecomposition_Allocate(void)
+{
+	ConvexDecomposition* decomposition = (ConvexDecomposition*)malloc(sizeof(ConvexDecomposition));
+	return decomposition;
+}
+
+///
+//Initializes a decomposition without any parts
+//
+//Parameters:
+//	decomposition: A pointer to the decomposition to initialize
+void ConvexDecomposition_Initialize(ConvexDecomposition* decomposition)
+{
+	//The voxel grid is allocated once the size of the mesh is known
+	decomposition->voxelSize = 0.0f;
+	decomposition->dimensions[0] = decomposition->dimensions[1] = decomposition->dimensions[2] = 0;
+	decomposition->states = NULL;
+	decomposition->owners = NULL;
+	decomposition->corners = NULL;
+	decomposition->stamp = 0;
+
+	decomposition->parts = DynamicArray_Allocate();
+	DynamicArray_Initialize(decomposition->parts, sizeof(ConvexDecomposition_Part));
+
+	decomposition->hull = QuickHull_Allocate();
+	QuickHull_Initialize(decomposition->hull);
+
+	decomposition->points = DynamicArray_Allocate();
+	DynamicArray_Initialize(decomposition->points, sizeof(float) * 3);
+}
+
+///
+//Frees a decomposition
+//
+//Parameters:
+//	decomposition: A pointer to the decomposition to free
+void ConvexDecomposition_Free(ConvexDecomposition* decomposition)
+{
+	ConvexDecomposition_Part* parts = (ConvexDecomposition_Part*)decomposition->parts->data;
+	for(unsigned int i = 0; i < decomposition->parts->size; i++)
+	{
+		DynamicArray_Free(parts[i].voxels);
+		free(parts[i].points);
+	}
+	DynamicArray_Free(decomposition->parts);
+
+	QuickHull_Free(decomposition->hull);
+	DynamicArray_Free(decomposition->points);
+
+	free(decomposition->states);
+	free(decomposition->owners);
+	free(decomposition->corners);
+
+	free(decomposition);
+}
+
+///
+//Splits a mesh into nearly convex parts.
+//The part leaving the most of it's convex hull empty is split until every part is convex enough or there are as many parts as allowed.
+//Open meshes are handled, only the space which can't be reached from outside of the mesh is solid.
+//
+//Parameters:
+//	decomposition: A pointer to an initialized decomposition to split the mesh into
+//	mesh: A pointer to the mesh to split
+//	maxParts: The most parts the mesh may be split into
+//	resolution: Number of voxels along the longest axis of the mesh, finer grids give tighter parts
+//	maxConcavity: Fraction of the convex hull of the whole mesh a part may leave empty
+//
+//Returns:
+//	0 if the mesh has no volume & could not be split, else 1
+unsigned char ConvexDecomposition_Decompose(ConvexDecomposition* decomposition, const Mesh* mesh, unsigned int maxParts, unsigned int resolution, float maxConcavity)
+{
+	if(maxParts == 0 || !ConvexDecomposition_Voxelize(decomposition, mesh, resolution)) return 0;
+	ConvexDecomposition_FindOutside(decomposition);
+
+	//Every solid voxel starts out in a single part
+	ConvexDecomposition_Part whole;
+	whole.voxels = DynamicArray_Allocate();
+	DynamicArray_Initialize(whole.voxels, sizeof(unsigned int));
+	whole.points = NULL;
+	whole.numPoints = 0;
+
+	unsigned int numVoxels = decomposition->dimensions[0] * decomposition->dimensions[1] * decomposition->dimensions[2];
+	for(unsigned int i = 0; i < numVoxels; i++)
+	{
+		if(decomposition->states[i] != VOXELSTATE_OUTSIDE)
+		{
+			decomposition->owners[i] = 0;
+			DynamicArray_Append(whole.voxels, &i);
+		}
+	}
+	DynamicArray_Append(decomposition->parts, &whole);
+
+	//Measure the whole mesh so concavity means the same thing for any size of model
+	((ConvexDecomposition_Part*)decomposition->parts->data)->concavity = ConvexDecomposition_MeasureConcavity(decomposition, 0, 0, 0, 1);
+	float wholeVolume = QuickHull_ComputeVolume(decomposition->hull);
+	if(wholeVolume <= 0.0f) return 0;
+
+	while(decomposition->parts->size < maxParts)
+	{
+		//Find the part leaving the most of it's hull empty
+		ConvexDecomposition_Part* parts = (ConvexDecomposition_Part*)decomposition->parts->data;
+		unsigned int worst = 0;
+		for(unsigned int i = 1; i < decomposition->parts->size; i++)
+		{
+			if(parts[i].concavity > parts[worst].concavity) worst = i;
+		}
+
+		if(parts[worst].concavity <= maxConcavity * wholeVolume) break;
+
+		//A part which can't be split has to stay as concave as it is
+		if(!ConvexDecomposition_SplitPart(decomposition, worst))
+		{
+			parts[worst].concavity = 0.0f;
+		}
+	}
+
+	//Hand out the corners of each part, kept within the bounds of the mesh so parts don't stick out past it
+	ConvexDecomposition_Part* parts = (ConvexDecomposition_Part*)decomposition->parts->data;
+	for(unsigned int i = 0; i < decomposition->parts->size; i++)
+	{
+		unsigned int numSurfaceVoxels;
+		ConvexDecomposition_GatherPoints(decomposition, i, 0, 0, 1, &numSurfaceVoxels);
+
+		parts[i].numPoints = decomposition->points->size;
+		parts[i].points = (float*)malloc(sizeof(float) * 3 * parts[i].numPoints);
+		memcpy(parts[i].points, decomposition->points->data, sizeof(float) * 3 * parts[i].numPoints);
+
+		for(unsigned int j = 0; j < 3 * parts[i].numPoints; j++)
+		{
+			if(parts[i].points[j] < decomposition->meshMin[j % 3]) parts[i].points[j] = decomposition->meshMin[j % 3];
+			else if(parts[i].points[j] > decomposition->meshMax[j % 3]) parts[i].points[j] = decomposition->meshMax[j % 3];
+		}
+	}
+
+	return 1;
+}
+
+///
+//Marks every voxel touched by a triangle of a mesh as surface
+//
+//Parameters:
+//	decomposition: A pointer to the decomposition to voxelize the mesh into
+//	mesh: A pointer to the mesh to voxelize
+//	resolution: Number of voxels along the longest axis of the mesh
+//
+//Returns:
+//	0 if the mesh has no extent, else 1
+static unsigned char ConvexDecomposition_Voxelize(ConvexDecomposition* decomposition, const Mesh* mesh, unsigned int resolution)
+{
+	if(mesh->numTriangles == 0 || resolution == 0) return 0;
+
+	//Find the bounds of the mesh
+	for(int i = 0; i < 3; i++)
+	{
+		decomposition->meshMin[i] = decomposition->meshMax[i] = (&mesh->triangles[0].a.x)[i];
+	}
+	for(unsigned int i = 0; i < mesh->numTriangles; i++)
+	{
+		const struct Vertex* corners[3] = { &mesh->triangles[i].a, &mesh->triangles[i].b, &mesh->triangles[i].c };
+		for(int j = 0; j < 3; j++)
+		{
+			const float* position = &corners[j]->x;
+			for(int k = 0; k < 3; k++)
+			{
+				if(position[k] < decomposition->meshMin[k]) decomposition->meshMin[k] = position[k];
+				if(position[k] > decomposition->meshMax[k]) decomposition->meshMax[k] = position[k];
+			}
+		}
+	}
+
+	float longest = 0.0f;
+	for(int i = 0; i < 3; i++)
+	{
+		if(decomposition->meshMax[i] - decomposition->meshMin[i] > longest) longest = decomposition->meshMax[i] - decomposition->meshMin[i];
+	}
+	if(longest <= 0.0f) return 0;
+
+	//Voxels are cubes, with a layer of padding around the mesh so the outside is connected.
+	//The bounds of the mesh run through the middle of the outermost voxels, so faces lying on the bounds never fall between two voxels.
+	decomposition->voxelSize = longest / resolution;
+	for(int i = 0; i < 3; i++)
+	{
+		unsigned int voxels = (unsigned int)ceilf((decomposition->meshMax[i] - decomposition->meshMin[i]) / decomposition->voxelSize) + 1;
+		decomposition->dimensions[i] = voxels + 2;
+		decomposition->origin[i] = decomposition->meshMin[i] - 1.5f * decomposition->voxelSize;
+	}
+
+	unsigned int numVoxels = decomposition->dimensions[0] * decomposition->dimensions[1] * decomposition->dimensions[2];
+	decomposition->states = (unsigned char*)calloc(numVoxels, sizeof(unsigned char));
+	decomposition->owners = (unsigned int*)malloc(sizeof(unsigned int) * numVoxels);
+	for(unsigned int i = 0; i < numVoxels; i++)
+	{
+		decomposition->owners[i] = UINT_MAX;
+	}
+
+	unsigned int numCorners = (decomposition->dimensions[0] + 1) * (decomposition->dimensions[1] + 1) * (decomposition->dimensions[2] + 1);
+	decomposition->corners = (unsigned int*)calloc(numCorners, sizeof(unsigned int));
+	decomposition->stamp = 0;
+
+	float halfSize = decomposition->voxelSize / 2.0f;
+	for(unsigned int i = 0; i < mesh->numTriangles; i++)
+	{
+		const float* a = &mesh->triangles[i].a.x;
+		const float* b = &mesh->triangles[i].b.x;
+		const float* c = &mesh->triangles[i].c.x;
+
+		//Only the voxels within the bounds of the triangle can touch it.
+		//The padding is never touched, even by triangles lying on the bounds of the mesh.
+		unsigned int first[3], last[3];
+		for(int j = 0; j < 3; j++)
+		{
+			float min = fminf(a[j], fminf(b[j], c[j])) - decomposition->origin[j];
+			float max = fmaxf(a[j], fmaxf(b[j], c[j])) - decomposition->origin[j];
+			first[j] = (unsigned int)(min / decomposition->voxelSize);
+			last[j] = (unsigned int)(max / decomposition->voxelSize);
+			if(first[j] < 1) first[j] = 1;
+			if(last[j] > decomposition->dimensions[j] - 2) last[j] = decomposition->dimensions[j] - 2;
+		}
+
+		for(unsigned int z = first[2]; z <= last[2]; z++)
+		{
+			for(unsigned int y = first[1]; y <= last[1]; y++)
+			{
+				for(unsigned int x = first[0]; x <= last[0]; x++)
+				{
+					unsigned int index = x + decomposition->dimensions[0] * (y + decomposition->dimensions[1] * z);
+					if(decomposition->states[index] == VOXELSTATE_SURFACE) continue;
+
+					float center[3] =
+					{
+						decomposition->origin[0] + (x + 0.5f) * decomposition->voxelSize,
+						decomposition->origin[1] + (y + 0.5f) * decomposition->voxelSize,
+						decomposition->origin[2] + (z + 0.5f) * decomposition->voxelSize
+					};
+					if(ConvexDecomposition_TriangleOverlapsCube(a, b, c, center, halfSize))
+					{
+						decomposition->states[index] = VOXELSTATE_SURFACE;
+					}
+				}
+			}
+		}
+	}
+
+	return 1;
+}
+
+///
+//Determines if a triangle overlaps an axis aligned cube
+//
+//Parameters:
+//	a: An array of 3 floats containing the first corner of the triangle
+//	b: An array of 3 floats containing the second corner of the triangle
+//	c: An array of 3 floats containing the third corner of the triangle
+//	center: An array of 3 floats containing the center of the cube
+//	halfSize: Half of the side length of the cube
+//
+//Returns:
+//	1 if the triangle overlaps the cube, else 0
+static unsigned char ConvexDecomposition_TriangleOverlapsCube(const float* a, const float* b, const float* c, const float* center, float halfSize)
+{
+	//Move the triangle so the cube is centered on the origin
+	float corners[3][3];
+	Vector_SubtractArray(corners[0], a, center, 3);
+	Vector_SubtractArray(corners[1], b, center, 3);
+	Vector_SubtractArray(corners[2], c, center, 3);
+
+	float edges[3][3];
+	for(int i = 0; i < 3; i++)
+	{
+		Vector_SubtractArray(edges[i], corners[(i + 1) % 3], corners[i], 3);
+	}
+
+	//The axes of the cube itself
+	for(int i = 0; i < 3; i++)
+	{
+		float axis[3] = { 0.0f, 0.0f, 0.0f };
+		axis[i] = 1.0f;
+		if(ConvexDecomposition_IsSeparatingAxis(axis, corners, halfSize)) return 0;
+	}
+
+	//Crosses of each edge of the triangle with each axis of the cube, written out since one component of the axis is always 0
+	for(int i = 0; i < 3; i++)
+	{
+		float axes[3][3] =
+		{
+			{ 0.0f, edges[i][2], -edges[i][1] },
+			{ -edges[i][2], 0.0f, edges[i][0] },
+			{ edges[i][1], -edges[i][0], 0.0f }
+		};
+		for(int j = 0; j < 3; j++)
+		{
+			if(ConvexDecomposition_IsSeparatingAxis(axes[j], corners, halfSize)) return 0;
+		}
+	}
+
+	//The normal of the triangle
+	float normal[3] =
+	{
+		edges[0][1] * edges[1][2] - edges[0][2] * edges[1][1],
+		edges[0][2] * edges[1][0] - edges[0][0] * edges[1][2],
+		edges[0][0] * edges[1][1] - edges[0][1] * edges[1][0]
+	};
+	return !ConvexDecomposition_IsSeparatingAxis(normal, corners, halfSize);
+}
+
+///
+//Determines if an axis separates a triangle from an axis aligned cube centered on the origin
+//
+//Parameters:
+//	axis: An array of 3 floats containing the axis, need not be normalized
+//	corners: The corners of the triangle relative to the center of the cube
+//	halfSize: Half of the side length of the cube
+//
+//Returns:
+//	1 if the axis separates the triangle & the cube, else 0
+static unsigned char ConvexDecomposition_IsSeparatingAxis(const float* axis, const float (*corners)[3], float halfSize)
+{
+	float min = Vector_DotProductArray(axis, corners[0], 3);
+	float max = min;
+	for(int i = 1; i < 3; i++)
+	{
+		float projection = Vector_DotProductArray(axis, corners[i], 3);
+		if(projection < min) min = projection;
+		if(projection > max) max = projection;
+	}
+
+	//Half of the extent of the cube along the axis
+	float radius = halfSize * (fabsf(axis[0]) + fabsf(axis[1]) + fabsf(axis[2]));
+	return min > radius || max < -radius;
+}
+
+///
+//Marks every voxel which can be reached from the padding of the grid without crossing the surface as outside
+//
+//Parameters:
+//	decomposition: A pointer to the voxelized decomposition
+static void ConvexDecomposition_FindOutside(ConvexDecomposition* decomposition)
+{
+	const unsigned int* dimensions = decomposition->dimensions;
+	unsigned int strides[3] = { 1, dimensions[0], dimensions[0] * dimensions[1] };
+
+	DynamicArray* stack = DynamicArray_Allocate();
+	DynamicArray_Initialize(stack, sizeof(unsigned int));
+
+	//The first voxel is padding, so it is always outside
+	unsigned int index = 0;
+	decomposition->states[index] = VOXELSTATE_OUTSIDE;
+	DynamicArray_Append(stack, &index);
+
+	while(stack->size > 0)
+	{
+		index = *(unsigned int*)DynamicArray_Index(stack, stack->size - 1);
+		stack->size--;
+
+		unsigned int coordinates[3] = { index % dimensions[0], (index / dimensions[0]) % dimensions[1], index / strides[2] };
+		for(int i = 0; i < 3; i++)
+		{
+			//Step to the neighbour on either side along the axis which is within the grid
+			for(int side = 0; side < 2; side++)
+			{
+				if(side == 0 ? coordinates[i] == 0 : coordinates[i] + 1 == dimensions[i]) continue;
+
+				unsigned int neighbour = side == 0 ? index - strides[i] : index + strides[i];
+				if(decomposition->states[neighbour] == VOXELSTATE_UNKNOWN)
+				{
+					decomposition->states[neighbour] = VOXELSTATE_OUTSIDE;
+					DynamicArray_Append(stack, &neighbour);
+				}
+			}
+		}
+	}
+
+	DynamicArray_Free(stack);
+}
+
+///
+//Gathers the corners of the voxels on the surface of one side of a part, each corner is gathered once
+//
+//Parameters:
+//	decomposition: A pointer to the decomposition
+//	part: Index of the part
+//	axis: Axis the part is split along
+//	split: Voxel coordinate along the axis the upper side starts at
+//	upper: 1 to gather the side at or above the split, 0 to gather the side below it
+//	numSurfaceVoxels: A pointer to store the number of voxels on the surface of the side in
+//
+//Returns:
+//	The number of voxels on the side of the part, the corners are left in decomposition->points
+static unsigned int ConvexDecomposition_GatherPoints(ConvexDecomposition* decomposition, unsigned int part, unsigned int axis, unsigned int split, unsigned char upper, unsigned int* numSurfaceVoxels)
+{
+	const unsigned int* dimensions = decomposition->dimensions;
+	unsigned int strides[3] = { 1, dimensions[0], dimensions[0] * dimensions[1] };
+	const DynamicArray* voxels = ((ConvexDecomposition_Part*)DynamicArray_Index(decomposition->parts, part))->voxels;
+
+	DynamicArray_Clear(decomposition->points);
+	decomposition->stamp++;
+
+	unsigned int numVoxels = 0;
+	*numSurfaceVoxels = 0;
+	for(unsigned int i = 0; i < voxels->size; i++)
+	{
+		unsigned int index = ((unsigned int*)voxels->data)[i];
+		unsigned int coordinates[3] = { index % dimensions[0], (index / dimensions[0]) % dimensions[1], index / strides[2] };
+		if((coordinates[axis] >= split) != (upper != 0)) continue;
+		numVoxels++;
+
+		//Voxels buried within the side can't be corners of it's hull. The padding keeps every solid voxel off the edge of the grid.
+		unsigned char buried = 1;
+		for(int j = 0; j < 3 && buried; j++)
+		{
+			unsigned int below = index - strides[j];
+			unsigned int above = index + strides[j];
+			buried = decomposition->owners[below] == part && decomposition->owners[above] == part;
+			if(j == (int)axis) buried = buried && (coordinates[j] - 1 >= split) == (upper != 0) && (coordinates[j] + 1 >= split) == (upper != 0);
+		}
+		if(buried) continue;
+		(*numSurfaceVoxels)++;
+
+		for(int corner = 0; corner < 8; corner++)
+		{
+			unsigned int x = coordinates[0] + (corner & 1);
+			unsigned int y = coordinates[1] + ((corner >> 1) & 1);
+			unsigned int z = coordinates[2] + ((corner >> 2) & 1);
+
+			unsigned int cornerIndex = x + (dimensions[0] + 1) * (y + (dimensions[1] + 1) * z);
+			if(decomposition->corners[cornerIndex] == decomposition->stamp) continue;
+			decomposition->corners[cornerIndex] = decomposition->stamp;
+
+			float point[3] =
+			{
+				decomposition->origin[0] + x * decomposition->voxelSize,
+				decomposition->origin[1] + y * decomposition->voxelSize,
+				decomposition->origin[2] + z * decomposition->voxelSize
+			};
+			DynamicArray_Append(decomposition->points, point);
+		}
+	}
+
+	return numVoxels;
+}
+
+///
+//Measures the volume of the convex hull of one side of a part which the side does not fill
+//
+//Parameters:
+//	decomposition: A pointer to the decomposition
+//	part: Index of the part
+//	axis: Axis the part is split along
+//	split: Voxel coordinate along the axis the upper side starts at
+//	upper: 1 to measure the side at or above the split, 0 to measure the side below it
+//
+//Returns:
+//	The empty volume of the hull of the side
+static float ConvexDecomposition_MeasureConcavity(ConvexDecomposition* decomposition, unsigned int part, unsigned int axis, unsigned int split, unsigned char upper)
+{
+	unsigned int numSurfaceVoxels;
+	unsigned int numVoxels = ConvexDecomposition_GatherPoints(decomposition, part, axis, split, upper, &numSurfaceVoxels);
+
+	//Corners of whole voxels always span a volume, unless there are none
+	if(!QuickHull_Build(decomposition->hull, (float*)decomposition->points->data, decomposition->points->size, UINT_MAX)) return 0.0f;
+
+	//The hull bridges the steps between voxels on any surface which isn't lined up with the grid,
+	//so up to half of a voxel around each surface voxel is allowed to be empty even in a convex part
+	float voxelVolume = decomposition->voxelSize * decomposition->voxelSize * decomposition->voxelSize;
+	float concavity = QuickHull_ComputeVolume(decomposition->hull) - (numVoxels + 0.5f * numSurfaceVoxels) * voxelVolume;
+	return concavity > 0.0f ? concavity : 0.0f;
+}
+
+///
+//Splits a part in two along the axis aligned plane which leaves the two halves most convex
+//
+//Parameters:
+//	decomposition: A pointer to the decomposition
+//	part: Index of the part to split
+//
+//Returns:
+//	0 if the part is a single voxel which can't be split, else 1
+static unsigned char ConvexDecomposition_SplitPart(ConvexDecomposition* decomposition, unsigned int part)
+{
+	const unsigned int* dimensions = decomposition->dimensions;
+	DynamicArray* voxels = ((ConvexDecomposition_Part*)DynamicArray_Index(decomposition->parts, part))->voxels;
+
+	//Find the voxel bounds of the part
+	unsigned int min[3] = { UINT_MAX, UINT_MAX, UINT_MAX };
+	unsigned int max[3] = { 0, 0, 0 };
+	for(unsigned int i = 0; i < voxels->size; i++)
+	{
+		unsigned int index = ((unsigned int*)voxels->data)[i];
+		unsigned int coordinates[3] = { index % dimensions[0], (index / dimensions[0]) % dimensions[1], index / (dimensions[0] * dimensions[1]) };
+		for(int j = 0; j < 3; j++)
+		{
+			if(coordinates[j] < min[j]) min[j] = coordinates[j];
+			if(coordinates[j] > max[j]) max[j] = coordinates[j];
+		}
+	}
+
+	//Try evenly spaced planes along every axis the part spans more than one voxel along
+	unsigned int bestAxis = 0;
+	unsigned int bestSplit = 0;
+	float bestConcavity[2] = { 0.0f, 0.0f };
+	unsigned char found = 0;
+	for(unsigned int axis = 0; axis < 3; axis++)
+	{
+		unsigned int lastSplit = 0;
+		for(unsigned int i = 1; i <= ConvexDecomposition_SPLITS_PER_AXIS; i++)
+		{
+			//Splits lie between the first & last layer of the part, so neither half is empty
+			unsigned int split = min[axis] + 1 + (max[axis] - min[axis]) * i / (ConvexDecomposition_SPLITS_PER_AXIS + 1);
+			if(split > max[axis] || split == lastSplit) continue;
+			lastSplit = split;
+
+			float concavity[2] =
+			{
+				ConvexDecomposition_MeasureConcavity(decomposition, part, axis, split, 0),
+				ConvexDecomposition_MeasureConcavity(decomposition, part, axis, split, 1)
+			};
+			if(!found || concavity[0] + concavity[1] < bestConcavity[0] + bestConcavity[1])
+			{
+				bestAxis = axis;
+				bestSplit = split;
+				bestConcavity[0] = concavity[0];
+				bestConcavity[1] = concavity[1];
+				found = 1;
+			}
+		}
+	}
+
+	if(!found) return 0;
+
+	//Move the upper side into a new part
+	ConvexDecomposition_Part upper;
+	upper.voxels = DynamicArray_Allocate();
+	DynamicArray_Initialize(upper.voxels, sizeof(unsigned int));
+	upper.concavity = bestConcavity[1];
+	upper.points = NULL;
+	upper.numPoints = 0;
+
+	unsigned int upperPart = decomposition->parts->size;
+	unsigned int numLower = 0;
+	for(unsigned int i = 0; i < voxels->size; i++)
+	{
+		unsigned int index = ((unsigned int*)voxels->data)[i];
+		unsigned int coordinate = bestAxis == 0 ? index % dimensions[0] : bestAxis == 1 ? (index / dimensions[0]) % dimensions[1] : index / (dimensions[0] * dimensions[1]);
+		if(coordinate >= bestSplit)
+		{
+			decomposition->owners[index] = upperPart;
+			DynamicArray_Append(upper.voxels, &index);
+		}
+		else
+		{
+			((unsigned int*)voxels->data)[numLower++] = index;
+		}
+	}
+	voxels->size = numLower;
+	((ConvexDecomposition_Part*)DynamicArray_Index(decomposition->parts, part))->concavity = bestConcavity[0];
+
+	DynamicArray_Append(decomposition->parts, &upper);
+	return 1;
+}
@@ -0,0 +1,183 @@
+#ifndef CONVEXDECOMPOSITION_H
+#define CONVEXDECOMPOSITION_H
+
+#include "DynamicArray.h"
+#include "Mesh.h"
+#include "QuickHull.h"
+
+//Number of voxels a mesh is split into along it's longest axis by default
+#define ConvexDecomposition_RESOLUTION 32
+//Parts are split until the hull of every part leaves less than this fraction of the hull of the whole mesh empty by default
+#define ConvexDecomposition_MAX_CONCAVITY 0.05f
+//Number of split planes tried along each axis when splitting a part
+#define ConvexDecomposition_SPLITS_PER_AXIS 7
+
+//What is known about a voxel of the mesh
+enum VoxelState
+{
+	VOXELSTATE_UNKNOWN,		//Not touched by the mesh, inside of the mesh once every voxel outside has been found
+	VOXELSTATE_SURFACE,		//Touched by a triangle of the mesh
+	VOXELSTATE_OUTSIDE		//Reachable from outside of the mesh without crossing it's surface
+};
+
+//A nearly convex part of a decomposed mesh
+typedef struct ConvexDecomposition_Part
+{
+	DynamicArray* voxels;			//Indices of the solid voxels making up the part
+	float concavity;				//Volume of the convex hull of the part which the part does not fill
+	float* points;					//Corners of the voxels on the surface of the part in model space, each three consecutive floats form a point. NULL until the decomposition is done.
+	unsigned int numPoints;			//Number of points
+} ConvexDecomposition_Part;
+
+//An approximate convex decomposition of a mesh.
+//The mesh is voxelized, then the solid voxels are split by axis aligned planes until every part fills most of it's convex hull.
+typedef struct ConvexDecomposition
+{
+	float origin[3];				//Model space position of the minimum corner of the voxel grid
+	float voxelSize;				//Side length of each voxel
+	unsigned int dimensions[3];		//Number of voxels along each axis, including a layer of padding on each side
+	unsigned char* states;			//VoxelState of each voxel, indexed X first then Y then Z
+	unsigned int* owners;			//Index of the part each solid voxel belongs to, UINT_MAX for voxels outside of the mesh
+
+	float meshMin[3];				//Model space minimum of the mesh along each axis
+	float meshMax[3];				//Model space maximum of the mesh along each axis
+
+	DynamicArray* parts;			//ConvexDecomposition_Parts the mesh has been split into stored by value
+
+	QuickHull* hull;				//Hull used to measure parts
+	DynamicArray* points;			//Points of the part being measured, 3 floats per element
+	unsigned int* corners;			//Stamp of the last gathering of points each corner of the voxel grid was added in, so each corner is only added once
+	unsigned int stamp;				//Stamp of the current gathering of points
+} ConvexDecomposition;
+
+///
+//Internals
+///
+
+///
+//Marks every voxel touched by a triangle of a mesh as surface
+//
+//Parameters:
+//	decomposition: A pointer to the decomposition to voxelize the mesh into
+//	mesh: A pointer to the mesh to voxelize
+//	resolution: Number of voxels along the longest axis of the mesh
+//
+//Returns:
+//	0 if the mesh has no extent, else 1
+static unsigned char ConvexDecomposition_Voxelize(ConvexDecomposition* decomposition, const Mesh* mesh, unsigned int resolution);
+
+///
+//Determines if a triangle overlaps an axis aligned cube
+//
+//Parameters:
+//	a: An array of 3 floats containing the first corner of the triangle
+//	b: An array of 3 floats containing the second corner of the triangle
+//	c: An array of 3 floats containing the third corner of the triangle
+//	center: An array of 3 floats containing the center of the cube
+//	halfSize: Half of the side length of the cube
+//
+//Returns:
+//	1 if the triangle overlaps the cube, else 0
+static unsigned char ConvexDecomposition_TriangleOverlapsCube(const float* a, const float* b, const float* c, const float* center, float halfSize);
+
+///
+//Determines if an axis separates a triangle from an axis aligned cube centered on the origin
+//
+//Parameters:
+//	axis: An array of 3 floats containing the axis, need not be normalized
+//	corners: The corners of the triangle relative to the center of the cube
+//	halfSize: Half of the side length of the cube
+//
+//Returns:
+//	1 if the axis separates the triangle & the cube, else 0
+static unsigned char ConvexDecomposition_IsSeparatingAxis(const float* axis, const float (*corners)[3], float halfSize);
+
+///
+//Marks every voxel which can be reached from the padding of the grid without crossing the surface as outside
+//
+//Parameters:
+//	decomposition: A pointer to the voxelized decomposition
+static void ConvexDecomposition_FindOutside(ConvexDecomposition* decomposition);
+
+///
+//Gathers the corners of the voxels on the surface of one side of a part, each corner is gathered once
+//
+//Parameters:
+//	decomposition: A pointer to the decomposition
+//	part: Index of the part
+//	axis: Axis the part is split along
+//	split: Voxel coordinate along the axis the upper side starts at
+//	upper: 1 to gather the side at or above the split, 0 to gather the side below it
+//	numSurfaceVoxels: A pointer to store the number of voxels on the surface of the side in
+//
+//Returns:
+//	The number of voxels on the side of the part, the corners are left in decomposition->points
+static unsigned int ConvexDecomposition_GatherPoints(ConvexDecomposition* decomposition, unsigned int part, unsigned int axis, unsigned int split, unsigned char upper, unsigned int* numSurfaceVoxels);
+
+///
+//Measures the volume of the convex hull of one side of a part which the side does not fill
+//
+//Parameters:
+//	decomposition: A pointer to the decomposition
+//	part: Index of the part
+//	axis: Axis the part is split along
+//	split: Voxel coordinate along the axis the upper side starts at
+//	upper: 1 to measure the side at or above the split, 0 to measure the side below it
+//
+//Returns:
+//	The empty volume of the hull of the side
+static float ConvexDecomposition_MeasureConcavity(ConvexDecomposition* decomposition, unsigned int part, unsigned int axis, unsigned int split, unsigned char upper);
+
+///
+//Splits a part in two along the axis aligned plane which leaves the two halves most convex
+//
+//Parameters:
+//	decomposition: A pointer to the decomposition
+//	part: Index of the part to split
+//
+//Returns:
+//	0 if the part is a single voxel which can't be split, else 1
+static unsigned char ConvexDecomposition_SplitPart(ConvexDecomposition* decomposition, unsigned int part);
+
+///
+//Functions
+///
+
+///
+//Allocates memory for a new decomposition
+//
+//Returns:
+//	A pointer to a newly allocated decomposition
+ConvexDecomposition* ConvexDecomposition_Allocate(void);
+
+///
+//Initializes a decomposition without any parts
+//
+//Parameters:
+//	decomposition: A pointer to the decomposition to initialize
+void ConvexDecomposition_Initialize(ConvexDecomposition* decomposition);
+
+///
+//Frees a decomposition
+//
+//Parameters:
+//	decomposition: A pointer to the decomposition to free
+void ConvexDecomposition_Free(ConvexDecomposition* decomposition);
+
+///
+//Splits a mesh into nearly convex parts.
+//The part leaving the most of it's convex hull empty is split until every part is convex enough or there are as many parts as allowed.
+//Open meshes are handled, only the space which can't be reached from outside of the mesh is solid.
+//
+//Parameters:
+//	decomposition: A pointer to an initialized decomposition to split the mesh into
+//	mesh: A pointer to the mesh to split
+//	maxParts: The most parts the mesh may be split into
+//	resolution: Number of voxels along the longest axis of the mesh, finer grids give tighter parts
+//	maxConcavity: Fraction of the convex hull of the whole mesh a part may leave empty
+//
+//Returns:
+//	0 if the mesh has no volume & could not be split, else 1
+unsigned char ConvexDecomposition_Decompose(ConvexDecomposition* decomposition, const Mesh* mesh, unsigned int maxParts, unsigned int resolution, float maxConcavity);
+
+#endif
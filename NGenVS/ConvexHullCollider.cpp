@@ -1,8 +1,13 @@
 #include "ConvexHullCollider.h"
 
 #include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <limits.h>
 
 #include "Collider.h"
+#include "QuickHull.h"
+#include "Hash.h"
 
 #include "AssetManager.h"
 
@@ -42,6 +47,19 @@ void ConvexHullCollider_InitializeData(struct ColliderData_ConvexHull* convexHul
 
 	convexHullData->edges = LinkedList_Allocate();
 	LinkedList_Initialize(convexHullData->edges);
+
+	convexHullData->arcs = DynamicArray_Allocate();
+	DynamicArray_Initialize(convexHullData->arcs, sizeof(ConvexHullCollider_Arc));
+
+	convexHullData->neighbours = DynamicArray_Allocate();
+	DynamicArray_Initialize(convexHullData->neighbours, sizeof(DynamicArray*));
+
+	//The world space cache is allocated the first time it is refreshed
+	convexHullData->worldCache.valid = 0;
+	convexHullData->worldCache.numVectors = 0;
+	convexHullData->worldCache.points = NULL;
+	convexHullData->worldCache.axes = NULL;
+	convexHullData->worldCache.edges = NULL;
 }
 
 ///
@@ -112,6 +130,16 @@ void ConvexHullCollider_FreeData(struct ColliderData_ConvexHull* colliderData)
 	}
 	LinkedList_Free(colliderData->edges);
 
+	DynamicArray_Free(colliderData->arcs);
+
+	for(unsigned int i = 0; i < colliderData->neighbours->size; i++)
+	{
+		DynamicArray_Free(*(DynamicArray**)DynamicArray_Index(colliderData->neighbours, i));
+	}
+	DynamicArray_Free(colliderData->neighbours);
+
+	free(colliderData->worldCache.points);
+
 	free(colliderData);
 }
 
@@ -125,6 +153,7 @@ void ConvexHullCollider_AddPoint(ColliderData_ConvexHull* collider, const Vector
 {
 	//The linked list will not manipulate the data
 	LinkedList_Append(collider->points, (Vector*)point);
+	collider->worldCache.valid = 0;
 }
 
 ///
@@ -137,6 +166,7 @@ void ConvexHullCollider_AddAxis(ColliderData_ConvexHull* collider, const Vector*
 {
 	//The linked list will not manipulate the data
 	LinkedList_Append(collider->axes, (Vector*)axis);
+	collider->worldCache.valid = 0;
 }
 
 ///
@@ -149,6 +179,196 @@ void ConvexHullCollider_AddEdge(ColliderData_ConvexHull* collider, const Vector*
 {
 	//The linked list will never manipulate the data
 	LinkedList_Append(collider->edges, (Vector*)edgeDirection);
+	collider->worldCache.valid = 0;
+}
+
+///
+//Adds the arc of an edge to a convex hull collider
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider having an arc added
+//	edge: The index of the edge direction of the collider which the edge runs along
+//	normal1: A pointer to a vector of dimension 3 representing the outward normal of one face meeting at the edge
+//	normal2: A pointer to a vector of dimension 3 representing the outward normal of the other face meeting at the edge
+void ConvexHullCollider_AddArc(ColliderData_ConvexHull* collider, unsigned int edge, const Vector* normal1, const Vector* normal2)
+{
+	ConvexHullCollider_Arc arc;
+	arc.edge = edge;
+	Vector_CopyArray(arc.normals[0], normal1->components, 3);
+	Vector_CopyArray(arc.normals[1], normal2->components, 3);
+	//The cross product is only needed once the arc has been oriented
+	Vector_ZeroArray(arc.cross, 3);
+
+	DynamicArray_Append(collider->arcs, &arc);
+}
+
+///
+//Adds the arcs of the twelve edges of a box centered on the origin to a convex hull collider.
+//The first three edge directions of the collider must be the X, Y & Z axes.
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider to add the arcs to
+static void ConvexHullCollider_AddBoxArcs(ColliderData_ConvexHull* collider)
+{
+	Vector normal1, normal2;
+	Vector_INIT_ON_STACK(normal1, 3);
+	Vector_INIT_ON_STACK(normal2, 3);
+
+	//Each edge along an axis is where a face facing along each of the other two axes meets
+	for(unsigned int edge = 0; edge < 3; edge++)
+	{
+		unsigned int axis1 = (edge + 1) % 3;
+		unsigned int axis2 = (edge + 2) % 3;
+
+		for(int i = 0; i < 4; i++)
+		{
+			Vector_Copy(&normal1, &Vector_ZERO);
+			Vector_Copy(&normal2, &Vector_ZERO);
+			normal1.components[axis1] = i & 1 ? -1.0f : 1.0f;
+			normal2.components[axis2] = i & 2 ? -1.0f : 1.0f;
+
+			ConvexHullCollider_AddArc(collider, edge, &normal1, &normal2);
+		}
+	}
+}
+
+///
+//Records the twelve edges between the corners of a box as neighbours of a convex hull collider.
+//The first eight points of the collider must be the corners of the box in the order the box makers add them.
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider to add the neighbours to
+static void ConvexHullCollider_AddBoxNeighbours(ColliderData_ConvexHull* collider)
+{
+	for(unsigned int i = 0; i < 4; i++)
+	{
+		//Around the bottom face
+		ConvexHullCollider_AddNeighbours(collider, i, (i + 1) % 4);
+		//Around the top face
+		ConvexHullCollider_AddNeighbours(collider, i + 4, (i + 1) % 4 + 4);
+		//From the bottom face to the top face
+		ConvexHullCollider_AddNeighbours(collider, i, i + 4);
+	}
+}
+
+///
+//Records that two points of a convex hull collider share an edge
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider having neighbours added
+//	point1: The index of the first point of the edge
+//	point2: The index of the second point of the edge
+void ConvexHullCollider_AddNeighbours(ColliderData_ConvexHull* collider, unsigned int point1, unsigned int point2)
+{
+	//Make sure both points have an array of neighbours
+	unsigned int maxPoint = point1 > point2 ? point1 : point2;
+	while(collider->neighbours->size <= maxPoint)
+	{
+		DynamicArray* neighbours = DynamicArray_Allocate();
+		DynamicArray_Initialize(neighbours, sizeof(unsigned int));
+		DynamicArray_Append(collider->neighbours, &neighbours);
+	}
+
+	DynamicArray* neighbours1 = *(DynamicArray**)DynamicArray_Index(collider->neighbours, point1);
+	DynamicArray* neighbours2 = *(DynamicArray**)DynamicArray_Index(collider->neighbours, point2);
+
+	if(!DynamicArray_ContainsWithin(neighbours1, &point2, neighbours1->size))
+	{
+		DynamicArray_Append(neighbours1, &point2);
+		DynamicArray_Append(neighbours2, &point1);
+	}
+}
+
+///
+//Determines if support queries on a convex hull collider climb it's adjacency rather than scan every point
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider
+//
+//Returns:
+//	1 if every point of the collider has neighbours and there are enough points for climbing to pay off, else 0
+unsigned char ConvexHullCollider_CanClimb(const ColliderData_ConvexHull* collider)
+{
+	return collider->points->size >= ConvexHullCollider_MIN_CLIMBING_POINTS && collider->neighbours->size == collider->points->size;
+}
+
+///
+//Climbs from a point of a convex hull to neighbouring points projecting further along a direction until none do.
+//Every point of a convex hull which no neighbour projects further than is a point which projects furthest.
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider to climb, must have neighbours for every point
+//	orientedPoints: An array of pointers to vectors representing the oriented points of the collider
+//	direction: A pointer to the direction to climb along
+//	sign: 1.0f to climb up the direction, -1.0f to climb down it
+//	start: The index of the point to start climbing from
+//
+//Returns:
+//	The index of a point projecting furthest along the direction
+static unsigned int ConvexHullCollider_Climb(const ColliderData_ConvexHull* collider, const Vector** orientedPoints, const Vector* direction, float sign, unsigned int start)
+{
+	unsigned int current = start < collider->points->size ? start : 0;
+	float currentDistance = sign * Vector_DotProduct(direction, orientedPoints[current]);
+
+	unsigned char climbed = 1;
+	while(climbed)
+	{
+		climbed = 0;
+
+		DynamicArray* neighbours = *(DynamicArray**)DynamicArray_Index(collider->neighbours, current);
+		unsigned int* indices = (unsigned int*)neighbours->data;
+		for(unsigned int i = 0; i < neighbours->size; i++)
+		{
+			//Only strictly further points are climbed to, so the climb can not go around in circles
+			float distance = sign * Vector_DotProduct(direction, orientedPoints[indices[i]]);
+			if(distance > currentDistance)
+			{
+				current = indices[i];
+				currentDistance = distance;
+				climbed = 1;
+				break;
+			}
+		}
+	}
+
+	return current;
+}
+
+///
+//Finds the points of a convex hull collider which project furthest down and up a direction
+//
+//Parameters:
+//	dest: An array of 2 indices holding the points to start searching from, the indices of the lowest & highest points are stored in it
+//	collider: A pointer to the convex hull collider to search
+//	orientedPoints: An array of pointers to vectors representing the oriented points of the collider
+//	direction: A pointer to the direction to project onto
+void ConvexHullCollider_GetExtremePoints(unsigned int* dest, const ColliderData_ConvexHull* collider, const Vector** orientedPoints, const Vector* direction)
+{
+	if(ConvexHullCollider_CanClimb(collider))
+	{
+		dest[0] = ConvexHullCollider_Climb(collider, orientedPoints, direction, -1.0f, dest[0]);
+		dest[1] = ConvexHullCollider_Climb(collider, orientedPoints, direction, 1.0f, dest[1]);
+		return;
+	}
+
+	//Scan every point
+	float min = Vector_DotProduct(direction, orientedPoints[0]);
+	float max = min;
+	dest[0] = dest[1] = 0;
+	for(unsigned int i = 1; i < collider->points->size; i++)
+	{
+		float distance = Vector_DotProduct(direction, orientedPoints[i]);
+		if(distance < min)
+		{
+			min = distance;
+			dest[0] = i;
+		}
+		else if(distance > max)
+		{
+			max = distance;
+			dest[1] = i;
+		}
+	}
 }
 
 ///
@@ -284,6 +504,9 @@ void ConvexHullCollider_MakeCubeCollider(ColliderData_ConvexHull* collider, floa
 	ConvexHullCollider_AddAxis(collider, axis);
 	ConvexHullCollider_AddEdge(collider, edge);
 
+	//Finally add the arcs & neighbours of the edges
+	ConvexHullCollider_AddBoxArcs(collider);
+	ConvexHullCollider_AddBoxNeighbours(collider);
 }
 
 ///
@@ -419,6 +642,409 @@ void ConvexHullCollider_MakeRectangularCollider(ColliderData_ConvexHull* collide
 
 	ConvexHullCollider_AddAxis(collider, axis);
 	ConvexHullCollider_AddEdge(collider, edge);
+
+	//Finally add the arcs & neighbours of the edges
+	ConvexHullCollider_AddBoxArcs(collider);
+	ConvexHullCollider_AddBoxNeighbours(collider);
+}
+
+///
+//Makes a convex hull collider which tightly wraps a mesh from a blank initialized convex hull collider.
+//The hull is built with quickhull, adding the points which stick out furthest first until it has as many points as allowed.
+//Parallel face normals & edge directions are only added once so SAT tests as few axes as possible,
+//and the arcs & neighbours of the hull are recorded for SAT pruning & hill climbing.
+//
+//Parameters:
+//	collider: A pointer to a convex hull collider with no current points, axes or edges to wrap around the mesh
+//	mesh: A pointer to the mesh to wrap, in the model space of the collider
+//	maxPoints: The most points the collider may have, at least 4
+//
+//Returns:
+//	0 if the mesh does not enclose a volume & the collider was left blank, else 1
+unsigned char ConvexHullCollider_MakeMeshCollider(ColliderData_ConvexHull* collider, const Mesh* mesh, unsigned int maxPoints)
+{
+	float* meshPoints = ConvexHullCollider_GetMeshPoints(mesh);
+	unsigned char built = ConvexHullCollider_MakePointCloudCollider(collider, meshPoints, mesh->numTriangles * 3, maxPoints);
+	free(meshPoints);
+
+	if(!built)
+	{
+		printf("ConvexHullCollider_MakeMeshCollider failed! Mesh does not enclose a volume. Collider not built.\n");
+	}
+	return built;
+}
+
+///
+//Makes a convex hull collider which tightly wraps a cloud of points from a blank initialized convex hull collider.
+//Built the same way as ConvexHullCollider_MakeMeshCollider.
+//
+//Parameters:
+//	collider: A pointer to a convex hull collider with no current points, axes or edges to wrap around the points
+//	points: The point cloud in the model space of the collider, each three consecutive floats form a point
+//	numPoints: The number of points in the cloud
+//	maxPoints: The most points the collider may have, at least 4
+//
+//Returns:
+//	0 if the points do not enclose a volume & the collider was left blank, else 1
+unsigned char ConvexHullCollider_MakePointCloudCollider(ColliderData_ConvexHull* collider, const float* points, unsigned int numPoints, unsigned int maxPoints)
+{
+	QuickHull* hull = QuickHull_Allocate();
+	QuickHull_Initialize(hull);
+	if(!QuickHull_Build(hull, points, numPoints, maxPoints))
+	{
+		QuickHull_Free(hull);
+		return 0;
+	}
+
+	QuickHull_Face* faces = (QuickHull_Face*)hull->faces->data;
+	unsigned int numFaces = hull->faces->size;
+
+	//Number the corners of the hull as the points of the collider
+	unsigned int* pointIndices = (unsigned int*)malloc(sizeof(unsigned int) * numPoints);
+	for(unsigned int i = 0; i < numPoints; i++)
+	{
+		pointIndices[i] = UINT_MAX;
+	}
+	for(unsigned int i = 0; i < numFaces; i++)
+	{
+		for(int j = 0; j < 3; j++)
+		{
+			unsigned int vertex = faces[i].vertices[j];
+			if(pointIndices[vertex] == UINT_MAX)
+			{
+				pointIndices[vertex] = collider->points->size;
+
+				Vector* point = Vector_Allocate();
+				Vector_Initialize(point, 3);
+				Vector_CopyArray(point->components, points + 3 * vertex, 3);
+				ConvexHullCollider_AddPoint(collider, point);
+			}
+		}
+	}
+
+	//Each direction a face faces is tested once, whichever way it faces along it
+	for(unsigned int i = 0; i < numFaces; i++)
+	{
+		if(ConvexHullCollider_FindDirection(collider->axes, faces[i].normal) == collider->axes->size)
+		{
+			Vector* axis = Vector_Allocate();
+			Vector_Initialize(axis, 3);
+			Vector_CopyArray(axis->components, faces[i].normal, 3);
+			ConvexHullCollider_AddAxis(collider, axis);
+		}
+	}
+
+	Vector normal1, normal2;
+	Vector_INIT_ON_STACK(normal1, 3);
+	Vector_INIT_ON_STACK(normal2, 3);
+
+	//Every edge of the hull borders two faces which run along it in opposite directions, visit each edge from the face running up the indices
+	for(unsigned int i = 0; i < numFaces; i++)
+	{
+		for(int j = 0; j < 3; j++)
+		{
+			unsigned int start = faces[i].vertices[j];
+			unsigned int end = faces[i].vertices[(j + 1) % 3];
+			if(start > end) continue;
+
+			ConvexHullCollider_AddNeighbours(collider, pointIndices[start], pointIndices[end]);
+
+			//Find the face across the edge
+			const QuickHull_Face* across = NULL;
+			for(unsigned int k = 0; k < numFaces && across == NULL; k++)
+			{
+				for(int l = 0; l < 3; l++)
+				{
+					if(faces[k].vertices[l] == end && faces[k].vertices[(l + 1) % 3] == start)
+					{
+						across = faces + k;
+						break;
+					}
+				}
+			}
+
+			//Edges between triangles of the same flat face are not edges of the hull
+			if(across == NULL || Vector_DotProductArray(faces[i].normal, across->normal, 3) > 1.0f - ConvexHullCollider_PARALLEL_TOLERANCE) continue;
+
+			float direction[3];
+			Vector_SubtractArray(direction, points + 3 * end, points + 3 * start, 3);
+			Vector_NormalizeArray(direction, 3);
+
+			unsigned int edge = ConvexHullCollider_FindDirection(collider->edges, direction);
+			if(edge == collider->edges->size)
+			{
+				Vector* edgeDirection = Vector_Allocate();
+				Vector_Initialize(edgeDirection, 3);
+				Vector_CopyArray(edgeDirection->components, direction, 3);
+				ConvexHullCollider_AddEdge(collider, edgeDirection);
+			}
+
+			Vector_CopyArray(normal1.components, faces[i].normal, 3);
+			Vector_CopyArray(normal2.components, across->normal, 3);
+			ConvexHullCollider_AddArc(collider, edge, &normal1, &normal2);
+		}
+	}
+
+	free(pointIndices);
+	QuickHull_Free(hull);
+	return 1;
+}
+
+///
+//Makes a convex hull collider which tightly wraps a mesh from a blank initialized convex hull collider, caching the hull on disk.
+//The hull is loaded from the cache if it was built from the same mesh with the same budget, otherwise it is built
+//as in ConvexHullCollider_MakeMeshCollider & written to the cache for next time.
+//
+//Parameters:
+//	collider: A pointer to a convex hull collider with no current points, axes or edges to wrap around the mesh
+//	mesh: A pointer to the mesh to wrap, in the model space of the collider
+//	maxPoints: The most points the collider may have, at least 4
+//	cachePath: The path of the cache file
+//
+//Returns:
+//	0 if the mesh does not enclose a volume & the collider was left blank, else 1
+unsigned char ConvexHullCollider_MakeCachedMeshCollider(ColliderData_ConvexHull* collider, const Mesh* mesh, unsigned int maxPoints, const char* cachePath)
+{
+	if(ConvexHullCollider_LoadCache(collider, mesh, maxPoints, cachePath)) return 1;
+
+	if(!ConvexHullCollider_MakeMeshCollider(collider, mesh, maxPoints)) return 0;
+
+	//The collider is usable even if it can't be cached
+	if(!ConvexHullCollider_SaveCache(collider, mesh, maxPoints, cachePath))
+	{
+		printf("ConvexHullCollider_MakeCachedMeshCollider could not write %s. Hull will be rebuilt next time.\n", cachePath);
+	}
+	return 1;
+}
+
+///
+//Loads a convex hull collider from a cache file into a blank initialized convex hull collider
+//
+//Parameters:
+//	collider: A pointer to a convex hull collider with no current points, axes or edges to load the cache into
+//	mesh: A pointer to the mesh the cache must have been built from
+//	maxPoints: The budget of points the cache must have been built with
+//	cachePath: The path of the cache file
+//
+//Returns:
+//	0 if the cache is missing, damaged or was built from a different mesh or budget & the collider was left blank, else 1
+unsigned char ConvexHullCollider_LoadCache(ColliderData_ConvexHull* collider, const Mesh* mesh, unsigned int maxPoints, const char* cachePath)
+{
+	FILE* fp = fopen(cachePath, "rb");
+	if(fp == NULL) return 0;
+
+	//Magic, version, mesh hash, budget, then the number of points, axes, edges, arcs & neighbour indices
+	unsigned int header[9];
+	if(fread(header, sizeof(unsigned int), 9, fp) != 9 || header[0] != ConvexHullCollider_CACHE_MAGIC || header[1] != ConvexHullCollider_CACHE_VERSION || header[3] != maxPoints)
+	{
+		fclose(fp);
+		return 0;
+	}
+
+	float* meshPoints = ConvexHullCollider_GetMeshPoints(mesh);
+	unsigned int meshHash = ConvexHullCollider_HashMeshPoints(meshPoints, mesh->numTriangles * 3);
+	free(meshPoints);
+	if(header[2] != meshHash)
+	{
+		fclose(fp);
+		return 0;
+	}
+
+	unsigned int numPoints = header[4];
+	unsigned int numAxes = header[5];
+	unsigned int numEdges = header[6];
+	unsigned int numArcs = header[7];
+	unsigned int numNeighbours = header[8];
+
+	//Read everything before touching the collider so a damaged cache leaves it blank
+	unsigned int numVectors = numPoints + numAxes + numEdges;
+	float* vectors = (float*)malloc(sizeof(float) * 3 * numVectors);
+	ConvexHullCollider_Arc* arcs = (ConvexHullCollider_Arc*)malloc(sizeof(ConvexHullCollider_Arc) * numArcs);
+	unsigned int* neighbours = (unsigned int*)malloc(sizeof(unsigned int) * (numPoints + numNeighbours));
+
+	unsigned char valid = fread(vectors, sizeof(float), 3 * numVectors, fp) == 3 * numVectors;
+	for(unsigned int i = 0; i < numArcs && valid; i++)
+	{
+		valid = fread(&arcs[i].edge, sizeof(unsigned int), 1, fp) == 1 && fread(arcs[i].normals, sizeof(float), 6, fp) == 6 && arcs[i].edge < numEdges;
+	}
+
+	//Each point's neighbours are stored as a count followed by the indices
+	unsigned int numRead = 0;
+	for(unsigned int i = 0; i < numPoints && valid; i++)
+	{
+		valid = fread(neighbours + numRead, sizeof(unsigned int), 1, fp) == 1 && neighbours[numRead] <= numNeighbours - (numRead - i);
+		if(!valid) break;
+
+		unsigned int count = neighbours[numRead++];
+		valid = fread(neighbours + numRead, sizeof(unsigned int), count, fp) == count;
+		for(unsigned int j = 0; j < count && valid; j++)
+		{
+			valid = neighbours[numRead + j] < numPoints;
+		}
+		numRead += count;
+	}
+	fclose(fp);
+
+	if(valid)
+	{
+		for(unsigned int i = 0; i < numVectors; i++)
+		{
+			Vector* vector = Vector_Allocate();
+			Vector_Initialize(vector, 3);
+			Vector_CopyArray(vector->components, vectors + 3 * i, 3);
+
+			if(i < numPoints) ConvexHullCollider_AddPoint(collider, vector);
+			else if(i < numPoints + numAxes) ConvexHullCollider_AddAxis(collider, vector);
+			else ConvexHullCollider_AddEdge(collider, vector);
+		}
+
+		Vector normal1, normal2;
+		Vector_INIT_ON_STACK(normal1, 3);
+		Vector_INIT_ON_STACK(normal2, 3);
+		for(unsigned int i = 0; i < numArcs; i++)
+		{
+			Vector_CopyArray(normal1.components, arcs[i].normals[0], 3);
+			Vector_CopyArray(normal2.components, arcs[i].normals[1], 3);
+			ConvexHullCollider_AddArc(collider, arcs[i].edge, &normal1, &normal2);
+		}
+
+		//Neighbours are restored in the order they were saved so climbs visit them in the same order
+		numRead = 0;
+		for(unsigned int i = 0; i < numPoints; i++)
+		{
+			unsigned int count = neighbours[numRead++];
+			DynamicArray* pointNeighbours = DynamicArray_Allocate();
+			DynamicArray_Initialize(pointNeighbours, sizeof(unsigned int));
+			for(unsigned int j = 0; j < count; j++)
+			{
+				DynamicArray_Append(pointNeighbours, neighbours + numRead + j);
+			}
+			DynamicArray_Append(collider->neighbours, &pointNeighbours);
+			numRead += count;
+		}
+	}
+
+	free(vectors);
+	free(arcs);
+	free(neighbours);
+	return valid;
+}
+
+///
+//Saves a convex hull collider built from a mesh to a cache file
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider to save
+//	mesh: A pointer to the mesh the collider was built from
+//	maxPoints: The budget of points the collider was built with
+//	cachePath: The path of the cache file
+//
+//Returns:
+//	0 if the cache file could not be written, else 1
+unsigned char ConvexHullCollider_SaveCache(const ColliderData_ConvexHull* collider, const Mesh* mesh, unsigned int maxPoints, const char* cachePath)
+{
+	FILE* fp = fopen(cachePath, "wb");
+	if(fp == NULL) return 0;
+
+	float* meshPoints = ConvexHullCollider_GetMeshPoints(mesh);
+	unsigned int meshHash = ConvexHullCollider_HashMeshPoints(meshPoints, mesh->numTriangles * 3);
+	free(meshPoints);
+
+	unsigned int numNeighbours = 0;
+	for(unsigned int i = 0; i < collider->neighbours->size; i++)
+	{
+		numNeighbours += (*(DynamicArray**)DynamicArray_Index(collider->neighbours, i))->size;
+	}
+
+	unsigned int header[9] = { ConvexHullCollider_CACHE_MAGIC, ConvexHullCollider_CACHE_VERSION, meshHash, maxPoints,
+		collider->points->size, collider->axes->size, collider->edges->size, collider->arcs->size, numNeighbours };
+	unsigned char written = fwrite(header, sizeof(unsigned int), 9, fp) == 9;
+
+	//Points, axes & edges are written one after another
+	const LinkedList* lists[3] = { collider->points, collider->axes, collider->edges };
+	for(int i = 0; i < 3; i++)
+	{
+		for(LinkedList_Node* current = lists[i]->head; current != NULL && written; current = current->next)
+		{
+			written = fwrite(((Vector*)current->data)->components, sizeof(float), 3, fp) == 3;
+		}
+	}
+
+	const ConvexHullCollider_Arc* arcs = (const ConvexHullCollider_Arc*)collider->arcs->data;
+	for(unsigned int i = 0; i < collider->arcs->size && written; i++)
+	{
+		written = fwrite(&arcs[i].edge, sizeof(unsigned int), 1, fp) == 1 && fwrite(arcs[i].normals, sizeof(float), 6, fp) == 6;
+	}
+
+	//Points without neighbours are written with a count of 0
+	for(unsigned int i = 0; i < collider->points->size && written; i++)
+	{
+		DynamicArray* neighbours = i < collider->neighbours->size ? *(DynamicArray**)DynamicArray_Index(collider->neighbours, i) : NULL;
+		unsigned int count = neighbours != NULL ? neighbours->size : 0;
+		written = fwrite(&count, sizeof(unsigned int), 1, fp) == 1 && (count == 0 || fwrite(neighbours->data, sizeof(unsigned int), count, fp) == count);
+	}
+
+	return fclose(fp) == 0 && written;
+}
+
+///
+//Gathers the corners of every triangle of a mesh
+//
+//Parameters:
+//	mesh: A pointer to the mesh to gather the corners of
+//
+//Returns:
+//	A newly allocated array of 9 floats per triangle of the mesh, each three consecutive floats form a corner
+static float* ConvexHullCollider_GetMeshPoints(const Mesh* mesh)
+{
+	float* meshPoints = (float*)malloc(sizeof(float) * 9 * mesh->numTriangles);
+	for(unsigned int i = 0; i < mesh->numTriangles; i++)
+	{
+		const struct Triangle* triangle = mesh->triangles + i;
+		const struct Vertex* corners[3] = { &triangle->a, &triangle->b, &triangle->c };
+		for(int j = 0; j < 3; j++)
+		{
+			meshPoints[9 * i + 3 * j] = corners[j]->x;
+			meshPoints[9 * i + 3 * j + 1] = corners[j]->y;
+			meshPoints[9 * i + 3 * j + 2] = corners[j]->z;
+		}
+	}
+	return meshPoints;
+}
+
+///
+//Hashes the corners of the triangles of a mesh, identifying the mesh a convex hull cache was built from
+//
+//Parameters:
+//	meshPoints: The corners of the triangles of the mesh as given by ConvexHullCollider_GetMeshPoints
+//	numPoints: The number of corners
+//
+//Returns:
+//	The hash of the corners
+static unsigned int ConvexHullCollider_HashMeshPoints(const float* meshPoints, unsigned int numPoints)
+{
+	//Only the low 32 bits are kept so caches are the same wherever they were built
+	return (unsigned int)Hash_SDBM((void*)meshPoints, sizeof(float) * 3 * numPoints);
+}
+
+///
+//Finds a direction parallel or antiparallel to a given direction in a list of directions
+//
+//Parameters:
+//	directions: A linked list of pointers to vectors of dimension 3 representing the directions to search
+//	direction: An array of 3 floats containing the unit direction to find
+//
+//Returns:
+//	The index of the first parallel direction in the list, or the size of the list if there is none
+static unsigned int ConvexHullCollider_FindDirection(const LinkedList* directions, const float* direction)
+{
+	unsigned int index = 0;
+	for(LinkedList_Node* current = directions->head; current != NULL; current = current->next)
+	{
+		if(fabsf(Vector_DotProductArray(((Vector*)current->data)->components, direction, 3)) > 1.0f - ConvexHullCollider_PARALLEL_TOLERANCE) break;
+		index++;
+	}
+	return index;
 }
 
 ///
@@ -441,6 +1067,33 @@ void ConvexHullCollider_GetOrientedWorldPoints(Vector** dest, const ColliderData
 
 }
 
+///
+//Gets the points of the collider oriented in world space to match a given frame of reference as a flat array of components
+//
+//Parameters:
+//	dest: An array of 3 floats per point of the collider to store the oriented collider points
+//	collider: The collider of which to orient the points of
+//	frame: The frame of reference with which to orient the points
+void ConvexHullCollider_GetOrientedWorldPointArray(float* dest, const ColliderData_ConvexHull* collider, const FrameOfReference* frame)
+{
+	//Create a transformation matrix to rotate and scale the points
+	Matrix trans;
+	Matrix_INIT_ON_STACK(trans, 3, 3);
+	Matrix_GetProductMatrix(&trans, frame->rotation, frame->scale);
+
+	//Loop through the colliders points
+	LinkedList_Node* currentPoint = collider->points->head;
+	for(unsigned int i = 0; i < collider->points->size; i++)
+	{
+		//Rotate and scale each point, then translate it to world space
+		Matrix_GetProductVectorArray(dest + 3 * i, trans.components, ((Vector*)currentPoint->data)->components, 3, 3);
+		Vector_IncrementArray(dest + 3 * i, frame->position->components, 3);
+
+		//Move to next point
+		currentPoint = currentPoint->next;
+	}
+}
+
 ///
 //Gets the points of the collider oriented in model space to match a given frame of reference
 //
@@ -509,6 +1162,57 @@ void ConvexHullCollider_GetOrientedEdges(Vector** dest, const ColliderData_Conve
 	}
 }
 
+///
+//Gets the arcs of a convex hull collider oriented to match a given frame of reference
+//
+//Parameters:
+//	dest: An array of arcs with room for every arc of the collider to store the oriented arcs
+//	collider: A pointer to the collider of which to orient the arcs of
+//	frame: A pointer to the frame of reference with which to orient the arcs
+void ConvexHullCollider_GetOrientedArcs(ConvexHullCollider_Arc* dest, const ColliderData_ConvexHull* collider, const FrameOfReference* frame)
+{
+	const ConvexHullCollider_Arc* arcs = (const ConvexHullCollider_Arc*)collider->arcs->data;
+	for(unsigned int i = 0; i < collider->arcs->size; i++)
+	{
+		dest[i].edge = arcs[i].edge;
+
+		//Rotate the normals the same way as the axes
+		Matrix_GetProductVectorArray(dest[i].normals[0], frame->rotation->components, arcs[i].normals[0], 3, 3);
+		Matrix_GetProductVectorArray(dest[i].normals[1], frame->rotation->components, arcs[i].normals[1], 3, 3);
+
+		//The cross product of the normals is the plane the arc lies in
+		const float* a = dest[i].normals[0];
+		const float* b = dest[i].normals[1];
+		dest[i].cross[0] = b[1] * a[2] - b[2] * a[1];
+		dest[i].cross[1] = b[2] * a[0] - b[0] * a[2];
+		dest[i].cross[2] = b[0] * a[1] - b[1] * a[0];
+	}
+}
+
+///
+//Determines if the edges of two arcs form a face of the Minkowski difference of their hulls.
+//This is the case when the first arc intersects the negation of the second arc on the Gauss map.
+//
+//Parameters:
+//	arc1: A pointer to the oriented arc of an edge of the first hull
+//	arc2: A pointer to the oriented arc of an edge of the second hull
+//
+//Returns:
+//	1 if the edges form a face of the Minkowski difference, else 0
+unsigned char ConvexHullCollider_IsMinkowskiFace(const ConvexHullCollider_Arc* arc1, const ConvexHullCollider_Arc* arc2)
+{
+	//The ends of the negated second arc must lie on opposite sides of the plane of the first arc.
+	//Negating both normals of the second arc leaves the plane it lies in unchanged.
+	float cba = -Vector_DotProductArray(arc2->normals[0], arc1->cross, 3);
+	float dba = -Vector_DotProductArray(arc2->normals[1], arc1->cross, 3);
+	//The ends of the first arc must lie on opposite sides of the plane of the negated second arc
+	float adc = Vector_DotProductArray(arc1->normals[0], arc2->cross, 3);
+	float bdc = Vector_DotProductArray(arc1->normals[1], arc2->cross, 3);
+
+	//And the arcs must be on the same hemisphere, rather than their great circles crossing on the far side
+	return cba * dba < 0.0f && adc * bdc < 0.0f && cba * bdc > 0.0f;
+}
+
 ///
 //Determines the subset set of a convex hull colliders points oriented to a given orientation furthest in a given direction.
 //These points are returned in MODEL SPACE! The components of the vectors in the dynamic array POINT TO the components of the vectors in the model oriented points array!
@@ -519,8 +1223,15 @@ void ConvexHullCollider_GetOrientedEdges(Vector** dest, const ColliderData_Conve
 //	modelOrientedPoints: An array of pointers to vectors representing the colliders points oriented into modelSpace
 //	frame: The frame to orient the collider's points with
 //	direction: The direction in which the desired set of points are furthest in.
-void ConvexHullCollider_GetFurthestPoints(DynamicArray* dest, const ColliderData_ConvexHull* collider, const Vector** modelOrientedPoints, const Vector* direction)
+//	start: A pointer to the index of the point to climb from, the index of a furthest point is stored in it for the next search along a similar direction.
+//		NULL to climb from the first point.
+void ConvexHullCollider_GetFurthestPoints(DynamicArray* dest, const ColliderData_ConvexHull* collider, const Vector** modelOrientedPoints, const Vector* direction, unsigned int* start)
 {
+	if(ConvexHullCollider_CanClimb(collider))
+	{
+		unsigned int first = 0;
+		if(ConvexHullCollider_ClimbToFurthestPoints(dest, collider, modelOrientedPoints, direction, start != NULL ? start : &first)) return;
+	}
 
 	//Find the points furthest in direction of relative MTV for convexHull1
 	float currentMaxDistance = 0.0f;
@@ -554,6 +1265,171 @@ void ConvexHullCollider_GetFurthestPoints(DynamicArray* dest, const ColliderData
 	}
 }
 
+///
+//Determines the subset of a convex hull colliders points furthest in a given direction by climbing it's adjacency.
+//Gives the same points in the same order as scanning every point in ConvexHullCollider_GetFurthestPoints.
+//
+//Parameters:
+//	dest: A dynamic array to store the set of points in
+//	collider: A pointer to a convex hull collider which can be climbed to get the subset of points from
+//	modelOrientedPoints: An array of pointers to vectors representing the colliders points oriented into modelSpace
+//	direction: The direction in which the desired set of points are furthest in.
+//	start: A pointer to the index of the point to start climbing from, the index of a furthest point is stored in it
+//
+//Returns:
+//	0 if more than ConvexHullCollider_MAX_CLIMBED_POINTS points are nearly as far & the points must be scanned instead, else 1
+static unsigned char ConvexHullCollider_ClimbToFurthestPoints(DynamicArray* dest, const ColliderData_ConvexHull* collider, const Vector** modelOrientedPoints, const Vector* direction, unsigned int* start)
+{
+	//The start may have been left by a different piece of a compound collider with more points
+	if(*start >= collider->points->size) *start = 0;
+	unsigned int furthest = ConvexHullCollider_Climb(collider, modelOrientedPoints, direction, 1.0f, *start);
+	*start = furthest;
+	float climbedDistance = Vector_DotProduct(modelOrientedPoints[furthest], direction);
+
+	//The points just as far lie on a face with the furthest point, but rounding may leave points between them a little nearer,
+	//or even leave the climb a little short of the furthest. Spread out over every point nearly as far to find them all.
+	float tolerance = 0.0001f * (fabsf(climbedDistance) + 1.0f);
+
+	//Only a few points are ever nearly as far, they are remembered on the stack & searched to tell if they were reached already
+	unsigned int reached[ConvexHullCollider_MAX_CLIMBED_POINTS];
+	unsigned int numReached = 0;
+	float maxDistance = climbedDistance;
+
+	reached[numReached++] = furthest;
+	for(unsigned int next = 0; next < numReached; next++)
+	{
+		DynamicArray* neighbours = *(DynamicArray**)DynamicArray_Index(collider->neighbours, reached[next]);
+		unsigned int* indices = (unsigned int*)neighbours->data;
+		for(unsigned int i = 0; i < neighbours->size; i++)
+		{
+			float distance = Vector_DotProduct(modelOrientedPoints[indices[i]], direction);
+			if(distance < climbedDistance - tolerance) continue;
+
+			unsigned int j = 0;
+			while(j < numReached && reached[j] != indices[i]) j++;
+			if(j < numReached) continue;
+
+			if(numReached == ConvexHullCollider_MAX_CLIMBED_POINTS) return 0;
+			reached[numReached++] = indices[i];
+			if(distance > maxDistance) maxDistance = distance;
+		}
+	}
+
+	//Only points at or in front of the origin are logged, as when scanning from a maximum distance of 0
+	if(maxDistance >= 0.0f)
+	{
+		if(maxDistance > 0.0f && dest->size != 0)
+		{
+			DynamicArray_Clear(dest);
+		}
+
+		//Put the points reached in the order a scan would find them, there are only ever a few
+		for(unsigned int i = 1; i < numReached; i++)
+		{
+			unsigned int index = reached[i];
+			unsigned int j = i;
+			for(; j > 0 && reached[j - 1] > index; j--) reached[j] = reached[j - 1];
+			reached[j] = index;
+		}
+
+		//Log the points exactly as far
+		for(unsigned int i = 0; i < numReached; i++)
+		{
+			if(Vector_DotProduct(modelOrientedPoints[reached[i]], direction) == maxDistance)
+			{
+				DynamicArray_Append(dest, (void*)modelOrientedPoints[reached[i]]);
+			}
+		}
+	}
+
+	return 1;
+}
+
+///
+//Orients the world space cache of a convex hull collider by a frame of reference.
+//Does nothing if the cache was already oriented by a frame of reference matching the one given.
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider to refresh the cache of
+//	frame: A pointer to the frame of reference to orient the cache with
+void ConvexHullCollider_RefreshWorldCache(ColliderData_ConvexHull* collider, const FrameOfReference* frame)
+{
+	if(ConvexHullCollider_HasWorldCache(collider, frame)) return;
+
+	ConvexHullCollider_WorldCache* cache = &collider->worldCache;
+	unsigned int numPoints = collider->points->size;
+	unsigned int numAxes = collider->axes->size;
+	unsigned int numEdges = collider->edges->size;
+	unsigned int numVectors = numPoints + numAxes + numEdges;
+
+	//The pointers, vectors & components share one block which only grows if the hull does
+	if(numVectors > cache->numVectors)
+	{
+		free(cache->points);
+		cache->points = (Vector**)malloc((sizeof(Vector*) + sizeof(Vector) + sizeof(float) * 3) * numVectors);
+		Vector* vectors = (Vector*)(cache->points + numVectors);
+		float* components = (float*)(vectors + numVectors);
+
+		for(unsigned int i = 0; i < numVectors; i++)
+		{
+			vectors[i].dimension = 3;
+			vectors[i].components = components + 3 * i;
+			cache->points[i] = vectors + i;
+		}
+		cache->numVectors = numVectors;
+	}
+	cache->axes = cache->points + numPoints;
+	cache->edges = cache->axes + numAxes;
+
+	ConvexHullCollider_GetOrientedWorldPoints(cache->points, collider, frame);
+	ConvexHullCollider_GetOrientedAxes(cache->axes, collider, frame);
+	ConvexHullCollider_GetOrientedEdges(cache->edges, collider, frame);
+
+	//Bound the oriented points
+	for(unsigned int i = 0; i < 3; i++)
+	{
+		cache->min[i] = numPoints > 0 ? cache->points[0]->components[i] : frame->position->components[i];
+		cache->max[i] = cache->min[i];
+	}
+	for(unsigned int i = 1; i < numPoints; i++)
+	{
+		for(unsigned int j = 0; j < 3; j++)
+		{
+			float component = cache->points[i]->components[j];
+			if(component < cache->min[j]) cache->min[j] = component;
+			if(component > cache->max[j]) cache->max[j] = component;
+		}
+	}
+
+	FrameOfReference_TakeSnapshot(cache->snapshot, frame);
+	cache->valid = 1;
+}
+
+///
+//Determines if the world space cache of a convex hull collider was oriented by a frame of reference matching the one given
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider to check the cache of
+//	frame: A pointer to the frame of reference to check against
+//
+//Returns:
+//	1 if the cache can be read in place of orienting the collider by the frame of reference, else 0
+unsigned char ConvexHullCollider_HasWorldCache(const ColliderData_ConvexHull* collider, const FrameOfReference* frame)
+{
+	return collider->worldCache.valid && !FrameOfReference_HasChanged(collider->worldCache.snapshot, frame);
+}
+
+///
+//Marks the world space cache of a convex hull collider as out of date.
+//Must be called after changing the points, axes or edges of a collider in place.
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider to invalidate the cache of
+void ConvexHullCollider_InvalidateWorldCache(ColliderData_ConvexHull* collider)
+{
+	collider->worldCache.valid = 0;
+}
+
 ///
 //Determines the minimum axis aligned bounding box which can contain the convex hull
 //
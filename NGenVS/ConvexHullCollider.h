@@ -25,13 +25,131 @@ static void(*ConvexHullCollider_ColliderInitializePtr)(struct Collider*, Collide
 void ConvexHullCollider_SetColliderInitializer(void(*funcPtr)(struct Collider*, ColliderType, Mesh*));
 
 
+//The fewest points a convex hull must have for support queries to climb it's adjacency rather than scan every point
+#define ConvexHullCollider_MIN_CLIMBING_POINTS 16
+//The most points nearly as far along a direction which a climb gathers on the stack, more are found by scanning every point
+#define ConvexHullCollider_MAX_CLIMBED_POINTS 64
+
+//Face normals & edge directions of a hull built from a mesh which are closer than this to parallel are only added once.
+//Only directions which differ by rounding may be merged, SAT tests the kept direction in place of every direction merged into it.
+#define ConvexHullCollider_PARALLEL_TOLERANCE 0.000001f
+//The first value of a convex hull cache file
+#define ConvexHullCollider_CACHE_MAGIC 0x4C485843
+//The layout of convex hull cache files, caches of any other version are rebuilt
+#define ConvexHullCollider_CACHE_VERSION 2
+
+//The arc traced on the Gauss map by an edge of a convex hull, running between the normals of the two faces which meet at the edge.
+//Two edges of different hulls can only form a face of the Minkowski difference of the hulls if their arcs intersect on the Gauss map.
+typedef struct ConvexHullCollider_Arc
+{
+	unsigned int edge;				//Index of the edge direction of the hull which the edge runs along
+	float normals[2][3];			//Outward normals of the faces which meet at the edge
+	float cross[3];					//Cross product of the second normal with the first
+} ConvexHullCollider_Arc;
+
+//The points, axes & edges of a convex hull oriented into world space, along with the world space bounds of the points.
+//Refreshed at most once for each transform of the hull so every pair the hull is tested in can share it.
+//Every convex narrow phase test, SAT & GJK alike, reads the hull from here when the cache matches the frame it tests with.
+typedef struct ConvexHullCollider_WorldCache
+{
+	float snapshot[FrameOfReference_SNAPSHOT_SIZE];	//Frame of reference the cache was oriented with
+	unsigned char valid;							//Does the cache hold the hull oriented by the snapshot
+	unsigned int numVectors;						//Number of vectors there is room for
+	Vector** points;								//World space points of the hull, the vectors & their components are stored after the pointers, the components of the points contiguous & in order
+	Vector** axes;									//Oriented axes of the hull, follows the points, the components of the axes contiguous & in order as well
+	Vector** edges;									//Oriented edges of the hull, follows the axes
+	float min[3];									//World space minimum of the points along each axis
+	float max[3];									//World space maximum of the points along each axis
+} ConvexHullCollider_WorldCache;
+
 struct ColliderData_ConvexHull
 {
 	LinkedList* points;
 	LinkedList* axes;
 	LinkedList* edges;
+	DynamicArray* arcs;				//Arcs of the edges of the hull stored by value, edge directions without arcs are never pruned from SAT
+	DynamicArray* neighbours;		//For each point, a pointer to a dynamic array of the indices of the points sharing an edge with it
+	ConvexHullCollider_WorldCache worldCache;	//The hull oriented into world space by the frame of reference it was last refreshed with
 };
 
+///
+//Adds the arcs of the twelve edges of a box centered on the origin to a convex hull collider.
+//The first three edge directions of the collider must be the X, Y & Z axes.
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider to add the arcs to
+static void ConvexHullCollider_AddBoxArcs(ColliderData_ConvexHull* collider);
+
+///
+//Records the twelve edges between the corners of a box as neighbours of a convex hull collider.
+//The first eight points of the collider must be the corners of the box in the order the box makers add them.
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider to add the neighbours to
+static void ConvexHullCollider_AddBoxNeighbours(ColliderData_ConvexHull* collider);
+
+///
+//Climbs from a point of a convex hull to neighbouring points projecting further along a direction until none do.
+//Every point of a convex hull which no neighbour projects further than is a point which projects furthest.
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider to climb, must have neighbours for every point
+//	orientedPoints: An array of pointers to vectors representing the oriented points of the collider
+//	direction: A pointer to the direction to climb along
+//	sign: 1.0f to climb up the direction, -1.0f to climb down it
+//	start: The index of the point to start climbing from
+//
+//Returns:
+//	The index of a point projecting furthest along the direction
+static unsigned int ConvexHullCollider_Climb(const ColliderData_ConvexHull* collider, const Vector** orientedPoints, const Vector* direction, float sign, unsigned int start);
+
+///
+//Determines the subset of a convex hull colliders points furthest in a given direction by climbing it's adjacency.
+//Gives the same points in the same order as scanning every point in ConvexHullCollider_GetFurthestPoints.
+//
+//Parameters:
+//	dest: A dynamic array to store the set of points in
+//	collider: A pointer to a convex hull collider which can be climbed to get the subset of points from
+//	modelOrientedPoints: An array of pointers to vectors representing the colliders points oriented into modelSpace
+//	direction: The direction in which the desired set of points are furthest in.
+//	start: A pointer to the index of the point to start climbing from, the index of a furthest point is stored in it
+//
+//Returns:
+//	0 if more than ConvexHullCollider_MAX_CLIMBED_POINTS points are nearly as far & the points must be scanned instead, else 1
+static unsigned char ConvexHullCollider_ClimbToFurthestPoints(DynamicArray* dest, const ColliderData_ConvexHull* collider, const Vector** modelOrientedPoints, const Vector* direction, unsigned int* start);
+
+///
+//Gathers the corners of every triangle of a mesh
+//
+//Parameters:
+//	mesh: A pointer to the mesh to gather the corners of
+//
+//Returns:
+//	A newly allocated array of 9 floats per triangle of the mesh, each three consecutive floats form a corner
+static float* ConvexHullCollider_GetMeshPoints(const Mesh* mesh);
+
+///
+//Hashes the corners of the triangles of a mesh, identifying the mesh a convex hull cache was built from
+//
+//Parameters:
+//	meshPoints: The corners of the triangles of the mesh as given by ConvexHullCollider_GetMeshPoints
+//	numPoints: The number of corners
+//
+//Returns:
+//	The hash of the corners
+static unsigned int ConvexHullCollider_HashMeshPoints(const float* meshPoints, unsigned int numPoints);
+
+///
+//Finds a direction parallel or antiparallel to a given direction in a list of directions
+//
+//Parameters:
+//	directions: A linked list of pointers to vectors of dimension 3 representing the directions to search
+//	direction: An array of 3 floats containing the unit direction to find
+//
+//Returns:
+//	The index of the first parallel direction in the list, or the size of the list if there is none
+static unsigned int ConvexHullCollider_FindDirection(const LinkedList* directions, const float* direction);
+
 ///
 //Allocates memory for a new convex hull collider data set
 //
@@ -84,6 +202,45 @@ void ConvexHullCollider_AddAxis(ColliderData_ConvexHull* collider, const Vector*
 //	axis: A pointer to a vector of dimension 3 representing the direction vector of an edge on the collider
 void ConvexHullCollider_AddEdge(ColliderData_ConvexHull* collider, const Vector* edgeDirection);
 
+///
+//Adds the arc of an edge to a convex hull collider
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider having an arc added
+//	edge: The index of the edge direction of the collider which the edge runs along
+//	normal1: A pointer to a vector of dimension 3 representing the outward normal of one face meeting at the edge
+//	normal2: A pointer to a vector of dimension 3 representing the outward normal of the other face meeting at the edge
+void ConvexHullCollider_AddArc(ColliderData_ConvexHull* collider, unsigned int edge, const Vector* normal1, const Vector* normal2);
+
+///
+//Records that two points of a convex hull collider share an edge
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider having neighbours added
+//	point1: The index of the first point of the edge
+//	point2: The index of the second point of the edge
+void ConvexHullCollider_AddNeighbours(ColliderData_ConvexHull* collider, unsigned int point1, unsigned int point2);
+
+///
+//Determines if support queries on a convex hull collider climb it's adjacency rather than scan every point
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider
+//
+//Returns:
+//	1 if every point of the collider has neighbours and there are enough points for climbing to pay off, else 0
+unsigned char ConvexHullCollider_CanClimb(const ColliderData_ConvexHull* collider);
+
+///
+//Finds the points of a convex hull collider which project furthest down and up a direction
+//
+//Parameters:
+//	dest: An array of 2 indices holding the points to start searching from, the indices of the lowest & highest points are stored in it
+//	collider: A pointer to the convex hull collider to search
+//	orientedPoints: An array of pointers to vectors representing the oriented points of the collider
+//	direction: A pointer to the direction to project onto
+void ConvexHullCollider_GetExtremePoints(unsigned int* dest, const ColliderData_ConvexHull* collider, const Vector** orientedPoints, const Vector* direction);
+
 ///
 //Makes a cube convex hull collider from a blank initialized convex hull collider
 //
@@ -102,6 +259,76 @@ void ConvexHullCollider_MakeCubeCollider(ColliderData_ConvexHull* collider, floa
 //	depth: The depth of the collider
 void ConvexHullCollider_MakeRectangularCollider(ColliderData_ConvexHull* collider, float width, float height, float depth);
 
+///
+//Makes a convex hull collider which tightly wraps a mesh from a blank initialized convex hull collider.
+//The hull is built with quickhull, adding the points which stick out furthest first until it has as many points as allowed.
+//Parallel face normals & edge directions are only added once so SAT tests as few axes as possible,
+//and the arcs & neighbours of the hull are recorded for SAT pruning & hill climbing.
+//
+//Parameters:
+//	collider: A pointer to a convex hull collider with no current points, axes or edges to wrap around the mesh
+//	mesh: A pointer to the mesh to wrap, in the model space of the collider
+//	maxPoints: The most points the collider may have, at least 4
+//
+//Returns:
+//	0 if the mesh does not enclose a volume & the collider was left blank, else 1
+unsigned char ConvexHullCollider_MakeMeshCollider(ColliderData_ConvexHull* collider, const Mesh* mesh, unsigned int maxPoints);
+
+///
+//Makes a convex hull collider which tightly wraps a cloud of points from a blank initialized convex hull collider.
+//Built the same way as ConvexHullCollider_MakeMeshCollider.
+//
+//Parameters:
+//	collider: A pointer to a convex hull collider with no current points, axes or edges to wrap around the points
+//	points: The point cloud in the model space of the collider, each three consecutive floats form a point
+//	numPoints: The number of points in the cloud
+//	maxPoints: The most points the collider may have, at least 4
+//
+//Returns:
+//	0 if the points do not enclose a volume & the collider was left blank, else 1
+unsigned char ConvexHullCollider_MakePointCloudCollider(ColliderData_ConvexHull* collider, const float* points, unsigned int numPoints, unsigned int maxPoints);
+
+///
+//Makes a convex hull collider which tightly wraps a mesh from a blank initialized convex hull collider, caching the hull on disk.
+//The hull is loaded from the cache if it was built from the same mesh with the same budget, otherwise it is built
+//as in ConvexHullCollider_MakeMeshCollider & written to the cache for next time.
+//
+//Parameters:
+//	collider: A pointer to a convex hull collider with no current points, axes or edges to wrap around the mesh
+//	mesh: A pointer to the mesh to wrap, in the model space of the collider
+//	maxPoints: The most points the collider may have, at least 4
+//	cachePath: The path of the cache file
+//
+//Returns:
+//	0 if the mesh does not enclose a volume & the collider was left blank, else 1
+unsigned char ConvexHullCollider_MakeCachedMeshCollider(ColliderData_ConvexHull* collider, const Mesh* mesh, unsigned int maxPoints, const char* cachePath);
+
+///
+//Loads a convex hull collider from a cache file into a blank initialized convex hull collider
+//
+//Parameters:
+//	collider: A pointer to a convex hull collider with no current points, axes or edges to load the cache into
+//	mesh: A pointer to the mesh the cache must have been built from
+//	maxPoints: The budget of points the cache must have been built with
+//	cachePath: The path of the cache file
+//
+//Returns:
+//	0 if the cache is missing, damaged or was built from a different mesh or budget & the collider was left blank, else 1
+unsigned char ConvexHullCollider_LoadCache(ColliderData_ConvexHull* collider, const Mesh* mesh, unsigned int maxPoints, const char* cachePath);
+
+///
+//Saves a convex hull collider built from a mesh to a cache file
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider to save
+//	mesh: A pointer to the mesh the collider was built from
+//	maxPoints: The budget of points the collider was built with
+//	cachePath: The path of the cache file
+//
+//Returns:
+//	0 if the cache file could not be written, else 1
+unsigned char ConvexHullCollider_SaveCache(const ColliderData_ConvexHull* collider, const Mesh* mesh, unsigned int maxPoints, const char* cachePath);
+
 ///
 //Gets the points of the collider oriented in world space to match a given frame of reference
 //
@@ -111,6 +338,15 @@ void ConvexHullCollider_MakeRectangularCollider(ColliderData_ConvexHull* collide
 //	frame: The frame of reference with which to orient the points
 void ConvexHullCollider_GetOrientedWorldPoints(Vector** dest, const ColliderData_ConvexHull* collider, const FrameOfReference* frame);
 
+///
+//Gets the points of the collider oriented in world space to match a given frame of reference as a flat array of components
+//
+//Parameters:
+//	dest: An array of 3 floats per point of the collider to store the oriented collider points
+//	collider: The collider of which to orient the points of
+//	frame: The frame of reference with which to orient the points
+void ConvexHullCollider_GetOrientedWorldPointArray(float* dest, const ColliderData_ConvexHull* collider, const FrameOfReference* frame);
+
 ///
 //Gets the points of the collider oriented in model space to match a given frame of reference
 //
@@ -138,6 +374,27 @@ void ConvexHullCollider_GetOrientedAxes(Vector** dest, const ColliderData_Convex
 //	frame: A pointer to the frame of reference with which to orient the edges
 void ConvexHullCollider_GetOrientedEdges(Vector** dest, const ColliderData_ConvexHull* collider, const FrameOfReference* frame);
 
+///
+//Gets the arcs of a convex hull collider oriented to match a given frame of reference
+//
+//Parameters:
+//	dest: An array of arcs with room for every arc of the collider to store the oriented arcs
+//	collider: A pointer to the collider of which to orient the arcs of
+//	frame: A pointer to the frame of reference with which to orient the arcs
+void ConvexHullCollider_GetOrientedArcs(ConvexHullCollider_Arc* dest, const ColliderData_ConvexHull* collider, const FrameOfReference* frame);
+
+///
+//Determines if the edges of two arcs form a face of the Minkowski difference of their hulls.
+//This is the case when the first arc intersects the negation of the second arc on the Gauss map.
+//
+//Parameters:
+//	arc1: A pointer to the oriented arc of an edge of the first hull
+//	arc2: A pointer to the oriented arc of an edge of the second hull
+//
+//Returns:
+//	1 if the edges form a face of the Minkowski difference, else 0
+unsigned char ConvexHullCollider_IsMinkowskiFace(const ConvexHullCollider_Arc* arc1, const ConvexHullCollider_Arc* arc2);
+
 ///
 //Determines the subset set of a convex hull colliders points oriented to a given orientation furthest in a given direction.
 //These points are found in MODEL SPACE! The components of the vectors in the dynamic array POINT TO the components of the vectors in the model oriented points array!
@@ -148,7 +405,37 @@ void ConvexHullCollider_GetOrientedEdges(Vector** dest, const ColliderData_Conve
 //	modelOrientedPoints: An array of pointers to vectors representing the colliders points oriented into modelSpace
 //	frame: The frame to orient the collider's points with
 //	direction: The direction in which the desired set of points are furthest in.
-void ConvexHullCollider_GetFurthestPoints(DynamicArray* dest, const ColliderData_ConvexHull* collider, const Vector** modelOrientedPoints, const Vector* direction);
+//	start: A pointer to the index of the point to climb from, the index of a furthest point is stored in it for the next search along a similar direction.
+//		NULL to climb from the first point.
+void ConvexHullCollider_GetFurthestPoints(DynamicArray* dest, const ColliderData_ConvexHull* collider, const Vector** modelOrientedPoints, const Vector* direction, unsigned int* start);
+
+///
+//Orients the world space cache of a convex hull collider by a frame of reference.
+//Does nothing if the cache was already oriented by a frame of reference matching the one given.
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider to refresh the cache of
+//	frame: A pointer to the frame of reference to orient the cache with
+void ConvexHullCollider_RefreshWorldCache(ColliderData_ConvexHull* collider, const FrameOfReference* frame);
+
+///
+//Determines if the world space cache of a convex hull collider was oriented by a frame of reference matching the one given
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider to check the cache of
+//	frame: A pointer to the frame of reference to check against
+//
+//Returns:
+//	1 if the cache can be read in place of orienting the collider by the frame of reference, else 0
+unsigned char ConvexHullCollider_HasWorldCache(const ColliderData_ConvexHull* collider, const FrameOfReference* frame);
+
+///
+//Marks the world space cache of a convex hull collider as out of date.
+//Must be called after changing the points, axes or edges of a collider in place.
+//
+//Parameters:
+//	collider: A pointer to the convex hull collider to invalidate the cache of
+void ConvexHullCollider_InvalidateWorldCache(ColliderData_ConvexHull* collider);
 
 ///
 //Determines the minimum axis aligned bounding box which can contain the convex hull
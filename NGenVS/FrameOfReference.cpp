@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <string.h>
 
 ///
 //Allocates memory for a Frame of Reference
@@ -185,3 +186,33 @@ void FrameOfReference_SetRotation(FrameOfReference* frame, Matrix* rotation)
 {
 	Matrix_Copy(frame->rotation, rotation);
 }
+
+///
+//Copies a frame of reference into a snapshot
+//
+//Parameters:
+//	dest: The snapshot to copy into, must hold FrameOfReference_SNAPSHOT_SIZE floats
+//	frame: The frame of reference to copy
+void FrameOfReference_TakeSnapshot(float* dest, const FrameOfReference* frame)
+{
+	memcpy(dest, frame->position->components, sizeof(float) * 3);
+	memcpy(dest + 3, frame->rotation->components, sizeof(float) * 9);
+	memcpy(dest + 12, frame->scale->components, sizeof(float) * 9);
+}
+
+///
+//Determines if a frame of reference differs from a snapshot of it
+//
+//Parameters:
+//	snapshot: The snapshot to compare against
+//	frame: The frame of reference to compare
+//
+//Returns:
+//	0 if the frame of reference matches the snapshot
+//	1 if it has changed
+unsigned char FrameOfReference_HasChanged(const float* snapshot, const FrameOfReference* frame)
+{
+	return memcmp(snapshot, frame->position->components, sizeof(float) * 3) != 0
+		|| memcmp(snapshot + 3, frame->rotation->components, sizeof(float) * 9) != 0
+		|| memcmp(snapshot + 12, frame->scale->components, sizeof(float) * 9) != 0;
+}
@@ -3,6 +3,10 @@
 
 #include "Matrix.h"
 
+//The number of floats needed to take a snapshot of a frame of reference
+//3 for the position, 9 for the rotation and 9 for the scale
+#define FrameOfReference_SNAPSHOT_SIZE 21
+
 typedef struct FrameOfReference
 {
 	Matrix* scale;
@@ -92,4 +96,24 @@ void FrameOfReference_SetPosition(FrameOfReference* frame, const Vector* positio
 //  position: The rotation to set the frame to
 void FrameOfReference_SetRotation(FrameOfReference* frame, Matrix* rotation);
 
+///
+//Copies a frame of reference into a snapshot
+//
+//Parameters:
+//	dest: The snapshot to copy into, must hold FrameOfReference_SNAPSHOT_SIZE floats
+//	frame: The frame of reference to copy
+void FrameOfReference_TakeSnapshot(float* dest, const FrameOfReference* frame);
+
+///
+//Determines if a frame of reference differs from a snapshot of it
+//
+//Parameters:
+//	snapshot: The snapshot to compare against
+//	frame: The frame of reference to compare
+//
+//Returns:
+//	0 if the frame of reference matches the snapshot
+//	1 if it has changed
+unsigned char FrameOfReference_HasChanged(const float* snapshot, const FrameOfReference* frame);
+
 #endif
\ No newline at end of file
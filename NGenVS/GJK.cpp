@@ -0,0 +1,467 @@
+#include "GJK.h"
+
+#include <math.h>
+#include <float.h>
+#include <string.h>
+
+#include "Vector.h"
+
+///
+//Determines if two convex shapes intersect with the Gilbert-Johnson-Keerthi algorithm,
+//searching the Minkowski difference of the shapes for a tetrahedron which encloses the origin
+//
+//Parameters:
+//	dest: A pointer to a simplex to store the tetrahedron enclosing the origin in if the shapes intersect
+//	shape1: A pointer to the first shape
+//	shape2: A pointer to the second shape
+//	direction: An array of 3 floats containing the direction to start searching in, such as the displacement between the shapes
+//
+//Returns:
+//	1 if the shapes intersect, else 0
+unsigned char GJK_TestIntersection(GJK_Simplex* dest, const GJK_Shape* shape1, const GJK_Shape* shape2, const float* direction)
+{
+	float searchDirection[3];
+	Vector_CopyArray(searchDirection, direction, 3);
+	if(Vector_GetMagSqFromArray(searchDirection, 3) == 0.0f)
+	{
+		searchDirection[0] = 1.0f;
+	}
+
+	GJK_Support(dest->points[0], shape1, shape2, searchDirection);
+	dest->numPoints = 1;
+	Vector_GetScalarProductFromArray(searchDirection, dest->points[0], -1.0f, 3);
+
+	for(int i = 0; i < GJK_MAX_ITERATIONS; i++)
+	{
+		//The origin lies on the simplex, so the shapes are only touching
+		if(Vector_GetMagSqFromArray(searchDirection, 3) == 0.0f) return 0;
+
+		float* point = dest->points[dest->numPoints];
+		GJK_Support(point, shape1, shape2, searchDirection);
+
+		//The furthest point towards the origin falls short of it, so the origin is outside of the Minkowski difference
+		if(Vector_DotProductArray(point, searchDirection, 3) < 0.0f) return 0;
+
+		dest->numPoints++;
+		if(GJK_UpdateSimplex(dest, searchDirection)) return 1;
+	}
+
+	//The simplex is stuck circling the origin, which only happens when the shapes are barely touching
+	return 0;
+}
+
+///
+//Determines the penetration of two intersecting convex shapes with the expanding polytope algorithm,
+//expanding the tetrahedron found by GJK until it reaches the face of the Minkowski difference closest to the origin
+//
+//Parameters:
+//	normal: An array of 3 floats to store the unit direction in which shape1 must be moved to separate the shapes
+//	depth: A pointer to store the distance shape1 must be moved to separate the shapes
+//	simplex: A pointer to the simplex enclosing the origin found by GJK_TestIntersection
+//	shape1: A pointer to the first shape
+//	shape2: A pointer to the second shape
+void GJK_GetPenetration(float* normal, float* depth, const GJK_Simplex* simplex, const GJK_Shape* shape1, const GJK_Shape* shape2)
+{
+	GJK_Face faces[GJK_MAX_EPA_FACES];
+	unsigned int numFaces = 0;
+
+	//Wind the faces of the tetrahedron so that each normal points away from the opposite corner
+	static const int tetrahedronFaces[4][4] = { { 0, 1, 2, 3 }, { 0, 2, 3, 1 }, { 0, 3, 1, 2 }, { 1, 3, 2, 0 } };
+	for(int i = 0; i < 4; i++)
+	{
+		const float* a = simplex->points[tetrahedronFaces[i][0]];
+		const float* b = simplex->points[tetrahedronFaces[i][1]];
+		const float* c = simplex->points[tetrahedronFaces[i][2]];
+		const float* opposite = simplex->points[tetrahedronFaces[i][3]];
+
+		float toOpposite[3];
+		Vector_SubtractArray(toOpposite, opposite, a, 3);
+
+		float edge1[3], edge2[3], faceNormal[3];
+		Vector_SubtractArray(edge1, b, a, 3);
+		Vector_SubtractArray(edge2, c, a, 3);
+		Vector_CrossProduct3Array(faceNormal, edge1, edge2);
+
+		unsigned char added = Vector_DotProductArray(faceNormal, toOpposite, 3) > 0.0f ? GJK_InitializeFace(faces + numFaces, a, c, b) : GJK_InitializeFace(faces + numFaces, a, b, c);
+		if(added) numFaces++;
+	}
+
+	for(int iteration = 0; iteration < GJK_MAX_EPA_ITERATIONS && numFaces > 0; iteration++)
+	{
+		unsigned int closest = GJK_FindClosestFace(faces, numFaces);
+
+		//The closest face is on the boundary of the Minkowski difference once the polytope can't be expanded past it
+		float point[3];
+		GJK_Support(point, shape1, shape2, faces[closest].normal);
+		if(Vector_DotProductArray(point, faces[closest].normal, 3) - faces[closest].distance < GJK_EPA_TOLERANCE) break;
+
+		//Find the faces which can see the new point, the edges they share with the rest of the polytope form the horizon
+		unsigned char visible[GJK_MAX_EPA_FACES];
+		unsigned int numVisible = 0;
+		float edges[GJK_MAX_EPA_EDGES][2][3];
+		unsigned int numEdges = 0;
+		unsigned char overflow = 0;
+
+		for(unsigned int i = 0; i < numFaces && !overflow; i++)
+		{
+			float toPoint[3];
+			Vector_SubtractArray(toPoint, point, faces[i].points[0], 3);
+			visible[i] = Vector_DotProductArray(faces[i].normal, toPoint, 3) > 0.0f;
+
+			if(visible[i])
+			{
+				numVisible++;
+				for(int j = 0; j < 3 && !overflow; j++)
+				{
+					overflow = !GJK_AddHorizonEdge(edges, &numEdges, faces[i].points[j], faces[i].points[(j + 1) % 3]);
+				}
+			}
+		}
+
+		//The polytope can't grow any further, settle on the closest face found
+		if(overflow || numFaces - numVisible + numEdges > GJK_MAX_EPA_FACES) break;
+
+		//Replace the visible faces with faces joining the horizon to the new point
+		unsigned int numKept = 0;
+		for(unsigned int i = 0; i < numFaces; i++)
+		{
+			if(!visible[i])
+			{
+				if(numKept != i) faces[numKept] = faces[i];
+				numKept++;
+			}
+		}
+		numFaces = numKept;
+
+		for(unsigned int i = 0; i < numEdges; i++)
+		{
+			if(GJK_InitializeFace(faces + numFaces, edges[i][0], edges[i][1], point)) numFaces++;
+		}
+	}
+
+	if(numFaces == 0)
+	{
+		//Every face of the polytope was degenerate, the shapes are only touching
+		Vector_ZeroArray(normal, 3);
+		*depth = 0.0f;
+		return;
+	}
+
+	//The polytope is rebuilt after it's closest face is found when the iterations run out, so find it again
+	unsigned int closest = GJK_FindClosestFace(faces, numFaces);
+
+	//Moving shape1 against the normal of the closest face moves the face onto the origin
+	Vector_GetScalarProductFromArray(normal, faces[closest].normal, -1.0f, 3);
+	*depth = faces[closest].distance;
+}
+
+///
+//Finds the point of the Minkowski difference of two shapes furthest in a direction
+//
+//Parameters:
+//	dest: An array of 3 floats to store the point in
+//	shape1: A pointer to the shape being subtracted from
+//	shape2: A pointer to the shape being subtracted
+//	direction: An array of 3 floats containing the direction to search in, need not be normalized
+static void GJK_Support(float* dest, const GJK_Shape* shape1, const GJK_Shape* shape2, const float* direction)
+{
+	float oppositeDirection[3];
+	Vector_GetScalarProductFromArray(oppositeDirection, direction, -1.0f, 3);
+
+	Vector_SubtractArray(dest, GJK_GetFurthestPoint(shape1, direction), GJK_GetFurthestPoint(shape2, oppositeDirection), 3);
+}
+
+///
+//Finds the point of a shape furthest in a direction
+//
+//Parameters:
+//	shape: A pointer to the shape to search
+//	direction: An array of 3 floats containing the direction to search in, need not be normalized
+//
+//Returns:
+//	A pointer to the 3 components of the furthest point
+static const float* GJK_GetFurthestPoint(const GJK_Shape* shape, const float* direction)
+{
+	const float* furthest = shape->points;
+	float furthestDistance = Vector_DotProductArray(furthest, direction, 3);
+
+	for(unsigned int i = 1; i < shape->numPoints; i++)
+	{
+		const float* point = shape->points + 3 * i;
+		float distance = Vector_DotProductArray(point, direction, 3);
+		if(distance > furthestDistance)
+		{
+			furthest = point;
+			furthestDistance = distance;
+		}
+	}
+
+	return furthest;
+}
+
+///
+//Reduces a simplex to it's feature closest to the origin & determines the direction to search for the next point in
+//
+//Parameters:
+//	simplex: A pointer to the simplex to update, the newest point must be last
+//	direction: An array of 3 floats to store the next direction to search in
+//
+//Returns:
+//	1 if the simplex encloses the origin, else 0
+static unsigned char GJK_UpdateSimplex(GJK_Simplex* simplex, float* direction)
+{
+	switch(simplex->numPoints)
+	{
+	case 2:
+		GJK_UpdateLine(simplex, direction);
+		return 0;
+	case 3:
+		GJK_UpdateTriangle(simplex, direction);
+		return 0;
+	default:
+		return GJK_UpdateTetrahedron(simplex, direction);
+	}
+}
+
+///
+//Reduces a simplex of two points to it's feature closest to the origin
+//
+//Parameters:
+//	simplex: A pointer to the simplex to update
+//	direction: An array of 3 floats to store the next direction to search in
+static void GJK_UpdateLine(GJK_Simplex* simplex, float* direction)
+{
+	const float* a = simplex->points[1];
+	const float* b = simplex->points[0];
+
+	float ab[3], ao[3];
+	Vector_SubtractArray(ab, b, a, 3);
+	Vector_GetScalarProductFromArray(ao, a, -1.0f, 3);
+
+	if(Vector_DotProductArray(ab, ao, 3) > 0.0f)
+	{
+		//The origin is beside the line, search perpendicular to the line towards the origin
+		GJK_TripleProduct(direction, ab, ao, ab);
+
+		if(Vector_GetMagSqFromArray(direction, 3) == 0.0f)
+		{
+			//The origin is on the line, search in any direction perpendicular to it
+			float axis[3] = { 0.0f, 0.0f, 0.0f };
+			int smallest = fabsf(ab[0]) < fabsf(ab[1]) ? (fabsf(ab[0]) < fabsf(ab[2]) ? 0 : 2) : (fabsf(ab[1]) < fabsf(ab[2]) ? 1 : 2);
+			axis[smallest] = 1.0f;
+			Vector_CrossProduct3Array(direction, ab, axis);
+		}
+	}
+	else
+	{
+		//The origin is past the newest point
+		Vector_CopyArray(simplex->points[0], a, 3);
+		simplex->numPoints = 1;
+		Vector_CopyArray(direction, ao, 3);
+	}
+}
+
+///
+//Reduces a simplex of three points to it's feature closest to the origin
+//
+//Parameters:
+//	simplex: A pointer to the simplex to update
+//	direction: An array of 3 floats to store the next direction to search in
+static void GJK_UpdateTriangle(GJK_Simplex* simplex, float* direction)
+{
+	float a[3], b[3], c[3];
+	Vector_CopyArray(a, simplex->points[2], 3);
+	Vector_CopyArray(b, simplex->points[1], 3);
+	Vector_CopyArray(c, simplex->points[0], 3);
+
+	float ab[3], ac[3], ao[3], abc[3];
+	Vector_SubtractArray(ab, b, a, 3);
+	Vector_SubtractArray(ac, c, a, 3);
+	Vector_GetScalarProductFromArray(ao, a, -1.0f, 3);
+	Vector_CrossProduct3Array(abc, ab, ac);
+
+	float edgeNormal[3];
+	Vector_CrossProduct3Array(edgeNormal, abc, ac);
+	if(Vector_DotProductArray(edgeNormal, ao, 3) > 0.0f)
+	{
+		if(Vector_DotProductArray(ac, ao, 3) > 0.0f)
+		{
+			//The origin is beside edge ac
+			Vector_CopyArray(simplex->points[0], c, 3);
+			Vector_CopyArray(simplex->points[1], a, 3);
+		}
+		else
+		{
+			//The origin is beside edge ab or past the newest point
+			Vector_CopyArray(simplex->points[0], b, 3);
+			Vector_CopyArray(simplex->points[1], a, 3);
+		}
+		simplex->numPoints = 2;
+		GJK_UpdateLine(simplex, direction);
+		return;
+	}
+
+	Vector_CrossProduct3Array(edgeNormal, ab, abc);
+	if(Vector_DotProductArray(edgeNormal, ao, 3) > 0.0f)
+	{
+		//The origin is beside edge ab or past the newest point
+		Vector_CopyArray(simplex->points[0], b, 3);
+		Vector_CopyArray(simplex->points[1], a, 3);
+		simplex->numPoints = 2;
+		GJK_UpdateLine(simplex, direction);
+		return;
+	}
+
+	//The origin is above or below the triangle, wind the triangle so it's normal faces the origin
+	if(Vector_DotProductArray(abc, ao, 3) >= 0.0f)
+	{
+		Vector_CopyArray(direction, abc, 3);
+	}
+	else
+	{
+		Vector_CopyArray(simplex->points[0], b, 3);
+		Vector_CopyArray(simplex->points[1], c, 3);
+		Vector_GetScalarProductFromArray(direction, abc, -1.0f, 3);
+	}
+}
+
+///
+//Reduces a simplex of four points to it's feature closest to the origin
+//
+//Parameters:
+//	simplex: A pointer to the simplex to update
+//	direction: An array of 3 floats to store the next direction to search in
+//
+//Returns:
+//	1 if the tetrahedron encloses the origin, else 0
+static unsigned char GJK_UpdateTetrahedron(GJK_Simplex* simplex, float* direction)
+{
+	//The triangle bcd was wound to face the new point a
+	float a[3], b[3], c[3], d[3];
+	Vector_CopyArray(a, simplex->points[3], 3);
+	Vector_CopyArray(b, simplex->points[2], 3);
+	Vector_CopyArray(c, simplex->points[1], 3);
+	Vector_CopyArray(d, simplex->points[0], 3);
+
+	float ab[3], ac[3], ad[3], ao[3], faceNormal[3];
+	Vector_SubtractArray(ab, b, a, 3);
+	Vector_SubtractArray(ac, c, a, 3);
+	Vector_SubtractArray(ad, d, a, 3);
+	Vector_GetScalarProductFromArray(ao, a, -1.0f, 3);
+
+	//Check whether the origin is outside of each face touching the new point
+	const float* faces[3][2] = { { b, c }, { c, d }, { d, b } };
+	const float* edges[3][2] = { { ab, ac }, { ac, ad }, { ad, ab } };
+	for(int i = 0; i < 3; i++)
+	{
+		Vector_CrossProduct3Array(faceNormal, edges[i][0], edges[i][1]);
+		if(Vector_DotProductArray(faceNormal, ao, 3) > 0.0f)
+		{
+			Vector_CopyArray(simplex->points[0], faces[i][1], 3);
+			Vector_CopyArray(simplex->points[1], faces[i][0], 3);
+			Vector_CopyArray(simplex->points[2], a, 3);
+			simplex->numPoints = 3;
+			GJK_UpdateTriangle(simplex, direction);
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+///
+//Initializes a face of the EPA polytope
+//The normal of the face is taken from the winding of it's corners.
+//
+//Parameters:
+//	face: A pointer to the face to initialize
+//	a: An array of 3 floats containing the first corner of the face
+//	b: An array of 3 floats containing the second corner of the face
+//	c: An array of 3 floats containing the third corner of the face
+//
+//Returns:
+//	0 if the face is degenerate, else 1
+static unsigned char GJK_InitializeFace(GJK_Face* face, const float* a, const float* b, const float* c)
+{
+	float ab[3], ac[3];
+	Vector_SubtractArray(ab, b, a, 3);
+	Vector_SubtractArray(ac, c, a, 3);
+	Vector_CrossProduct3Array(face->normal, ab, ac);
+
+	float area = Vector_GetMagFromArray(face->normal, 3);
+	if(area <= FLT_EPSILON * (Vector_GetMagSqFromArray(ab, 3) + Vector_GetMagSqFromArray(ac, 3))) return 0;
+
+	Vector_ScaleArray(face->normal, 1.0f / area, 3);
+	face->distance = Vector_DotProductArray(face->normal, a, 3);
+
+	Vector_CopyArray(face->points[0], a, 3);
+	Vector_CopyArray(face->points[1], b, 3);
+	Vector_CopyArray(face->points[2], c, 3);
+	return 1;
+}
+
+///
+//Finds the face of the EPA polytope closest to the origin
+//
+//Parameters:
+//	faces: An array of the faces of the polytope
+//	numFaces: The number of faces in the array, at least 1
+//
+//Returns:
+//	The index of the closest face
+static unsigned int GJK_FindClosestFace(const GJK_Face* faces, unsigned int numFaces)
+{
+	unsigned int closest = 0;
+	for(unsigned int i = 1; i < numFaces; i++)
+	{
+		if(faces[i].distance < faces[closest].distance) closest = i;
+	}
+	return closest;
+}
+
+///
+//Adds an edge to the horizon of the EPA polytope, removing it instead if the opposite edge is already on the horizon
+//
+//Parameters:
+//	edges: An array of edges, each made of two points of 3 floats
+//	numEdges: A pointer to the number of edges in the array
+//	a: An array of 3 floats containing the start of the edge
+//	b: An array of 3 floats containing the end of the edge
+//
+//Returns:
+//	0 if the array of edges is full, else 1
+static unsigned char GJK_AddHorizonEdge(float (*edges)[2][3], unsigned int* numEdges, const float* a, const float* b)
+{
+	//An edge shared by two visible faces appears once in each direction and is not part of the horizon
+	for(unsigned int i = 0; i < *numEdges; i++)
+	{
+		if(memcmp(edges[i][0], b, 3 * sizeof(float)) == 0 && memcmp(edges[i][1], a, 3 * sizeof(float)) == 0)
+		{
+			(*numEdges)--;
+			memcpy(edges[i], edges[*numEdges], sizeof(edges[i]));
+			return 1;
+		}
+	}
+
+	if(*numEdges == GJK_MAX_EPA_EDGES) return 0;
+
+	Vector_CopyArray(edges[*numEdges][0], a, 3);
+	Vector_CopyArray(edges[*numEdges][1], b, 3);
+	(*numEdges)++;
+	return 1;
+}
+
+///
+//Computes the triple product (a x b) x c of three 3 dimensional vectors
+//
+//Parameters:
+//	dest: An array of 3 floats to store the product in, must not alias any operand
+//	a: An array of 3 floats containing the first operand
+//	b: An array of 3 floats containing the second operand
+//	c: An array of 3 floats containing the third operand
+static void GJK_TripleProduct(float* dest, const float* a, const float* b, const float* c)
+{
+	float ab[3];
+	Vector_CrossProduct3Array(ab, a, b);
+	Vector_CrossProduct3Array(dest, ab, c);
+}
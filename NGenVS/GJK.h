@@ -0,0 +1,178 @@
+#ifndef GJK_H
+#define GJK_H
+
+//The most iterations GJK takes to enclose the origin before giving up
+#define GJK_MAX_ITERATIONS 64
+//The most iterations EPA takes to expand it's polytope before settling on the closest face found so far
+#define GJK_MAX_EPA_ITERATIONS 64
+//The most faces the EPA polytope can have
+#define GJK_MAX_EPA_FACES 128
+//The most horizon edges the EPA polytope can have when expanding towards a new point
+#define GJK_MAX_EPA_EDGES 64
+//EPA stops once the polytope can not be expanded further than this past it's closest face
+#define GJK_EPA_TOLERANCE 0.0001f
+
+//A convex shape given by the points of it's hull in world space
+typedef struct GJK_Shape
+{
+	const float* points;			//Points of the hull, each three consecutive floats form a point
+	unsigned int numPoints;			//Number of points in the hull
+} GJK_Shape;
+
+//A simplex of points on the Minkowski difference of two shapes, built up by GJK
+typedef struct GJK_Simplex
+{
+	float points[4][3];				//Points of the simplex, the newest point is last
+	unsigned int numPoints;			//Number of points in the simplex
+} GJK_Simplex;
+
+//A triangular face of the polytope EPA expands within the Minkowski difference of two shapes
+typedef struct GJK_Face
+{
+	float points[3][3];				//Corners of the face, wound counter clockwise when seen from outside the polytope
+	float normal[3];				//Unit normal of the face pointing out of the polytope
+	float distance;					//Distance from the origin to the plane of the face
+} GJK_Face;
+
+///
+//Internals
+///
+
+///
+//Finds the point of the Minkowski difference of two shapes furthest in a direction
+//
+//Parameters:
+//	dest: An array of 3 floats to store the point in
+//	shape1: A pointer to the shape being subtracted from
+//	shape2: A pointer to the shape being subtracted
+//	direction: An array of 3 floats containing the direction to search in, need not be normalized
+static void GJK_Support(float* dest, const GJK_Shape* shape1, const GJK_Shape* shape2, const float* direction);
+
+///
+//Finds the point of a shape furthest in a direction
+//
+//Parameters:
+//	shape: A pointer to the shape to search
+//	direction: An array of 3 floats containing the direction to search in, need not be normalized
+//
+//Returns:
+//	A pointer to the 3 components of the furthest point
+static const float* GJK_GetFurthestPoint(const GJK_Shape* shape, const float* direction);
+
+///
+//Reduces a simplex to it's feature closest to the origin & determines the direction to search for the next point in
+//
+//Parameters:
+//	simplex: A pointer to the simplex to update, the newest point must be last
+//	direction: An array of 3 floats to store the next direction to search in
+//
+//Returns:
+//	1 if the simplex encloses the origin, else 0
+static unsigned char GJK_UpdateSimplex(GJK_Simplex* simplex, float* direction);
+
+///
+//Reduces a simplex of two points to it's feature closest to the origin
+//
+//Parameters:
+//	simplex: A pointer to the simplex to update
+//	direction: An array of 3 floats to store the next direction to search in
+static void GJK_UpdateLine(GJK_Simplex* simplex, float* direction);
+
+///
+//Reduces a simplex of three points to it's feature closest to the origin
+//
+//Parameters:
+//	simplex: A pointer to the simplex to update
+//	direction: An array of 3 floats to store the next direction to search in
+static void GJK_UpdateTriangle(GJK_Simplex* simplex, float* direction);
+
+///
+//Reduces a simplex of four points to it's feature closest to the origin
+//
+//Parameters:
+//	simplex: A pointer to the simplex to update
+//	direction: An array of 3 floats to store the next direction to search in
+//
+//Returns:
+//	1 if the tetrahedron encloses the origin, else 0
+static unsigned char GJK_UpdateTetrahedron(GJK_Simplex* simplex, float* direction);
+
+///
+//Initializes a face of the EPA polytope
+//The normal of the face is taken from the winding of it's corners.
+//
+//Parameters:
+//	face: A pointer to the face to initialize
+//	a: An array of 3 floats containing the first corner of the face
+//	b: An array of 3 floats containing the second corner of the face
+//	c: An array of 3 floats containing the third corner of the face
+//
+//Returns:
+//	0 if the face is degenerate, else 1
+static unsigned char GJK_InitializeFace(GJK_Face* face, const float* a, const float* b, const float* c);
+
+///
+//Finds the face of the EPA polytope closest to the origin
+//
+//Parameters:
+//	faces: An array of the faces of the polytope
+//	numFaces: The number of faces in the array, at least 1
+//
+//Returns:
+//	The index of the closest face
+static unsigned int GJK_FindClosestFace(const GJK_Face* faces, unsigned int numFaces);
+
+///
+//Adds an edge to the horizon of the EPA polytope, removing it instead if the opposite edge is already on the horizon
+//
+//Parameters:
+//	edges: An array of edges, each made of two points of 3 floats
+//	numEdges: A pointer to the number of edges in the array
+//	a: An array of 3 floats containing the start of the edge
+//	b: An array of 3 floats containing the end of the edge
+//
+//Returns:
+//	0 if the array of edges is full, else 1
+static unsigned char GJK_AddHorizonEdge(float (*edges)[2][3], unsigned int* numEdges, const float* a, const float* b);
+
+///
+//Computes the triple product (a x b) x c of three 3 dimensional vectors
+//
+//Parameters:
+//	dest: An array of 3 floats to store the product in, must not alias any operand
+//	a: An array of 3 floats containing the first operand
+//	b: An array of 3 floats containing the second operand
+//	c: An array of 3 floats containing the third operand
+static void GJK_TripleProduct(float* dest, const float* a, const float* b, const float* c);
+
+///
+//Functions
+///
+
+///
+//Determines if two convex shapes intersect with the Gilbert-Johnson-Keerthi algorithm,
+//searching the Minkowski difference of the shapes for a tetrahedron which encloses the origin
+//
+//Parameters:
+//	dest: A pointer to a simplex to store the tetrahedron enclosing the origin in if the shapes intersect
+//	shape1: A pointer to the first shape
+//	shape2: A pointer to the second shape
+//	direction: An array of 3 floats containing the direction to start searching in, such as the displacement between the shapes
+//
+//Returns:
+//	1 if the shapes intersect, else 0
+unsigned char GJK_TestIntersection(GJK_Simplex* dest, const GJK_Shape* shape1, const GJK_Shape* shape2, const float* direction);
+
+///
+//Determines the penetration of two intersecting convex shapes with the expanding polytope algorithm,
+//expanding the tetrahedron found by GJK until it reaches the face of the Minkowski difference closest to the origin
+//
+//Parameters:
+//	normal: An array of 3 floats to store the unit direction in which shape1 must be moved to separate the shapes
+//	depth: A pointer to store the distance shape1 must be moved to separate the shapes
+//	simplex: A pointer to the simplex enclosing the origin found by GJK_TestIntersection
+//	shape1: A pointer to the first shape
+//	shape2: A pointer to the second shape
+void GJK_GetPenetration(float* normal, float* depth, const GJK_Simplex* simplex, const GJK_Shape* shape1, const GJK_Shape* shape2);
+
+#endif
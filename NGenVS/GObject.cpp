@@ -18,6 +18,8 @@ GObject* GObject_Allocate(void)
 //	GO: The Game Object to initialize
 void GObject_Initialize(GObject* GO)
 {
+	GO->id = GObject_nextID++;
+
 	GO->frameOfReference = FrameOfReference_Allocate();
 	FrameOfReference_Initialize(GO->frameOfReference);
 
@@ -31,6 +33,7 @@ void GObject_Initialize(GObject* GO)
 	GO->texture = NULL;
 	GO->body = NULL;
 	GO->collider = NULL;
+	GO->treeMembership = NULL;
 
 
 }
@@ -11,8 +11,11 @@
 
 #include "Collider.h"
 
+struct OctTree_Membership;
+
 typedef struct GObject
 {
+	unsigned int id;	//Unique, non zero identifier of this game object
 	FrameOfReference* frameOfReference;
 	Mesh* mesh;
 	Texture* texture;
@@ -20,9 +23,14 @@ typedef struct GObject
 	RigidBody* body;
 	Collider* collider;
 
+	struct OctTree_Membership* treeMembership;	//The nodes of an oct tree holding this object, NULL if it is in none
+
 	Matrix* colorMatrix;
 } GObject;
 
+//Internals
+static unsigned int GObject_nextID = 1;	//Identifier given to the next game object initialized
+
 ///
 //Allocates memory for a new Game Object
 //
@@ -0,0 +1,461 @@
+#include "LinearOctTree.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+///
+//Allocates memory for a new linear oct tree
+//
+//Returns:
+//	Pointer to a newly allocated linear oct tree
+LinearOctTree* LinearOctTree_Allocate(void)
+{
+	LinearOctTree* tree = (LinearOctTree*)malloc(sizeof(LinearOctTree));
+	return tree;
+}
+
+///
+//Initializes a linear oct tree bounded by a cube
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree to initialize
+//	left: The left bound of the cube
+//	bottom: The bottom bound of the cube
+//	back: The back bound of the cube
+//	size: The width of the cube
+//	maxDepth: The deepest level of the tree, at most LinearOctTree_MAX_DEPTH
+void LinearOctTree_Initialize(LinearOctTree* tree, float left, float bottom, float back, float size, unsigned int maxDepth)
+{
+	tree->origin[0] = left;
+	tree->origin[1] = bottom;
+	tree->origin[2] = back;
+	tree->size = size;
+	tree->maxDepth = maxDepth < LinearOctTree_MAX_DEPTH ? maxDepth : LinearOctTree_MAX_DEPTH;
+
+	tree->proxies = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->proxies, sizeof(LinearOctTree_Proxy));
+
+	tree->order = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->order, sizeof(unsigned int));
+
+	tree->scratch = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->scratch, sizeof(unsigned int));
+
+	tree->blockCounts = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->blockCounts, sizeof(unsigned int) * 256);
+
+	tree->nodes = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->nodes, sizeof(LinearOctTree_Node));
+
+	tree->built = 0;
+}
+
+///
+//Frees resources allocated by a linear oct tree
+//Does not free the objects being tracked.
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree to free
+void LinearOctTree_Free(LinearOctTree* tree)
+{
+	DynamicArray_Free(tree->proxies);
+	DynamicArray_Free(tree->order);
+	DynamicArray_Free(tree->scratch);
+	DynamicArray_Free(tree->blockCounts);
+	DynamicArray_Free(tree->nodes);
+	free(tree);
+}
+
+///
+//Adds an object to a linear oct tree
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree to add the object to
+//	obj: A pointer to the object to add (Must have collider attached)
+void LinearOctTree_Add(LinearOctTree* tree, GObject* obj)
+{
+	LinearOctTree_Proxy proxy;
+	proxy.obj = obj;
+	LinearOctTree_UpdateProxy(tree, &proxy);
+
+	DynamicArray_Append(tree->proxies, &proxy);
+	tree->built = 0;
+}
+
+///
+//Removes an object from a linear oct tree
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree to remove the object from
+//	obj: A pointer to the object to remove
+void LinearOctTree_Remove(LinearOctTree* tree, GObject* obj)
+{
+	LinearOctTree_Proxy* proxies = (LinearOctTree_Proxy*)tree->proxies->data;
+
+	unsigned int index;
+	for(index = 0; index < tree->proxies->size; index++)
+	{
+		if(proxies[index].obj == obj) break;
+	}
+	if(index == tree->proxies->size) return;
+
+	//The last proxy is moved into the removed proxy's place
+	proxies[index] = proxies[tree->proxies->size - 1];
+	tree->proxies->size--;
+	tree->built = 0;
+}
+
+///
+//Updates the bounds of all objects in a linear oct tree, the tree is rebuilt by the next query
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree to update
+void LinearOctTree_Update(LinearOctTree* tree)
+{
+	LinearOctTree_Proxy* proxies = (LinearOctTree_Proxy*)tree->proxies->data;
+	for(unsigned int i = 0; i < tree->proxies->size; i++)
+	{
+		LinearOctTree_UpdateProxy(tree, proxies + i);
+	}
+
+	tree->built = 0;
+}
+
+///
+//Finds all pairs of objects in a linear oct tree whose bounds overlap
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree to query
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to,
+//		each two consecutive objects appended form a pair
+//	pool: A pointer to the worker pool to sort the keys on if the tree must be rebuilt
+void LinearOctTree_QueryPairs(LinearOctTree* tree, DynamicArray* dest, WorkerPool* pool)
+{
+	//Objects were added, removed or moved since the last rebuild
+	if(!tree->built)
+	{
+		LinearOctTree_Rebuild(tree, pool);
+	}
+
+	LinearOctTree_Node* nodes = (LinearOctTree_Node*)tree->nodes->data;
+	for(unsigned int i = 0; i < tree->nodes->size; i++)
+	{
+		//Pairs within the node
+		LinearOctTree_QueryNodePairs(tree, nodes + i, nodes + i, dest);
+
+		//Pairs with each ancestor of the node, removing the last level of the key moves to the parent
+		for(unsigned int key = nodes[i].key >> 3; key != 0; key >>= 3)
+		{
+			LinearOctTree_Node* ancestor = LinearOctTree_FindNode(tree, key);
+			if(ancestor != NULL)
+			{
+				LinearOctTree_QueryNodePairs(tree, nodes + i, ancestor, dest);
+			}
+		}
+	}
+}
+
+///
+//Sorts the proxies of a linear oct tree by key and collects the nodes holding them
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree to rebuild
+//	pool: A pointer to the worker pool to sort the keys on
+static void LinearOctTree_Rebuild(LinearOctTree* tree, WorkerPool* pool)
+{
+	unsigned int numProxies = tree->proxies->size;
+
+	//Start from the identity order
+	while(tree->order->capacity < numProxies) DynamicArray_Grow(tree->order);
+	while(tree->scratch->capacity < numProxies) DynamicArray_Grow(tree->scratch);
+	tree->order->size = numProxies;
+	tree->scratch->size = numProxies;
+
+	unsigned int* order = (unsigned int*)tree->order->data;
+	for(unsigned int i = 0; i < numProxies; i++)
+	{
+		order[i] = i;
+	}
+
+	LinearOctTree_SortKeys(tree, pool);
+
+	//Each run of equal keys forms a node
+	LinearOctTree_Proxy* proxies = (LinearOctTree_Proxy*)tree->proxies->data;
+	order = (unsigned int*)tree->order->data;
+	tree->nodes->size = 0;
+	for(unsigned int i = 0; i < numProxies; i++)
+	{
+		unsigned int key = proxies[order[i]].key;
+		if(tree->nodes->size > 0)
+		{
+			LinearOctTree_Node* last = (LinearOctTree_Node*)tree->nodes->data + (tree->nodes->size - 1);
+			if(last->key == key)
+			{
+				last->count++;
+				continue;
+			}
+		}
+
+		LinearOctTree_Node node;
+		node.key = key;
+		node.start = i;
+		node.count = 1;
+		DynamicArray_Append(tree->nodes, &node);
+	}
+
+	tree->built = 1;
+}
+
+///
+//Sorts the indices of the proxies of a linear oct tree by their keys with a least significant digit radix sort
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree to sort the indices of
+//	pool: A pointer to the worker pool to count & scatter the blocks of keys on
+static void LinearOctTree_SortKeys(LinearOctTree* tree, WorkerPool* pool)
+{
+	LinearOctTree_SortPass pass;
+	pass.proxies = (LinearOctTree_Proxy*)tree->proxies->data;
+	pass.numKeys = tree->order->size;
+	if(pass.numKeys == 0) return;
+
+	//Each block of keys keeps it's own counts
+	unsigned int numBlocks = (pass.numKeys + LinearOctTree_KEYS_PER_BLOCK - 1) / LinearOctTree_KEYS_PER_BLOCK;
+	while(tree->blockCounts->capacity < numBlocks) DynamicArray_Grow(tree->blockCounts);
+	tree->blockCounts->size = numBlocks;
+	pass.counts = (unsigned int*)tree->blockCounts->data;
+
+	//Keys hold at most 31 bits, sort them 8 bits at a time
+	for(pass.shift = 0; pass.shift < 32; pass.shift += 8)
+	{
+		pass.source = (unsigned int*)tree->order->data;
+		pass.dest = (unsigned int*)tree->scratch->data;
+
+		WorkerPool_Run(pool, LinearOctTree_CountBlocks, &pass, numBlocks, 1);
+
+		//Every key shares this digit, the pass would not change the order
+		unsigned int firstDigit = (pass.proxies[pass.source[0]].key >> pass.shift) & 0xFF;
+		unsigned int firstDigitCount = 0;
+		for(unsigned int i = 0; i < numBlocks; i++)
+		{
+			firstDigitCount += pass.counts[256 * i + firstDigit];
+		}
+		if(firstDigitCount == pass.numKeys) continue;
+
+		//Turn the counts into the starts of each digit within each block.
+		//The blocks of a digit follow each other in order, so the scatter keeps the order of the previous digits.
+		unsigned int start = 0;
+		for(unsigned int digit = 0; digit < 256; digit++)
+		{
+			for(unsigned int i = 0; i < numBlocks; i++)
+			{
+				unsigned int count = pass.counts[256 * i + digit];
+				pass.counts[256 * i + digit] = start;
+				start += count;
+			}
+		}
+
+		WorkerPool_Run(pool, LinearOctTree_ScatterBlocks, &pass, numBlocks, 1);
+
+		//The sorted indices become the source of the next pass
+		DynamicArray swap = *tree->order;
+		*tree->order = *tree->scratch;
+		*tree->scratch = swap;
+	}
+}
+
+///
+//Counts the digits of a range of blocks of keys for a pass of a radix sort
+//
+//Parameters:
+//	data: A pointer to the LinearOctTree_SortPass being run
+//	begin: The index of the first block to count
+//	end: The index one past the last block to count
+//	worker: The index of the worker counting the blocks
+static void LinearOctTree_CountBlocks(void* data, unsigned int begin, unsigned int end, unsigned int worker)
+{
+	LinearOctTree_SortPass* pass = (LinearOctTree_SortPass*)data;
+
+	for(unsigned int block = begin; block < end; block++)
+	{
+		unsigned int* counts = pass->counts + 256 * block;
+		memset(counts, 0, sizeof(unsigned int) * 256);
+
+		unsigned int last = (block + 1) * LinearOctTree_KEYS_PER_BLOCK;
+		if(last > pass->numKeys) last = pass->numKeys;
+		for(unsigned int i = block * LinearOctTree_KEYS_PER_BLOCK; i < last; i++)
+		{
+			counts[(pass->proxies[pass->source[i]].key >> pass->shift) & 0xFF]++;
+		}
+	}
+}
+
+///
+//Scatters the indices of a range of blocks of keys to the starts of their digits for a pass of a radix sort
+//
+//Parameters:
+//	data: A pointer to the LinearOctTree_SortPass being run
+//	begin: The index of the first block to scatter
+//	end: The index one past the last block to scatter
+//	worker: The index of the worker scattering the blocks
+static void LinearOctTree_ScatterBlocks(void* data, unsigned int begin, unsigned int end, unsigned int worker)
+{
+	LinearOctTree_SortPass* pass = (LinearOctTree_SortPass*)data;
+
+	for(unsigned int block = begin; block < end; block++)
+	{
+		unsigned int* starts = pass->counts + 256 * block;
+
+		unsigned int last = (block + 1) * LinearOctTree_KEYS_PER_BLOCK;
+		if(last > pass->numKeys) last = pass->numKeys;
+		for(unsigned int i = block * LinearOctTree_KEYS_PER_BLOCK; i < last; i++)
+		{
+			pass->dest[starts[(pass->proxies[pass->source[i]].key >> pass->shift) & 0xFF]++] = pass->source[i];
+		}
+	}
+}
+
+///
+//Determines the key of the smallest node of a linear oct tree whose interior contains a set of bounds
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree
+//	bounds: The bounds to find the node of in the order minX, maxX, minY, maxY, minZ, maxZ
+//
+//Returns:
+//	The key of the node, the root has a key of 1
+static unsigned int LinearOctTree_GetKey(const LinearOctTree* tree, const float* bounds)
+{
+	int numCells = 1 << tree->maxDepth;
+	float cellsPerUnit = numCells / tree->size;
+
+	//Find the cells at the deepest level containing the minimum and maximum of the bounds.
+	//A minimum lying exactly on the border between two cells is placed in the lower one,
+	//so the cell of every level containing both is certain to contain the bounds within it's interior.
+	int minCells[3];
+	int maxCells[3];
+	for(int i = 0; i < 3; i++)
+	{
+		float min = (bounds[2 * i] - tree->origin[i]) * cellsPerUnit;
+		float max = (bounds[2 * i + 1] - tree->origin[i]) * cellsPerUnit;
+		minCells[i] = (int)ceilf(min) - 1;
+		maxCells[i] = (int)floorf(max);
+
+		//Bounds reaching outside of the tree belong to the root
+		if(min <= 0.0f || max >= numCells)
+		{
+			return 1;
+		}
+	}
+
+	//The highest bit in which the cells differ determines how many levels up they share a cell
+	unsigned int difference = (minCells[0] ^ maxCells[0]) | (minCells[1] ^ maxCells[1]) | (minCells[2] ^ maxCells[2]);
+	unsigned int levelsUp = 0;
+	while(difference != 0)
+	{
+		difference >>= 1;
+		levelsUp++;
+	}
+
+	unsigned int depth = tree->maxDepth - levelsUp;
+	unsigned int code = LinearOctTree_SpreadBits(minCells[0] >> levelsUp) |
+		(LinearOctTree_SpreadBits(minCells[1] >> levelsUp) << 1) |
+		(LinearOctTree_SpreadBits(minCells[2] >> levelsUp) << 2);
+
+	return (1u << (3 * depth)) | code;
+}
+
+///
+//Spreads the lower 10 bits of a value out so there are two zero bits between each of them
+//
+//Parameters:
+//	value: The value to spread out
+//
+//Returns:
+//	The spread out bits
+static unsigned int LinearOctTree_SpreadBits(unsigned int value)
+{
+	value &= 0x000003FF;
+	value = (value | (value << 16)) & 0xFF0000FF;
+	value = (value | (value << 8)) & 0x0300F00F;
+	value = (value | (value << 4)) & 0x030C30C3;
+	value = (value | (value << 2)) & 0x09249249;
+	return value;
+}
+
+///
+//Finds the node of a linear oct tree with a key
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree to search
+//	key: The key of the node to find
+//
+//Returns:
+//	A pointer to the node, or NULL if no node with the key holds any objects
+static LinearOctTree_Node* LinearOctTree_FindNode(const LinearOctTree* tree, unsigned int key)
+{
+	LinearOctTree_Node* nodes = (LinearOctTree_Node*)tree->nodes->data;
+
+	//Binary search the pool which is sorted by key
+	unsigned int low = 0;
+	unsigned int high = tree->nodes->size;
+	while(low < high)
+	{
+		unsigned int middle = (low + high) / 2;
+		if(nodes[middle].key < key) low = middle + 1;
+		else high = middle;
+	}
+
+	if(low < tree->nodes->size && nodes[low].key == key) return nodes + low;
+	return NULL;
+}
+
+///
+//Appends the pairs of objects with overlapping bounds between two nodes of a linear oct tree
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree
+//	node1: A pointer to the first node
+//	node2: A pointer to the second node, or the same node to find the pairs within a node
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to
+static void LinearOctTree_QueryNodePairs(const LinearOctTree* tree, const LinearOctTree_Node* node1, const LinearOctTree_Node* node2, DynamicArray* dest)
+{
+	const LinearOctTree_Proxy* proxies = (LinearOctTree_Proxy*)tree->proxies->data;
+	const unsigned int* order = (unsigned int*)tree->order->data;
+
+	for(unsigned int i = 0; i < node1->count; i++)
+	{
+		const LinearOctTree_Proxy* proxy1 = proxies + order[node1->start + i];
+
+		//Within a single node each pair is only considered once
+		unsigned int j = node1 == node2 ? i + 1 : 0;
+		for(; j < node2->count; j++)
+		{
+			const LinearOctTree_Proxy* proxy2 = proxies + order[node2->start + j];
+
+			if(proxy1->bounds[0] <= proxy2->bounds[1] && proxy2->bounds[0] <= proxy1->bounds[1] &&
+				proxy1->bounds[2] <= proxy2->bounds[3] && proxy2->bounds[2] <= proxy1->bounds[3] &&
+				proxy1->bounds[4] <= proxy2->bounds[5] && proxy2->bounds[4] <= proxy1->bounds[5])
+			{
+				DynamicArray_Append(dest, (void*)&proxy1->obj);
+				DynamicArray_Append(dest, (void*)&proxy2->obj);
+			}
+		}
+	}
+}
+
+///
+//Determines the world space bounds of a proxy's object and the key of the node containing it
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree containing the proxy
+//	proxy: A pointer to the proxy to update
+static void LinearOctTree_UpdateProxy(const LinearOctTree* tree, LinearOctTree_Proxy* proxy)
+{
+	GObject* obj = proxy->obj;
+	FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+	Collider_GetWorldBounds(proxy->bounds, obj->collider, frame);
+
+	proxy->key = LinearOctTree_GetKey(tree, proxy->bounds);
+}
@@ -0,0 +1,218 @@
+#ifndef LINEAROCTTREE_H
+#define LINEAROCTTREE_H
+
+#include "GObject.h"
+#include "DynamicArray.h"
+#include "WorkerPool.h"
+
+//The deepest level a linear oct tree can have, limited by the bits of a key
+#define LinearOctTree_MAX_DEPTH 10
+
+//The number of keys in each block of a radix sort pass, the blocks are counted & scattered by the workers
+#define LinearOctTree_KEYS_PER_BLOCK 4096
+
+//An object tracked by a linear oct tree
+typedef struct LinearOctTree_Proxy
+{
+	GObject* obj;				//The object being tracked (Must have collider attached)
+	float bounds[6];			//World space bounds of the object's collider in the order minX, maxX, minY, maxY, minZ, maxZ
+	unsigned int key;			//Key of the node containing the object
+} LinearOctTree_Proxy;
+
+//A node of a linear oct tree which holds at least one object.
+//The bounds of a node are implied by it's key.
+typedef struct LinearOctTree_Node
+{
+	unsigned int key;			//A set bit marking the level of the node followed by the morton code of the node's cell within that level
+	unsigned int start;			//Start of the node's range of objects in the sorted order
+	unsigned int count;			//Number of objects in the node
+} LinearOctTree_Node;
+
+//A pass of the radix sort of a linear oct tree over one digit of the keys.
+//The keys are split into blocks which keep their order, so the blocks can be counted & scattered by any worker
+//while the sort stays stable.
+typedef struct LinearOctTree_SortPass
+{
+	const LinearOctTree_Proxy* proxies;	//Proxies holding the keys being sorted
+	const unsigned int* source;			//Indices of the proxies in the order of the previous digits
+	unsigned int* dest;					//Destination of the indices in the order of this digit
+	unsigned int numKeys;				//Number of indices being sorted
+	unsigned int shift;					//Position of the digit within the keys
+	unsigned int* counts;				//256 counts of each digit per block, turned into the start of each digit per block before scattering
+} LinearOctTree_SortPass;
+
+//An oct tree whose nodes are identified by morton codes rather than linked by pointers.
+//Each object is placed in the smallest cell whose interior contains it.
+//Rather than being updated incrementally, the tree is rebuilt each frame by radix sorting the keys of all objects,
+//which groups the objects of every node together, and collecting the nodes into a single pool sorted by key.
+//Since the cells of two overlapping objects must be nested, pairs are found by checking each node against it's ancestors.
+typedef struct LinearOctTree
+{
+	float origin[3];			//Minimum corner of the cube bounding the tree
+	float size;					//Width of the cube bounding the tree
+	unsigned int maxDepth;		//The deepest level of the tree, at most LinearOctTree_MAX_DEPTH
+
+	DynamicArray* proxies;		//Proxies of the tracked objects, stored by value
+	DynamicArray* order;		//Indices of the proxies sorted by their keys
+	DynamicArray* scratch;		//Scratch space for sorting the indices
+	DynamicArray* blockCounts;	//Digit counts of each block of keys while sorting the indices
+	DynamicArray* nodes;		//Pool of nodes holding objects, sorted by key
+
+	unsigned char built;		//Are the nodes up to date with the proxies
+} LinearOctTree;
+
+///
+//Internals
+///
+
+///
+//Sorts the proxies of a linear oct tree by key and collects the nodes holding them
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree to rebuild
+//	pool: A pointer to the worker pool to sort the keys on
+static void LinearOctTree_Rebuild(LinearOctTree* tree, WorkerPool* pool);
+
+///
+//Sorts the indices of the proxies of a linear oct tree by their keys with a least significant digit radix sort
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree to sort the indices of
+//	pool: A pointer to the worker pool to count & scatter the blocks of keys on
+static void LinearOctTree_SortKeys(LinearOctTree* tree, WorkerPool* pool);
+
+///
+//Counts the digits of a range of blocks of keys for a pass of a radix sort
+//
+//Parameters:
+//	data: A pointer to the LinearOctTree_SortPass being run
+//	begin: The index of the first block to count
+//	end: The index one past the last block to count
+//	worker: The index of the worker counting the blocks
+static void LinearOctTree_CountBlocks(void* data, unsigned int begin, unsigned int end, unsigned int worker);
+
+///
+//Scatters the indices of a range of blocks of keys to the starts of their digits for a pass of a radix sort
+//
+//Parameters:
+//	data: A pointer to the LinearOctTree_SortPass being run
+//	begin: The index of the first block to scatter
+//	end: The index one past the last block to scatter
+//	worker: The index of the worker scattering the blocks
+static void LinearOctTree_ScatterBlocks(void* data, unsigned int begin, unsigned int end, unsigned int worker);
+
+///
+//Determines the key of the smallest node of a linear oct tree whose interior contains a set of bounds
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree
+//	bounds: The bounds to find the node of in the order minX, maxX, minY, maxY, minZ, maxZ
+//
+//Returns:
+//	The key of the node, the root has a key of 1
+static unsigned int LinearOctTree_GetKey(const LinearOctTree* tree, const float* bounds);
+
+///
+//Spreads the lower 10 bits of a value out so there are two zero bits between each of them
+//
+//Parameters:
+//	value: The value to spread out
+//
+//Returns:
+//	The spread out bits
+static unsigned int LinearOctTree_SpreadBits(unsigned int value);
+
+///
+//Finds the node of a linear oct tree with a key
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree to search
+//	key: The key of the node to find
+//
+//Returns:
+//	A pointer to the node, or NULL if no node with the key holds any objects
+static LinearOctTree_Node* LinearOctTree_FindNode(const LinearOctTree* tree, unsigned int key);
+
+///
+//Appends the pairs of objects with overlapping bounds between two nodes of a linear oct tree
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree
+//	node1: A pointer to the first node
+//	node2: A pointer to the second node, or the same node to find the pairs within a node
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to
+static void LinearOctTree_QueryNodePairs(const LinearOctTree* tree, const LinearOctTree_Node* node1, const LinearOctTree_Node* node2, DynamicArray* dest);
+
+///
+//Determines the world space bounds of a proxy's object and the key of the node containing it
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree containing the proxy
+//	proxy: A pointer to the proxy to update
+static void LinearOctTree_UpdateProxy(const LinearOctTree* tree, LinearOctTree_Proxy* proxy);
+
+///
+//Functions
+///
+
+///
+//Allocates memory for a new linear oct tree
+//
+//Returns:
+//	Pointer to a newly allocated linear oct tree
+LinearOctTree* LinearOctTree_Allocate(void);
+
+///
+//Initializes a linear oct tree bounded by a cube
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree to initialize
+//	left: The left bound of the cube
+//	bottom: The bottom bound of the cube
+//	back: The back bound of the cube
+//	size: The width of the cube
+//	maxDepth: The deepest level of the tree, at most LinearOctTree_MAX_DEPTH
+void LinearOctTree_Initialize(LinearOctTree* tree, float left, float bottom, float back, float size, unsigned int maxDepth);
+
+///
+//Frees resources allocated by a linear oct tree
+//Does not free the objects being tracked.
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree to free
+void LinearOctTree_Free(LinearOctTree* tree);
+
+///
+//Adds an object to a linear oct tree
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree to add the object to
+//	obj: A pointer to the object to add (Must have collider attached)
+void LinearOctTree_Add(LinearOctTree* tree, GObject* obj);
+
+///
+//Removes an object from a linear oct tree
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree to remove the object from
+//	obj: A pointer to the object to remove
+void LinearOctTree_Remove(LinearOctTree* tree, GObject* obj);
+
+///
+//Updates the bounds of all objects in a linear oct tree, the tree is rebuilt by the next query
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree to update
+void LinearOctTree_Update(LinearOctTree* tree);
+
+///
+//Finds all pairs of objects in a linear oct tree whose bounds overlap
+//
+//Parameters:
+//	tree: A pointer to the linear oct tree to query
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to,
+//		each two consecutive objects appended form a pair
+//	pool: A pointer to the worker pool to sort the keys on if the tree must be rebuilt
+void LinearOctTree_QueryPairs(LinearOctTree* tree, DynamicArray* dest, WorkerPool* pool);
+
+#endif
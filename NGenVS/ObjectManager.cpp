@@ -5,10 +5,13 @@
 
 ///
 //Initializes the Object manager
-void ObjectManager_Initialize(void)
+//
+//Parameters:
+//	broadphase: The type of broadphase structure to keep the objects in
+void ObjectManager_Initialize(BroadphaseType broadphase)
 {
 	objectBuffer = ObjectManager_AllocateBuffer();
-	ObjectManager_InitializeBuffer(objectBuffer);
+	ObjectManager_InitializeBuffer(objectBuffer, broadphase);
 }
 
 ///
@@ -42,25 +45,10 @@ void ObjectManager_Update(void)
 		GObject_Update(gameObj);
 
 		
-		//Clear the game objects list of collisions which occurred with itself last frame
+		//Clear the game objects range of collisions which occurred with itself last frame
 		if(gameObj->collider != NULL)
 		{
-			if(gameObj->collider->currentCollisions->size > 0)
-			{
-				/*
-				//Clear the current list of collisions
-				LinkedList_Node* currentNode = gameObj->collider->currentCollisions->head;
-				LinkedList_Node* nextNode = NULL;
-				while(currentNode != NULL)
-				{
-					nextNode = currentNode->next;
-					Collision* currentCollision = (Collision*)currentNode->data;
-					CollisionManager_FreeCollision(currentCollision);
-					currentNode = nextNode;
-				}
-				*/
-				LinkedList_Clear(gameObj->collider->currentCollisions);
-			}
+			gameObj->collider->numCollisions = 0;
 		}
 		
 
@@ -82,10 +70,29 @@ void ObjectManager_Update(void)
 }
 
 ///
-//Updates the internal state of the OctTree
-void ObjectManager_UpdateOctTree(void)
+//Updates the internal state of the broadphase structure
+void ObjectManager_UpdateBroadphase(void)
 {
-	OctTree_Update(objectBuffer->octTree, objectBuffer->gameObjects);
+	switch(objectBuffer->broadphase)
+	{
+	case BROADPHASE_OCTTREE:
+	case BROADPHASE_LOOSEOCTTREE:
+		OctTree_Update(objectBuffer->octTree, objectBuffer->gameObjects);
+		break;
+	case BROADPHASE_SWEEPANDPRUNE_1AXIS:
+	case BROADPHASE_SWEEPANDPRUNE_3AXES:
+		SweepAndPrune_Update(objectBuffer->sweepAndPrune);
+		break;
+	case BROADPHASE_AABBTREE:
+		AABBTree_Update(objectBuffer->aabbTree);
+		break;
+	case BROADPHASE_SPATIALHASHGRID:
+		SpatialHashGrid_Update(objectBuffer->spatialHashGrid);
+		break;
+	case BROADPHASE_LINEAROCTTREE:
+		LinearOctTree_Update(objectBuffer->linearOctTree);
+		break;
+	}
 }
 
 ///
@@ -99,7 +106,26 @@ void ObjectManager_AddObject(GObject* obj)
 	if(obj->collider != NULL)
 	{
 		//Add the object
-		OctTree_AddAndLog(objectBuffer->octTree, obj);
+		switch(objectBuffer->broadphase)
+		{
+		case BROADPHASE_OCTTREE:
+		case BROADPHASE_LOOSEOCTTREE:
+			OctTree_AddAndLog(objectBuffer->octTree, obj);
+			break;
+		case BROADPHASE_SWEEPANDPRUNE_1AXIS:
+		case BROADPHASE_SWEEPANDPRUNE_3AXES:
+			SweepAndPrune_Add(objectBuffer->sweepAndPrune, obj);
+			break;
+		case BROADPHASE_AABBTREE:
+			AABBTree_Add(objectBuffer->aabbTree, obj);
+			break;
+		case BROADPHASE_SPATIALHASHGRID:
+			SpatialHashGrid_Add(objectBuffer->spatialHashGrid, obj);
+			break;
+		case BROADPHASE_LINEAROCTTREE:
+			LinearOctTree_Add(objectBuffer->linearOctTree, obj);
+			break;
+		}
 	}
 }
 
@@ -114,7 +140,26 @@ void ObjectManager_RemoveObject(GObject* obj)
 	LinkedList_RemoveValue(objectBuffer->gameObjects, obj);
 	if(obj->collider != NULL)
 	{
-		OctTree_RemoveAndUnLog(objectBuffer->octTree, obj);
+		switch(objectBuffer->broadphase)
+		{
+		case BROADPHASE_OCTTREE:
+		case BROADPHASE_LOOSEOCTTREE:
+			OctTree_RemoveAndUnLog(objectBuffer->octTree, obj);
+			break;
+		case BROADPHASE_SWEEPANDPRUNE_1AXIS:
+		case BROADPHASE_SWEEPANDPRUNE_3AXES:
+			SweepAndPrune_Remove(objectBuffer->sweepAndPrune, obj);
+			break;
+		case BROADPHASE_AABBTREE:
+			AABBTree_Remove(objectBuffer->aabbTree, obj);
+			break;
+		case BROADPHASE_SPATIALHASHGRID:
+			SpatialHashGrid_Remove(objectBuffer->spatialHashGrid, obj);
+			break;
+		case BROADPHASE_LINEAROCTTREE:
+			LinearOctTree_Remove(objectBuffer->linearOctTree, obj);
+			break;
+		}
 	}
 }
 
@@ -157,7 +202,8 @@ static ObjectBuffer* ObjectManager_AllocateBuffer(void)
 //
 //Parameters:
 //	buffer: The object buffer to initialize
-static void ObjectManager_InitializeBuffer(ObjectBuffer* buffer)
+//	broadphase: The type of broadphase structure to keep the objects in
+static void ObjectManager_InitializeBuffer(ObjectBuffer* buffer, BroadphaseType broadphase)
 {
 	buffer->toDelete = LinkedList_Allocate();
 	LinkedList_Initialize(buffer->toDelete);
@@ -165,8 +211,46 @@ static void ObjectManager_InitializeBuffer(ObjectBuffer* buffer)
 	buffer->gameObjects = LinkedList_Allocate();
 	LinkedList_Initialize(buffer->gameObjects);
 
-	buffer->octTree = OctTree_Allocate();
-	OctTree_Initialize(buffer->octTree, -50.0f, 50.0f, -50.0f, 50.0f, -50.0f, 50.0f);
+	buffer->broadphase = broadphase;
+	buffer->octTree = NULL;
+	buffer->sweepAndPrune = NULL;
+	buffer->aabbTree = NULL;
+	buffer->spatialHashGrid = NULL;
+	buffer->linearOctTree = NULL;
+
+	switch(broadphase)
+	{
+	case BROADPHASE_OCTTREE:
+		buffer->octTree = OctTree_Allocate();
+		OctTree_Initialize(buffer->octTree, -50.0f, 50.0f, -50.0f, 50.0f, -50.0f, 50.0f);
+		break;
+	case BROADPHASE_LOOSEOCTTREE:
+		buffer->octTree = OctTree_Allocate();
+		//Objects only descend as far as they fit, so the tree can afford to be deeper
+		buffer->octTree->maxDepth = 5;
+		OctTree_InitializeLoose(buffer->octTree, -50.0f, 50.0f, -50.0f, 50.0f, -50.0f, 50.0f, 2.0f);
+		break;
+	case BROADPHASE_SWEEPANDPRUNE_1AXIS:
+		buffer->sweepAndPrune = SweepAndPrune_Allocate();
+		SweepAndPrune_Initialize(buffer->sweepAndPrune, 1);
+		break;
+	case BROADPHASE_SWEEPANDPRUNE_3AXES:
+		buffer->sweepAndPrune = SweepAndPrune_Allocate();
+		SweepAndPrune_Initialize(buffer->sweepAndPrune, 3);
+		break;
+	case BROADPHASE_AABBTREE:
+		buffer->aabbTree = AABBTree_Allocate();
+		AABBTree_Initialize(buffer->aabbTree, 0.25f);
+		break;
+	case BROADPHASE_SPATIALHASHGRID:
+		buffer->spatialHashGrid = SpatialHashGrid_Allocate();
+		SpatialHashGrid_Initialize(buffer->spatialHashGrid, 4.0f);
+		break;
+	case BROADPHASE_LINEAROCTTREE:
+		buffer->linearOctTree = LinearOctTree_Allocate();
+		LinearOctTree_Initialize(buffer->linearOctTree, -50.0f, -50.0f, -50.0f, 100.0f, 8);
+		break;
+	}
 }
 
 ///
@@ -176,8 +260,12 @@ static void ObjectManager_InitializeBuffer(ObjectBuffer* buffer)
 //	buffer: The object buffer to free
 static void ObjectManager_FreeBuffer(ObjectBuffer* buffer)
 {
-	//Free the oct tree
-	OctTree_Free(buffer->octTree);
+	//Free the broadphase structure
+	if(buffer->octTree != NULL) OctTree_Free(buffer->octTree);
+	if(buffer->sweepAndPrune != NULL) SweepAndPrune_Free(buffer->sweepAndPrune);
+	if(buffer->aabbTree != NULL) AABBTree_Free(buffer->aabbTree);
+	if(buffer->spatialHashGrid != NULL) SpatialHashGrid_Free(buffer->spatialHashGrid);
+	if(buffer->linearOctTree != NULL) LinearOctTree_Free(buffer->linearOctTree);
 
 	//Delete all Objects being held in the object buffer
 	struct LinkedList_Node* current = buffer->gameObjects->head;
@@ -4,13 +4,35 @@
 #include "LinkedList.h"
 #include "GObject.h"
 #include "OctTree.h"
+#include "SweepAndPrune.h"
+#include "AABBTree.h"
+#include "SpatialHashGrid.h"
+#include "LinearOctTree.h"
 #include "HashMap.h"
 
+//Dictates which broadphase structure the Object Manager keeps its objects in
+enum BroadphaseType
+{
+	BROADPHASE_OCTTREE,					//Oct tree subdividing space around the objects
+	BROADPHASE_LOOSEOCTTREE,			//Oct tree with loose bounds holding each object in a single node
+	BROADPHASE_LINEAROCTTREE,			//Oct tree of morton coded nodes rebuilt each frame
+	BROADPHASE_SWEEPANDPRUNE_1AXIS,		//Sweep and prune sorting along the X axis
+	BROADPHASE_SWEEPANDPRUNE_3AXES,		//Sweep and prune sorting along all axes, sweeping along the axis of greatest variance
+	BROADPHASE_AABBTREE,				//Dynamic AABB tree of enlarged object bounds
+	BROADPHASE_SPATIALHASHGRID			//Uniform grid of hashed cells, for many objects of a similar size
+};
+
 typedef struct ObjectBuffer
 {
 	LinkedList* toDelete;
 	LinkedList* gameObjects;
-	OctTree* octTree;
+
+	BroadphaseType broadphase;			//The type of broadphase structure in use
+	OctTree* octTree;					//Oct tree containing objects with colliders, NULL if not in use
+	SweepAndPrune* sweepAndPrune;		//Sweep and prune containing objects with colliders, NULL if not in use
+	AABBTree* aabbTree;					//Dynamic AABB tree containing objects with colliders, NULL if not in use
+	SpatialHashGrid* spatialHashGrid;	//Spatial hash grid containing objects with colliders, NULL if not in use
+	LinearOctTree* linearOctTree;		//Linear oct tree containing objects with colliders, NULL if not in use
 } ObjectBuffer;
 
 //Internal
@@ -28,7 +50,8 @@ static ObjectBuffer* ObjectManager_AllocateBuffer(void);
 //
 //Parameters:
 //	buffer: The object buffer to initialize
-static void ObjectManager_InitializeBuffer(ObjectBuffer* buffer);
+//	broadphase: The type of broadphase structure to keep the objects in
+static void ObjectManager_InitializeBuffer(ObjectBuffer* buffer, BroadphaseType broadphase);
 
 ///
 //Frees resources being used by an Object Buffer
@@ -41,7 +64,10 @@ static void ObjectManager_FreeBuffer(ObjectBuffer* buffer);
 
 ///
 //Initializes the Object manager
-void ObjectManager_Initialize(void);
+//
+//Parameters:
+//	broadphase: The type of broadphase structure to keep the objects in
+void ObjectManager_Initialize(BroadphaseType broadphase);
 
 ///
 //Frees all internal data managed by the Object Manager
@@ -59,8 +85,8 @@ ObjectBuffer ObjectManager_GetObjectBuffer(void);
 void ObjectManager_Update(void);
 
 ///
-//Updates the internal state of the OctTree
-void ObjectManager_UpdateOctTree(void);
+//Updates the internal state of the broadphase structure
+void ObjectManager_UpdateBroadphase(void);
 
 ///
 //Adds an object to collection of objects managed by the Object Manager
@@ -2,7 +2,7 @@
 
 #include <stdlib.h>
 #include <math.h>
-#include <stdio.h>
+#include <limits.h>
 
 ///
 //Allocates memory for an octtree node
@@ -41,8 +41,18 @@ static void OctTree_Node_Initialize(struct OctTree_Node* node, OctTree* tree, st
 	node->data->capacity = tree->maxOccupancy;
 	DynamicArray_Initialize(node->data, sizeof(GObject*));
 
+	//Loose trees keep the bounds of their occupants
+	node->bounds = NULL;
+	if(tree->looseness > 1.0f)
+	{
+		node->bounds = DynamicArray_Allocate();
+		node->bounds->capacity = tree->maxOccupancy;
+		DynamicArray_Initialize(node->bounds, sizeof(float) * 6);
+	}
+
 	//Set depth
 	node->depth = depth;
+	node->vacated = 0;
 
 	//Set bounds
 	node->left = leftBound;
@@ -63,22 +73,34 @@ static void OctTree_Node_Free(struct OctTree_Node* node)
 	//If this node has children
 	if(node->children != NULL)
 	{
-		for(int i = 0; i < 8; i++)
-		{
-			//Free the children!
-			OctTree_Node_Free(node->children + i);
-		}
-		//Free the children container...
-		free(node->children);
+		OctTree_Node_FreeChildren(node);
 	}
 
 	//Free the data contained within this tree
 	DynamicArray_Free(node->data);
+	if(node->bounds != NULL) DynamicArray_Free(node->bounds);
 
 	//Free this node
 	//free(node);
 }
 
+///
+//Frees the children of an oct tree node and their descendants
+//
+//Parameters:
+//	node: A pointer to the node to free the children of
+static void OctTree_Node_FreeChildren(struct OctTree_Node* node)
+{
+	for(int i = 0; i < 8; i++)
+	{
+		//Free the children!
+		OctTree_Node_Free(node->children + i);
+	}
+	//Free the children container...
+	free(node->children);
+	node->children = NULL;
+}
+
 ///
 //Allocates the children of an oct tree node
 //
@@ -168,6 +190,9 @@ OctTree* OctTree_Allocate()
 	//Assign default values
 	tree->maxDepth = defaultMaxDepth;
 	tree->maxOccupancy = defaultMaxOccupancy;
+	tree->collapseOccupancy = defaultCollapseOccupancy;
+	tree->looseness = 1.0f;
+	tree->queryStamp = 0;
 
 	return tree;
 }
@@ -190,10 +215,35 @@ void OctTree_Initialize(OctTree* tree, float leftBound, float rightBound, float
 	//Initialize root
 	OctTree_Node_Initialize(tree->root, tree, NULL, 0, leftBound, rightBound, bottomBound, topBound, backBound, frontBound);
 
-	//Allocate hashmap
-	tree->map = HashMap_Allocate();
-	//Initialize map
-	HashMap_Initialize(tree->map, 16);
+	//Allocate overflow
+	tree->overflow = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->overflow, sizeof(GObject*));
+
+	tree->looseEntries = NULL;
+}
+
+///
+//Initializes a loose oct tree and creates a root node with the given dimensions.
+//Each object of a loose oct tree lives in exactly one node chosen from it's size & center,
+//whose bounds scaled by the looseness contain the object.
+//
+//Parameters:
+//	tree: A pointer to the oct tree to initialize
+//	leftBound: The left bound of the octtree
+//	rightBound: The right bound of the octtree
+//	bottomBound: The bottom bound of the octtree
+//	topBound: The top bound of the octtree
+//	backBound: The back bound of the octtree
+//	frontBound: The front bound of the octtree
+//	looseness: The factor to scale the bounds of each node by, must be greater than 1
+void OctTree_InitializeLoose(OctTree* tree, float leftBound, float rightBound, float bottomBound, float topBound, float backBound, float frontBound, float looseness)
+{
+	//Set the looseness first so the nodes keep the bounds of their occupants
+	tree->looseness = looseness;
+	OctTree_Initialize(tree, leftBound, rightBound, bottomBound, topBound, backBound, frontBound);
+
+	tree->looseEntries = DynamicArray_Allocate();
+	DynamicArray_Initialize(tree->looseEntries, sizeof(GObject*));
 }
 
 ///
@@ -204,8 +254,29 @@ void OctTree_Initialize(OctTree* tree, float leftBound, float rightBound, float
 //	tree: A pointer to the octtree to free
 void OctTree_Free(OctTree* tree)
 {
+	//Free the memberships carried by the objects
+	if(tree->looseEntries != NULL)
+	{
+		for(unsigned int i = 0; i < tree->looseEntries->size; i++)
+		{
+			OctTree_FreeMembership(*(GObject**)DynamicArray_Index(tree->looseEntries, i));
+		}
+	}
+	else
+	{
+		OctTree_Node_FreeMemberships(tree->root);
+		for(unsigned int i = 0; i < tree->overflow->size; i++)
+		{
+			OctTree_FreeMembership(*(GObject**)DynamicArray_Index(tree->overflow, i));
+		}
+	}
+
 	//Free the nodes
 	OctTree_Node_Free(tree->root);
+	//Free the overflow
+	DynamicArray_Free(tree->overflow);
+	//Free the loose entries
+	if(tree->looseEntries != NULL) DynamicArray_Free(tree->looseEntries);
 	//Free the root
 	free(tree->root);
 	//Free the tree!
@@ -220,22 +291,25 @@ void OctTree_Free(OctTree* tree)
 //	gameObjects: A linked list of all game objects currently in the simulation
 void OctTree_Update(OctTree* tree, LinkedList* gameObjects)
 {
+	//Objects of loose trees are tracked by the tree itself
+	if(tree->looseEntries != NULL)
+	{
+		OctTree_UpdateLoose(tree);
+		return;
+	}
+
 	struct LinkedList_Node* current = gameObjects->head;
 
 	while(current != NULL)
 	{
 		GObject* gameObj = (GObject*)current->data;
-		//Find all gameObjects which have entries in the octtree (& treemap)
-		if(gameObj->collider != NULL)
-		{
-			//Get the treemap entry
-			DynamicArray* log = (DynamicArray*)HashMap_LookUp(tree->map, &gameObj, sizeof(GObject*))->data;
+		struct OctTree_Membership* membership = gameObj->treeMembership;
+		FrameOfReference* frame = gameObj->body != NULL ? gameObj->body->frame : gameObj->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
 
-			if(log->size <= 0)
-			{
-				printf("Not contained in any tree..\n");
-				//OctTree_AddAndLog(tree, gameObj);
-			}
+		//Find all gameObjects which have entries in the octtree and have moved since their statuses were determined
+		if(membership != NULL && FrameOfReference_HasChanged(membership->snapshot, frame))
+		{
+			DynamicArray* log = membership->log;
 
 			//For each OctTree_Node the game object was in
 			for(int i = 0; i < log->size; i++)
@@ -252,21 +326,27 @@ void OctTree_Update(OctTree* tree, LinkedList* gameObjects)
 				{
 
 					//Remove the object from this node
-					OctTree_Node_Remove(nodeStatus->node, gameObj);
+					struct OctTree_Node* previousNode = nodeStatus->node;
+					OctTree_Node_RemoveSlot(previousNode, nodeStatus->slot);
+					//Remove the ith nodeStatus from the log
+					DynamicArray_Remove(log, i);
+
 					//Find where it moved
-					struct OctTree_Node* containingNode = OctTree_SearchUp(nodeStatus->node, gameObj);
+					struct OctTree_Node* containingNode = OctTree_SearchUp(previousNode, gameObj);
 					//If it is still in a node
 					if(containingNode != NULL)
 					{
 						//Add it to that node!
 						OctTree_Node_AddAndLog(tree, containingNode, gameObj);
 					}
+					//It has left the root
 					else
 					{
-						printf("No node found to relocate\n");
+						OctTree_AddOverflow(tree, gameObj);
 					}
-					//Remove the ith nodeStatus from the log
-					DynamicArray_Remove(log, i);
+
+					//Adding the object may subdivide nodes holding it, rearranging the log, so start over
+					i = -1;
 				}
 				//Object was fully contained, and now it is not
 				else if(currentStatus == 1)
@@ -280,10 +360,13 @@ void OctTree_Update(OctTree* tree, LinkedList* gameObjects)
 					{
 						//Add it to that node!
 						OctTree_Node_AddAndLog(tree, containingNode, gameObj);
+						//The log may have been rearranged, start over
+						i = -1;
 					}
+					//It is crossing the bounds of the root
 					else
 					{
-						printf("No node found to relocate\n");
+						OctTree_AddOverflow(tree, gameObj);
 					}
 				}
 				//Object was partially contained and now it is fully contained!
@@ -294,11 +377,33 @@ void OctTree_Update(OctTree* tree, LinkedList* gameObjects)
 					nodeStatus->collisionStatus = currentStatus;
 				}
 			}
+
+			//Objects in the overflow return to the tree as they re-enter the root
+			if(membership->overflowSlot != UINT_MAX)
+			{
+				unsigned char rootStatus = OctTree_Node_DoesObjectCollide(tree->root, gameObj);
+
+				//Place the object in every leaf it overlaps, objects already held are only logged
+				if(rootStatus != 0)
+				{
+					OctTree_Node_AddAndLog(tree, tree->root, gameObj);
+				}
+
+				//Fully contained objects are found by the tree alone
+				if(rootStatus == 2)
+				{
+					OctTree_RemoveOverflow(tree, gameObj);
+				}
+			}
+
+			FrameOfReference_TakeSnapshot(membership->snapshot, frame);
 		}
 		//Move to next object in linked list
 		current = current->next;
 	}
 
+	//Merge the branches objects have moved away from
+	OctTree_Node_Collapse(tree, tree->root);
 }
 
 ///
@@ -321,8 +426,40 @@ void OctTree_Add(OctTree* tree, GObject* obj)
 //	obj: A pointer to the game object to add
 void OctTree_AddAndLog(OctTree* tree, GObject* obj)
 {
+	//Make sure the object has a membership, objects outside of the root of a regular tree may not be held by any node
+	struct OctTree_Membership* membership = OctTree_GetMembership(obj);
+	FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+
+	//Loose trees place the object in a single node
+	if(tree->looseEntries != NULL)
+	{
+		float bounds[6];
+		Collider_GetWorldBounds(bounds, obj->collider, frame);
+
+		//Give the object the status of the node it will be held by
+		struct OctTree_NodeStatus status;
+		status.node = NULL;
+		status.slot = 0;
+		status.collisionStatus = 2;
+		DynamicArray_Append(membership->log, &status);
+		OctTree_LooseNode_Add(OctTree_FindLooseNode(tree, bounds), obj, bounds);
+
+		membership->looseSlot = tree->looseEntries->size;
+		DynamicArray_Append(tree->looseEntries, &obj);
+
+		FrameOfReference_TakeSnapshot(membership->snapshot, frame);
+		return;
+	}
+
 	//Add the object to the root node
 	OctTree_Node_AddAndLog(tree, tree->root, obj);
+
+	if(OctTree_Node_DoesObjectCollide(tree->root, obj) != 2)
+	{
+		OctTree_AddOverflow(tree, obj);
+	}
+
+	FrameOfReference_TakeSnapshot(membership->snapshot, frame);
 }
 
 ///
@@ -344,14 +481,196 @@ void OctTree_Remove(OctTree* tree, GObject* obj)
 //	obj: the object to remove
 void OctTree_RemoveAndUnLog(OctTree* tree, GObject* obj)
 {
-	//Remove from the treemap
-	DynamicArray* objLog = (DynamicArray*)HashMap_Remove(tree->map, &obj, sizeof(GObject*));
-	
-	//Delete the log
-	DynamicArray_Free(objLog);
+	struct OctTree_Membership* membership = obj->treeMembership;
+	if(membership == NULL) return;
+
+	//Move the last entry of a loose tree into the removed object's place
+	if(membership->looseSlot != UINT_MAX)
+	{
+		GObject** entries = (GObject**)tree->looseEntries->data;
+		GObject* moved = entries[tree->looseEntries->size - 1];
+		entries[membership->looseSlot] = moved;
+		moved->treeMembership->looseSlot = membership->looseSlot;
+		tree->looseEntries->size--;
+	}
+
+	//Remove the object from every node holding it
+	for(unsigned int i = 0; i < membership->log->size; i++)
+	{
+		struct OctTree_NodeStatus* nodeStatus = (struct OctTree_NodeStatus*)DynamicArray_Index(membership->log, i);
+		OctTree_Node_RemoveSlot(nodeStatus->node, nodeStatus->slot);
+	}
+
+	//Remove from the overflow
+	OctTree_RemoveOverflow(tree, obj);
+
+	//Delete the membership
+	OctTree_FreeMembership(obj);
+}
+
+///
+//Gets the membership of an object in an oct tree, creating it if the object has none
+//
+//Parameters:
+//	obj: A pointer to the object to get the membership of
+//
+//Returns:
+//	A pointer to the membership of the object
+static struct OctTree_Membership* OctTree_GetMembership(GObject* obj)
+{
+	if(obj->treeMembership == NULL)
+	{
+		struct OctTree_Membership* membership = (struct OctTree_Membership*)malloc(sizeof(struct OctTree_Membership));
+		membership->log = DynamicArray_Allocate();
+		DynamicArray_Initialize(membership->log, sizeof(struct OctTree_NodeStatus));
+		membership->overflowSlot = UINT_MAX;
+		membership->looseSlot = UINT_MAX;
+		membership->queryStamp = 0;
+
+		obj->treeMembership = membership;
+	}
+	return obj->treeMembership;
+}
+
+///
+//Frees the membership of an object in an oct tree
+//
+//Parameters:
+//	obj: A pointer to the object to free the membership of
+static void OctTree_FreeMembership(GObject* obj)
+{
+	if(obj->treeMembership == NULL) return;
+
+	DynamicArray_Free(obj->treeMembership->log);
+	free(obj->treeMembership);
+	obj->treeMembership = NULL;
+}
+
+///
+//Finds the status of an object in a node within it's membership
+//
+//Parameters:
+//	membership: A pointer to the membership of the object
+//	node: A pointer to the node to find the status of
+//
+//Returns:
+//	A pointer to the status of the object in the node, or NULL if the node does not hold the object
+static struct OctTree_NodeStatus* OctTree_Membership_FindStatus(struct OctTree_Membership* membership, struct OctTree_Node* node)
+{
+	struct OctTree_NodeStatus* statuses = (struct OctTree_NodeStatus*)membership->log->data;
+	for(unsigned int i = 0; i < membership->log->size; i++)
+	{
+		if(statuses[i].node == node) return statuses + i;
+	}
+	return NULL;
+}
+
+///
+//Removes an object from the data of an oct tree node by it's slot.
+//The last occupant of the node, and it's bounds in a loose node, are moved into the slot.
+//
+//Parameters:
+//	node: A pointer to the node holding the object
+//	slot: The index of the object within the data of the node
+static void OctTree_Node_RemoveSlot(struct OctTree_Node* node, unsigned int slot)
+{
+	GObject** occupants = (GObject**)node->data->data;
+	unsigned int last = node->data->size - 1;
+	if(slot != last)
+	{
+		GObject* moved = occupants[last];
+		occupants[slot] = moved;
+		if(node->bounds != NULL)
+		{
+			float* bounds = (float*)node->bounds->data;
+			memcpy(bounds + 6 * slot, bounds + 6 * last, sizeof(float) * 6);
+		}
+
+		//Point the moved occupant's status at it's new slot
+		if(moved->treeMembership != NULL)
+		{
+			struct OctTree_NodeStatus* status = OctTree_Membership_FindStatus(moved->treeMembership, node);
+			if(status != NULL) status->slot = slot;
+		}
+	}
+	node->data->size--;
+	if(node->bounds != NULL) node->bounds->size--;
+
+	OctTree_Node_MarkVacated(node);
+}
+
+///
+//Marks an oct tree node & it's ancestors as having lost an occupant, so the next collapse visits them
+//
+//Parameters:
+//	node: A pointer to the node which lost an occupant
+static void OctTree_Node_MarkVacated(struct OctTree_Node* node)
+{
+	//Once a marked node is reached the rest of the ancestors are marked already
+	while(node != NULL && node->vacated == 0)
+	{
+		node->vacated = 1;
+		node = node->parent;
+	}
+}
+
+///
+//Adds an object to the overflow of an oct tree if it is not already there
+//
+//Parameters:
+//	tree: A pointer to the oct tree
+//	obj: A pointer to the object to add
+static void OctTree_AddOverflow(OctTree* tree, GObject* obj)
+{
+	struct OctTree_Membership* membership = OctTree_GetMembership(obj);
+	if(membership->overflowSlot != UINT_MAX) return;
+
+	membership->overflowSlot = tree->overflow->size;
+	DynamicArray_Append(tree->overflow, &obj);
+}
+
+///
+//Removes an object from the overflow of an oct tree if it is there
+//
+//Parameters:
+//	tree: A pointer to the oct tree
+//	obj: A pointer to the object to remove
+static void OctTree_RemoveOverflow(OctTree* tree, GObject* obj)
+{
+	struct OctTree_Membership* membership = obj->treeMembership;
+	if(membership == NULL || membership->overflowSlot == UINT_MAX) return;
+
+	//Move the last object of the overflow into the removed object's place
+	GObject** overflow = (GObject**)tree->overflow->data;
+	GObject* moved = overflow[tree->overflow->size - 1];
+	overflow[membership->overflowSlot] = moved;
+	moved->treeMembership->overflowSlot = membership->overflowSlot;
+	tree->overflow->size--;
+
+	membership->overflowSlot = UINT_MAX;
+}
 
-	//Remove the object from octtree
-	OctTree_Remove(tree, obj);
+///
+//Frees the memberships of all occupants of the leaves of an oct tree node
+//
+//Parameters:
+//	node: A pointer to the node to free the memberships of the occupants of
+static void OctTree_Node_FreeMemberships(struct OctTree_Node* node)
+{
+	if(node->children != NULL)
+	{
+		for(int i = 0; i < 8; i++)
+		{
+			OctTree_Node_FreeMemberships(node->children + i);
+		}
+	}
+	else
+	{
+		for(unsigned int i = 0; i < node->data->size; i++)
+		{
+			OctTree_FreeMembership(*(GObject**)DynamicArray_Index(node->data, i));
+		}
+	}
 }
 
 ///
@@ -387,6 +706,7 @@ void OctTree_Node_Remove(OctTree_Node* current, GObject* obj)
 			{
 				// this line of code is commented until GetIndexOf is written
 				DynamicArray_RemoveData(current->data, &obj);
+				OctTree_Node_MarkVacated(current);
 			}
 		}
 	}
@@ -482,85 +802,29 @@ void OctTree_Node_AddAndLog(OctTree* tree, struct OctTree_Node* node, GObject* o
 		//Can we hold another object? or are we too deep to subdivide?
 		if(node->data->size <= tree->maxOccupancy || node->depth >= tree->maxDepth)
 		{
+			struct OctTree_Membership* membership = OctTree_GetMembership(obj);
+			//Get the containment status!
+			unsigned char status = OctTree_Node_DoesObjectCollide(node, obj);
+
 			//Make sure we aren't already holding a pointer to the object...
-			if(DynamicArray_ContainsWithin(node->data, &obj, node->data->size) == 0)
+			struct OctTree_NodeStatus* existing = OctTree_Membership_FindStatus(membership, node);
+			if(existing == NULL)
 			{
-				//Add the object!
-				DynamicArray_Append(node->data, &obj);
-
-				//Find the entry for this object in the treemap
-				DynamicArray* log = NULL;
-
-				//Is this object already contained in the map?
-				if(HashMap_Contains(tree->map, &obj, sizeof(GObject*)) == 1)
-				{
-					log = (DynamicArray*)HashMap_LookUp(tree->map, &obj, sizeof(GObject*))->data;
-				}
-				else
-				{
-					//Add this object to the tree map
-					log = DynamicArray_Allocate();
-					DynamicArray_Initialize(log, sizeof(struct OctTree_NodeStatus));
-
-					HashMap_Add(tree->map, &obj, log, sizeof(GObject*));
-				}
-
-				//Add this node to the log of the object
-				//Get the containment status!
-				unsigned char status = OctTree_Node_DoesObjectCollide(node, obj);
 				//create a Nodestatus struct
 				struct OctTree_NodeStatus entry;
 				entry.node = node;
+				entry.slot = node->data->size;
 				entry.collisionStatus = status;
 
+				//Add the object!
+				DynamicArray_Append(node->data, &obj);
 				//Log the entry!
-				DynamicArray_Append(log, &entry);
+				DynamicArray_Append(membership->log, &entry);
 			}
-			//Else, it is already contained
+			//Else, it is already contained, update the status of containment in this node
 			else
 			{
-				//Check if the status of containment in this node has changed
-				//Get the object's log
-				DynamicArray* log = (DynamicArray*)HashMap_LookUp(tree->map, &obj, sizeof(GObject*))->data;
-				//Find the entry of this node in the log
-				struct OctTree_NodeStatus* entry = NULL;
-				for(int i = 0; i < log->size; i++)
-				{
-					struct OctTree_NodeStatus* mightBeTheEntry = (struct OctTree_NodeStatus*)DynamicArray_Index(log, i);
-					//If we find it
-					if(mightBeTheEntry->node == node)
-					{
-						entry = mightBeTheEntry;
-						break;		
-					}
-				}
-
-				//If this object is logged as being in this node
-				if(entry != NULL)
-				{
-
-					//Compare the status of the entry to the current status
-					unsigned char status = OctTree_Node_DoesObjectCollide(node, obj);
-					if(entry->collisionStatus !=  status)
-					{
-						//Update the status
-						entry->collisionStatus = status;
-					}
-				}
-				//This object is not logged as being in this node
-				else
-				{
-					//Create an entry
-					//Get the containment status!
-					unsigned char status = OctTree_Node_DoesObjectCollide(node, obj);
-					//create a Nodestatus struct
-					struct OctTree_NodeStatus entry;
-					entry.node = node;
-					entry.collisionStatus = status;
-
-					//Log the entry!
-					DynamicArray_Append(log, &entry);
-				}
+				existing->collisionStatus = status;
 			}
 		}
 		//Else, we are out of room and can subdivide!
@@ -643,7 +907,7 @@ static void OctTree_Node_SubdivideAndLog(OctTree*tree, struct OctTree_Node* node
 		current = occupants[i];
 
 		//Get this log of this object
-		DynamicArray* log = (DynamicArray*)HashMap_LookUp(tree->map, &current, sizeof(GObject*))->data;
+		DynamicArray* log = current->treeMembership->log;
 		//Find parent node in the log
 		for(int i = 0; i < log->size; i++)
 		{
@@ -664,68 +928,237 @@ static void OctTree_Node_SubdivideAndLog(OctTree*tree, struct OctTree_Node* node
 }
 
 ///
-//Determines if and how a game object is colliding with an oct tree node.
+//Finds the pairs of objects which may collide with the objects outside the bounds of the root of an oct tree.
+//Objects in the overflow are paired with each other by their bounds,
+//and with every occupant of the leaves their bounds overlap.
 //
 //Parameters:
-//	node: The node to check if the game object is colliding with
-//	obj: The game object to test for
-//
-//Returns:
-//	0 if the object does not collide with the octent
-//	1 if the object intersects the octent but is not contained within the octent
-//	2 if the object is completely contained within the octent
-unsigned char OctTree_Node_DoesObjectCollide(OctTree_Node* node, GObject* obj)
+//	tree: A pointer to the oct tree to query
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to,
+//		each two consecutive objects appended form a pair
+void OctTree_QueryOverflowPairs(OctTree* tree, DynamicArray* dest)
 {
-	unsigned char collisionStatus = 0;
-	//Determine which frame of reference we will be using to orient the object
-	FrameOfReference* primaryFrame;
-	if(obj->body != NULL)
-	{
-		primaryFrame = obj->body->frame;
-	}
-	else
+	unsigned int numOverflow = tree->overflow->size;
+	if(numOverflow == 0) return;
+
+	GObject** overflow = (GObject**)tree->overflow->data;
+
+	//Find the bounds of each object once
+	float* bounds = (float*)malloc(sizeof(float) * 6 * numOverflow);
+	for(unsigned int i = 0; i < numOverflow; i++)
 	{
-		primaryFrame = obj->frameOfReference;
+		FrameOfReference* frame = overflow[i]->body != NULL ? overflow[i]->body->frame : overflow[i]->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+		Collider_GetWorldBounds(bounds + 6 * i, overflow[i]->collider, frame);
 	}
 
-	//Determine the type of collider the object has
-	switch(obj->collider->type)
+	for(unsigned int i = 0; i < numOverflow; i++)
 	{
-	case COLLIDER_SPHERE:
-		collisionStatus = OctTree_Node_DoesSphereCollide(node, obj->collider->data->sphereData, primaryFrame);
-		break;
-	case COLLIDER_AABB:
-		collisionStatus = OctTree_Node_DoesAABBCollide(node, obj->collider->data->AABBData, primaryFrame);
-		break;
-	case COLLIDER_CONVEXHULL:
-		collisionStatus = OctTree_Node_DoesConvexHullCollide(node, obj->collider->data->convexHullData, primaryFrame);
-		break;
+		const float* bounds1 = bounds + 6 * i;
+		for(unsigned int j = i + 1; j < numOverflow; j++)
+		{
+			const float* bounds2 = bounds + 6 * j;
+			if(bounds1[0] <= bounds2[1] && bounds2[0] <= bounds1[1] &&
+				bounds1[2] <= bounds2[3] && bounds2[2] <= bounds1[3] &&
+				bounds1[4] <= bounds2[5] && bounds2[4] <= bounds1[5])
+			{
+				DynamicArray_Append(dest, overflow + i);
+				DynamicArray_Append(dest, overflow + j);
+			}
+		}
+
+		OctTree_Node_QueryOverflowObject(tree->root, overflow[i], bounds1, dest);
 	}
 
-	return collisionStatus;
+	free(bounds);
 }
 
+///
+//Finds the occupants of the leaves of an oct tree node which overlap the bounds of an object in the overflow
+//
+//Parameters:
+//	node: A pointer to the node to search
+//	obj: A pointer to the object to find the possibly colliding objects of
+//	bounds: The world space bounds of the object
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to
+static void OctTree_Node_QueryOverflowObject(struct OctTree_Node* node, GObject* obj, const float* bounds, DynamicArray* dest)
+{
+	if(node->left > bounds[1] || node->right < bounds[0]) return;
+	if(node->bottom > bounds[3] || node->top < bounds[2]) return;
+	if(node->back > bounds[5] || node->front < bounds[4]) return;
+
+	if(node->children != NULL)
+	{
+		for(int i = 0; i < 8; i++)
+		{
+			OctTree_Node_QueryOverflowObject(node->children + i, obj, bounds, dest);
+		}
+	}
+	else
+	{
+		//Pairs found more than once are only tested once by the collision manager
+		GObject** occupants = (GObject**)node->data->data;
+		for(unsigned int i = 0; i < node->data->size; i++)
+		{
+			if(occupants[i] == obj) continue;
+			DynamicArray_Append(dest, &obj);
+			DynamicArray_Append(dest, occupants + i);
+		}
+	}
+}
 
 ///
-//Determines if and how a sphere collider is colliding with an oct tree node.
+//Merges the children of an oct tree node back into the node once they hold few enough unique occupants.
+//Children are collapsed first, so whole branches left behind by objects which moved away are merged.
+//Only branches which lost occupants since the last collapse are visited, the rest could not be merged then and still can't.
+//The nodes of every occupant's log are updated to the node.
 //
 //Parameters:
-//	node: The node to check if the game object is colliding with
-//	sphere: The sphere to test for
-//	frame: The frame of reference to orient the sphere when checking
+//	tree: A pointer to the oct tree containing the node
+//	node: A pointer to the node to collapse the children of
 //
 //Returns:
-//	0 if the sphere does not collide with the octent
-//	1 if the sphere intersects the octent but is not contained within the octent
-//	2 if the sphere is completely contained within the octent
-static unsigned char OctTree_Node_DoesSphereCollide(OctTree_Node* node, ColliderData_Sphere* sphere, FrameOfReference* frame)
+//	0 if the node still has children
+//	1 if the node is a leaf
+static unsigned char OctTree_Node_Collapse(OctTree* tree, struct OctTree_Node* node)
 {
-	unsigned char collisionStatus = 0;
+	if(node->children == NULL)
+	{
+		node->vacated = 0;
+		return 1;
+	}
 
+	//Branches which lost no occupants held too many to merge at the last collapse, and still do
+	if(node->vacated == 0) return 0;
+	node->vacated = 0;
 
-	//Find the scaled radius
-	float scaledRadius = SphereCollider_GetScaledRadius(sphere, frame);
-	//For reference, get a pointer to where the first bound is located in the node struct
+	//Only children which are leaves can be merged
+	unsigned char childrenAreLeaves = 1;
+	for(int i = 0; i < 8; i++)
+	{
+		if(OctTree_Node_Collapse(tree, node->children + i) == 0) childrenAreLeaves = 0;
+	}
+	if(childrenAreLeaves == 0) return 0;
+
+	//Gather the unique occupants of the children into the node, which holds none while it has children.
+	//An object overlapping several children is held by each of them.
+	for(int i = 0; i < 8; i++)
+	{
+		DynamicArray* childData = node->children[i].data;
+		for(unsigned int j = 0; j < childData->size; j++)
+		{
+			GObject* occupant = *(GObject**)DynamicArray_Index(childData, j);
+			if(DynamicArray_ContainsWithin(node->data, &occupant, node->data->size) == 0)
+			{
+				//Too many occupants remain to merge the children
+				if(node->data->size >= tree->collapseOccupancy)
+				{
+					DynamicArray_Clear(node->data);
+					return 0;
+				}
+				DynamicArray_Append(node->data, &occupant);
+			}
+		}
+	}
+
+	//Replace the children in the log of each occupant with the node
+	for(unsigned int i = 0; i < node->data->size; i++)
+	{
+		GObject* occupant = *(GObject**)DynamicArray_Index(node->data, i);
+		if(occupant->treeMembership == NULL) continue;
+
+		DynamicArray* log = occupant->treeMembership->log;
+		for(unsigned int j = 0; j < log->size;)
+		{
+			struct OctTree_NodeStatus* entry = (struct OctTree_NodeStatus*)DynamicArray_Index(log, j);
+			if(entry->node >= node->children && entry->node < node->children + 8)
+			{
+				DynamicArray_Remove(log, j);
+			}
+			else
+			{
+				j++;
+			}
+		}
+
+		struct OctTree_NodeStatus entry;
+		entry.node = node;
+		entry.slot = i;
+		entry.collisionStatus = OctTree_Node_DoesObjectCollide(node, occupant);
+		DynamicArray_Append(log, &entry);
+	}
+
+	OctTree_Node_FreeChildren(node);
+	return 1;
+}
+
+///
+//Determines if and how a game object is colliding with an oct tree node.
+//
+//Parameters:
+//	node: The node to check if the game object is colliding with
+//	obj: The game object to test for
+//
+//Returns:
+//	0 if the object does not collide with the octent
+//	1 if the object intersects the octent but is not contained within the octent
+//	2 if the object is completely contained within the octent
+unsigned char OctTree_Node_DoesObjectCollide(OctTree_Node* node, GObject* obj)
+{
+	unsigned char collisionStatus = 0;
+	//Determine which frame of reference we will be using to orient the object
+	FrameOfReference* primaryFrame;
+	if(obj->body != NULL)
+	{
+		primaryFrame = obj->body->frame;
+	}
+	else
+	{
+		primaryFrame = obj->frameOfReference;
+	}
+
+	//Determine the type of collider the object has
+	switch(obj->collider->type)
+	{
+	case COLLIDER_SPHERE:
+		collisionStatus = OctTree_Node_DoesSphereCollide(node, obj->collider->data->sphereData, primaryFrame);
+		break;
+	case COLLIDER_AABB:
+		collisionStatus = OctTree_Node_DoesAABBCollide(node, obj->collider->data->AABBData, primaryFrame);
+		break;
+	case COLLIDER_CONVEXHULL:
+		collisionStatus = OctTree_Node_DoesConvexHullCollide(node, obj->collider->data->convexHullData, primaryFrame);
+		break;
+	case COLLIDER_COMPOUND:
+		collisionStatus = OctTree_Node_DoesCompoundCollide(node, obj->collider->data->compoundData, primaryFrame);
+		break;
+	default:
+		break;
+	}
+
+	return collisionStatus;
+}
+
+
+///
+//Determines if and how a sphere collider is colliding with an oct tree node.
+//
+//Parameters:
+//	node: The node to check if the game object is colliding with
+//	sphere: The sphere to test for
+//	frame: The frame of reference to orient the sphere when checking
+//
+//Returns:
+//	0 if the sphere does not collide with the octent
+//	1 if the sphere intersects the octent but is not contained within the octent
+//	2 if the sphere is completely contained within the octent
+static unsigned char OctTree_Node_DoesSphereCollide(OctTree_Node* node, ColliderData_Sphere* sphere, FrameOfReference* frame)
+{
+	unsigned char collisionStatus = 0;
+
+
+	//Find the scaled radius
+	float scaledRadius = SphereCollider_GetScaledRadius(sphere, frame);
+	//For reference, get a pointer to where the first bound is located in the node struct
 	float* reference = &(node->left);
 
 
@@ -876,6 +1309,33 @@ static unsigned char OctTree_Node_DoesConvexHullCollide(OctTree_Node* node, Coll
 	return OctTree_Node_DoesAABBCollide(node, &AABB, frame);
 }
 
+///
+//Determines if and how a compound collider is colliding with an oct tree node.
+//Uses the minimum AABB around every piece as a test, not the pieces themselves.
+//
+//Parameters:
+//	node: The node to check if the game object is colliding with
+//	compound: The compound collider to test for
+//	frame: The frame of reference with which to orient the compound collider
+//
+//Returns:
+//	0 if the compound collider does not collide with the octent
+//	1 if the compound collider intersects the octent but is not contained within the octent
+//	2 if the compound collider is completely contained within the octent
+static unsigned char OctTree_Node_DoesCompoundCollide(OctTree_Node* node, ColliderData_Compound* compound, FrameOfReference* frame)
+{
+	//Generate the minimum AABB around every piece
+	ColliderData_AABB AABB;
+	Vector AABBCentroid;
+	Vector_INIT_ON_STACK(AABBCentroid, 3);
+	AABB.centroid = &AABBCentroid;
+
+	CompoundCollider_GenerateMinimumAABB(&AABB, compound, frame);
+
+	//Then use the AABB test
+	return OctTree_Node_DoesAABBCollide(node, &AABB, frame);
+}
+
 
 ///
 //Definition:
@@ -959,4 +1419,775 @@ struct OctTree_Node* OctTree_SearchUp(OctTree_Node* node, GObject* obj)
 		else fullyContainedWithin = fullyContainedWithin->parent;
 	}
 	return fullyContainedWithin;
-}
\ No newline at end of file
+}
+
+///
+//Finds all pairs of objects in a loose oct tree whose bounds overlap
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree to query
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to,
+//		each two consecutive objects appended form a pair
+void OctTree_QueryLoosePairs(OctTree* tree, DynamicArray* dest)
+{
+	OctTree_LooseNode_QueryPairs(tree, tree->root, dest);
+}
+
+///
+//Determines the node an object belongs in within a loose oct tree.
+//This is the deepest node whose loose bounds are certain to contain the object,
+//found by descending into the child containing the center of the object while the object is small enough to fit.
+//Children are created as needed.
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree
+//	bounds: The world space bounds of the object in the order minX, maxX, minY, maxY, minZ, maxZ
+//
+//Returns:
+//	A pointer to the node the object belongs in
+static struct OctTree_Node* OctTree_FindLooseNode(OctTree* tree, const float* bounds)
+{
+	float center[3];
+	float halfExtents[3];
+	for(int i = 0; i < 3; i++)
+	{
+		center[i] = (bounds[2 * i] + bounds[2 * i + 1]) / 2.0f;
+		halfExtents[i] = (bounds[2 * i + 1] - bounds[2 * i]) / 2.0f;
+	}
+
+	struct OctTree_Node* node = tree->root;
+	//Objects centered outside of the tree stay in the root
+	if(center[0] < node->left || center[0] > node->right || center[1] < node->bottom || center[1] > node->top || center[2] < node->back || center[2] > node->front)
+	{
+		return node;
+	}
+
+	while(node->depth < tree->maxDepth)
+	{
+		//The object fits in a child if it reaches no further past the child's bounds than the child's loose bounds do
+		float slack = (tree->looseness - 1.0f) / 4.0f;
+		if(halfExtents[0] > slack * (node->right - node->left) ||
+			halfExtents[1] > slack * (node->top - node->bottom) ||
+			halfExtents[2] > slack * (node->front - node->back))
+		{
+			break;
+		}
+
+		if(node->children == NULL)
+		{
+			node->children = OctTree_Node_AllocateChildren();
+			OctTree_Node_InitializeChildren(tree, node);
+		}
+
+		//Move to the child containing the center of the object
+		struct OctTree_Node* next = NULL;
+		for(int i = 0; i < 8; i++)
+		{
+			struct OctTree_Node* child = node->children + i;
+			if(center[0] >= child->left && center[0] <= child->right &&
+				center[1] >= child->bottom && center[1] <= child->top &&
+				center[2] >= child->back && center[2] <= child->front)
+			{
+				next = child;
+				break;
+			}
+		}
+		if(next == NULL) break;
+		node = next;
+	}
+
+	return node;
+}
+
+///
+//Determines if a set of bounds overlaps the loose bounds of an oct tree node
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree containing the node
+//	node: A pointer to the node
+//	bounds: The bounds to test in the order minX, maxX, minY, maxY, minZ, maxZ
+//
+//Returns:
+//	0 if the bounds do not overlap
+//	1 if the bounds overlap
+static unsigned char OctTree_Node_DoesOverlapLoose(OctTree* tree, struct OctTree_Node* node, const float* bounds)
+{
+	//Distance the loose bounds extend past the bounds of the node on each side
+	float slack = (tree->looseness - 1.0f) / 2.0f;
+	float extendX = slack * (node->right - node->left);
+	float extendY = slack * (node->top - node->bottom);
+	float extendZ = slack * (node->front - node->back);
+
+	if(node->left - extendX > bounds[1] || node->right + extendX < bounds[0]) return 0;
+	if(node->bottom - extendY > bounds[3] || node->top + extendY < bounds[2]) return 0;
+	if(node->back - extendZ > bounds[5] || node->front + extendZ < bounds[4]) return 0;
+	return 1;
+}
+
+///
+//Adds an object to a node of a loose oct tree, recording the node in the object's membership
+//
+//Parameters:
+//	node: A pointer to the node to add the object to
+//	obj: A pointer to the object to add
+//	bounds: The world space bounds of the object
+static void OctTree_LooseNode_Add(struct OctTree_Node* node, GObject* obj, const float* bounds)
+{
+	struct OctTree_NodeStatus* status = (struct OctTree_NodeStatus*)DynamicArray_Index(obj->treeMembership->log, 0);
+	status->node = node;
+	status->slot = node->data->size;
+
+	DynamicArray_Append(node->data, &obj);
+	DynamicArray_Append(node->bounds, (void*)bounds);
+}
+
+///
+//Finds pairs of objects with overlapping bounds between the occupants of a node of a loose oct tree & the rest of the tree
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree
+//	node: A pointer to the node to find the pairs of the occupants of
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to
+static void OctTree_LooseNode_QueryPairs(OctTree* tree, struct OctTree_Node* node, DynamicArray* dest)
+{
+	GObject** occupants = (GObject**)node->data->data;
+	float* bounds = (float*)node->bounds->data;
+
+	//The loose bounds of neighboring nodes overlap, so each occupant searches the whole tree
+	for(unsigned int i = 0; i < node->data->size; i++)
+	{
+		OctTree_LooseNode_QueryObject(tree, tree->root, occupants[i], bounds + 6 * i, dest);
+	}
+
+	if(node->children != NULL)
+	{
+		for(int i = 0; i < 8; i++)
+		{
+			OctTree_LooseNode_QueryPairs(tree, node->children + i, dest);
+		}
+	}
+}
+
+///
+//Finds the objects in a node of a loose oct tree & it's descendants which overlap the bounds of an object
+//Only objects with a larger identifier than the object are reported, so each pair is found once.
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree
+//	node: A pointer to the node to search
+//	obj: A pointer to the object to find the overlapping objects of
+//	bounds: The world space bounds of the object
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to
+static void OctTree_LooseNode_QueryObject(OctTree* tree, struct OctTree_Node* node, GObject* obj, const float* bounds, DynamicArray* dest)
+{
+	GObject** occupants = (GObject**)node->data->data;
+	float* occupantBounds = (float*)node->bounds->data;
+
+	for(unsigned int i = 0; i < node->data->size; i++)
+	{
+		if(occupants[i]->id <= obj->id) continue;
+
+		const float* other = occupantBounds + 6 * i;
+		if(bounds[0] <= other[1] && other[0] <= bounds[1] &&
+			bounds[2] <= other[3] && other[2] <= bounds[3] &&
+			bounds[4] <= other[5] && other[4] <= bounds[5])
+		{
+			DynamicArray_Append(dest, &obj);
+			DynamicArray_Append(dest, occupants + i);
+		}
+	}
+
+	if(node->children != NULL)
+	{
+		for(int i = 0; i < 8; i++)
+		{
+			if(OctTree_Node_DoesOverlapLoose(tree, node->children + i, bounds))
+			{
+				OctTree_LooseNode_QueryObject(tree, node->children + i, obj, bounds, dest);
+			}
+		}
+	}
+}
+
+///
+//Frees the branches of a loose oct tree node which no longer hold any objects.
+//Objects of a loose tree are placed by their size rather than by the occupancy of a node,
+//so only empty branches are merged. Only branches which lost occupants since the last collapse are visited.
+//
+//Parameters:
+//	node: A pointer to the node to collapse the children of
+//
+//Returns:
+//	0 if the node or it's descendants hold objects
+//	1 if the node is an empty leaf
+static unsigned char OctTree_LooseNode_Collapse(struct OctTree_Node* node)
+{
+	//Branches which lost no occupants still hold the objects they held at the last collapse
+	if(node->vacated == 0) return node->children == NULL && node->data->size == 0;
+	node->vacated = 0;
+
+	if(node->children != NULL)
+	{
+		unsigned char childrenAreEmpty = 1;
+		for(int i = 0; i < 8; i++)
+		{
+			if(OctTree_LooseNode_Collapse(node->children + i) == 0) childrenAreEmpty = 0;
+		}
+		if(childrenAreEmpty == 0) return 0;
+
+		OctTree_Node_FreeChildren(node);
+	}
+
+	return node->data->size == 0;
+}
+
+///
+//Updates the nodes of all objects within a loose oct tree
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree to update
+static void OctTree_UpdateLoose(OctTree* tree)
+{
+	GObject** entries = (GObject**)tree->looseEntries->data;
+	float bounds[6];
+
+	for(unsigned int i = 0; i < tree->looseEntries->size; i++)
+	{
+		GObject* obj = entries[i];
+		struct OctTree_Membership* membership = obj->treeMembership;
+		FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+
+		//Objects which have not moved keep their node & bounds
+		if(!FrameOfReference_HasChanged(membership->snapshot, frame)) continue;
+		FrameOfReference_TakeSnapshot(membership->snapshot, frame);
+
+		Collider_GetWorldBounds(bounds, obj->collider, frame);
+
+		//Only the node the object belongs in now needs to be compared with the node it is in
+		struct OctTree_NodeStatus* status = (struct OctTree_NodeStatus*)DynamicArray_Index(membership->log, 0);
+		struct OctTree_Node* node = OctTree_FindLooseNode(tree, bounds);
+		if(node != status->node)
+		{
+			OctTree_Node_RemoveSlot(status->node, status->slot);
+			OctTree_LooseNode_Add(node, obj, bounds);
+		}
+		else
+		{
+			//Refresh the bounds kept by the node
+			memcpy((float*)node->bounds->data + 6 * status->slot, bounds, sizeof(float) * 6);
+		}
+	}
+
+	//Merge the branches objects have moved away from
+	OctTree_LooseNode_Collapse(tree->root);
+}
+
+///
+//Finds the objects in an oct tree whose bounds overlap an axis aligned box
+//
+//Parameters:
+//	tree: A pointer to the oct tree to query
+//	bounds: The bounds of the box in the order minX, maxX, minY, maxY, minZ, maxZ
+//	dest: An array to place the objects found in
+//	capacity: The number of objects dest can hold, further objects are not reported
+//
+//Returns:
+//	The number of objects placed in dest
+unsigned int OctTree_QueryAABB(OctTree* tree, const float* bounds, GObject** dest, unsigned int capacity)
+{
+	OctTree_BeginQuery(tree);
+	unsigned int count = 0;
+
+	OctTree_Node_QueryRegion(tree, tree->root, bounds, NULL, 0.0f, dest, capacity, &count);
+
+	//Objects outside of the root are not bounded by any node
+	float objBounds[6];
+	for(unsigned int i = 0; i < tree->overflow->size && count < capacity; i++)
+	{
+		GObject* obj = *(GObject**)DynamicArray_Index(tree->overflow, i);
+		if(OctTree_MarkQueried(tree, obj) == 0) continue;
+
+		FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+		Collider_GetWorldBounds(objBounds, obj->collider, frame);
+		OctTree_QueryRegionObject(obj, objBounds, bounds, NULL, 0.0f, dest, capacity, &count);
+	}
+
+	return count;
+}
+
+///
+//Finds the objects in an oct tree whose bounds overlap a sphere
+//
+//Parameters:
+//	tree: A pointer to the oct tree to query
+//	center: The center of the sphere
+//	radius: The radius of the sphere
+//	dest: An array to place the objects found in
+//	capacity: The number of objects dest can hold, further objects are not reported
+//
+//Returns:
+//	The number of objects placed in dest
+unsigned int OctTree_QuerySphere(OctTree* tree, const Vector* center, float radius, GObject** dest, unsigned int capacity)
+{
+	//Nodes are culled by the box bounding the sphere
+	float bounds[6];
+	for(int i = 0; i < 3; i++)
+	{
+		bounds[2 * i] = center->components[i] - radius;
+		bounds[2 * i + 1] = center->components[i] + radius;
+	}
+
+	OctTree_BeginQuery(tree);
+	unsigned int count = 0;
+
+	OctTree_Node_QueryRegion(tree, tree->root, bounds, center->components, radius, dest, capacity, &count);
+
+	//Objects outside of the root are not bounded by any node
+	float objBounds[6];
+	for(unsigned int i = 0; i < tree->overflow->size && count < capacity; i++)
+	{
+		GObject* obj = *(GObject**)DynamicArray_Index(tree->overflow, i);
+		if(OctTree_MarkQueried(tree, obj) == 0) continue;
+
+		FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+		Collider_GetWorldBounds(objBounds, obj->collider, frame);
+		OctTree_QueryRegionObject(obj, objBounds, bounds, center->components, radius, dest, capacity, &count);
+	}
+
+	return count;
+}
+
+///
+//Finds the first object in an oct tree whose bounds are hit by a ray
+//
+//Parameters:
+//	tree: A pointer to the oct tree to query
+//	origin: The origin of the ray
+//	direction: The direction of the ray, distances are measured in multiples of it's length
+//	maxDistance: The furthest distance along the ray to search
+//	distance: A pointer to store the distance along the ray of the hit in, may be NULL
+//
+//Returns:
+//	A pointer to the object hit, or NULL if no object is hit
+GObject* OctTree_RayCast(OctTree* tree, const Vector* origin, const Vector* direction, float maxDistance, float* distance)
+{
+	OctTree_BeginQuery(tree);
+
+	GObject* closest = NULL;
+	float closestDistance = maxDistance;
+
+	//Objects outside of the root are not bounded by any node, test them first to shorten the ray
+	float objBounds[6];
+	for(unsigned int i = 0; i < tree->overflow->size; i++)
+	{
+		GObject* obj = *(GObject**)DynamicArray_Index(tree->overflow, i);
+		if(OctTree_MarkQueried(tree, obj) == 0) continue;
+
+		FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+		Collider_GetWorldBounds(objBounds, obj->collider, frame);
+
+		float entry;
+		if(OctTree_RayCastBounds(objBounds, origin->components, direction->components, closestDistance, &entry))
+		{
+			closest = obj;
+			closestDistance = entry;
+		}
+	}
+
+	OctTree_Node_RayCast(tree, tree->root, origin->components, direction->components, &closest, &closestDistance);
+
+	if(distance != NULL && closest != NULL) *distance = closestDistance;
+	return closest;
+}
+
+///
+//Finds the objects in an oct tree whose bounds are nearest to a point
+//
+//Parameters:
+//	tree: A pointer to the oct tree to query
+//	point: The point to find the nearest objects to
+//	k: The number of objects to find
+//	dest: An array of at least k elements to place the objects found in, ordered nearest first
+//	distances: An array of at least k elements to place the distance to each object found in
+//
+//Returns:
+//	The number of objects placed in dest, less than k if the tree holds fewer objects
+unsigned int OctTree_QueryNearest(OctTree* tree, const Vector* point, unsigned int k, GObject** dest, float* distances)
+{
+	if(k == 0) return 0;
+
+	OctTree_BeginQuery(tree);
+	unsigned int count = 0;
+
+	//Objects outside of the root are not bounded by any node
+	float objBounds[6];
+	for(unsigned int i = 0; i < tree->overflow->size; i++)
+	{
+		GObject* obj = *(GObject**)DynamicArray_Index(tree->overflow, i);
+		if(OctTree_MarkQueried(tree, obj) == 0) continue;
+
+		FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+		Collider_GetWorldBounds(objBounds, obj->collider, frame);
+		OctTree_InsertNearest(obj, OctTree_GetSquaredDistance(point->components, objBounds), k, dest, distances, &count);
+	}
+
+	OctTree_Node_QueryNearest(tree, tree->root, point->components, k, dest, distances, &count);
+
+	//The search compares squared distances
+	for(unsigned int i = 0; i < count; i++)
+	{
+		distances[i] = sqrtf(distances[i]);
+	}
+	return count;
+}
+
+///
+//Begins a new spatial query of an oct tree, so objects held by several nodes are only reported once
+//
+//Parameters:
+//	tree: A pointer to the oct tree being queried
+static void OctTree_BeginQuery(OctTree* tree)
+{
+	tree->queryStamp++;
+}
+
+///
+//Marks an object as visited by the current spatial query of an oct tree
+//
+//Parameters:
+//	tree: A pointer to the oct tree being queried
+//	obj: A pointer to the object being visited
+//
+//Returns:
+//	0 if the object was already visited by this query
+//	1 if this is the first visit
+static unsigned char OctTree_MarkQueried(OctTree* tree, GObject* obj)
+{
+	//Objects of loose trees are held by a single node
+	if(tree->looseEntries != NULL || obj->treeMembership == NULL) return 1;
+
+	if(obj->treeMembership->queryStamp == tree->queryStamp) return 0;
+	obj->treeMembership->queryStamp = tree->queryStamp;
+	return 1;
+}
+
+///
+//Gets the world space bounds of an occupant of an oct tree node
+//
+//Parameters:
+//	dest: The destination of the bounds in the order minX, maxX, minY, maxY, minZ, maxZ
+//	node: A pointer to the node holding the occupant
+//	index: The index of the occupant within the data of the node
+static void OctTree_Node_GetOccupantBounds(float* dest, struct OctTree_Node* node, unsigned int index)
+{
+	//Loose nodes keep the bounds of their occupants
+	if(node->bounds != NULL)
+	{
+		memcpy(dest, DynamicArray_Index(node->bounds, index), sizeof(float) * 6);
+		return;
+	}
+
+	GObject* obj = *(GObject**)DynamicArray_Index(node->data, index);
+	FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+	Collider_GetWorldBounds(dest, obj->collider, frame);
+}
+
+///
+//Gets the bounds which contain the occupants of an oct tree node.
+//These are the bounds of the node scaled by the looseness of the tree.
+//
+//Parameters:
+//	dest: The destination of the bounds in the order minX, maxX, minY, maxY, minZ, maxZ
+//	tree: A pointer to the oct tree containing the node
+//	node: A pointer to the node
+static void OctTree_Node_GetQueryBounds(float* dest, OctTree* tree, struct OctTree_Node* node)
+{
+	//Distance the loose bounds extend past the bounds of the node on each side
+	float slack = (tree->looseness - 1.0f) / 2.0f;
+	float extendX = slack * (node->right - node->left);
+	float extendY = slack * (node->top - node->bottom);
+	float extendZ = slack * (node->front - node->back);
+
+	dest[0] = node->left - extendX;
+	dest[1] = node->right + extendX;
+	dest[2] = node->bottom - extendY;
+	dest[3] = node->top + extendY;
+	dest[4] = node->back - extendZ;
+	dest[5] = node->front + extendZ;
+}
+
+///
+//Determines the squared distance from a point to a set of bounds
+//
+//Parameters:
+//	point: The point to measure from
+//	bounds: The bounds to measure to in the order minX, maxX, minY, maxY, minZ, maxZ
+//
+//Returns:
+//	The squared distance, 0 if the point is within the bounds
+static float OctTree_GetSquaredDistance(const float* point, const float* bounds)
+{
+	float squaredDistance = 0.0f;
+	for(int i = 0; i < 3; i++)
+	{
+		float offset = 0.0f;
+		if(point[i] < bounds[2 * i]) offset = bounds[2 * i] - point[i];
+		else if(point[i] > bounds[2 * i + 1]) offset = point[i] - bounds[2 * i + 1];
+		squaredDistance += offset * offset;
+	}
+	return squaredDistance;
+}
+
+///
+//Determines where a ray enters a set of bounds
+//
+//Parameters:
+//	bounds: The bounds to test in the order minX, maxX, minY, maxY, minZ, maxZ
+//	origin: The origin of the ray
+//	direction: The direction of the ray
+//	maxDistance: The furthest distance along the ray to test
+//	entry: The destination of the distance along the ray at which it enters the bounds, 0 if it starts within them
+//
+//Returns:
+//	0 if the ray misses the bounds within the max distance
+//	1 if the ray hits the bounds
+static unsigned char OctTree_RayCastBounds(const float* bounds, const float* origin, const float* direction, float maxDistance, float* entry)
+{
+	float entryDistance = 0.0f;
+	float exitDistance = maxDistance;
+	for(int i = 0; i < 3; i++)
+	{
+		//A ray parallel to the slab either always or never lies between it's planes
+		if(direction[i] == 0.0f)
+		{
+			if(origin[i] < bounds[2 * i] || origin[i] > bounds[2 * i + 1]) return 0;
+			continue;
+		}
+
+		float t1 = (bounds[2 * i] - origin[i]) / direction[i];
+		float t2 = (bounds[2 * i + 1] - origin[i]) / direction[i];
+		if(t1 > t2)
+		{
+			float swap = t1;
+			t1 = t2;
+			t2 = swap;
+		}
+
+		if(t1 > entryDistance) entryDistance = t1;
+		if(t2 < exitDistance) exitDistance = t2;
+		if(entryDistance > exitDistance) return 0;
+	}
+
+	*entry = entryDistance;
+	return 1;
+}
+
+///
+//Finds the objects in an oct tree node & it's descendants whose bounds overlap a region
+//
+//Parameters:
+//	tree: A pointer to the oct tree being queried
+//	node: A pointer to the node to search
+//	bounds: The bounds of the region in the order minX, maxX, minY, maxY, minZ, maxZ
+//	center: The center of the sphere bounding the region, or NULL if the region is only the bounds
+//	radius: The radius of the sphere bounding the region
+//	dest: The array to place the objects found in
+//	capacity: The number of objects dest can hold
+//	count: A pointer to the number of objects found so far
+static void OctTree_Node_QueryRegion(OctTree* tree, struct OctTree_Node* node, const float* bounds, const float* center, float radius, GObject** dest, unsigned int capacity, unsigned int* count)
+{
+	float objBounds[6];
+	for(unsigned int i = 0; i < node->data->size && *count < capacity; i++)
+	{
+		GObject* obj = *(GObject**)DynamicArray_Index(node->data, i);
+		if(OctTree_MarkQueried(tree, obj) == 0) continue;
+
+		OctTree_Node_GetOccupantBounds(objBounds, node, i);
+		OctTree_QueryRegionObject(obj, objBounds, bounds, center, radius, dest, capacity, count);
+	}
+
+	if(node->children != NULL)
+	{
+		float childBounds[6];
+		for(int i = 0; i < 8 && *count < capacity; i++)
+		{
+			OctTree_Node_GetQueryBounds(childBounds, tree, node->children + i);
+			if(childBounds[0] > bounds[1] || childBounds[1] < bounds[0]) continue;
+			if(childBounds[2] > bounds[3] || childBounds[3] < bounds[2]) continue;
+			if(childBounds[4] > bounds[5] || childBounds[5] < bounds[4]) continue;
+			if(center != NULL && OctTree_GetSquaredDistance(center, childBounds) > radius * radius) continue;
+
+			OctTree_Node_QueryRegion(tree, node->children + i, bounds, center, radius, dest, capacity, count);
+		}
+	}
+}
+
+///
+//Tests an object against a region, appending it to the results if it overlaps
+//
+//Parameters:
+//	obj: A pointer to the object to test
+//	objBounds: The world space bounds of the object
+//	bounds: The bounds of the region in the order minX, maxX, minY, maxY, minZ, maxZ
+//	center: The center of the sphere bounding the region, or NULL if the region is only the bounds
+//	radius: The radius of the sphere bounding the region
+//	dest: The array to place the objects found in
+//	capacity: The number of objects dest can hold
+//	count: A pointer to the number of objects found so far
+static void OctTree_QueryRegionObject(GObject* obj, const float* objBounds, const float* bounds, const float* center, float radius, GObject** dest, unsigned int capacity, unsigned int* count)
+{
+	if(objBounds[0] > bounds[1] || objBounds[1] < bounds[0]) return;
+	if(objBounds[2] > bounds[3] || objBounds[3] < bounds[2]) return;
+	if(objBounds[4] > bounds[5] || objBounds[5] < bounds[4]) return;
+	if(center != NULL && OctTree_GetSquaredDistance(center, objBounds) > radius * radius) return;
+
+	if(*count < capacity)
+	{
+		dest[*count] = obj;
+		(*count)++;
+	}
+}
+
+///
+//Finds the closest object in an oct tree node & it's descendants hit by a ray,
+//visiting the children in the order the ray enters them and skipping those entered beyond the closest hit
+//
+//Parameters:
+//	tree: A pointer to the oct tree being queried
+//	node: A pointer to the node to search
+//	origin: The origin of the ray
+//	direction: The direction of the ray
+//	closest: A pointer to the closest object hit so far
+//	distance: A pointer to the distance along the ray of the closest hit so far
+static void OctTree_Node_RayCast(OctTree* tree, struct OctTree_Node* node, const float* origin, const float* direction, GObject** closest, float* distance)
+{
+	float objBounds[6];
+	for(unsigned int i = 0; i < node->data->size; i++)
+	{
+		GObject* obj = *(GObject**)DynamicArray_Index(node->data, i);
+		if(OctTree_MarkQueried(tree, obj) == 0) continue;
+
+		OctTree_Node_GetOccupantBounds(objBounds, node, i);
+
+		float entry;
+		if(OctTree_RayCastBounds(objBounds, origin, direction, *distance, &entry))
+		{
+			*closest = obj;
+			*distance = entry;
+		}
+	}
+
+	if(node->children == NULL) return;
+
+	//Order the children the ray enters by where it enters them
+	int order[8];
+	float entries[8];
+	int numEntered = 0;
+	float childBounds[6];
+	for(int i = 0; i < 8; i++)
+	{
+		float entry;
+		OctTree_Node_GetQueryBounds(childBounds, tree, node->children + i);
+		if(OctTree_RayCastBounds(childBounds, origin, direction, *distance, &entry) == 0) continue;
+
+		int j = numEntered;
+		while(j > 0 && entries[j - 1] > entry)
+		{
+			order[j] = order[j - 1];
+			entries[j] = entries[j - 1];
+			j--;
+		}
+		order[j] = i;
+		entries[j] = entry;
+		numEntered++;
+	}
+
+	for(int i = 0; i < numEntered; i++)
+	{
+		//Every remaining child is entered beyond the closest hit
+		if(entries[i] > *distance) break;
+		OctTree_Node_RayCast(tree, node->children + order[i], origin, direction, closest, distance);
+	}
+}
+
+///
+//Finds the nearest objects to a point in an oct tree node & it's descendants,
+//visiting the closest children first and skipping those further than the furthest object found once enough are found
+//
+//Parameters:
+//	tree: A pointer to the oct tree being queried
+//	node: A pointer to the node to search
+//	point: The point to find the nearest objects to
+//	k: The number of objects to find
+//	dest: The array of the nearest objects found so far, ordered nearest first
+//	distances: The squared distances of the objects in dest
+//	count: A pointer to the number of objects found so far
+static void OctTree_Node_QueryNearest(OctTree* tree, struct OctTree_Node* node, const float* point, unsigned int k, GObject** dest, float* distances, unsigned int* count)
+{
+	float objBounds[6];
+	for(unsigned int i = 0; i < node->data->size; i++)
+	{
+		GObject* obj = *(GObject**)DynamicArray_Index(node->data, i);
+		if(OctTree_MarkQueried(tree, obj) == 0) continue;
+
+		OctTree_Node_GetOccupantBounds(objBounds, node, i);
+		OctTree_InsertNearest(obj, OctTree_GetSquaredDistance(point, objBounds), k, dest, distances, count);
+	}
+
+	if(node->children == NULL) return;
+
+	//Order the children by their distance from the point
+	int order[8];
+	float childDistances[8];
+	float childBounds[6];
+	for(int i = 0; i < 8; i++)
+	{
+		OctTree_Node_GetQueryBounds(childBounds, tree, node->children + i);
+		float childDistance = OctTree_GetSquaredDistance(point, childBounds);
+
+		int j = i;
+		while(j > 0 && childDistances[j - 1] > childDistance)
+		{
+			order[j] = order[j - 1];
+			childDistances[j] = childDistances[j - 1];
+			j--;
+		}
+		order[j] = i;
+		childDistances[j] = childDistance;
+	}
+
+	for(int i = 0; i < 8; i++)
+	{
+		//Every remaining child is further than the furthest of the nearest objects
+		if(*count == k && childDistances[i] > distances[k - 1]) break;
+		OctTree_Node_QueryNearest(tree, node->children + order[i], point, k, dest, distances, count);
+	}
+}
+
+///
+//Inserts an object into the nearest objects found by a query if it is near enough
+//
+//Parameters:
+//	obj: A pointer to the object to insert
+//	squaredDistance: The squared distance from the query point to the object
+//	k: The number of objects to find
+//	dest: The array of the nearest objects found so far, ordered nearest first
+//	distances: The squared distances of the objects in dest
+//	count: A pointer to the number of objects found so far
+static void OctTree_InsertNearest(GObject* obj, float squaredDistance, unsigned int k, GObject** dest, float* distances, unsigned int* count)
+{
+	if(*count == k && squaredDistance >= distances[k - 1]) return;
+
+	//Shift further objects back, dropping the furthest once k have been found
+	unsigned int i = *count < k ? *count : k - 1;
+	while(i > 0 && distances[i - 1] > squaredDistance)
+	{
+		dest[i] = dest[i - 1];
+		distances[i] = distances[i - 1];
+		i--;
+	}
+	dest[i] = obj;
+	distances[i] = squaredDistance;
+
+	if(*count < k) (*count)++;
+}
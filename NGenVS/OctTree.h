@@ -3,7 +3,6 @@
 
 #include "GObject.h"		//The data the oct tree will contain
 #include "DynamicArray.h"
-#include "HashMap.h"
 
 struct OctTree_Node
 {
@@ -14,11 +13,18 @@ struct OctTree_Node
 
 	//The data contained in this node
 	DynamicArray* data;
+	//The world space bounds of each object in data, in the same order.
+	//Only kept by loose oct trees, NULL otherwise.
+	DynamicArray* bounds;
 
 	//The depth of this node from the root of the tree
 	//The root has a depth of 0.
 	unsigned int depth;
 
+	//Has this node or one of it's descendants lost an occupant since the tree was last collapsed.
+	//The ancestors of a marked node are always marked.
+	unsigned char vacated;
+
 	//Bounds of this oct tree node
 	float left, right;		//Width
 	float bottom, top;		//Height
@@ -28,9 +34,27 @@ struct OctTree_Node
 struct OctTree_NodeStatus
 {
 	struct OctTree_Node* node;
+	unsigned int slot;				//Index of the object within the data of the node
 	unsigned char collisionStatus;
 };
 
+//The nodes of an oct tree holding an object.
+//Carried by the object itself so the tree can update & remove it without searching.
+//Objects of a loose oct tree have a single status, for the one node holding them.
+struct OctTree_Membership
+{
+	//Status of the object in each node holding it
+	DynamicArray* log;
+	//Frame of reference of the object when it's statuses were last determined
+	float snapshot[FrameOfReference_SNAPSHOT_SIZE];
+	//Index of the object within the overflow of the tree, UINT_MAX if it is not in the overflow
+	unsigned int overflowSlot;
+	//Index of the object within the entries of a loose oct tree, UINT_MAX for regular oct trees
+	unsigned int looseSlot;
+	//The last spatial query of the tree which visited the object
+	unsigned int queryStamp;
+};
+
 typedef struct OctTree
 {
 	//Pointer to the root of the tree
@@ -40,14 +64,27 @@ typedef struct OctTree
 	unsigned int maxDepth;		//How many subdivisions can exist
 	unsigned int maxOccupancy;	//How many occupants can an octtree have before trying to subdivide
 								//This number will be exceeded if maxDepth is reached.
+	unsigned int collapseOccupancy;	//How few unique occupants the children of a node must hold before they are merged back into the node
+									//Kept below maxOccupancy so nodes do not split & merge over and over.
+
+	//Objects which are not fully contained within the root of a regular oct tree.
+	//These may be held by no node at all, so they are tested against every node they overlap.
+	DynamicArray* overflow;
+
+	//Factor the bounds of each node are scaled by when objects are placed in a loose oct tree.
+	//A looseness of 1 gives a regular oct tree where objects are placed in every leaf they overlap.
+	float looseness;
+	//Pointers to every object in a loose oct tree, NULL for regular oct trees
+	DynamicArray* looseEntries;
 
-	//Hashmap used to update tree
-	HashMap* map;
+	//Incremented by each spatial query so objects held by several nodes are reported once
+	unsigned int queryStamp;
 } OctTree;
 
 //Internal members
 static unsigned int defaultMaxOccupancy = 3;
 static unsigned int defaultMaxDepth = 3;
+static unsigned int defaultCollapseOccupancy = 1;
 
 //Internal functions
 
@@ -96,6 +133,313 @@ static struct OctTree_Node* OctTree_Node_AllocateChildren();
 //	node: A pointer to the node to initialize the children of
 static void OctTree_Node_InitializeChildren(OctTree* tree, struct OctTree_Node* parent);
 
+///
+//Merges the children of an oct tree node back into the node once they hold few enough unique occupants.
+//Children are collapsed first, so whole branches left behind by objects which moved away are merged.
+//Only branches which lost occupants since the last collapse are visited, the rest could not be merged then and still can't.
+//The nodes of every occupant's log are updated to the node.
+//
+//Parameters:
+//	tree: A pointer to the oct tree containing the node
+//	node: A pointer to the node to collapse the children of
+//
+//Returns:
+//	0 if the node still has children
+//	1 if the node is a leaf
+static unsigned char OctTree_Node_Collapse(OctTree* tree, struct OctTree_Node* node);
+
+///
+//Frees the children of an oct tree node and their descendants
+//
+//Parameters:
+//	node: A pointer to the node to free the children of
+static void OctTree_Node_FreeChildren(struct OctTree_Node* node);
+
+///
+//Gets the membership of an object in an oct tree, creating it if the object has none
+//
+//Parameters:
+//	obj: A pointer to the object to get the membership of
+//
+//Returns:
+//	A pointer to the membership of the object
+static struct OctTree_Membership* OctTree_GetMembership(GObject* obj);
+
+///
+//Frees the membership of an object in an oct tree
+//
+//Parameters:
+//	obj: A pointer to the object to free the membership of
+static void OctTree_FreeMembership(GObject* obj);
+
+///
+//Finds the status of an object in a node within it's membership
+//
+//Parameters:
+//	membership: A pointer to the membership of the object
+//	node: A pointer to the node to find the status of
+//
+//Returns:
+//	A pointer to the status of the object in the node, or NULL if the node does not hold the object
+static struct OctTree_NodeStatus* OctTree_Membership_FindStatus(struct OctTree_Membership* membership, struct OctTree_Node* node);
+
+///
+//Removes an object from the data of an oct tree node by it's slot.
+//The last occupant of the node, and it's bounds in a loose node, are moved into the slot.
+//
+//Parameters:
+//	node: A pointer to the node holding the object
+//	slot: The index of the object within the data of the node
+static void OctTree_Node_RemoveSlot(struct OctTree_Node* node, unsigned int slot);
+
+///
+//Marks an oct tree node & it's ancestors as having lost an occupant, so the next collapse visits them
+//
+//Parameters:
+//	node: A pointer to the node which lost an occupant
+static void OctTree_Node_MarkVacated(struct OctTree_Node* node);
+
+///
+//Adds an object to the overflow of an oct tree if it is not already there
+//
+//Parameters:
+//	tree: A pointer to the oct tree
+//	obj: A pointer to the object to add
+static void OctTree_AddOverflow(OctTree* tree, GObject* obj);
+
+///
+//Removes an object from the overflow of an oct tree if it is there
+//
+//Parameters:
+//	tree: A pointer to the oct tree
+//	obj: A pointer to the object to remove
+static void OctTree_RemoveOverflow(OctTree* tree, GObject* obj);
+
+///
+//Frees the memberships of all occupants of the leaves of an oct tree node
+//
+//Parameters:
+//	node: A pointer to the node to free the memberships of the occupants of
+static void OctTree_Node_FreeMemberships(struct OctTree_Node* node);
+
+///
+//Finds the occupants of the leaves of an oct tree node which overlap the bounds of an object in the overflow
+//
+//Parameters:
+//	node: A pointer to the node to search
+//	obj: A pointer to the object to find the possibly colliding objects of
+//	bounds: The world space bounds of the object
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to
+static void OctTree_Node_QueryOverflowObject(struct OctTree_Node* node, GObject* obj, const float* bounds, DynamicArray* dest);
+
+///
+//Determines the node an object belongs in within a loose oct tree.
+//This is the deepest node whose loose bounds are certain to contain the object,
+//found by descending into the child containing the center of the object while the object is small enough to fit.
+//Children are created as needed.
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree
+//	bounds: The world space bounds of the object in the order minX, maxX, minY, maxY, minZ, maxZ
+//
+//Returns:
+//	A pointer to the node the object belongs in
+static struct OctTree_Node* OctTree_FindLooseNode(OctTree* tree, const float* bounds);
+
+///
+//Determines if a set of bounds overlaps the loose bounds of an oct tree node
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree containing the node
+//	node: A pointer to the node
+//	bounds: The bounds to test in the order minX, maxX, minY, maxY, minZ, maxZ
+//
+//Returns:
+//	0 if the bounds do not overlap
+//	1 if the bounds overlap
+static unsigned char OctTree_Node_DoesOverlapLoose(OctTree* tree, struct OctTree_Node* node, const float* bounds);
+
+///
+//Adds an object to a node of a loose oct tree, recording the node in the object's membership
+//
+//Parameters:
+//	node: A pointer to the node to add the object to
+//	obj: A pointer to the object to add
+//	bounds: The world space bounds of the object
+static void OctTree_LooseNode_Add(struct OctTree_Node* node, GObject* obj, const float* bounds);
+
+///
+//Finds pairs of objects with overlapping bounds between the occupants of a node of a loose oct tree & the rest of the tree
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree
+//	node: A pointer to the node to find the pairs of the occupants of
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to
+static void OctTree_LooseNode_QueryPairs(OctTree* tree, struct OctTree_Node* node, DynamicArray* dest);
+
+///
+//Finds the objects in a node of a loose oct tree & it's descendants which overlap the bounds of an object
+//Only objects with a larger identifier than the object are reported, so each pair is found once.
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree
+//	node: A pointer to the node to search
+//	obj: A pointer to the object to find the overlapping objects of
+//	bounds: The world space bounds of the object
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to
+static void OctTree_LooseNode_QueryObject(OctTree* tree, struct OctTree_Node* node, GObject* obj, const float* bounds, DynamicArray* dest);
+
+///
+//Frees the branches of a loose oct tree node which no longer hold any objects.
+//Objects of a loose tree are placed by their size rather than by the occupancy of a node,
+//so only empty branches are merged. Only branches which lost occupants since the last collapse are visited.
+//
+//Parameters:
+//	node: A pointer to the node to collapse the children of
+//
+//Returns:
+//	0 if the node or it's descendants hold objects
+//	1 if the node is an empty leaf
+static unsigned char OctTree_LooseNode_Collapse(struct OctTree_Node* node);
+
+///
+//Begins a new spatial query of an oct tree, so objects held by several nodes are only reported once
+//
+//Parameters:
+//	tree: A pointer to the oct tree being queried
+static void OctTree_BeginQuery(OctTree* tree);
+
+///
+//Marks an object as visited by the current spatial query of an oct tree
+//
+//Parameters:
+//	tree: A pointer to the oct tree being queried
+//	obj: A pointer to the object being visited
+//
+//Returns:
+//	0 if the object was already visited by this query
+//	1 if this is the first visit
+static unsigned char OctTree_MarkQueried(OctTree* tree, GObject* obj);
+
+///
+//Gets the world space bounds of an occupant of an oct tree node
+//
+//Parameters:
+//	dest: The destination of the bounds in the order minX, maxX, minY, maxY, minZ, maxZ
+//	node: A pointer to the node holding the occupant
+//	index: The index of the occupant within the data of the node
+static void OctTree_Node_GetOccupantBounds(float* dest, struct OctTree_Node* node, unsigned int index);
+
+///
+//Gets the bounds which contain the occupants of an oct tree node.
+//These are the bounds of the node scaled by the looseness of the tree.
+//
+//Parameters:
+//	dest: The destination of the bounds in the order minX, maxX, minY, maxY, minZ, maxZ
+//	tree: A pointer to the oct tree containing the node
+//	node: A pointer to the node
+static void OctTree_Node_GetQueryBounds(float* dest, OctTree* tree, struct OctTree_Node* node);
+
+///
+//Determines the squared distance from a point to a set of bounds
+//
+//Parameters:
+//	point: The point to measure from
+//	bounds: The bounds to measure to in the order minX, maxX, minY, maxY, minZ, maxZ
+//
+//Returns:
+//	The squared distance, 0 if the point is within the bounds
+static float OctTree_GetSquaredDistance(const float* point, const float* bounds);
+
+///
+//Determines where a ray enters a set of bounds
+//
+//Parameters:
+//	bounds: The bounds to test in the order minX, maxX, minY, maxY, minZ, maxZ
+//	origin: The origin of the ray
+//	direction: The direction of the ray
+//	maxDistance: The furthest distance along the ray to test
+//	entry: The destination of the distance along the ray at which it enters the bounds, 0 if it starts within them
+//
+//Returns:
+//	0 if the ray misses the bounds within the max distance
+//	1 if the ray hits the bounds
+static unsigned char OctTree_RayCastBounds(const float* bounds, const float* origin, const float* direction, float maxDistance, float* entry);
+
+///
+//Finds the objects in an oct tree node & it's descendants whose bounds overlap a region
+//
+//Parameters:
+//	tree: A pointer to the oct tree being queried
+//	node: A pointer to the node to search
+//	bounds: The bounds of the region in the order minX, maxX, minY, maxY, minZ, maxZ
+//	center: The center of the sphere bounding the region, or NULL if the region is only the bounds
+//	radius: The radius of the sphere bounding the region
+//	dest: The array to place the objects found in
+//	capacity: The number of objects dest can hold
+//	count: A pointer to the number of objects found so far
+static void OctTree_Node_QueryRegion(OctTree* tree, struct OctTree_Node* node, const float* bounds, const float* center, float radius, GObject** dest, unsigned int capacity, unsigned int* count);
+
+///
+//Tests an object against a region, appending it to the results if it overlaps
+//
+//Parameters:
+//	obj: A pointer to the object to test
+//	objBounds: The world space bounds of the object
+//	bounds: The bounds of the region in the order minX, maxX, minY, maxY, minZ, maxZ
+//	center: The center of the sphere bounding the region, or NULL if the region is only the bounds
+//	radius: The radius of the sphere bounding the region
+//	dest: The array to place the objects found in
+//	capacity: The number of objects dest can hold
+//	count: A pointer to the number of objects found so far
+static void OctTree_QueryRegionObject(GObject* obj, const float* objBounds, const float* bounds, const float* center, float radius, GObject** dest, unsigned int capacity, unsigned int* count);
+
+///
+//Finds the closest object in an oct tree node & it's descendants hit by a ray,
+//visiting the children in the order the ray enters them and skipping those entered beyond the closest hit
+//
+//Parameters:
+//	tree: A pointer to the oct tree being queried
+//	node: A pointer to the node to search
+//	origin: The origin of the ray
+//	direction: The direction of the ray
+//	closest: A pointer to the closest object hit so far
+//	distance: A pointer to the distance along the ray of the closest hit so far
+static void OctTree_Node_RayCast(OctTree* tree, struct OctTree_Node* node, const float* origin, const float* direction, GObject** closest, float* distance);
+
+///
+//Finds the nearest objects to a point in an oct tree node & it's descendants,
+//visiting the closest children first and skipping those further than the furthest object found once enough are found
+//
+//Parameters:
+//	tree: A pointer to the oct tree being queried
+//	node: A pointer to the node to search
+//	point: The point to find the nearest objects to
+//	k: The number of objects to find
+//	dest: The array of the nearest objects found so far, ordered nearest first
+//	distances: The squared distances of the objects in dest
+//	count: A pointer to the number of objects found so far
+static void OctTree_Node_QueryNearest(OctTree* tree, struct OctTree_Node* node, const float* point, unsigned int k, GObject** dest, float* distances, unsigned int* count);
+
+///
+//Inserts an object into the nearest objects found by a query if it is near enough
+//
+//Parameters:
+//	obj: A pointer to the object to insert
+//	squaredDistance: The squared distance from the query point to the object
+//	k: The number of objects to find
+//	dest: The array of the nearest objects found so far, ordered nearest first
+//	distances: The squared distances of the objects in dest
+//	count: A pointer to the number of objects found so far
+static void OctTree_InsertNearest(GObject* obj, float squaredDistance, unsigned int k, GObject** dest, float* distances, unsigned int* count);
+
+///
+//Updates the nodes of all objects within a loose oct tree
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree to update
+static void OctTree_UpdateLoose(OctTree* tree);
+
 //Functions
 
 ///
@@ -118,6 +462,22 @@ OctTree* OctTree_Allocate();
 //	frontBound: The front bound of the octtree
 void OctTree_Initialize(OctTree* tree, float leftBound, float rightBound, float bottomBound, float topBound, float backBound, float frontBound);
 
+///
+//Initializes a loose oct tree and creates a root node with the given dimensions.
+//Each object of a loose oct tree lives in exactly one node chosen from it's size & center,
+//whose bounds scaled by the looseness contain the object.
+//
+//Parameters:
+//	tree: A pointer to the oct tree to initialize
+//	leftBound: The left bound of the octtree
+//	rightBound: The right bound of the octtree
+//	bottomBound: The bottom bound of the octtree
+//	topBound: The top bound of the octtree
+//	backBound: The back bound of the octtree
+//	frontBound: The front bound of the octtree
+//	looseness: The factor to scale the bounds of each node by, must be greater than 1
+void OctTree_InitializeLoose(OctTree* tree, float leftBound, float rightBound, float bottomBound, float topBound, float backBound, float frontBound, float looseness);
+
 ///
 //Frees the data allocated by an octtree.
 //Does not free any of the data contained within the octtree!
@@ -166,6 +526,81 @@ void OctTree_Remove(OctTree* tree, GObject* obj);
 //	obj: the object to remove
 void OctTree_RemoveAndUnLog(OctTree* tree, GObject* obj);
 
+///
+//Finds the pairs of objects which may collide with the objects outside the bounds of the root of an oct tree.
+//Objects in the overflow are paired with each other by their bounds,
+//and with every occupant of the leaves their bounds overlap.
+//
+//Parameters:
+//	tree: A pointer to the oct tree to query
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to,
+//		each two consecutive objects appended form a pair
+void OctTree_QueryOverflowPairs(OctTree* tree, DynamicArray* dest);
+
+///
+//Finds all pairs of objects in a loose oct tree whose bounds overlap
+//
+//Parameters:
+//	tree: A pointer to the loose oct tree to query
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to,
+//		each two consecutive objects appended form a pair
+void OctTree_QueryLoosePairs(OctTree* tree, DynamicArray* dest);
+
+///
+//Finds the objects in an oct tree whose bounds overlap an axis aligned box
+//
+//Parameters:
+//	tree: A pointer to the oct tree to query
+//	bounds: The bounds of the box in the order minX, maxX, minY, maxY, minZ, maxZ
+//	dest: An array to place the objects found in
+//	capacity: The number of objects dest can hold, further objects are not reported
+//
+//Returns:
+//	The number of objects placed in dest
+unsigned int OctTree_QueryAABB(OctTree* tree, const float* bounds, GObject** dest, unsigned int capacity);
+
+///
+//Finds the objects in an oct tree whose bounds overlap a sphere
+//
+//Parameters:
+//	tree: A pointer to the oct tree to query
+//	center: The center of the sphere
+//	radius: The radius of the sphere
+//	dest: An array to place the objects found in
+//	capacity: The number of objects dest can hold, further objects are not reported
+//
+//Returns:
+//	The number of objects placed in dest
+unsigned int OctTree_QuerySphere(OctTree* tree, const Vector* center, float radius, GObject** dest, unsigned int capacity);
+
+///
+//Finds the first object in an oct tree whose bounds are hit by a ray
+//
+//Parameters:
+//	tree: A pointer to the oct tree to query
+//	origin: The origin of the ray
+//	direction: The direction of the ray, distances are measured in multiples of it's length
+//	maxDistance: The furthest distance along the ray to search
+//	distance: A pointer to store the distance along the ray of the hit in, may be NULL
+//
+//Returns:
+//	A pointer to the object hit, or NULL if no object is hit
+GObject* OctTree_RayCast(OctTree* tree, const Vector* origin, const Vector* direction, float maxDistance, float* distance);
+
+///
+//Finds the objects in an oct tree whose bounds are nearest to a point
+//
+//Parameters:
+//	tree: A pointer to the oct tree to query
+//	point: The point to find the nearest objects to
+//	k: The number of objects to find
+//	dest: An array of at least k elements to place the objects found in, ordered nearest first
+//	distances: An array of at least k elements to place the distance to each object found in
+//
+//Returns:
+//	The number of objects placed in dest, less than k if the tree holds fewer objects
+unsigned int OctTree_QueryNearest(OctTree* tree, const Vector* point, unsigned int k, GObject** dest, float* distances);
+
 
 ///
 //Adds a game object to a node of the oct tree
@@ -266,6 +701,20 @@ static unsigned char OctTree_Node_DoesAABBCollide(OctTree_Node* node, ColliderDa
 //	2 if the convexHull is completely contained within the octent
 static unsigned char OctTree_Node_DoesConvexHullCollide(OctTree_Node* node, ColliderData_ConvexHull* convexHull, FrameOfReference* frame);
 
+///
+//Determines if and how a compound collider is colliding with an oct tree node.
+//
+//Parameters:
+//	node: The node to check if the game object is colliding with
+//	compound: The compound collider to test for
+//	frame: The frame of reference with which to orient the compound collider
+//
+//Returns:
+//	0 if the compound collider does not collide with the octent
+//	1 if the compound collider intersects the octent but is not contained within the octent
+//	2 if the compound collider is completely contained within the octent
+static unsigned char OctTree_Node_DoesCompoundCollide(OctTree_Node* node, ColliderData_Compound* compound, FrameOfReference* frame);
+
 ///
 //Definition:
 //	Recurses through all Nodes and Children of an octree
@@ -287,4 +736,4 @@ void OctTree_Node_CleanAll(OctTree_Node* node);
 //	or null if no nodes do
 struct OctTree_Node* OctTree_SearchUp(OctTree_Node* node, GObject* obj);
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -0,0 +1,281 @@
+#include "PairCache.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+///
+//Allocates memory for a new pair cache
+//
+//Returns:
+//	Pointer to a newly allocated pair cache
+PairCache* PairCache_Allocate(void)
+{
+	PairCache* cache = (PairCache*)malloc(sizeof(PairCache));
+	return cache;
+}
+
+///
+//Initializes a pair cache
+//
+//Parameters:
+//	cache: A pointer to the pair cache to initialize
+void PairCache_Initialize(PairCache* cache)
+{
+	cache->pairs = DynamicArray_Allocate();
+	DynamicArray_Initialize(cache->pairs, sizeof(PairCache_Pair));
+
+	cache->numSlots = 64;
+	cache->slots = (unsigned int*)calloc(cache->numSlots, sizeof(unsigned int));
+
+	cache->frame = 1;
+}
+
+///
+//Frees a pair cache
+//Does not free the objects referenced by the pairs
+//
+//Parameters:
+//	cache: A pointer to the pair cache to free
+void PairCache_Free(PairCache* cache)
+{
+	DynamicArray_Free(cache->pairs);
+	free(cache->slots);
+	free(cache);
+}
+
+///
+//Begins a new frame of a pair cache
+//
+//Parameters:
+//	cache: A pointer to the pair cache
+void PairCache_BeginFrame(PairCache* cache)
+{
+	cache->frame++;
+}
+
+///
+//Ends the current frame of a pair cache
+//Every pair which was not reported this frame is removed from the cache.
+//The pair indices held by the cache are not stable across this function.
+//
+//Parameters:
+//	cache: A pointer to the pair cache
+void PairCache_EndFrame(PairCache* cache)
+{
+	PairCache_Pair* pairs = (PairCache_Pair*)cache->pairs->data;
+	unsigned int numPairs = cache->pairs->size;
+
+	//Compact the pairs which were reported this frame to the front of the array, keeping their order
+	unsigned int numKept = 0;
+	for(unsigned int i = 0; i < numPairs; i++)
+	{
+		if(pairs[i].reportedFrame == cache->frame)
+		{
+			if(numKept != i)
+			{
+				pairs[numKept] = pairs[i];
+			}
+			numKept++;
+		}
+	}
+
+	//The table only needs rebuilding if pairs were moved
+	if(numKept != numPairs)
+	{
+		cache->pairs->size = numKept;
+		PairCache_RebuildTable(cache);
+	}
+}
+
+///
+//Gets the key of a pair of identifiers, independant of the order they are given in
+//
+//Parameters:
+//	id1: The identifier of the first member of the pair
+//	id2: The identifier of the second member of the pair
+//
+//Returns:
+//	The key of the pair
+unsigned long long PairCache_GetKey(unsigned int id1, unsigned int id2)
+{
+	if(id1 < id2)
+	{
+		return ((unsigned long long)id1 << 32) | id2;
+	}
+	return ((unsigned long long)id2 << 32) | id1;
+}
+
+///
+//Reports a potentially colliding pair of objects to a pair cache
+//Adds the pair to the cache if it is not contained.
+//
+//Parameters:
+//	cache: A pointer to the pair cache to report to
+//	obj1: A pointer to the first object of the pair
+//	obj2: A pointer to the second object of the pair
+//	dest: Destination for the index of the pair within the cache
+//
+//Returns:
+//	1 if this is the first time the pair was reported this frame
+//	0 if the pair has already been reported this frame
+unsigned char PairCache_Report(PairCache* cache, GObject* obj1, GObject* obj2, unsigned int* dest)
+{
+	unsigned long long key = PairCache_GetKey(obj1->id, obj2->id);
+	unsigned int slot = PairCache_FindSlot(cache, key);
+
+	PairCache_Pair* pair;
+	if(cache->slots[slot] != 0)
+	{
+		*dest = cache->slots[slot] - 1;
+		pair = (PairCache_Pair*)cache->pairs->data + *dest;
+
+		if(pair->reportedFrame == cache->frame)
+		{
+			return 0;
+		}
+	}
+	else
+	{
+		//Add a new pair
+		PairCache_Pair newPair;
+		memset(&newPair, 0, sizeof(PairCache_Pair));
+		newPair.key = key;
+		newPair.obj1 = obj1->id < obj2->id ? obj1 : obj2;
+		newPair.obj2 = obj1->id < obj2->id ? obj2 : obj1;
+
+		*dest = cache->pairs->size;
+		DynamicArray_Append(cache->pairs, &newPair);
+
+		cache->slots[slot] = *dest + 1;
+
+		//Keep the table at most half full
+		if(cache->pairs->size * 2 > cache->numSlots)
+		{
+			PairCache_RebuildTable(cache);
+		}
+
+		pair = (PairCache_Pair*)cache->pairs->data + *dest;
+	}
+
+	pair->reportedFrame = cache->frame;
+	return 1;
+}
+
+///
+//Finds the index of a pair of objects within a pair cache
+//
+//Parameters:
+//	cache: A pointer to the pair cache to search
+//	obj1: A pointer to the first object of the pair
+//	obj2: A pointer to the second object of the pair
+//
+//Returns:
+//	The index of the pair, or UINT_MAX if the pair is not contained
+unsigned int PairCache_Find(const PairCache* cache, const GObject* obj1, const GObject* obj2)
+{
+	unsigned int slot = PairCache_FindSlot(cache, PairCache_GetKey(obj1->id, obj2->id));
+	return cache->slots[slot] != 0 ? cache->slots[slot] - 1 : UINT_MAX;
+}
+
+///
+//Gets a pair of a pair cache
+//
+//Parameters:
+//	cache: A pointer to the pair cache
+//	index: The index of the pair
+//
+//Returns:
+//	A pointer to the pair. Only valid until another pair is reported or the frame is ended.
+PairCache_Pair* PairCache_GetPair(PairCache* cache, unsigned int index)
+{
+	return (PairCache_Pair*)cache->pairs->data + index;
+}
+
+///
+//Determines if either object of a pair has moved since the pair was last tested
+//
+//Parameters:
+//	pair: A pointer to the pair
+//	obj1Frame: The frame of reference currently orienting obj1 of the pair
+//	obj2Frame: The frame of reference currently orienting obj2 of the pair
+//
+//Returns:
+//	0 if the pair has been tested and neither object has moved since
+//	1 if the pair has never been tested or either object has moved
+unsigned char PairCache_HasMoved(const PairCache_Pair* pair, const FrameOfReference* obj1Frame, const FrameOfReference* obj2Frame)
+{
+	if(pair->testedFrame == 0)
+	{
+		return 1;
+	}
+	return FrameOfReference_HasChanged(pair->obj1Snapshot, obj1Frame) || FrameOfReference_HasChanged(pair->obj2Snapshot, obj2Frame);
+}
+
+///
+//Records the frames of reference of the objects of a pair as they were tested
+//
+//Parameters:
+//	cache: A pointer to the pair cache containing the pair
+//	pair: A pointer to the pair being tested
+//	obj1Frame: The frame of reference orienting obj1 of the pair
+//	obj2Frame: The frame of reference orienting obj2 of the pair
+void PairCache_MarkTested(const PairCache* cache, PairCache_Pair* pair, const FrameOfReference* obj1Frame, const FrameOfReference* obj2Frame)
+{
+	pair->testedFrame = cache->frame;
+	FrameOfReference_TakeSnapshot(pair->obj1Snapshot, obj1Frame);
+	FrameOfReference_TakeSnapshot(pair->obj2Snapshot, obj2Frame);
+}
+
+///
+//Finds the slot of the table which holds a key, or the empty slot where it would be placed
+//
+//Parameters:
+//	cache: A pointer to the pair cache to search
+//	key: The key of the pair to find
+//
+//Returns:
+//	The index of the slot
+static unsigned int PairCache_FindSlot(const PairCache* cache, unsigned long long key)
+{
+	PairCache_Pair* pairs = (PairCache_Pair*)cache->pairs->data;
+	unsigned int mask = cache->numSlots - 1;
+	unsigned int slot = (unsigned int)((key * 11400714819323198485ull) >> 32) & mask;
+	while(cache->slots[slot] != 0 && pairs[cache->slots[slot] - 1].key != key)
+	{
+		slot = (slot + 1) & mask;
+	}
+	return slot;
+}
+
+///
+//Re-creates the table of a pair cache from the pairs it contains
+//Grows the table if needed to keep it at most half full.
+//
+//Parameters:
+//	cache: A pointer to the pair cache to rebuild the table of
+static void PairCache_RebuildTable(PairCache* cache)
+{
+	unsigned int numSlots = cache->numSlots;
+	while(cache->pairs->size * 2 > numSlots)
+	{
+		numSlots <<= 1;
+	}
+
+	if(numSlots != cache->numSlots)
+	{
+		free(cache->slots);
+		cache->slots = (unsigned int*)calloc(numSlots, sizeof(unsigned int));
+		cache->numSlots = numSlots;
+	}
+	else
+	{
+		memset(cache->slots, 0, numSlots * sizeof(unsigned int));
+	}
+
+	PairCache_Pair* pairs = (PairCache_Pair*)cache->pairs->data;
+	for(unsigned int i = 0; i < cache->pairs->size; i++)
+	{
+		cache->slots[PairCache_FindSlot(cache, pairs[i].key)] = i + 1;
+	}
+}
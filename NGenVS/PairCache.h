@@ -0,0 +1,202 @@
+#ifndef PAIRCACHE_H
+#define PAIRCACHE_H
+
+#include "GObject.h"
+#include "DynamicArray.h"
+
+//The kinds of axis which can separate a pair of colliders in the separating axis test
+enum PairCache_AxisType
+{
+	PAIRCACHE_AXIS_NONE,			//No axis separated the colliders
+	PAIRCACHE_AXIS_FACE1,			//A face normal of the first collider
+	PAIRCACHE_AXIS_FACE2,			//A face normal of the second collider
+	PAIRCACHE_AXIS_EDGES			//The cross product of an edge of the first collider and an edge of the second collider
+};
+
+//An axis which separated a pair of colliders in the separating axis test
+typedef struct PairCache_SeparatingAxis
+{
+	unsigned char type;				//Kind of axis, one of PairCache_AxisType
+	unsigned int indices[2];		//Index of the face normal, or of the edges of the first & second colliders, forming the axis
+} PairCache_SeparatingAxis;
+
+//The most points a contact manifold between two colliders may have
+#define PairCache_MAX_CONTACTS 4
+
+//A pair of objects which the broadphase has reported as potentially colliding.
+//Pairs persist across frames for as long as the broadphase keeps reporting them,
+//carrying the results of the narrow phase and the collision response between frames.
+typedef struct PairCache_Pair
+{
+	unsigned long long key;			//Key of the pair, made from the identifiers of the objects
+	GObject* obj1;					//Object of the pair with the smaller identifier
+	GObject* obj2;					//Object of the pair with the larger identifier
+
+	unsigned int reportedFrame;		//Frame in which the broadphase last reported this pair
+	unsigned int testedFrame;		//Frame in which the narrow phase last tested this pair, 0 if never tested
+
+	float obj1Snapshot[FrameOfReference_SNAPSHOT_SIZE];	//Frame of reference of obj1 when the pair was last tested
+	float obj2Snapshot[FrameOfReference_SNAPSHOT_SIZE];	//Frame of reference of obj2 when the pair was last tested
+
+	unsigned char colliding;		//Were the objects colliding when the pair was last tested
+	unsigned char swapped;			//Was obj2 the first object of the last collision
+	Collider* colliders[2];			//Colliders of the first & second objects of the last collision which were hit, pieces of compound colliders or else the objects' own
+	float normal[3];				//Minimum translation vector of the last collision, pointing towards the first object of the collision
+	float overlap;					//Overlap of the last collision
+	PairCache_SeparatingAxis separatingAxis;	//Axis which separated obj1 & obj2 when the pair was last tested with SAT, tested first next time
+	unsigned int extremes[2][2];	//Indices of the points of obj1 & obj2 which projected lowest & highest onto the last axis SAT tested
+	unsigned int furthest[2];		//Indices of the points of obj1 & obj2 which were last found furthest along the MTV, climbed from next time
+
+	unsigned char numContacts;		//Number of points in the contact manifold of the last resolved collision
+	float contacts[PairCache_MAX_CONTACTS][3];			//World space points of the contact manifold of the last resolved collision, shared by both objects
+	float contactImpulses[PairCache_MAX_CONTACTS];		//Impulse applied along the normal at each point of the contact manifold, warm starts the next resolution
+	float normalImpulse;			//Total impulse applied along the normal when the last collision was resolved
+} PairCache_Pair;
+
+typedef struct PairCache
+{
+	DynamicArray* pairs;			//Pairs currently in the cache, stored by value
+	unsigned int* slots;			//Open addressed table of indices into pairs plus one, 0 denotes an empty slot
+	unsigned int numSlots;			//Number of slots in the table, always a power of two
+
+	unsigned int frame;				//Current frame of the cache, starts at 1
+} PairCache;
+
+///
+//Internals
+///
+
+///
+//Finds the slot of the table which holds a key, or the empty slot where it would be placed
+//
+//Parameters:
+//	cache: A pointer to the pair cache to search
+//	key: The key of the pair to find
+//
+//Returns:
+//	The index of the slot
+static unsigned int PairCache_FindSlot(const PairCache* cache, unsigned long long key);
+
+///
+//Re-creates the table of a pair cache from the pairs it contains
+//Grows the table if needed to keep it at most half full.
+//
+//Parameters:
+//	cache: A pointer to the pair cache to rebuild the table of
+static void PairCache_RebuildTable(PairCache* cache);
+
+///
+//Functions
+///
+
+///
+//Allocates memory for a new pair cache
+//
+//Returns:
+//	Pointer to a newly allocated pair cache
+PairCache* PairCache_Allocate(void);
+
+///
+//Initializes a pair cache
+//
+//Parameters:
+//	cache: A pointer to the pair cache to initialize
+void PairCache_Initialize(PairCache* cache);
+
+///
+//Frees a pair cache
+//Does not free the objects referenced by the pairs
+//
+//Parameters:
+//	cache: A pointer to the pair cache to free
+void PairCache_Free(PairCache* cache);
+
+///
+//Begins a new frame of a pair cache
+//
+//Parameters:
+//	cache: A pointer to the pair cache
+void PairCache_BeginFrame(PairCache* cache);
+
+///
+//Ends the current frame of a pair cache
+//Every pair which was not reported this frame is removed from the cache.
+//The pair indices held by the cache are not stable across this function.
+//
+//Parameters:
+//	cache: A pointer to the pair cache
+void PairCache_EndFrame(PairCache* cache);
+
+///
+//Gets the key of a pair of identifiers, independant of the order they are given in
+//
+//Parameters:
+//	id1: The identifier of the first member of the pair
+//	id2: The identifier of the second member of the pair
+//
+//Returns:
+//	The key of the pair
+unsigned long long PairCache_GetKey(unsigned int id1, unsigned int id2);
+
+///
+//Reports a potentially colliding pair of objects to a pair cache
+//Adds the pair to the cache if it is not contained.
+//
+//Parameters:
+//	cache: A pointer to the pair cache to report to
+//	obj1: A pointer to the first object of the pair
+//	obj2: A pointer to the second object of the pair
+//	dest: Destination for the index of the pair within the cache
+//
+//Returns:
+//	1 if this is the first time the pair was reported this frame
+//	0 if the pair has already been reported this frame
+unsigned char PairCache_Report(PairCache* cache, GObject* obj1, GObject* obj2, unsigned int* dest);
+
+///
+//Finds the index of a pair of objects within a pair cache
+//
+//Parameters:
+//	cache: A pointer to the pair cache to search
+//	obj1: A pointer to the first object of the pair
+//	obj2: A pointer to the second object of the pair
+//
+//Returns:
+//	The index of the pair, or UINT_MAX if the pair is not contained
+unsigned int PairCache_Find(const PairCache* cache, const GObject* obj1, const GObject* obj2);
+
+///
+//Gets a pair of a pair cache
+//
+//Parameters:
+//	cache: A pointer to the pair cache
+//	index: The index of the pair
+//
+//Returns:
+//	A pointer to the pair. Only valid until another pair is reported or the frame is ended.
+PairCache_Pair* PairCache_GetPair(PairCache* cache, unsigned int index);
+
+///
+//Determines if either object of a pair has moved since the pair was last tested
+//
+//Parameters:
+//	pair: A pointer to the pair
+//	obj1Frame: The frame of reference currently orienting obj1 of the pair
+//	obj2Frame: The frame of reference currently orienting obj2 of the pair
+//
+//Returns:
+//	0 if the pair has been tested and neither object has moved since
+//	1 if the pair has never been tested or either object has moved
+unsigned char PairCache_HasMoved(const PairCache_Pair* pair, const FrameOfReference* obj1Frame, const FrameOfReference* obj2Frame);
+
+///
+//Records the frames of reference of the objects of a pair as they were tested
+//
+//Parameters:
+//	cache: A pointer to the pair cache containing the pair
+//	pair: A pointer to the pair being tested
+//	obj1Frame: The frame of reference orienting obj1 of the pair
+//	obj2Frame: The frame of reference orienting obj2 of the pair
+void PairCache_MarkTested(const PairCache* cache, PairCache_Pair* pair, const FrameOfReference* obj1Frame, const FrameOfReference* obj2Frame);
+
+#endif
@@ -2,6 +2,7 @@
 
 #include <stdio.h>
 #include <math.h>
+#include <float.h>
 
 #include "TimeManager.h"
 
@@ -28,6 +29,9 @@ static void PhysicsManager_InitializeBuffer(PhysicsBuffer* buffer)
 
 	buffer->globalAccelerations = LinkedList_Allocate();
 	LinkedList_Initialize(buffer->globalAccelerations);
+
+	buffer->scratch = NULL;
+	buffer->scratchSize = 0;
 }
 
 ///
@@ -57,10 +61,33 @@ static void PhysicsManager_FreeBuffer(PhysicsBuffer* buffer)
 	//Delete linked list of global accelerations
 	LinkedList_Free(buffer->globalAccelerations);
 
+	free(buffer->scratch);
+
 	//Free the buffer itself
 	free(buffer);
 }
 
+///
+//Makes room for a number of floats in the scratch memory of a physics buffer.
+//The contents of the scratch memory are not kept when it grows.
+//
+//Parameters:
+//	buffer: A pointer to the physics buffer owning the scratch memory
+//	numFloats: The number of floats needed
+//
+//Returns:
+//	A pointer to at least numFloats floats
+static float* PhysicsManager_ReserveScratch(PhysicsBuffer* buffer, unsigned int numFloats)
+{
+	if(numFloats > buffer->scratchSize)
+	{
+		free(buffer->scratch);
+		buffer->scratch = (float*)malloc(sizeof(float) * numFloats);
+		buffer->scratchSize = numFloats;
+	}
+	return buffer->scratch;
+}
+
 ///
 //Initializes the physics manager
 void PhysicsManager_Initialize()
@@ -337,28 +364,17 @@ void PhysicsManager_UpdateObjects(LinkedList* gameObjects)
 
 
 ///
-//Resolves all collisions in a linked list
+//Resolves all collisions in a dynamic array
 //
 //Parameters:
-//	collisions: A linked list of all collisions detected which need resolving
-void PhysicsManager_ResolveCollisions(LinkedList* collisions)
+//	collisions: A dynamic array of all collisions detected which need resolving
+void PhysicsManager_ResolveCollisions(DynamicArray* collisions)
 {
-	//Loop through the linked list of collisions
-	LinkedList_Node* current = collisions->head;
-	LinkedList_Node* next = NULL;
-
-	Collision* collision;
-	while(current != NULL)
+	//Loop through the array of collisions
+	Collision* collision = (Collision*)collisions->data;
+	for(unsigned int i = 0; i < collisions->size; i++)
 	{
-		next = current->next;
-		collision = (Collision*)current->data;
-		PhysicsManager_ResolveCollision(collision);
-
-
-
-		current = next;
-
-
+		PhysicsManager_ResolveCollision(collision + i);
 	}
 }
 
@@ -380,23 +396,36 @@ static void PhysicsManager_ResolveCollision(Collision* collision)
 		//If and only if the objects need to be pulled apart
 		PhysicsManager_DecoupleCollision(collision);
 
-		//Step 2: Calculate the point of collision
-		//In the case that one of the objects is an AABB, there will be different collision points. Allocate an array of two vectors to store these points.
-		Vector* pointsOfCollision[2];
+		//Step 2: Determine the points of contact, & start each at the impulse of the point it matches from last frame
+		PhysicsManager_ContactManifold manifold;
+		PhysicsManager_DetermineContactManifold(&manifold, collision);
+		PhysicsManager_MatchContacts(&manifold, collision->pair);
 
-		//Allocate and initialize these vectors individually
-		pointsOfCollision[0] = Vector_Allocate();
-		pointsOfCollision[1] = Vector_Allocate();
-
-		Vector_Initialize(pointsOfCollision[0], 3);
-		Vector_Initialize(pointsOfCollision[1], 3);
-
-		PhysicsManager_DetermineCollisionPoints(pointsOfCollision, collision);
+		//Step 3: Calculate and apply impulses due to collision
+		float impulse = PhysicsManager_ApplyManifoldImpulses(collision, &manifold);
 
+		//Record the response in the persistent pair so it is available next frame
+		if(collision->pair != NULL)
+		{
+			collision->pair->numContacts = manifold.numContacts;
+			for(unsigned int i = 0; i < manifold.numContacts; i++)
+			{
+				Vector_CopyArray(collision->pair->contacts[i], manifold.points[i], 3);
+				collision->pair->contactImpulses[i] = manifold.impulses[i];
+			}
+			collision->pair->normalImpulse = impulse;
+		}
 
-		//Step 3: Calculate and apply impulses due to collision
-		PhysicsManager_ApplyCollisionImpulses(collision, (const Vector**)pointsOfCollision);
+		//Friction acts through the center of the contact manifold
+		Vector centerOfContact;
+		Vector_INIT_ON_STACK(centerOfContact, 3);
+		for(unsigned int i = 0; i < manifold.numContacts; i++)
+		{
+			Vector_IncrementArray(centerOfContact.components, manifold.points[i], 3);
+		}
+		Vector_Scale(&centerOfContact, 1.0f / manifold.numContacts);
 
+		const Vector* pointsOfCollision[2] = { &centerOfContact, &centerOfContact };
 
 		//Step 4a: Calculate frictional coefficients
 		//float staticCoefficient = sqrt(powf(collision->obj1->body != NULL ? collision->obj1->body->staticFriction : 1.0f, 2)+powf(collision->obj2->body != NULL ? collision->obj2->body->staticFriction : 1.0f, 2));
@@ -408,7 +437,7 @@ static void PhysicsManager_ResolveCollision(Collision* collision)
 		//printf("static:\t%f\ndynamic:\t%f\n", staticCoefficient, dynamicCoefficient);
 
 		//Step 4b: Calculate and apply frictional impulses
-		PhysicsManager_ApplyLinearFrictionalImpulses(collision, (const Vector**)pointsOfCollision, staticCoefficient, dynamicCoefficient);
+		PhysicsManager_ApplyLinearFrictionalImpulses(collision, pointsOfCollision, staticCoefficient, dynamicCoefficient);
 		PhysicsManager_ApplyFrictionalTorques(collision, staticCoefficient, dynamicCoefficient);
 
 		//Step 5:
@@ -432,10 +461,12 @@ static void PhysicsManager_ResolveCollision(Collision* collision)
 		PhysicsManager_UpdateRotationalPhysicsOfBody(collision->obj2->body, dt);
 		}
 		*/
-
-		//Free the vectors used to hold the collision points
-		Vector_Free(pointsOfCollision[0]);
-		Vector_Free(pointsOfCollision[1]);
+	}
+	else if(collision->pair != NULL)
+	{
+		//The collision is resolving itself, no response was applied
+		collision->pair->numContacts = 0;
+		collision->pair->normalImpulse = 0.0f;
 	}
 
 
@@ -453,6 +484,11 @@ static void PhysicsManager_ResolveCollision(Collision* collision)
 //	1 if collision resolution is needed
 static unsigned char PhysicsManager_IsResolutionNeeded(Collision* collision)
 {
+	//The collision's minimum translation vector, viewed as a vector for the functions which take one
+	Vector mtv;
+	mtv.dimension = 3;
+	mtv.components = collision->minimumTranslationVector;
+
 	//If the overlap is 0 (contact case) or negative, this collision does not need resolving
 	if(collision->overlap <= 0.0f)
 	{
@@ -470,15 +506,15 @@ static unsigned char PhysicsManager_IsResolutionNeeded(Collision* collision)
 		Vector_INIT_ON_STACK(totalVelocity2, 3);
 
 		//Calculate Obj1's total velocity of point on obj1 furthest in direction of relative MTV
-		if(collision->obj1->collider->type == COLLIDER_CONVEXHULL)
+		if(collision->obj1Collider->type == COLLIDER_CONVEXHULL)
 		{
 			Vector relativeMTV;
 			Vector_INIT_ON_STACK(relativeMTV, 3);
-			Vector_GetScalarProduct(&relativeMTV, collision->minimumTranslationVector, -1.0f);
+			Vector_GetScalarProductFromArray(relativeMTV.components, collision->minimumTranslationVector, -1.0f, 3);
 			//Determine the set of points most in the direction of the relative MTV
 
 			//Grab convexHull data set
-			ColliderData_ConvexHull* convex = collision->obj1->collider->data->convexHullData;
+			ColliderData_ConvexHull* convex = collision->obj1Collider->data->convexHullData;
 
 			//Create an array of pointers to vectors to hold the model oriented collider points
 			Vector** modelOrientedPoints = (Vector**)malloc(sizeof(Vector*) * convex->points->size);
@@ -497,7 +533,7 @@ static unsigned char PhysicsManager_IsResolutionNeeded(Collision* collision)
 			DynamicArray_Initialize(furthestPoints, sizeof(Vector));
 
 			//Get the furthest points in the direction of relative MTV
-			ConvexHullCollider_GetFurthestPoints(furthestPoints, convex, (const Vector**) modelOrientedPoints, &relativeMTV);
+			ConvexHullCollider_GetFurthestPoints(furthestPoints, convex, (const Vector**) modelOrientedPoints, &relativeMTV, PhysicsManager_GetFurthestStart(collision, 0));
 
 			//Calculate the maximum linear velocity due to the bodies angular velocity in the direction of the relative MTV
 			Vector maxLinearVelocityAtPoint;
@@ -525,12 +561,12 @@ static unsigned char PhysicsManager_IsResolutionNeeded(Collision* collision)
 
 
 		//Calculate Obj2's total velocity of point on obj2 furthest in direction of relative MTV
-		if(collision->obj2->collider->type == COLLIDER_CONVEXHULL)
+		if(collision->obj2Collider->type == COLLIDER_CONVEXHULL)
 		{
 			//Determine the set of points most in the direction of the relative MTV
 
 			//Grab convexHull data set
-			ColliderData_ConvexHull* convex = collision->obj2->collider->data->convexHullData;
+			ColliderData_ConvexHull* convex = collision->obj2Collider->data->convexHullData;
 
 			//Create an array of pointers to vectors to hold the model oriented collider points
 			Vector** modelOrientedPoints = (Vector**)malloc(sizeof(Vector*) * convex->points->size);
@@ -549,13 +585,13 @@ static unsigned char PhysicsManager_IsResolutionNeeded(Collision* collision)
 			DynamicArray_Initialize(furthestPoints, sizeof(Vector));
 
 			//Get the furthest points in the direction of relative MTV
-			ConvexHullCollider_GetFurthestPoints(furthestPoints, convex, (const Vector**) modelOrientedPoints, collision->minimumTranslationVector);
+			ConvexHullCollider_GetFurthestPoints(furthestPoints, convex, (const Vector**) modelOrientedPoints, &mtv, PhysicsManager_GetFurthestStart(collision, 1));
 
 			Vector maxLinearVelocityAtPoint;
 			Vector_INIT_ON_STACK(maxLinearVelocityAtPoint, 3);
 
 			//Calculate the maximum linear velocity due to the body's angular velocity in the direction of the relative MTV
-			RigidBody_CalculateMaxLocalLinearVelocity(&maxLinearVelocityAtPoint, collision->obj2->body, furthestPoints, collision->minimumTranslationVector);
+			RigidBody_CalculateMaxLocalLinearVelocity(&maxLinearVelocityAtPoint, collision->obj2->body, furthestPoints, &mtv);
 
 			//Once the maximum linear velocity due to angular velocity of the furthest points is found, inrement the total velocity by that
 			Vector_Increment(&totalVelocity2, &maxLinearVelocityAtPoint);
@@ -584,10 +620,10 @@ static unsigned char PhysicsManager_IsResolutionNeeded(Collision* collision)
 		Vector_Subtract(&relVelocity, &totalVelocity2, &totalVelocity1);
 
 		Vector_Normalize(&relVelocity);
-		Vector_Normalize(collision->minimumTranslationVector);
+		Vector_NormalizeArray(collision->minimumTranslationVector, 3);
 
 		//If the relative velocity is in the direction of the MTV object, object B is smashing into object A
-		if(Vector_DotProduct(&relVelocity, collision->minimumTranslationVector) > 0.0f)
+		if(Vector_DotProductArray(relVelocity.components, collision->minimumTranslationVector, 3) > 0.0f)
 		{
 			return 1;
 		}
@@ -604,17 +640,17 @@ static unsigned char PhysicsManager_IsResolutionNeeded(Collision* collision)
 		Vector_INIT_ON_STACK(totalVelocity1, 3);
 
 		//Calculate Obj1's total velocity of point on obj1 furthest in direction of relative MTV
-		if(collision->obj1->collider->type == COLLIDER_CONVEXHULL)
+		if(collision->obj1Collider->type == COLLIDER_CONVEXHULL)
 		{
 			//Determine the point furthest in the direction of the relative MTV
 			Vector relativeMTV;
 			Vector_INIT_ON_STACK(relativeMTV, 3);
-			Vector_GetScalarProduct(&relativeMTV, collision->minimumTranslationVector, -1.0f);
+			Vector_GetScalarProductFromArray(relativeMTV.components, collision->minimumTranslationVector, -1.0f, 3);
 
 			//Determine the set of points most in the direction of the relative MTV
 
 			//Grab convexHull data set
-			ColliderData_ConvexHull* convex = collision->obj1->collider->data->convexHullData;
+			ColliderData_ConvexHull* convex = collision->obj1Collider->data->convexHullData;
 
 			//Create an array of pointers to vectors to hold the model oriented collider points
 			Vector** modelOrientedPoints = (Vector**)malloc(sizeof(Vector*) * convex->points->size);
@@ -633,7 +669,7 @@ static unsigned char PhysicsManager_IsResolutionNeeded(Collision* collision)
 			DynamicArray_Initialize(furthestPoints, sizeof(Vector));
 
 			//Get the furthest points in the direction of relative MTV
-			ConvexHullCollider_GetFurthestPoints(furthestPoints, convex, (const Vector**) modelOrientedPoints, &relativeMTV);
+			ConvexHullCollider_GetFurthestPoints(furthestPoints, convex, (const Vector**) modelOrientedPoints, &relativeMTV, PhysicsManager_GetFurthestStart(collision, 0));
 
 			Vector maxLinearVelocityAtPoint;
 			Vector_INIT_ON_STACK(maxLinearVelocityAtPoint, 3);
@@ -657,7 +693,7 @@ static unsigned char PhysicsManager_IsResolutionNeeded(Collision* collision)
 		//Increment the total velocity by the linear velocity of object1
 		Vector_Increment(&totalVelocity1, collision->obj1->body->velocity);
 
-		if(Vector_DotProduct(&totalVelocity1, collision->minimumTranslationVector) < 0.0f)
+		if(Vector_DotProductArray(totalVelocity1.components, collision->minimumTranslationVector, 3) < 0.0f)
 		{
 			return 1;
 		}
@@ -669,13 +705,13 @@ static unsigned char PhysicsManager_IsResolutionNeeded(Collision* collision)
 		Vector_INIT_ON_STACK(totalVelocity2, 3);
 
 		//Calculate Obj2's total velocity of point on obj2 furthest in direction of relative MTV
-		if(collision->obj2->collider->type == COLLIDER_CONVEXHULL)
+		if(collision->obj2Collider->type == COLLIDER_CONVEXHULL)
 		{
 
 			//Determine the set of points most in the direction of the relative MTV
 
 			//Grab convexHull data set
-			ColliderData_ConvexHull* convex = collision->obj2->collider->data->convexHullData;
+			ColliderData_ConvexHull* convex = collision->obj2Collider->data->convexHullData;
 
 			//Create an array of pointers to vectors to hold the model oriented collider points
 			Vector** modelOrientedPoints = (Vector**)malloc(sizeof(Vector*) * convex->points->size);
@@ -694,13 +730,13 @@ static unsigned char PhysicsManager_IsResolutionNeeded(Collision* collision)
 			DynamicArray_Initialize(furthestPoints, sizeof(Vector));
 
 			//Get the furthest points in the direction of relative MTV
-			ConvexHullCollider_GetFurthestPoints(furthestPoints, convex, (const Vector**) modelOrientedPoints, collision->minimumTranslationVector);
+			ConvexHullCollider_GetFurthestPoints(furthestPoints, convex, (const Vector**) modelOrientedPoints, &mtv, PhysicsManager_GetFurthestStart(collision, 1));
 
 			Vector maxLinearVelocityAtPoint;
 			Vector_INIT_ON_STACK(maxLinearVelocityAtPoint, 3);
 
 			//Calculate the maximum linear velocity due to the body's angular velocity in the direction of the relative MTV
-			RigidBody_CalculateMaxLocalLinearVelocity(&maxLinearVelocityAtPoint, collision->obj2->body, furthestPoints, collision->minimumTranslationVector);
+			RigidBody_CalculateMaxLocalLinearVelocity(&maxLinearVelocityAtPoint, collision->obj2->body, furthestPoints, &mtv);
 
 			//Once the maximum linear velocity due to angular velocity of the furthest points is found, inrement the total velocity by that
 			Vector_Increment(&totalVelocity2, &maxLinearVelocityAtPoint);
@@ -719,7 +755,7 @@ static unsigned char PhysicsManager_IsResolutionNeeded(Collision* collision)
 		//Increment total velocity of object 2 by linear velocity of object 2
 		Vector_Increment(&totalVelocity2, collision->obj2->body->velocity);
 
-		if(Vector_DotProduct(&totalVelocity2, collision->minimumTranslationVector) > 0.0f)
+		if(Vector_DotProductArray(totalVelocity2.components, collision->minimumTranslationVector, 3) > 0.0f)
 		{
 			return 1;
 		}
@@ -736,6 +772,11 @@ static unsigned char PhysicsManager_IsResolutionNeeded(Collision* collision)
 //	collision: The collision to decouple
 static void PhysicsManager_DecoupleCollision(Collision* collision)
 {
+	//The collision's minimum translation vector, viewed as a vector for the functions which take one
+	Vector mtv;
+	mtv.dimension = 3;
+	mtv.components = collision->minimumTranslationVector;
+
 	Vector resolutionVector1;	//The tranlation vector to get object 1 out of object 2
 	Vector resolutionVector2;	//The translation vector to get object 2 out of object 1
 
@@ -751,7 +792,7 @@ static void PhysicsManager_DecoupleCollision(Collision* collision)
 		//TODO: Finish experiment
 
 		//If the object's collider can be spinning
-		if(collision->obj1->collider->type == COLLIDER_CONVEXHULL)
+		if(collision->obj1Collider->type == COLLIDER_CONVEXHULL)
 		{
 			//If the collider IS spinning
 			if(Vector_GetMag(collision->obj1->body->angularVelocity) > 0.0f)
@@ -759,13 +800,13 @@ static void PhysicsManager_DecoupleCollision(Collision* collision)
 				//Determine the point furthest in the direction of the relative MTV
 				Vector relativeMTV;
 				Vector_INIT_ON_STACK(relativeMTV, 3);
-				Vector_GetScalarProduct(&relativeMTV, collision->minimumTranslationVector, -1.0f);
+				Vector_GetScalarProductFromArray(relativeMTV.components, collision->minimumTranslationVector, -1.0f, 3);
 
 
 				//Determine the set of points most in the direction of the relative MTV
 
 				//Grab convexHull data set
-				ColliderData_ConvexHull* convex = collision->obj1->collider->data->convexHullData;
+				ColliderData_ConvexHull* convex = collision->obj1Collider->data->convexHullData;
 
 				//Create an array of pointers to vectors to hold the model oriented collider points
 				Vector** modelOrientedPoints = (Vector**)malloc(sizeof(Vector*) * convex->points->size);
@@ -784,7 +825,7 @@ static void PhysicsManager_DecoupleCollision(Collision* collision)
 				DynamicArray_Initialize(furthestPoints, sizeof(Vector));
 
 				//Get the furthest points in the direction of relative MTV
-				ConvexHullCollider_GetFurthestPoints(furthestPoints, convex, (const Vector**) modelOrientedPoints, &relativeMTV);
+				ConvexHullCollider_GetFurthestPoints(furthestPoints, convex, (const Vector**) modelOrientedPoints, &relativeMTV, PhysicsManager_GetFurthestStart(collision, 0));
 
 				Vector maxLinearVelocityAtPoint;
 				Vector_INIT_ON_STACK(maxLinearVelocityAtPoint, 3);
@@ -818,13 +859,13 @@ static void PhysicsManager_DecoupleCollision(Collision* collision)
 		Vector_Copy(&resolutionVector2, collision->obj2->body->velocity);
 
 		//If the object's collider can be spinning
-		if(collision->obj2->collider->type == COLLIDER_CONVEXHULL)
+		if(collision->obj2Collider->type == COLLIDER_CONVEXHULL)
 		{
 
 			//Determine the set of points most in the direction of the relative MTV
 
 			//Grab convexHull data set
-			ColliderData_ConvexHull* convex = collision->obj2->collider->data->convexHullData;
+			ColliderData_ConvexHull* convex = collision->obj2Collider->data->convexHullData;
 
 			//Create an array of pointers to vectors to hold the model oriented collider points
 			Vector** modelOrientedPoints = (Vector**)malloc(sizeof(Vector*) * convex->points->size);
@@ -843,13 +884,13 @@ static void PhysicsManager_DecoupleCollision(Collision* collision)
 			DynamicArray_Initialize(furthestPoints, sizeof(Vector));
 
 			//Get the furthest points in the direction of relative MTV
-			ConvexHullCollider_GetFurthestPoints(furthestPoints, convex, (const Vector**) modelOrientedPoints, collision->minimumTranslationVector);
+			ConvexHullCollider_GetFurthestPoints(furthestPoints, convex, (const Vector**) modelOrientedPoints, &mtv, PhysicsManager_GetFurthestStart(collision, 1));
 
 			Vector maxLinearVelocityAtPoint;
 			Vector_INIT_ON_STACK(maxLinearVelocityAtPoint, 3);
 
 			//Calculate the maximum linear velocity due to the body's angular velocity in the direction of the relative MTV
-			RigidBody_CalculateMaxLocalLinearVelocity(&maxLinearVelocityAtPoint, collision->obj2->body, furthestPoints, collision->minimumTranslationVector);
+			RigidBody_CalculateMaxLocalLinearVelocity(&maxLinearVelocityAtPoint, collision->obj2->body, furthestPoints, &mtv);
 
 			//Once the maximum linear velocity due to angular velocity of the furthest points is found, inrement the resolution vector by that
 			Vector_Increment(&resolutionVector2, &maxLinearVelocityAtPoint);
@@ -874,8 +915,8 @@ static void PhysicsManager_DecoupleCollision(Collision* collision)
 	Vector_Scale(&resolutionVector2, -1.0f);
 
 	//Project the resolution vectors (containing - velocity) onto the MTV
-	Vector_Project(&resolutionVector1, collision->minimumTranslationVector);
-	Vector_Project(&resolutionVector2, collision->minimumTranslationVector);
+	Vector_ProjectArray(resolutionVector1.components, collision->minimumTranslationVector, 3);
+	Vector_ProjectArray(resolutionVector2.components, collision->minimumTranslationVector, 3);
 
 	//Find the scale values for the resolution vectors
 	//These scales should be the mass of the object / sum of the masses
@@ -978,34 +1019,39 @@ static void PhysicsManager_DecoupleCollision(Collision* collision)
 //	collision: The collision to determine the point of contact 
 static void PhysicsManager_DetermineCollisionPoints(Vector** dest, Collision* collision)
 {
+	//The collision's minimum translation vector, viewed as a vector for the functions which take one
+	Vector mtv;
+	mtv.dimension = 3;
+	mtv.components = collision->minimumTranslationVector;
+
 	unsigned char obj1PointFound = 0;	//Boolean dictating if obj1's collision point was determined
 	unsigned char obj2PointFound = 0;	//Boolean dictating if obj2's collision point was determined
 
 	//If either object is a sphere, first do the sphere test as it's the least expensive & most accurate
-	if(collision->obj2->collider->type == COLLIDER_SPHERE)
+	if(collision->obj2Collider->type == COLLIDER_SPHERE)
 	{
-		PhysicsManager_DetermineCollisionPointSphere(dest[1], collision->obj2->collider->data->sphereData, collision->obj2Frame, collision->minimumTranslationVector);
+		PhysicsManager_DetermineCollisionPointSphere(dest[1], collision->obj2Collider->data->sphereData, collision->obj2Frame, &mtv);
 		obj2PointFound = 1;
 
 		//If obj2 is a sphere and obj1 is anything but an AABB, they have the same collision point
-		if(collision->obj1->collider->type != COLLIDER_AABB)
+		if(collision->obj1Collider->type != COLLIDER_AABB)
 		{
 			Vector_Copy(dest[0], dest[1]);
 			obj1PointFound = 1;
 		}
 	}
-	else if(collision->obj1->collider->type == COLLIDER_SPHERE)
+	else if(collision->obj1Collider->type == COLLIDER_SPHERE)
 	{
 		//Obj1's relative MTV is the negated MTV, because the MTV always points towards obj1 by convention
 		Vector relativeMTV;
 		Vector_INIT_ON_STACK(relativeMTV, 3);
-		Vector_GetScalarProduct(&relativeMTV, collision->minimumTranslationVector, -1.0f);
+		Vector_GetScalarProductFromArray(relativeMTV.components, collision->minimumTranslationVector, -1.0f, 3);
 
-		PhysicsManager_DetermineCollisionPointSphere(dest[0], collision->obj1->collider->data->sphereData, collision->obj1Frame, &relativeMTV);
+		PhysicsManager_DetermineCollisionPointSphere(dest[0], collision->obj1Collider->data->sphereData, collision->obj1Frame, &relativeMTV);
 		obj1PointFound = 1;
 
 		//If obj1 is a sphere and obj2 is anything but an AABB, they have the same collision point
-		if(collision->obj2->collider->type != COLLIDER_AABB)
+		if(collision->obj2Collider->type != COLLIDER_AABB)
 		{
 			Vector_Copy(dest[1], dest[0]);
 			obj2PointFound = 1;
@@ -1019,14 +1065,14 @@ static void PhysicsManager_DetermineCollisionPoints(Vector** dest, Collision* co
 	}
 
 	//Check if obj1 is an AABB
-	if(collision->obj1->collider->type == COLLIDER_AABB)
+	if(collision->obj1Collider->type == COLLIDER_AABB)
 	{
 		PhysicsManager_DetermineCollisionPointAABB(dest[0], collision->obj1Frame);
 		obj1PointFound = 1;
 	}
 
 	//Check if obj2 is an AABB
-	if(collision->obj2->collider->type == COLLIDER_AABB)
+	if(collision->obj2Collider->type == COLLIDER_AABB)
 	{
 		PhysicsManager_DetermineCollisionPointAABB(dest[1], collision->obj2Frame);
 		obj2PointFound = 1;
@@ -1049,16 +1095,17 @@ static void PhysicsManager_DetermineCollisionPoints(Vector** dest, Collision* co
 			ColliderData_ConvexHull* AABBAsConvex = ConvexHullCollider_AllocateData();
 			ConvexHullCollider_InitializeData(AABBAsConvex);
 
-			AABBCollider_ToConvexHullCollider(AABBAsConvex, collision->obj2->collider->data->AABBData);
+			AABBCollider_ToConvexHullCollider(AABBAsConvex, collision->obj2Collider->data->AABBData);
 
 			//Next we must get obj1's relative MTV
 			Vector relativeMTV;
 			Vector_INIT_ON_STACK(relativeMTV, 3);
-			Vector_GetScalarProduct(&relativeMTV, collision->minimumTranslationVector, -1.0f);
+			Vector_GetScalarProductFromArray(relativeMTV.components, collision->minimumTranslationVector, -1.0f, 3);
 
 			//Now we can determine the collision point of obj1 using the convex hull method
 			PhysicsManager_DetermineCollisionPointConvexHull(dest[0], 
-				collision->obj1->collider->data->convexHullData, collision->obj1Frame, AABBAsConvex, collision->obj2Frame, 
+				collision->obj1Collider->data->convexHullData, collision->obj1Frame, PhysicsManager_GetFurthestStart(collision, 0),
+				AABBAsConvex, collision->obj2Frame, NULL,
 				&relativeMTV);
 
 			obj1PointFound = 1;
@@ -1072,12 +1119,13 @@ static void PhysicsManager_DetermineCollisionPoints(Vector** dest, Collision* co
 			ColliderData_ConvexHull* AABBAsConvex = ConvexHullCollider_AllocateData();
 			ConvexHullCollider_InitializeData(AABBAsConvex);
 
-			AABBCollider_ToConvexHullCollider(AABBAsConvex, collision->obj1->collider->data->AABBData);
+			AABBCollider_ToConvexHullCollider(AABBAsConvex, collision->obj1Collider->data->AABBData);
 
 			//Now we can determine the collision point of obj2 using the convex hull method
 			PhysicsManager_DetermineCollisionPointConvexHull(dest[1], 
-				collision->obj2->collider->data->convexHullData, collision->obj2Frame, AABBAsConvex, collision->obj1Frame, 
-				collision->minimumTranslationVector);
+				collision->obj2Collider->data->convexHullData, collision->obj2Frame, PhysicsManager_GetFurthestStart(collision, 1),
+				AABBAsConvex, collision->obj1Frame, NULL,
+				&mtv);
 
 			obj2PointFound = 1;
 
@@ -1089,11 +1137,11 @@ static void PhysicsManager_DetermineCollisionPoints(Vector** dest, Collision* co
 	else
 	{
 		//Grab the convex hull data from both colliders
-		ColliderData_ConvexHull* convex1 = collision->obj1->collider->data->convexHullData;
-		ColliderData_ConvexHull* convex2 = collision->obj2->collider->data->convexHullData;
+		ColliderData_ConvexHull* convex1 = collision->obj1Collider->data->convexHullData;
+		ColliderData_ConvexHull* convex2 = collision->obj2Collider->data->convexHullData;
 
 		//Determine obj2's collision point
-		PhysicsManager_DetermineCollisionPointConvexHull(dest[1], convex2, collision->obj2Frame, convex1, collision->obj1Frame, collision->minimumTranslationVector);
+		PhysicsManager_DetermineCollisionPointConvexHull(dest[1], convex2, collision->obj2Frame, PhysicsManager_GetFurthestStart(collision, 1), convex1, collision->obj1Frame, PhysicsManager_GetFurthestStart(collision, 0), &mtv);
 		obj2PointFound = 1;
 
 		//Obj1's collision point will be the same
@@ -1143,12 +1191,14 @@ static void PhysicsManager_DetermineCollisionPointAABB(Vector* dest, const Frame
 //	dest: A pointer to a vector to store the collision point in
 //	convexHull1: A pointer to the convex hull collider data involved in the collision which we are determining the point of collision on.
 //	convexFrame1: A pointer to the frame of reference of the convex hull involved in the collision which we are determining the point of collision on.
+//	start1: A pointer to the index of the point of convexHull1 to start searching for it's furthest points from, NULL to start from the first
 //	convexHull2: A pointer to the other convex hull collider data involved in the collision, whether the object itself has a convex hull or not.
 //	convexFrame2: A pointer to the frame of reference of the other convex hull involved in the collision, whether the object itself has a convex hull or not
+//	start2: A pointer to the index of the point of convexHull2 to start searching for it's furthest points from, NULL to start from the first
 //	relativeMTV: A pointer to a vector representing the MTV !Pointing towards the OTHER object (convexHull2)!
 static void PhysicsManager_DetermineCollisionPointConvexHull(Vector* dest,
-															 const ColliderData_ConvexHull* convexHull1, const FrameOfReference* convexFrame1, 
-															 const ColliderData_ConvexHull* convexHull2, const FrameOfReference* convexFrame2,
+															 const ColliderData_ConvexHull* convexHull1, const FrameOfReference* convexFrame1, unsigned int* start1, 
+															 const ColliderData_ConvexHull* convexHull2, const FrameOfReference* convexFrame2, unsigned int* start2,
 															 const Vector* relativeMTV)
 {
 	//Create an unsigned character to serve as a boolean for whether the collision point was found yet
@@ -1192,7 +1242,7 @@ static void PhysicsManager_DetermineCollisionPointConvexHull(Vector* dest,
 	DynamicArray_Initialize(furthestPoints1, sizeof(Vector));
 	DynamicArray_Initialize(furthestPoints2, sizeof(Vector));
 
-	ConvexHullCollider_GetFurthestPoints(furthestPoints1, convexHull1, (const Vector**)modelOrientedPoints1, relativeMTV);
+	ConvexHullCollider_GetFurthestPoints(furthestPoints1, convexHull1, (const Vector**)modelOrientedPoints1, relativeMTV, start1);
 
 	//If only a single closest point was found, We have a special case of:
 	//	Vertex - Vertex / Edge / Face
@@ -1212,7 +1262,7 @@ static void PhysicsManager_DetermineCollisionPointConvexHull(Vector* dest,
 		Vector relativeMTVForObj2;
 		Vector_INIT_ON_STACK(relativeMTVForObj2, 3);
 		Vector_GetScalarProduct(&relativeMTVForObj2, relativeMTV, -1.0f);
-		ConvexHullCollider_GetFurthestPoints(furthestPoints2, convexHull2, (const Vector**)modelOrientedPoints2, &relativeMTVForObj2);
+		ConvexHullCollider_GetFurthestPoints(furthestPoints2, convexHull2, (const Vector**)modelOrientedPoints2, &relativeMTVForObj2, start2);
 
 
 		//If only a single furthest point was found, We have a special case of:
@@ -1478,170 +1528,863 @@ static void PhysicsManager_DetermineCollisionPointConvexHullFace(Vector* dest,
 }
 
 ///
-//Calculates and imparts the resulting collision impulse from the collision
+//Determines the contact manifold of a decoupled collision.
+//When a face of one collider rests against the other, the nearest face of the other collider is clipped against it giving up to 4 points,
+//else the single point of contact is found by PhysicsManager_DetermineCollisionPoints.
 //
 //Parameters:
-//	collision: The collision having it's resulting impulses calculated and applied
-//	pointOfCollision: Vector representing the point of collision in global space
-static void PhysicsManager_ApplyCollisionImpulses(Collision* collision, const Vector** pointsOfCollision)
+//	dest: A pointer to the contact manifold to store the points of contact in, the impulses are left at 0
+//	collision: The collision to determine the points of contact of
+static void PhysicsManager_DetermineContactManifold(PhysicsManager_ContactManifold* dest, Collision* collision)
 {
-	//Calculation for the numerator of Chris Hecker's collision impulse equation
-	//Hardcode coefficients of restitution for now
-	float coefficientOfRestitution1 = collision->obj1->body != NULL ? collision->obj1->body->coefficientOfRestitution : 1.0f;
-	float coefficientOfRestitution2 = collision->obj2->body != NULL ? collision->obj2->body->coefficientOfRestitution : 1.0f;
+	dest->numContacts = 0;
+	for(unsigned int i = 0; i < PairCache_MAX_CONTACTS; i++)
+	{
+		dest->impulses[i] = 0.0f;
+	}
 
-	//TODO: Find out if the final coefficient e is the product of the two coefficients of restitution
-	float e = coefficientOfRestitution1 * coefficientOfRestitution2;
+	//Spheres have no faces, only convex hulls & AABBs can rest on more than one point
+	if(collision->obj1Collider->type != COLLIDER_SPHERE && collision->obj2Collider->type != COLLIDER_SPHERE)
+	{
+		Collider* colliders[2] = { collision->obj1Collider, collision->obj2Collider };
+		const FrameOfReference* frames[2] = { collision->obj1Frame, collision->obj2Frame };
 
-	Vector radP1;	//Radial vector from CoM of obj1 to point of collision
-	Vector radP2;	//Radial vector from CoM of obj2 to point of collision
+		//AABBs are oriented onto the stack, convex hulls are read from their world space caches
+		float boxPoints[2][24];
+		float boxAxes[2][9];
+		const float* points[2];
+		const float* axes[2];
+		unsigned int numPoints[2];
+		unsigned int numAxes[2];
 
-	Vector_INIT_ON_STACK(radP1, 3);
-	Vector_INIT_ON_STACK(radP2, 3);
+		for(unsigned int i = 0; i < 2; i++)
+		{
+			if(colliders[i]->type == COLLIDER_AABB)
+			{
+				PhysicsManager_GetAABBContactShape(boxPoints[i], boxAxes[i], colliders[i]->data->AABBData, frames[i]);
+				points[i] = boxPoints[i];
+				axes[i] = boxAxes[i];
+				numPoints[i] = 8;
+				numAxes[i] = 3;
+			}
+			else
+			{
+				ColliderData_ConvexHull* convex = colliders[i]->data->convexHullData;
+				ConvexHullCollider_RefreshWorldCache(convex, frames[i]);
 
-	Vector_Subtract(&radP1, pointsOfCollision[0], collision->obj1Frame->position);
-	Vector_Subtract(&radP2, pointsOfCollision[1], collision->obj2Frame->position);
+				numPoints[i] = convex->points->size;
+				numAxes[i] = convex->axes->size;
+				points[i] = numPoints[i] > 0 ? convex->worldCache.points[0]->components : NULL;
+				axes[i] = numAxes[i] > 0 ? convex->worldCache.axes[0]->components : NULL;
+			}
+		}
 
+		dest->numContacts = PhysicsManager_ClipContactFaces(dest, points[0], numPoints[0], axes[0], numAxes[0], points[1], numPoints[1], axes[1], numAxes[1], collision->minimumTranslationVector);
+	}
+
+	//Edge, vertex & sphere contacts touch at a single point
+	if(dest->numContacts == 0)
+	{
+		Vector pointOfCollision1;
+		Vector pointOfCollision2;
+		Vector_INIT_ON_STACK(pointOfCollision1, 3);
+		Vector_INIT_ON_STACK(pointOfCollision2, 3);
 
-	Vector velP1;	//total Linear Velocity at point P on obj1
-	Vector velP2;	//Total linear velocity at point P on obj2
+		Vector* pointsOfCollision[2] = { &pointOfCollision1, &pointOfCollision2 };
+		PhysicsManager_DetermineCollisionPoints(pointsOfCollision, collision);
 
-	Vector_INIT_ON_STACK(velP1, 3);
-	Vector_INIT_ON_STACK(velP2, 3);
+		//The point of an AABB is only it's position, so take the point of the other object
+		Vector_CopyArray(dest->points[0], collision->obj1Collider->type == COLLIDER_AABB ? pointsOfCollision[1]->components : pointsOfCollision[0]->components, 3);
+		dest->numContacts = 1;
+	}
+}
 
-	if(collision->obj1->body != NULL)
+///
+//Orients the corners & face axes of an AABB into world space, in the same order as AABBCollider_ToConvexHullCollider would give them
+//
+//Parameters:
+//	points: An array of 24 floats to store the 8 world space corners of the AABB in
+//	axes: An array of 9 floats to store the 3 oriented axes of the AABB in
+//	AABB: A pointer to the AABB collider data to orient
+//	frame: A pointer to the frame of reference orienting the AABB
+static void PhysicsManager_GetAABBContactShape(float* points, float* axes, const ColliderData_AABB* AABB, const FrameOfReference* frame)
+{
+	//The sign of each corner along the width, height & depth of the box
+	static const float corners[8][3] =
+	{
+		{ 1.0f, -1.0f, 1.0f }, { 1.0f, -1.0f, -1.0f }, { -1.0f, -1.0f, -1.0f }, { -1.0f, -1.0f, 1.0f },
+		{ 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, -1.0f }, { -1.0f, 1.0f, -1.0f }, { -1.0f, 1.0f, 1.0f }
+	};
+
+	//Create a transformation matrix to rotate and scale the points
+	Matrix trans;
+	Matrix_INIT_ON_STACK(trans, 3, 3);
+	Matrix_GetProductMatrix(&trans, frame->rotation, frame->scale);
+
+	for(unsigned int i = 0; i < 8; i++)
 	{
-		Vector_CrossProduct(&velP1, collision->obj1->body->angularVelocity, &radP1);
-		Vector_Increment(&velP1, collision->obj1->body->velocity);
+		float corner[3];
+		corner[0] = corners[i][0] * AABB->width / 2.0f + AABB->centroid->components[0];
+		corner[1] = corners[i][1] * AABB->height / 2.0f + AABB->centroid->components[1];
+		corner[2] = corners[i][2] * AABB->depth / 2.0f + AABB->centroid->components[2];
+
+		Matrix_GetProductVectorArray(points + 3 * i, trans.components, corner, 3, 3);
+		Vector_IncrementArray(points + 3 * i, frame->position->components, 3);
 	}
-	else
+
+	Matrix_GetProductVectorArray(axes, frame->rotation->components, Vector_E1.components, 3, 3);
+	Matrix_GetProductVectorArray(axes + 3, frame->rotation->components, Vector_E2.components, 3, 3);
+	Matrix_GetProductVectorArray(axes + 6, frame->rotation->components, Vector_E3.components, 3, 3);
+}
+
+///
+//Clips the face of one convex shape nearest the other against the face of the other nearest the first
+//
+//Parameters:
+//	dest: A pointer to the contact manifold to store the points of contact in
+//	points1: The world space points of obj1 of the collision, 3 floats per point
+//	numPoints1: The number of points of obj1
+//	axes1: The oriented face axes of obj1, 3 floats per axis
+//	numAxes1: The number of axes of obj1
+//	points2: The world space points of obj2 of the collision, 3 floats per point
+//	numPoints2: The number of points of obj2
+//	axes2: The oriented face axes of obj2, 3 floats per axis
+//	numAxes2: The number of axes of obj2
+//	normal: An array of 3 floats containing the minimum translation vector of the collision, pointing towards obj1
+//
+//Returns:
+//	The number of points of contact found, 0 if neither face lines up with the normal
+static unsigned char PhysicsManager_ClipContactFaces(PhysicsManager_ContactManifold* dest,
+													 const float* points1, unsigned int numPoints1, const float* axes1, unsigned int numAxes1,
+													 const float* points2, unsigned int numPoints2, const float* axes2, unsigned int numAxes2,
+													 const float* normal)
+{
+	//The faces of both shapes & the polygons being clipped each hold at most every point of both shapes,
+	//the depths of the kept points hold one more & are used for the angles of each polygon ordered before them
+	unsigned int numPoints = numPoints1 + numPoints2;
+	float* face1 = PhysicsManager_ReserveScratch(physicsBuffer, 10 * numPoints + 1);
+	float* face2 = face1 + 3 * numPoints1;
+	float* clipped = face2 + 3 * numPoints2;
+	float* swap = clipped + 3 * numPoints;
+	float* depths = swap + 3 * numPoints;
+
+	//Find the face of each shape facing the other, obj1 faces against the normal
+	float towardsObj2[3];
+	Vector_GetScalarProductFromArray(towardsObj2, normal, -1.0f, 3);
+
+	float normal1[3];
+	float normal2[3];
+	unsigned int numFacePoints1 = 0;
+	unsigned int numFacePoints2 = 0;
+
+	float alignment1 = PhysicsManager_FindContactFace(normal1, face1, &numFacePoints1, points1, numPoints1, axes1, numAxes1, towardsObj2, depths);
+	float alignment2 = PhysicsManager_FindContactFace(normal2, face2, &numFacePoints2, points2, numPoints2, axes2, numAxes2, normal, depths);
+
+	unsigned char numContacts = 0;
+
+	//If neither face lies flat against the other object the objects touch at an edge or vertex
+	if(alignment1 >= PhysicsManager_MIN_FACE_ALIGNMENT || alignment2 >= PhysicsManager_MIN_FACE_ALIGNMENT)
+	{
+		//The face closest to the normal is the reference face, the other shape's points under it form the incident face
+		float* referenceNormal;
+		float* referenceFace;
+		unsigned int numReferencePoints;
+		const float* incidentPoints;
+		unsigned int numIncidentPoints;
+		float* incidentFace;
+
+		if(alignment1 >= alignment2)
+		{
+			referenceNormal = normal1;
+			referenceFace = face1;
+			numReferencePoints = numFacePoints1;
+			incidentPoints = points2;
+			numIncidentPoints = numPoints2;
+			incidentFace = face2;
+		}
+		else
+		{
+			referenceNormal = normal2;
+			referenceFace = face2;
+			numReferencePoints = numFacePoints2;
+			incidentPoints = points1;
+			numIncidentPoints = numPoints1;
+			incidentFace = face1;
+		}
+
+		float incidentDirection[3];
+		Vector_GetScalarProductFromArray(incidentDirection, referenceNormal, -1.0f, 3);
+		unsigned int numIncidentFacePoints = PhysicsManager_GatherSupportPoints(incidentFace, incidentPoints, numIncidentPoints, incidentDirection);
+
+		//A vertex resting on a face is a single point of contact
+		if(numIncidentFacePoints >= 2)
+		{
+			if(numIncidentFacePoints > 2)
+			{
+				PhysicsManager_OrderPolygon(incidentFace, numIncidentFacePoints, incidentDirection, depths);
+			}
+
+			//Each clip adds at most one point, so the clipped polygon never holds more than the points of both faces
+			Vector_CopyArray(clipped, incidentFace, 3 * numIncidentFacePoints);
+			unsigned int numClipped = numIncidentFacePoints;
+
+			//Clip the incident face to the inside of each edge of the reference face
+			for(unsigned int i = 0; i < numReferencePoints && numClipped > 0; i++)
+			{
+				const float* start = referenceFace + 3 * i;
+				const float* end = referenceFace + 3 * ((i + 1) % numReferencePoints);
+
+				float edge[3];
+				Vector_SubtractArray(edge, end, start, 3);
+
+				//The reference face runs counterclockwise around it's normal, so the normal crossed with an edge points into the face
+				float inward[3];
+				Vector_CrossProduct3Array(inward, referenceNormal, edge);
+
+				numClipped = PhysicsManager_ClipPolygon(swap, clipped, numClipped, start, inward);
+
+				float* temp = clipped;
+				clipped = swap;
+				swap = temp;
+			}
+
+			//Keep the points which touch the reference face, moved halfway to it so both objects share them
+			unsigned int numKept = 0;
+			for(unsigned int i = 0; i < numClipped; i++)
+			{
+				float offset[3];
+				Vector_SubtractArray(offset, clipped + 3 * i, referenceFace, 3);
+				float separation = Vector_DotProductArray(offset, referenceNormal, 3);
+				if(separation > PhysicsManager_CONTACT_TOLERANCE)
+				{
+					continue;
+				}
+
+				float point[3];
+				Vector_GetScalarProductFromArray(point, referenceNormal, -0.5f * separation, 3);
+				Vector_IncrementArray(point, clipped + 3 * i, 3);
+
+				//Clipping a segment visits each end twice
+				unsigned char duplicate = 0;
+				for(unsigned int j = 0; j < numKept; j++)
+				{
+					Vector_SubtractArray(offset, point, swap + 3 * j, 3);
+					if(Vector_GetMagSqFromArray(offset, 3) < 0.000001f)
+					{
+						duplicate = 1;
+						break;
+					}
+				}
+
+				if(!duplicate)
+				{
+					//The clipped points are no longer needed, so the kept points are gathered into the other buffer
+					Vector_CopyArray(swap + 3 * numKept, point, 3);
+					depths[numKept] = -separation;
+					numKept++;
+				}
+			}
+
+			if(numKept > PairCache_MAX_CONTACTS)
+			{
+				PhysicsManager_ReduceContacts(dest, swap, depths, numKept, referenceNormal);
+				numContacts = PairCache_MAX_CONTACTS;
+			}
+			else
+			{
+				Vector_CopyArray(dest->points[0], swap, 3 * numKept);
+				numContacts = numKept;
+			}
+		}
+	}
+
+	return numContacts;
+}
+
+///
+//Finds the face of a convex shape whose normal is closest to a direction
+//
+//Parameters:
+//	faceNormal: An array of 3 floats to store the normal of the face in
+//	face: An array of 3 floats per point of the shape to store the world space points of the face in, ordered around the normal
+//	numFacePoints: A pointer to store the number of points of the face in
+//	points: The world space points of the convex shape, 3 floats per point
+//	numPoints: The number of points of the shape
+//	axes: The oriented face axes of the convex shape, 3 floats per axis
+//	numAxes: The number of axes of the shape
+//	direction: An array of 3 floats containing the direction the face should face
+//	angles: An array of a float per point of the shape to hold the angles of the points of the face while ordering them
+//
+//Returns:
+//	The cosine of the angle between the normal of the face and the direction, -1 if the shape has no face
+static float PhysicsManager_FindContactFace(float* faceNormal, float* face, unsigned int* numFacePoints,
+											const float* points, unsigned int numPoints, const float* axes, unsigned int numAxes,
+											const float* direction, float* angles)
+{
+	float bestAlignment = -1.0f;
+	*numFacePoints = 0;
+
+	for(unsigned int i = 0; i < numAxes; i++)
 	{
-		Vector_Copy(&velP1, &Vector_ZERO);
+		float axis[3];
+		Vector_CopyArray(axis, axes + 3 * i, 3);
+		Vector_NormalizeArray(axis, 3);
+
+		//Axes are stored once for both faces they are normal to, use the side facing the direction
+		float alignment = Vector_DotProductArray(axis, direction, 3);
+		if(alignment < 0.0f)
+		{
+			Vector_ScaleArray(axis, -1.0f, 3);
+			alignment = -alignment;
+		}
+
+		if(alignment > bestAlignment)
+		{
+			//The opposite side of an axis may be a vertex or edge rather than a face
+			unsigned int numSupportPoints = PhysicsManager_GatherSupportPoints(face, points, numPoints, axis);
+			if(numSupportPoints >= 3)
+			{
+				bestAlignment = alignment;
+				*numFacePoints = numSupportPoints;
+				Vector_CopyArray(faceNormal, axis, 3);
+			}
+		}
 	}
 
-	if(collision->obj2->body != NULL)
+	if(*numFacePoints > 0)
 	{
-		Vector_CrossProduct(&velP2, collision->obj2->body->angularVelocity, &radP2);
-		Vector_Increment(&velP2, collision->obj2->body->velocity);
+		//The face buffer holds the points of the last face gathered, gather the best again
+		PhysicsManager_GatherSupportPoints(face, points, numPoints, faceNormal);
+		PhysicsManager_OrderPolygon(face, *numFacePoints, faceNormal, angles);
 	}
-	else
+
+	return bestAlignment;
+}
+
+///
+//Gathers the points of a convex hull which lie furthest in a direction
+//
+//Parameters:
+//	dest: An array of 3 floats per point of the hull to store the furthest points in
+//	points: The world space points of the convex hull, 3 floats per point
+//	numPoints: The number of points of the hull
+//	direction: An array of 3 floats containing the direction
+//
+//Returns:
+//	The number of points within PhysicsManager_FACE_TOLERANCE of the furthest point
+static unsigned int PhysicsManager_GatherSupportPoints(float* dest, const float* points, unsigned int numPoints, const float* direction)
+{
+	float max = -FLT_MAX;
+	for(unsigned int i = 0; i < numPoints; i++)
 	{
-		Vector_Copy(&velP2, &Vector_ZERO);
+		float projection = Vector_DotProductArray(points + 3 * i, direction, 3);
+		if(projection > max)
+		{
+			max = projection;
+		}
 	}
 
-	Vector velAB;	//Relative linear velocity of point P on object A from an observer on Point P on obj B
-	Vector_INIT_ON_STACK(velAB, 3);
+	unsigned int numSupportPoints = 0;
+	for(unsigned int i = 0; i < numPoints; i++)
+	{
+		if(Vector_DotProductArray(points + 3 * i, direction, 3) >= max - PhysicsManager_FACE_TOLERANCE)
+		{
+			Vector_CopyArray(dest + 3 * numSupportPoints, points + 3 * i, 3);
+			numSupportPoints++;
+		}
+	}
 
-	Vector_Subtract(&velAB, &velP1, &velP2);
+	return numSupportPoints;
+}
 
-	//Get the magnitude of the relative velocity in the direction of obj1 from the point of contact
-	float relNormalVel = Vector_DotProduct(&velAB, collision->minimumTranslationVector);
+///
+//Orders the points of a convex polygon counterclockwise around it's normal
+//
+//Parameters:
+//	polygon: The points of the polygon, 3 floats per point
+//	numPoints: The number of points of the polygon
+//	normal: An array of 3 floats containing the normal of the polygon
+//	angles: An array of a float per point of the polygon to hold the angle of each point around the center in
+static void PhysicsManager_OrderPolygon(float* polygon, unsigned int numPoints, const float* normal, float* angles)
+{
+	float center[3] = { 0.0f, 0.0f, 0.0f };
+	for(unsigned int i = 0; i < numPoints; i++)
+	{
+		Vector_IncrementArray(center, polygon + 3 * i, 3);
+	}
+	Vector_ScaleArray(center, 1.0f / numPoints, 3);
 
+	//Measure the angle of each point around the center from the first point
+	float u[3];
+	float v[3];
+	Vector_SubtractArray(u, polygon, center, 3);
+	Vector_CrossProduct3Array(v, normal, u);
 
-	//The final numerator of the impulse equation
-	float numerator =  (-1 - e) * relNormalVel;
+	for(unsigned int i = 0; i < numPoints; i++)
+	{
+		float offset[3];
+		Vector_SubtractArray(offset, polygon + 3 * i, center, 3);
+		angles[i] = atan2f(Vector_DotProductArray(offset, v, 3), Vector_DotProductArray(offset, u, 3));
+	}
 
-	//Calculation for Denominator of Chris Hecker's impulse equation
-	Vector torque1;	//Torque due to collision on obj1
-	Vector torque2;	//Torque due to collision on obj2
+	//Faces have few points, insertion sort them by angle
+	for(unsigned int i = 1; i < numPoints; i++)
+	{
+		float angle = angles[i];
+		float point[3];
+		Vector_CopyArray(point, polygon + 3 * i, 3);
 
-	Vector_INIT_ON_STACK(torque1, 3);
-	Vector_INIT_ON_STACK(torque2, 3);
+		unsigned int j = i;
+		while(j > 0 && angles[j - 1] > angle)
+		{
+			angles[j] = angles[j - 1];
+			Vector_CopyArray(polygon + 3 * j, polygon + 3 * (j - 1), 3);
+			j--;
+		}
 
-	Vector_CrossProduct(&torque1, &radP1, collision->minimumTranslationVector);
-	Vector_CrossProduct(&torque2, &radP2, collision->minimumTranslationVector);
+		angles[j] = angle;
+		Vector_CopyArray(polygon + 3 * j, point, 3);
+	}
+}
 
+///
+//Clips a polygon to the side of a plane it's normal points towards
+//
+//Parameters:
+//	dest: An array with room for 3 floats per point of the polygon plus 3 more to store the clipped polygon in
+//	polygon: The points of the polygon to clip, 3 floats per point
+//	numPoints: The number of points of the polygon
+//	planePoint: An array of 3 floats containing a point on the plane
+//	planeNormal: An array of 3 floats containing the normal of the plane, pointing to the side which is kept
+//
+//Returns:
+//	The number of points of the clipped polygon
+static unsigned int PhysicsManager_ClipPolygon(float* dest, const float* polygon, unsigned int numPoints, const float* planePoint, const float* planeNormal)
+{
+	unsigned int numClipped = 0;
+	float planeDistance = Vector_DotProductArray(planePoint, planeNormal, 3);
 
-	Vector velPFromT1;	//Linear velocity of point P on obj1 due to torque of obj1
-	Vector velPFromT2;	//Linear velocity of point P on Obj2 due to torque of obj2
+	//Walk each edge of the polygon, keeping the points inside & adding a point wherever an edge crosses the plane
+	const float* start = polygon + 3 * (numPoints - 1);
+	float startDistance = Vector_DotProductArray(start, planeNormal, 3) - planeDistance;
+	for(unsigned int i = 0; i < numPoints; i++)
+	{
+		const float* end = polygon + 3 * i;
+		float endDistance = Vector_DotProductArray(end, planeNormal, 3) - planeDistance;
 
-	Vector_INIT_ON_STACK(velPFromT1, 3);
-	Vector_INIT_ON_STACK(velPFromT2, 3);
+		if((startDistance >= 0.0f) != (endDistance >= 0.0f))
+		{
+			float t = startDistance / (startDistance - endDistance);
+			float* crossing = dest + 3 * numClipped;
+			Vector_SubtractArray(crossing, end, start, 3);
+			Vector_ScaleArray(crossing, t, 3);
+			Vector_IncrementArray(crossing, start, 3);
+			numClipped++;
+		}
 
-	if(collision->obj1->body != NULL && collision->obj1->body->inverseMass != 0.0f)
+		if(endDistance >= 0.0f)
+		{
+			Vector_CopyArray(dest + 3 * numClipped, end, 3);
+			numClipped++;
+		}
+
+		start = end;
+		startDistance = endDistance;
+	}
+
+	return numClipped;
+}
+
+///
+//Chooses the points of contact which cover the most area when there are more than a contact manifold can hold.
+//The deepest point is kept first, then the point furthest from it, then the points spreading the kept points furthest.
+//
+//Parameters:
+//	dest: A pointer to the contact manifold to store the chosen points in
+//	points: The candidate points of contact, 3 floats per point
+//	depths: The depth of each candidate point beneath the reference face
+//	numPoints: The number of candidate points
+//	normal: An array of 3 floats containing the normal of the reference face
+static void PhysicsManager_ReduceContacts(PhysicsManager_ContactManifold* dest, const float* points, const float* depths, unsigned int numPoints, const float* normal)
+{
+	unsigned int chosen[PairCache_MAX_CONTACTS];
+
+	//The deepest point
+	chosen[0] = 0;
+	for(unsigned int i = 1; i < numPoints; i++)
 	{
-		Matrix inertiaInWorldSpace;
-		Matrix_INIT_ON_STACK(inertiaInWorldSpace, 3, 3);
+		if(depths[i] > depths[chosen[0]])
+		{
+			chosen[0] = i;
+		}
+	}
 
-		RigidBody_CalculateMomentOfInertiaInWorldSpace(&inertiaInWorldSpace, collision->obj1->body);
+	//The point furthest from the deepest point
+	const float* a = points + 3 * chosen[0];
+	float bestDistance = -1.0f;
+	chosen[1] = chosen[0];
+	for(unsigned int i = 0; i < numPoints; i++)
+	{
+		float offset[3];
+		Vector_SubtractArray(offset, points + 3 * i, a, 3);
+		float distance = Vector_GetMagSqFromArray(offset, 3);
+		if(distance > bestDistance)
+		{
+			bestDistance = distance;
+			chosen[1] = i;
+		}
+	}
 
-		Matrix inverseInertia;
-		Matrix_INIT_ON_STACK(inverseInertia, 3, 3);
-		Matrix_GetInverse(&inverseInertia, &inertiaInWorldSpace);
+	//The point making the largest triangle with the first two
+	const float* b = points + 3 * chosen[1];
+	float ab[3];
+	Vector_SubtractArray(ab, b, a, 3);
 
-		//Calculate angular acceleration due to torque
-		Matrix_TransformVector(&inverseInertia, &torque1);
+	float bestArea = -1.0f;
+	float winding = 1.0f;
+	chosen[2] = chosen[0];
+	for(unsigned int i = 0; i < numPoints; i++)
+	{
+		float ac[3];
+		float cross[3];
+		Vector_SubtractArray(ac, points + 3 * i, a, 3);
+		Vector_CrossProduct3Array(cross, ab, ac);
 
-		//Determine linear velocity of pont P on obj1 due to angular acceleration of obj1
-		Vector_CrossProduct(&velPFromT1, &torque1, &radP1);
+		float area = Vector_DotProductArray(cross, normal, 3);
+		if(fabsf(area) > bestArea)
+		{
+			bestArea = fabsf(area);
+			winding = area < 0.0f ? -1.0f : 1.0f;
+			chosen[2] = i;
+		}
 	}
-	else
+
+	//The point furthest outside of the triangle, which adds the most area
+	const float* triangle[3] = { a, b, points + 3 * chosen[2] };
+	bestArea = 0.0f;
+	chosen[3] = chosen[0];
+	for(unsigned int i = 0; i < numPoints; i++)
+	{
+		for(unsigned int j = 0; j < 3; j++)
+		{
+			float edge[3];
+			float offset[3];
+			float cross[3];
+			Vector_SubtractArray(edge, triangle[(j + 1) % 3], triangle[j], 3);
+			Vector_SubtractArray(offset, points + 3 * i, triangle[j], 3);
+			Vector_CrossProduct3Array(cross, edge, offset);
+
+			//Points outside of an edge wind the other way around the triangle
+			float area = -winding * Vector_DotProductArray(cross, normal, 3);
+			if(area > bestArea)
+			{
+				bestArea = area;
+				chosen[3] = i;
+			}
+		}
+	}
+
+	for(unsigned int i = 0; i < PairCache_MAX_CONTACTS; i++)
 	{
-		Vector_Copy(&velPFromT1, &Vector_ZERO);
+		Vector_CopyArray(dest->points[i], points + 3 * chosen[i], 3);
 	}
+}
 
-	if(collision->obj2->body != NULL && collision->obj2->body->inverseMass != 0.0f)
+///
+//Matches the points of a contact manifold to the points of contact of the last frame,
+//each point which matches starts with the impulse applied at the point it matched
+//
+//Parameters:
+//	manifold: A pointer to the contact manifold to match
+//	pair: A pointer to the persistent pair the collision was detected on, NULL if there is none
+static void PhysicsManager_MatchContacts(PhysicsManager_ContactManifold* manifold, const PairCache_Pair* pair)
+{
+	if(pair == NULL)
 	{
-		Matrix inertiaInWorldSpace;
-		Matrix_INIT_ON_STACK(inertiaInWorldSpace, 3, 3);
+		return;
+	}
 
-		RigidBody_CalculateMomentOfInertiaInWorldSpace(&inertiaInWorldSpace, collision->obj2->body);
+	//Each point of the last frame may only be matched once
+	unsigned char matched[PairCache_MAX_CONTACTS] = { 0 };
 
-		Matrix inverseInertia;
-		Matrix_INIT_ON_STACK(inverseInertia, 3, 3);
-		Matrix_GetInverse(&inverseInertia, &inertiaInWorldSpace);
+	for(unsigned int i = 0; i < manifold->numContacts; i++)
+	{
+		float bestDistance = PhysicsManager_CONTACT_MATCH_DISTANCE * PhysicsManager_CONTACT_MATCH_DISTANCE;
+		unsigned int best = PairCache_MAX_CONTACTS;
 
-		//Calculate angular acceleration due to torque
-		Matrix_TransformVector(&inverseInertia, &torque2);
+		for(unsigned int j = 0; j < pair->numContacts; j++)
+		{
+			if(matched[j])
+			{
+				continue;
+			}
 
-		//Determine linear velocity of pont P on obj1 due to angular acceleration of obj1
-		Vector_CrossProduct(&velPFromT2, &torque2, &radP2);
+			float offset[3];
+			Vector_SubtractArray(offset, manifold->points[i], pair->contacts[j], 3);
+			float distance = Vector_GetMagSqFromArray(offset, 3);
+			if(distance < bestDistance)
+			{
+				bestDistance = distance;
+				best = j;
+			}
+		}
+
+		if(best < PairCache_MAX_CONTACTS)
+		{
+			matched[best] = 1;
+			manifold->impulses[i] = pair->contactImpulses[best];
+		}
+		else
+		{
+			manifold->impulses[i] = 0.0f;
+		}
 	}
-	else
+}
+
+///
+//Gets the index of the point a convex hull of a collision last climbed to along the collision's MTV,
+//which it's climb to it's furthest points should start from
+//
+//Parameters:
+//	collision: A pointer to the collision the convex hull is a part of
+//	second: 0 for the hull of the collision's obj1, which searches against the MTV, 1 for the hull of it's obj2, which searches along the MTV
+//
+//Returns:
+//	A pointer to the index to climb from in the collision's persistent pair, NULL if the collision has no pair
+static unsigned int* PhysicsManager_GetFurthestStart(const Collision* collision, unsigned char second)
+{
+	if(collision->pair == NULL) return NULL;
+	//The pair stores it's start indices by it's own obj1 & obj2, which the collision may have swapped
+	unsigned char swapped = collision->obj1 != collision->pair->obj1;
+	return collision->pair->furthest + (second != swapped);
+}
+
+///
+//Calculates and imparts the resulting collision impulses at every point of a contact manifold.
+//The impulses at each point start at their matched impulses from the last frame, then are corrected in turn until they
+//stop every point from approaching, or separate them as given by the coefficients of restitution, without pulling any point together.
+//
+//Parameters:
+//	collision: The collision having it's resulting impulses calculated and applied
+//	manifold: A pointer to the contact manifold of the collision, the impulse applied at each point is stored in it
+//
+//Returns:
+//	The magnitude of the total impulse applied along the minimum translation vector
+static float PhysicsManager_ApplyManifoldImpulses(Collision* collision, PhysicsManager_ContactManifold* manifold)
+{
+	//Calculation for the numerator of Chris Hecker's collision impulse equation
+	//Hardcode coefficients of restitution for now
+	float coefficientOfRestitution1 = collision->obj1->body != NULL ? collision->obj1->body->coefficientOfRestitution : 1.0f;
+	float coefficientOfRestitution2 = collision->obj2->body != NULL ? collision->obj2->body->coefficientOfRestitution : 1.0f;
+
+	//TODO: Find out if the final coefficient e is the product of the two coefficients of restitution
+	float e = coefficientOfRestitution1 * coefficientOfRestitution2;
+
+	const float* normal = collision->minimumTranslationVector;
+
+	RigidBody* bodies[2] = { collision->obj1->body, collision->obj2->body };
+	const FrameOfReference* frames[2] = { collision->obj1Frame, collision->obj2Frame };
+	const Collider* colliders[2] = { collision->obj1Collider, collision->obj2Collider };
+
+	//The impulse on obj2 acts against the normal
+	const float signs[2] = { 1.0f, -1.0f };
+
+	//Track the velocities of both bodies as the impulses are corrected, the bodies themselves only change once the impulses are applied
+	float inverseMasses[2];
+	float inverseInertias[2][9];
+	unsigned char canRotate[2];
+	float velocities[2][3];
+	float angularVelocities[2][3];
+
+	for(unsigned int i = 0; i < 2; i++)
 	{
-		Vector_Copy(&velPFromT2, &Vector_ZERO);
+		inverseMasses[i] = 0.0f;
+		canRotate[i] = 0;
+		Vector_ZeroArray(velocities[i], 3);
+		Vector_ZeroArray(angularVelocities[i], 3);
+
+		if(bodies[i] != NULL)
+		{
+			Vector_CopyArray(velocities[i], bodies[i]->velocity->components, 3);
+			Vector_CopyArray(angularVelocities[i], bodies[i]->angularVelocity->components, 3);
+
+			if(bodies[i]->inverseMass != 0.0f)
+			{
+				if(!bodies[i]->freezeTranslation)
+				{
+					inverseMasses[i] = bodies[i]->inverseMass;
+				}
+
+				if(!bodies[i]->freezeRotation)
+				{
+					Matrix inertiaInWorldSpace;
+					Matrix_INIT_ON_STACK(inertiaInWorldSpace, 3, 3);
+
+					RigidBody_CalculateMomentOfInertiaInWorldSpace(&inertiaInWorldSpace, bodies[i]);
+
+					Matrix inverseInertia;
+					Matrix_INIT_ON_STACK(inverseInertia, 3, 3);
+					Matrix_GetInverse(&inverseInertia, &inertiaInWorldSpace);
+
+					Vector_CopyArray(inverseInertias[i], inverseInertia.components, 9);
+					canRotate[i] = 1;
+				}
+			}
+		}
 	}
 
-	//Add the velocities due to torques together
-	Vector_Increment(&velPFromT1, &velPFromT2);
+	float radii[PairCache_MAX_CONTACTS][2][3];				//Radial vectors from the CoM of each object to each point of contact
+	float angularResponses[PairCache_MAX_CONTACTS][2][3];	//Change in angular velocity of each object due to a unit impulse at each point
+	float inverseEffectiveMasses[PairCache_MAX_CONTACTS];	//Change in relative normal velocity at each point due to a unit impulse at the point
+	float targetVelocities[PairCache_MAX_CONTACTS];			//Relative normal velocity each point should leave the collision with
 
+	for(unsigned int i = 0; i < manifold->numContacts; i++)
+	{
+		inverseEffectiveMasses[i] = inverseMasses[0] + inverseMasses[1];
 
-	//Get the sum of the inverse masses
-	float iMassSum = 0.0f;
-	if(collision->obj1->body != NULL)
+		for(unsigned int j = 0; j < 2; j++)
+		{
+			//The point of collision of an AABB is it's position, AABBs never rotate
+			if(colliders[j]->type == COLLIDER_AABB)
+			{
+				Vector_ZeroArray(radii[i][j], 3);
+			}
+			else
+			{
+				Vector_SubtractArray(radii[i][j], manifold->points[i], frames[j]->position->components, 3);
+			}
+
+			if(canRotate[j])
+			{
+				float torque[3];
+				Vector_CrossProduct3Array(torque, radii[i][j], normal);
+				Matrix_GetProductVectorArray(angularResponses[i][j], inverseInertias[j], torque, 3, 3);
+
+				float velocityFromTorque[3];
+				Vector_CrossProduct3Array(velocityFromTorque, angularResponses[i][j], radii[i][j]);
+				inverseEffectiveMasses[i] += Vector_DotProductArray(velocityFromTorque, normal, 3);
+			}
+			else
+			{
+				Vector_ZeroArray(angularResponses[i][j], 3);
+			}
+		}
+	}
+
+	//Measure how fast each point approaches before any impulse is applied
+	for(unsigned int i = 0; i < manifold->numContacts; i++)
 	{
-		iMassSum += collision->obj1->body->inverseMass;
+		float relativeNormalVelocity = PhysicsManager_GetRelativeNormalVelocity(normal, radii[i], velocities, angularVelocities);
+		targetVelocities[i] = relativeNormalVelocity < 0.0f ? -e * relativeNormalVelocity : 0.0f;
 	}
 
-	if(collision->obj2->body != NULL)
+	//If neither object can move there is nothing to resolve
+	unsigned char canRespond = 1;
+	for(unsigned int i = 0; i < manifold->numContacts; i++)
 	{
-		iMassSum += collision->obj2->body->inverseMass;
+		if(inverseEffectiveMasses[i] <= 0.0f)
+		{
+			canRespond = 0;
+		}
 	}
 
-	//Final calculation for denominator of impulse equation
-	float denominator = iMassSum + Vector_DotProduct(&velPFromT1, collision->minimumTranslationVector);
+	if(!canRespond)
+	{
+		for(unsigned int i = 0; i < manifold->numContacts; i++)
+		{
+			manifold->impulses[i] = 0.0f;
+		}
+		return 0.0f;
+	}
 
-	//Calculate impulse
-	float impulse = numerator/denominator;
+	//Start from the impulses matched from last frame, then correct the impulse at each point in turn.
+	//The first pass is the warm start, which applies the matched impulses as they are.
+	for(unsigned int iteration = 0; iteration <= PhysicsManager_MANIFOLD_ITERATIONS; iteration++)
+	{
+		for(unsigned int i = 0; i < manifold->numContacts; i++)
+		{
+			float deltaImpulse = manifold->impulses[i];
+
+			if(iteration > 0)
+			{
+				float relativeNormalVelocity = PhysicsManager_GetRelativeNormalVelocity(normal, radii[i], velocities, angularVelocities);
+
+				//The total impulse at a point may push the objects apart but never pull them together
+				float impulse = manifold->impulses[i] + (targetVelocities[i] - relativeNormalVelocity) / inverseEffectiveMasses[i];
+				if(impulse < 0.0f)
+				{
+					impulse = 0.0f;
+				}
+
+				deltaImpulse = impulse - manifold->impulses[i];
+				manifold->impulses[i] = impulse;
+			}
+
+			for(unsigned int j = 0; j < 2; j++)
+			{
+				float deltaVelocity[3];
+				Vector_GetScalarProductFromArray(deltaVelocity, normal, signs[j] * deltaImpulse * inverseMasses[j], 3);
+				Vector_IncrementArray(velocities[j], deltaVelocity, 3);
+
+				Vector_GetScalarProductFromArray(deltaVelocity, angularResponses[i][j], signs[j] * deltaImpulse, 3);
+				Vector_IncrementArray(angularVelocities[j], deltaVelocity, 3);
+			}
+		}
+	}
+
+	//Apply the final impulse at each point
+	float totalImpulse = 0.0f;
 
 	Vector impulseVector;
 	Vector_INIT_ON_STACK(impulseVector, 3);
-	//V1After = V1Before + impulse / M1 * MTV
-	Vector_GetScalarProduct(&impulseVector, collision->minimumTranslationVector, impulse);
-	//Apply impulse
-	if(collision->obj1->body != NULL && collision->obj1->body->inverseMass != 0.0f)
-	{
-		RigidBody_ApplyImpulse(collision->obj1->body, &impulseVector, &radP1);
-	}
-	if(collision->obj2->body != NULL && collision->obj2->body->inverseMass != 0.0f)
+
+	Vector radius;
+	radius.dimension = 3;
+
+	for(unsigned int i = 0; i < manifold->numContacts; i++)
 	{
-		//V2After = V2Before - impulse / M2 * MTV
-		Vector_Scale(&impulseVector, -1.0f);
+		totalImpulse += manifold->impulses[i];
 
-		RigidBody_ApplyImpulse(collision->obj2->body, &impulseVector, &radP2);
+		for(unsigned int j = 0; j < 2; j++)
+		{
+			if(bodies[j] != NULL && bodies[j]->inverseMass != 0.0f)
+			{
+				//V1After = V1Before + impulse / M1 * MTV, V2After = V2Before - impulse / M2 * MTV
+				Vector_GetScalarProductFromArray(impulseVector.components, normal, signs[j] * manifold->impulses[i], 3);
+				radius.components = radii[i][j];
 
+				RigidBody_ApplyImpulse(bodies[j], &impulseVector, &radius);
+			}
+		}
 	}
 
+	return totalImpulse;
+}
+
+///
+//Gets the velocity at which the two objects of a collision approach each other at a point, along the normal
+//
+//Parameters:
+//	normal: An array of 3 floats containing the minimum translation vector of the collision, pointing towards obj1
+//	radii: The radial vectors from the CoM of obj1 and obj2 to the point
+//	velocities: The linear velocities of obj1 and obj2
+//	angularVelocities: The angular velocities of obj1 and obj2
+//
+//Returns:
+//	The velocity of obj1 relative to obj2 at the point along the normal, negative when the objects approach
+static float PhysicsManager_GetRelativeNormalVelocity(const float* normal, const float (*radii)[3], const float (*velocities)[3], const float (*angularVelocities)[3])
+{
+	float pointVelocity1[3];
+	float pointVelocity2[3];
+
+	Vector_CrossProduct3Array(pointVelocity1, angularVelocities[0], radii[0]);
+	Vector_IncrementArray(pointVelocity1, velocities[0], 3);
+
+	Vector_CrossProduct3Array(pointVelocity2, angularVelocities[1], radii[1]);
+	Vector_IncrementArray(pointVelocity2, velocities[1], 3);
+
+	Vector_DecrementArray(pointVelocity1, pointVelocity2, 3);
+	return Vector_DotProductArray(pointVelocity1, normal, 3);
 }
 
 ///
@@ -1683,7 +2426,7 @@ static void PhysicsManager_ApplyLinearFrictionalImpulses(Collision* collision, c
 
 		//Project the relative velocity onto the surface normal
 		//Vector_GetScalarProduct(&relativeVelocityPerp, &relativeVelocity, Vector_DotProduct(&relativeVelocity, collision->minimumTranslationVector));
-		Vector_GetProjection(&relativeVelocityPerp, &relativeVelocity, collision->minimumTranslationVector);
+		Vector_GetProjectionArray(relativeVelocityPerp.components, relativeVelocity.components, collision->minimumTranslationVector, 3);
 
 		//VTangential = V - VPerpendicular
 		Vector_Subtract(&unitTangentVector, &relativeVelocity, &relativeVelocityPerp);
@@ -1712,7 +2455,7 @@ static void PhysicsManager_ApplyLinearFrictionalImpulses(Collision* collision, c
 		Vector_INIT_ON_STACK(cumNetForcePerp, 3);
 
 		//Vector_GetScalarProduct(&cumNetForcePerp, &cumulativeNetForce, Vector_DotProduct(&cumulativeNetForce, collision->minimumTranslationVector));
-		Vector_GetProjection(&cumNetForcePerp, &cumulativeNetForce, collision->minimumTranslationVector);
+		Vector_GetProjectionArray(cumNetForcePerp.components, cumulativeNetForce.components, collision->minimumTranslationVector, 3);
 
 
 		//VTangential = V - VPerpendicular
@@ -1725,11 +2468,11 @@ static void PhysicsManager_ApplyLinearFrictionalImpulses(Collision* collision, c
 	float reactionMag = 0.0f;
 	if(collision->obj1->body != NULL && collision->obj1->body->inverseMass != 0.0f && !collision->obj1->body->freezeTranslation)
 	{
-		reactionMag = fabs(Vector_DotProduct(collision->obj1->body->netImpulse, collision->minimumTranslationVector));
+		reactionMag = fabs(Vector_DotProductArray(collision->obj1->body->netImpulse->components, collision->minimumTranslationVector, 3));
 	}
 	else
 	{
-		reactionMag = fabs(Vector_DotProduct(collision->obj2->body->netImpulse, collision->minimumTranslationVector));
+		reactionMag = fabs(Vector_DotProductArray(collision->obj2->body->netImpulse->components, collision->minimumTranslationVector, 3));
 	}
 
 	float staticMag = staticCoefficient * reactionMag;
@@ -1815,7 +2558,7 @@ static void PhysicsManager_ApplyFrictionalTorques(Collision* collision, const fl
 
 		Vector_Increment(&instantaneousTorqueCausingAngularAcceleration, collision->obj1->body->netInstantaneousTorque);
 
-		reactionMag1 = fabs(Vector_DotProduct(&instantaneousTorqueCausingAngularAcceleration, collision->minimumTranslationVector));
+		reactionMag1 = fabs(Vector_DotProductArray(instantaneousTorqueCausingAngularAcceleration.components, collision->minimumTranslationVector, 3));
 
 	}
 	else if (collision->obj2->body != NULL && collision->obj2->body->inverseMass != 0.0f && !collision->obj2->body->freezeRotation)
@@ -1828,7 +2571,7 @@ static void PhysicsManager_ApplyFrictionalTorques(Collision* collision, const fl
 
 		Vector_Increment(&instantaneousTorqueCausingAngularAcceleration, collision->obj2->body->netInstantaneousTorque);
 
-		reactionMag2 = fabs(Vector_DotProduct(&instantaneousTorqueCausingAngularAcceleration, collision->minimumTranslationVector));
+		reactionMag2 = fabs(Vector_DotProductArray(instantaneousTorqueCausingAngularAcceleration.components, collision->minimumTranslationVector, 3));
 	}
 
 
@@ -1863,7 +2606,7 @@ static void PhysicsManager_ApplyFrictionalTorques(Collision* collision, const fl
 		Vector_Increment(&cumNetTorques, collision->obj2->body->previousNetTorque);
 	}
 
-	Vector_Project(&cumNetTorques, collision->minimumTranslationVector);
+	Vector_ProjectArray(cumNetTorques.components, collision->minimumTranslationVector, 3);
 
 	//Step 3) Compute frictional torque
 	Vector frictionalTorque;
@@ -1874,8 +2617,8 @@ static void PhysicsManager_ApplyFrictionalTorques(Collision* collision, const fl
 
 	if(collision->obj1->body != NULL)
 	{
-		float angularInDirectionOfNormal = Vector_DotProduct(collision->obj1->body->angularVelocity, collision->minimumTranslationVector);
-		float torqueInDirectionOfNormal = Vector_DotProduct(collision->obj1->body->previousNetTorque, collision->minimumTranslationVector);
+		float angularInDirectionOfNormal = Vector_DotProductArray(collision->obj1->body->angularVelocity->components, collision->minimumTranslationVector, 3);
+		float torqueInDirectionOfNormal = Vector_DotProductArray(collision->obj1->body->previousNetTorque->components, collision->minimumTranslationVector, 3);
 
 		//If the object isn't spinning on the collision face, 
 		//and the magnitude of the component of the torque in the direction of the collision face normal is less than the magnitude of static torque due to friction
@@ -1885,7 +2628,7 @@ static void PhysicsManager_ApplyFrictionalTorques(Collision* collision, const fl
 			//For OBJ1
 			//We can base frictional torque off of the current angular velocity to negate it (Nothing should be moving yet)
 			Matrix_GetProductVector(&frictionalTorque, collision->obj1->body->inertia, &relativeAngularVelocity);
-			Vector_GetScalarProduct(&frictionalTorque, collision->minimumTranslationVector, -1.0f * Vector_DotProduct(&frictionalTorque, collision->minimumTranslationVector));
+			Vector_GetScalarProductFromArray(frictionalTorque.components, collision->minimumTranslationVector, -1.0f * Vector_DotProductArray(frictionalTorque.components, collision->minimumTranslationVector, 3), 3);
 
 			RigidBody_ApplyInstantaneousTorque(collision->obj1->body, &frictionalTorque);
 
@@ -1897,9 +2640,9 @@ static void PhysicsManager_ApplyFrictionalTorques(Collision* collision, const fl
 			Vector_INIT_ON_STACK(axis, 3);
 
 			if(Vector_GetMag(collision->obj2->body->angularVelocity) > 0.0f)
-				Vector_GetProjection(&axis, collision->obj2->body->angularVelocity, collision->minimumTranslationVector);
+				Vector_GetProjectionArray(axis.components, collision->obj2->body->angularVelocity->components, collision->minimumTranslationVector, 3);
 			else
-				Vector_GetProjection(&axis, collision->obj2->body->previousNetTorque, collision->minimumTranslationVector);
+				Vector_GetProjectionArray(axis.components, collision->obj2->body->previousNetTorque->components, collision->minimumTranslationVector, 3);
 
 			Vector_Normalize(&axis);
 
@@ -1914,8 +2657,8 @@ static void PhysicsManager_ApplyFrictionalTorques(Collision* collision, const fl
 	//OBJ2
 	if(collision->obj2->body != NULL)
 	{
-		float angularInDirectionOfNormal = Vector_DotProduct(collision->obj2->body->angularVelocity, collision->minimumTranslationVector);
-		float torqueInDirectionOfNormal = Vector_DotProduct(collision->obj2->body->previousNetTorque, collision->minimumTranslationVector);
+		float angularInDirectionOfNormal = Vector_DotProductArray(collision->obj2->body->angularVelocity->components, collision->minimumTranslationVector, 3);
+		float torqueInDirectionOfNormal = Vector_DotProductArray(collision->obj2->body->previousNetTorque->components, collision->minimumTranslationVector, 3);
 		//If the object isn't spinning on the collision face, 
 		//and the magnitude of the component of the torque in the direction of the collision face normal is less than the magnitude of static torque due to friction
 		if(angularInDirectionOfNormal == 0.0f && fabs(torqueInDirectionOfNormal) <= staticMag2)
@@ -1923,7 +2666,7 @@ static void PhysicsManager_ApplyFrictionalTorques(Collision* collision, const fl
 
 			//We can base frictional torque off of the current angular velocity to negate it (Nothing should be moving yet)
 			Matrix_GetProductVector(&frictionalTorque, collision->obj2->body->inertia, &relativeAngularVelocity);
-			Vector_GetScalarProduct(&frictionalTorque, collision->minimumTranslationVector, -1.0f * Vector_DotProduct(&frictionalTorque, collision->minimumTranslationVector));
+			Vector_GetScalarProductFromArray(frictionalTorque.components, collision->minimumTranslationVector, -1.0f * Vector_DotProductArray(frictionalTorque.components, collision->minimumTranslationVector, 3), 3);
 
 			RigidBody_ApplyInstantaneousTorque(collision->obj2->body, &frictionalTorque);
 		}
@@ -1934,9 +2677,9 @@ static void PhysicsManager_ApplyFrictionalTorques(Collision* collision, const fl
 			Vector_INIT_ON_STACK(axis, 3);
 
 			if(Vector_GetMag(collision->obj2->body->angularVelocity) > 0.0f)
-				Vector_GetProjection(&axis, collision->obj2->body->angularVelocity, collision->minimumTranslationVector);
+				Vector_GetProjectionArray(axis.components, collision->obj2->body->angularVelocity->components, collision->minimumTranslationVector, 3);
 			else
-				Vector_GetProjection(&axis, collision->obj2->body->previousNetTorque, collision->minimumTranslationVector);
+				Vector_GetProjectionArray(axis.components, collision->obj2->body->previousNetTorque->components, collision->minimumTranslationVector, 3);
 
 			Vector_Normalize(&axis);
 
@@ -8,8 +8,30 @@ typedef struct PhysicsBuffer
 {
 	LinkedList* globalForces;			//Contains the list of global forces to apply to all bodies upon each update
 	LinkedList* globalAccelerations;	//Contains the listof global accelerations to apply to all bodies upon each update
+	float* scratch;						//Memory reused to clip contact faces, only grows so once it fits the largest colliders clipping does not touch the heap
+	unsigned int scratchSize;			//Number of floats there is room for in the scratch memory
 } PhysicsBuffer;
 
+//The most a point of the incident face may lie above the reference face & still be kept as a point of contact,
+//the objects were pulled apart before contact points are determined so resting faces only just touch
+#define PhysicsManager_CONTACT_TOLERANCE 0.02f
+//The furthest a point of contact may move between frames & still be matched to the point it was the last frame
+#define PhysicsManager_CONTACT_MATCH_DISTANCE 0.05f
+//The least the normal of the reference face must agree with the minimum translation vector to clip faces, edge & vertex contacts give a single point
+#define PhysicsManager_MIN_FACE_ALIGNMENT 0.95f
+//The furthest a point of a hull may lie from the furthest point in a direction & still be part of the face in that direction
+#define PhysicsManager_FACE_TOLERANCE 0.001f
+//Number of times the impulses of a contact manifold are corrected
+#define PhysicsManager_MANIFOLD_ITERATIONS 8
+
+//The points of contact between two colliders, shared by both objects
+typedef struct PhysicsManager_ContactManifold
+{
+	unsigned char numContacts;							//Number of points of contact
+	float points[PairCache_MAX_CONTACTS][3];			//World space points of contact
+	float impulses[PairCache_MAX_CONTACTS];				//Impulse applied along the normal at each point, starts at the impulse the point matched last frame
+} PhysicsManager_ContactManifold;
+
 static PhysicsBuffer* physicsBuffer;
 
 ///
@@ -33,6 +55,18 @@ static void PhysicsManager_InitializeBuffer(PhysicsBuffer* buffer);
 //	buffer: The buffer to free the memory of
 static void PhysicsManager_FreeBuffer(PhysicsBuffer* buffer);
 
+///
+//Makes room for a number of floats in the scratch memory of a physics buffer.
+//The contents of the scratch memory are not kept when it grows.
+//
+//Parameters:
+//	buffer: A pointer to the physics buffer owning the scratch memory
+//	numFloats: The number of floats needed
+//
+//Returns:
+//	A pointer to at least numFloats floats
+static float* PhysicsManager_ReserveScratch(PhysicsBuffer* buffer, unsigned int numFloats);
+
 ///
 //Initializes the physics manager
 void PhysicsManager_Initialize();
@@ -111,11 +145,11 @@ void PhysicsManager_UpdateRotationalPhysicsOfBody(RigidBody* body, float dt);
 void PhysicsManager_UpdateObjects(LinkedList* gameObjects);
 
 ///
-//Resolves all collisions in a linked list
+//Resolves all collisions in a dynamic array
 //
 //Parameters:
-//	collisions: A linked list of all collisions detected which need resolving
-void PhysicsManager_ResolveCollisions(LinkedList* collisions);
+//	collisions: A dynamic array of all collisions detected which need resolving
+void PhysicsManager_ResolveCollisions(DynamicArray* collisions);
 
 ///
 //Resolves a collision
@@ -179,12 +213,14 @@ static void PhysicsManager_DetermineCollisionPointAABB(Vector* dest, const Frame
 //	dest: A pointer to a vector to store the collision point in
 //	convexHull1: A pointer to the convex hull collider data involved in the collision which we are determining the point of collision on.
 //	convexFrame1: A pointer to the frame of reference of the convex hull involved in the collision which we are determining the point of collision on.
+//	start1: A pointer to the index of the point of convexHull1 to start searching for it's furthest points from, NULL to start from the first
 //	convexHull2: A pointer to the other convex hull collider data involved in the collision, whether the object itself has a convex hull or not.
 //	convexFrame2: A pointer to the frame of reference of the other convex hull involved in the collision, whether the object itself has a convex hull or not
+//	start2: A pointer to the index of the point of convexHull2 to start searching for it's furthest points from, NULL to start from the first
 //	relativeMTV: A pointer to a vector representing the MTV !Pointing towards the OTHER object (convexHull2)!
 static void PhysicsManager_DetermineCollisionPointConvexHull(Vector* dest,
-															const ColliderData_ConvexHull* convexHull1, const FrameOfReference* convexFrame1,
-															const ColliderData_ConvexHull* convexHull2, const FrameOfReference* convexFrame2,
+															const ColliderData_ConvexHull* convexHull1, const FrameOfReference* convexFrame1, unsigned int* start1,
+															const ColliderData_ConvexHull* convexHull2, const FrameOfReference* convexFrame2, unsigned int* start2,
 															const Vector* relativeMTV);
 
 ///
@@ -230,12 +266,162 @@ static void PhysicsManager_DetermineCollisionPointConvexHullFace(Vector* dest,
 															  const DynamicArray* furthestOnHull2, const FrameOfReference* convexFrame2);
 
 ///
-//Calculates and imparts the resulting collision impulse from the collision
+//Determines the contact manifold of a decoupled collision.
+//When a face of one collider rests against the other, the nearest face of the other collider is clipped against it giving up to 4 points,
+//else the single point of contact is found by PhysicsManager_DetermineCollisionPoints.
+//
+//Parameters:
+//	dest: A pointer to the contact manifold to store the points of contact in, the impulses are left at 0
+//	collision: The collision to determine the points of contact of
+static void PhysicsManager_DetermineContactManifold(PhysicsManager_ContactManifold* dest, Collision* collision);
+
+///
+//Orients the corners & face axes of an AABB into world space, in the same order as AABBCollider_ToConvexHullCollider would give them
+//
+//Parameters:
+//	points: An array of 24 floats to store the 8 world space corners of the AABB in
+//	axes: An array of 9 floats to store the 3 oriented axes of the AABB in
+//	AABB: A pointer to the AABB collider data to orient
+//	frame: A pointer to the frame of reference orienting the AABB
+static void PhysicsManager_GetAABBContactShape(float* points, float* axes, const ColliderData_AABB* AABB, const FrameOfReference* frame);
+
+///
+//Clips the face of one convex shape nearest the other against the face of the other nearest the first
+//
+//Parameters:
+//	dest: A pointer to the contact manifold to store the points of contact in
+//	points1: The world space points of obj1 of the collision, 3 floats per point
+//	numPoints1: The number of points of obj1
+//	axes1: The oriented face axes of obj1, 3 floats per axis
+//	numAxes1: The number of axes of obj1
+//	points2: The world space points of obj2 of the collision, 3 floats per point
+//	numPoints2: The number of points of obj2
+//	axes2: The oriented face axes of obj2, 3 floats per axis
+//	numAxes2: The number of axes of obj2
+//	normal: An array of 3 floats containing the minimum translation vector of the collision, pointing towards obj1
+//
+//Returns:
+//	The number of points of contact found, 0 if neither face lines up with the normal
+static unsigned char PhysicsManager_ClipContactFaces(PhysicsManager_ContactManifold* dest,
+													 const float* points1, unsigned int numPoints1, const float* axes1, unsigned int numAxes1,
+													 const float* points2, unsigned int numPoints2, const float* axes2, unsigned int numAxes2,
+													 const float* normal);
+
+///
+//Finds the face of a convex shape whose normal is closest to a direction
+//
+//Parameters:
+//	faceNormal: An array of 3 floats to store the normal of the face in
+//	face: An array of 3 floats per point of the shape to store the world space points of the face in, ordered around the normal
+//	numFacePoints: A pointer to store the number of points of the face in
+//	points: The world space points of the convex shape, 3 floats per point
+//	numPoints: The number of points of the shape
+//	axes: The oriented face axes of the convex shape, 3 floats per axis
+//	numAxes: The number of axes of the shape
+//	direction: An array of 3 floats containing the direction the face should face
+//	angles: An array of a float per point of the shape to hold the angles of the points of the face while ordering them
+//
+//Returns:
+//	The cosine of the angle between the normal of the face and the direction, -1 if the shape has no face
+static float PhysicsManager_FindContactFace(float* faceNormal, float* face, unsigned int* numFacePoints,
+											const float* points, unsigned int numPoints, const float* axes, unsigned int numAxes,
+											const float* direction, float* angles);
+
+///
+//Gathers the points of a convex hull which lie furthest in a direction
+//
+//Parameters:
+//	dest: An array of 3 floats per point of the hull to store the furthest points in
+//	points: The world space points of the convex hull, 3 floats per point
+//	numPoints: The number of points of the hull
+//	direction: An array of 3 floats containing the direction
+//
+//Returns:
+//	The number of points within PhysicsManager_FACE_TOLERANCE of the furthest point
+static unsigned int PhysicsManager_GatherSupportPoints(float* dest, const float* points, unsigned int numPoints, const float* direction);
+
+///
+//Orders the points of a convex polygon counterclockwise around it's normal
+//
+//Parameters:
+//	polygon: The points of the polygon, 3 floats per point
+//	numPoints: The number of points of the polygon
+//	normal: An array of 3 floats containing the normal of the polygon
+//	angles: An array of a float per point of the polygon to hold the angle of each point around the center in
+static void PhysicsManager_OrderPolygon(float* polygon, unsigned int numPoints, const float* normal, float* angles);
+
+///
+//Clips a polygon to the side of a plane it's normal points towards
+//
+//Parameters:
+//	dest: An array with room for 3 floats per point of the polygon plus 3 more to store the clipped polygon in
+//	polygon: The points of the polygon to clip, 3 floats per point
+//	numPoints: The number of points of the polygon
+//	planePoint: An array of 3 floats containing a point on the plane
+//	planeNormal: An array of 3 floats containing the normal of the plane, pointing to the side which is kept
+//
+//Returns:
+//	The number of points of the clipped polygon
+static unsigned int PhysicsManager_ClipPolygon(float* dest, const float* polygon, unsigned int numPoints, const float* planePoint, const float* planeNormal);
+
+///
+//Chooses the points of contact which cover the most area when there are more than a contact manifold can hold.
+//The deepest point is kept first, then the point furthest from it, then the points spreading the kept points furthest.
+//
+//Parameters:
+//	dest: A pointer to the contact manifold to store the chosen points in
+//	points: The candidate points of contact, 3 floats per point
+//	depths: The depth of each candidate point beneath the reference face
+//	numPoints: The number of candidate points
+//	normal: An array of 3 floats containing the normal of the reference face
+static void PhysicsManager_ReduceContacts(PhysicsManager_ContactManifold* dest, const float* points, const float* depths, unsigned int numPoints, const float* normal);
+
+///
+//Matches the points of a contact manifold to the points of contact of the last frame,
+//each point which matches starts with the impulse applied at the point it matched
+//
+//Parameters:
+//	manifold: A pointer to the contact manifold to match
+//	pair: A pointer to the persistent pair the collision was detected on, NULL if there is none
+static void PhysicsManager_MatchContacts(PhysicsManager_ContactManifold* manifold, const PairCache_Pair* pair);
+
+///
+//Gets the index of the point a convex hull of a collision last climbed to along the collision's MTV,
+//which it's climb to it's furthest points should start from
+//
+//Parameters:
+//	collision: A pointer to the collision the convex hull is a part of
+//	second: 0 for the hull of the collision's obj1, which searches against the MTV, 1 for the hull of it's obj2, which searches along the MTV
+//
+//Returns:
+//	A pointer to the index to climb from in the collision's persistent pair, NULL if the collision has no pair
+static unsigned int* PhysicsManager_GetFurthestStart(const Collision* collision, unsigned char second);
+
+///
+//Calculates and imparts the resulting collision impulses at every point of a contact manifold.
+//The impulses at each point start at their matched impulses from the last frame, then are corrected in turn until they
+//stop every point from approaching, or separate them as given by the coefficients of restitution, without pulling any point together.
 //
 //Parameters:
 //	collision: The collision having it's resulting impulses calculated and applied
-//	pointsOfCollision: Array of 2 Vectors representing the point of collision in global space for obj1 and obj2 respectively
-static void PhysicsManager_ApplyCollisionImpulses(Collision* collision, const Vector** pointsOfCollision);
+//	manifold: A pointer to the contact manifold of the collision, the impulse applied at each point is stored in it
+//
+//Returns:
+//	The magnitude of the total impulse applied along the minimum translation vector
+static float PhysicsManager_ApplyManifoldImpulses(Collision* collision, PhysicsManager_ContactManifold* manifold);
+
+///
+//Gets the velocity at which the two objects of a collision approach each other at a point, along the normal
+//
+//Parameters:
+//	normal: An array of 3 floats containing the minimum translation vector of the collision, pointing towards obj1
+//	radii: The radial vectors from the CoM of obj1 and obj2 to the point
+//	velocities: The linear velocities of obj1 and obj2
+//	angularVelocities: The angular velocities of obj1 and obj2
+//
+//Returns:
+//	The velocity of obj1 relative to obj2 at the point along the normal, negative when the objects approach
+static float PhysicsManager_GetRelativeNormalVelocity(const float* normal, const float (*radii)[3], const float (*velocities)[3], const float (*angularVelocities)[3]);
 
 ///
 //Calculates and applies the linear frictional forces when two objects slide against each other
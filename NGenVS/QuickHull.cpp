@@ -0,0 +1,441 @@
+#include "QuickHull.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "Vector.h"
+
+///
+//Allocates memory for a new hull
+//
+//Returns:
+//	A pointer to a newly allocated hull
+QuickHull* QuickHull_Allocate(void)
+{
+	QuickHull* hull = (QuickHull*)malloc(sizeof(QuickHull));
+	return hull;
+}
+
+///
+//Initializes a hull without any faces
+//
+//Parameters:
+//	hull: A pointer to the hull to initialize
+void QuickHull_Initialize(QuickHull* hull)
+{
+	hull->points = NULL;
+	hull->numPoints = 0;
+	hull->tolerance = 0.0f;
+
+	hull->faces = DynamicArray_Allocate();
+	DynamicArray_Initialize(hull->faces, sizeof(QuickHull_Face));
+	hull->numVertices = 0;
+}
+
+///
+//Frees a hull
+//
+//Parameters:
+//	hull: A pointer to the hull to free
+void QuickHull_Free(QuickHull* hull)
+{
+	QuickHull_Face* faces = (QuickHull_Face*)hull->faces->data;
+	for(unsigned int i = 0; i < hull->faces->size; i++)
+	{
+		DynamicArray_Free(faces[i].outside);
+	}
+	DynamicArray_Free(hull->faces);
+
+	free(hull);
+}
+
+///
+//Builds the convex hull of a cloud of points with the quickhull algorithm.
+//The point furthest outside of the hull is added until none are left or the hull has as many corners as allowed,
+//so a hull cut short by the budget holds the points which matter most to it's shape.
+//
+//Parameters:
+//	hull: A pointer to an initialized hull to build
+//	points: The point cloud, each three consecutive floats form a point. Must outlive the hull.
+//	numPoints: The number of points in the cloud
+//	maxVertices: The most corners the hull may have, at least 4
+//
+//Returns:
+//	0 if the points do not span a volume & no hull could be built, else 1
+unsigned char QuickHull_Build(QuickHull* hull, const float* points, unsigned int numPoints, unsigned int maxVertices)
+{
+	//Throw away any hull built before
+	QuickHull_Face* faces = (QuickHull_Face*)hull->faces->data;
+	for(unsigned int i = 0; i < hull->faces->size; i++)
+	{
+		DynamicArray_Free(faces[i].outside);
+	}
+	DynamicArray_Clear(hull->faces);
+	hull->numVertices = 0;
+
+	hull->points = points;
+	hull->numPoints = numPoints;
+	if(numPoints < 4) return 0;
+
+	//Scale the tolerance by the extent of the cloud so it means the same thing for any size of model
+	float extent[3] = { 0.0f, 0.0f, 0.0f };
+	for(unsigned int i = 0; i < numPoints; i++)
+	{
+		for(int j = 0; j < 3; j++)
+		{
+			if(fabsf(points[3 * i + j]) > extent[j]) extent[j] = fabsf(points[3 * i + j]);
+		}
+	}
+	hull->tolerance = (extent[0] + extent[1] + extent[2]) * QuickHull_TOLERANCE_SCALE;
+
+	DynamicArray* candidates = DynamicArray_Allocate();
+	DynamicArray_Initialize(candidates, sizeof(unsigned int));
+
+	if(!QuickHull_BuildTetrahedron(hull, candidates))
+	{
+		DynamicArray_Free(candidates);
+		return 0;
+	}
+	QuickHull_AssignPoints(hull, candidates, 0);
+	DynamicArray_Free(candidates);
+
+	hull->numVertices = 4;
+	while(hull->numVertices < maxVertices)
+	{
+		//Find the point furthest outside of the hull
+		faces = (QuickHull_Face*)hull->faces->data;
+		QuickHull_Face* furthestFace = NULL;
+		for(unsigned int i = 0; i < hull->faces->size; i++)
+		{
+			if(faces[i].furthestDistance > 0.0f && (furthestFace == NULL || faces[i].furthestDistance > furthestFace->furthestDistance))
+			{
+				furthestFace = faces + i;
+			}
+		}
+
+		//Every point is inside of the hull
+		if(furthestFace == NULL) break;
+
+		QuickHull_AddPoint(hull, furthestFace->furthest);
+
+		//Adding a point can swallow corners as well as adding one
+		hull->numVertices = QuickHull_CountVertices(hull);
+	}
+
+	return 1;
+}
+
+///
+//Computes the volume enclosed by a hull
+//
+//Parameters:
+//	hull: A pointer to the hull
+//
+//Returns:
+//	The volume of the hull, 0 if no hull has been built
+float QuickHull_ComputeVolume(const QuickHull* hull)
+{
+	//Sum the volumes of the pyramids from the origin to each face
+	const QuickHull_Face* faces = (const QuickHull_Face*)hull->faces->data;
+	float volume = 0.0f;
+	for(unsigned int i = 0; i < hull->faces->size; i++)
+	{
+		const float* a = hull->points + 3 * faces[i].vertices[0];
+		const float* b = hull->points + 3 * faces[i].vertices[1];
+		const float* c = hull->points + 3 * faces[i].vertices[2];
+
+		float ab[3], ac[3], doubleArea[3];
+		Vector_SubtractArray(ab, b, a, 3);
+		Vector_SubtractArray(ac, c, a, 3);
+		Vector_CrossProduct3Array(doubleArea, ab, ac);
+
+		volume += Vector_DotProductArray(doubleArea, a, 3) / 6.0f;
+	}
+	return volume;
+}
+
+///
+//Initializes a face of the hull, taking it's plane from it's corners
+//
+//Parameters:
+//	face: A pointer to the face to initialize
+//	points: The point cloud
+//	a: Index of the first corner of the face
+//	b: Index of the second corner of the face
+//	c: Index of the third corner of the face
+static void QuickHull_InitializeFace(QuickHull_Face* face, const float* points, unsigned int a, unsigned int b, unsigned int c)
+{
+	face->vertices[0] = a;
+	face->vertices[1] = b;
+	face->vertices[2] = c;
+
+	float edge1[3], edge2[3];
+	Vector_SubtractArray(edge1, points + 3 * b, points + 3 * a, 3);
+	Vector_SubtractArray(edge2, points + 3 * c, points + 3 * a, 3);
+	Vector_CrossProduct3Array(face->normal, edge1, edge2);
+
+	//A sliver with no area has no plane, nothing is ever outside of it
+	if(Vector_GetMagSqFromArray(face->normal, 3) > 0.0f)
+	{
+		Vector_NormalizeArray(face->normal, 3);
+	}
+	face->distance = Vector_DotProductArray(face->normal, points + 3 * a, 3);
+
+	face->outside = DynamicArray_Allocate();
+	DynamicArray_Initialize(face->outside, sizeof(unsigned int));
+	face->furthest = 0;
+	face->furthestDistance = 0.0f;
+	face->visible = 0;
+}
+
+///
+//Builds the tetrahedron the hull grows from out of four extreme points of the cloud
+//
+//Parameters:
+//	hull: A pointer to the hull to build the tetrahedron of
+//	candidates: A dynamic array to store the indices of every other point of the cloud in
+//
+//Returns:
+//	0 if the points of the cloud do not span a volume, else 1
+static unsigned char QuickHull_BuildTetrahedron(QuickHull* hull, DynamicArray* candidates)
+{
+	const float* points = hull->points;
+
+	//Find the points with the smallest & largest coordinate along each axis
+	unsigned int extremes[6] = { 0, 0, 0, 0, 0, 0 };
+	for(unsigned int i = 1; i < hull->numPoints; i++)
+	{
+		for(int j = 0; j < 3; j++)
+		{
+			if(points[3 * i + j] < points[3 * extremes[2 * j] + j]) extremes[2 * j] = i;
+			if(points[3 * i + j] > points[3 * extremes[2 * j + 1] + j]) extremes[2 * j + 1] = i;
+		}
+	}
+
+	//The first two corners are the pair of extremes furthest apart
+	unsigned int corners[4];
+	float furthest = -1.0f;
+	float difference[3];
+	for(int i = 0; i < 6; i++)
+	{
+		for(int j = i + 1; j < 6; j++)
+		{
+			Vector_SubtractArray(difference, points + 3 * extremes[j], points + 3 * extremes[i], 3);
+			float distanceSq = Vector_GetMagSqFromArray(difference, 3);
+			if(distanceSq > furthest)
+			{
+				furthest = distanceSq;
+				corners[0] = extremes[i];
+				corners[1] = extremes[j];
+			}
+		}
+	}
+	if(furthest <= hull->tolerance * hull->tolerance) return 0;
+
+	//The third corner is the point furthest from the line through the first two
+	float line[3], cross[3];
+	Vector_SubtractArray(line, points + 3 * corners[1], points + 3 * corners[0], 3);
+	furthest = -1.0f;
+	for(unsigned int i = 0; i < hull->numPoints; i++)
+	{
+		Vector_SubtractArray(difference, points + 3 * i, points + 3 * corners[0], 3);
+		Vector_CrossProduct3Array(cross, line, difference);
+		float distanceSq = Vector_GetMagSqFromArray(cross, 3);
+		if(distanceSq > furthest)
+		{
+			furthest = distanceSq;
+			corners[2] = i;
+		}
+	}
+	if(furthest <= hull->tolerance * hull->tolerance * Vector_GetMagSqFromArray(line, 3)) return 0;
+
+	//The fourth corner is the point furthest from the plane through the first three
+	QuickHull_Face base;
+	QuickHull_InitializeFace(&base, points, corners[0], corners[1], corners[2]);
+	DynamicArray_Free(base.outside);
+	furthest = -1.0f;
+	for(unsigned int i = 0; i < hull->numPoints; i++)
+	{
+		float distance = fabsf(Vector_DotProductArray(base.normal, points + 3 * i, 3) - base.distance);
+		if(distance > furthest)
+		{
+			furthest = distance;
+			corners[3] = i;
+		}
+	}
+	if(furthest <= hull->tolerance) return 0;
+
+	//Wind each face so that it's normal points away from the opposite corner
+	static const int tetrahedronFaces[4][4] = { { 0, 1, 2, 3 }, { 0, 2, 3, 1 }, { 0, 3, 1, 2 }, { 1, 3, 2, 0 } };
+	for(int i = 0; i < 4; i++)
+	{
+		QuickHull_Face face;
+		QuickHull_InitializeFace(&face, points, corners[tetrahedronFaces[i][0]], corners[tetrahedronFaces[i][1]], corners[tetrahedronFaces[i][2]]);
+		if(Vector_DotProductArray(face.normal, points + 3 * corners[tetrahedronFaces[i][3]], 3) > face.distance)
+		{
+			DynamicArray_Free(face.outside);
+			QuickHull_InitializeFace(&face, points, corners[tetrahedronFaces[i][0]], corners[tetrahedronFaces[i][2]], corners[tetrahedronFaces[i][1]]);
+		}
+		DynamicArray_Append(hull->faces, &face);
+	}
+
+	for(unsigned int i = 0; i < hull->numPoints; i++)
+	{
+		if(i != corners[0] && i != corners[1] && i != corners[2] && i != corners[3])
+		{
+			DynamicArray_Append(candidates, &i);
+		}
+	}
+	return 1;
+}
+
+///
+//Gives each point to the first face it is outside of, points outside of none are inside the hull and dropped
+//
+//Parameters:
+//	hull: A pointer to the hull
+//	points: A dynamic array of the indices of the points to assign
+//	firstFace: Index of the first face of the hull which may take the points
+static void QuickHull_AssignPoints(QuickHull* hull, const DynamicArray* points, unsigned int firstFace)
+{
+	QuickHull_Face* faces = (QuickHull_Face*)hull->faces->data;
+	const unsigned int* indices = (const unsigned int*)points->data;
+	for(unsigned int i = 0; i < points->size; i++)
+	{
+		const float* point = hull->points + 3 * indices[i];
+		for(unsigned int j = firstFace; j < hull->faces->size; j++)
+		{
+			float distance = Vector_DotProductArray(faces[j].normal, point, 3) - faces[j].distance;
+			if(distance > hull->tolerance)
+			{
+				DynamicArray_Append(faces[j].outside, (void*)(indices + i));
+				if(distance > faces[j].furthestDistance)
+				{
+					faces[j].furthestDistance = distance;
+					faces[j].furthest = indices[i];
+				}
+				break;
+			}
+		}
+	}
+}
+
+///
+//Adds a point outside of the hull to it, replacing every face the point can see with faces joining the point to the horizon
+//
+//Parameters:
+//	hull: A pointer to the hull
+//	eye: Index of the point to add
+static void QuickHull_AddPoint(QuickHull* hull, unsigned int eye)
+{
+	const float* point = hull->points + 3 * eye;
+	QuickHull_Face* faces = (QuickHull_Face*)hull->faces->data;
+	unsigned int numFaces = hull->faces->size;
+
+	for(unsigned int i = 0; i < numFaces; i++)
+	{
+		faces[i].visible = Vector_DotProductArray(faces[i].normal, point, 3) - faces[i].distance > hull->tolerance;
+	}
+
+	//The horizon is made of the edges of visible faces which border a face that can't be seen.
+	//Each edge is stored as two consecutive indices wound the same way as the visible face.
+	DynamicArray* horizon = DynamicArray_Allocate();
+	DynamicArray_Initialize(horizon, sizeof(unsigned int));
+	for(unsigned int i = 0; i < numFaces; i++)
+	{
+		if(!faces[i].visible) continue;
+
+		for(int j = 0; j < 3; j++)
+		{
+			unsigned int start = faces[i].vertices[j];
+			unsigned int end = faces[i].vertices[(j + 1) % 3];
+
+			//The face across the edge runs along it the other way
+			unsigned char bordersVisible = 0;
+			for(unsigned int k = 0; k < numFaces && !bordersVisible; k++)
+			{
+				if(k == i || !faces[k].visible) continue;
+				for(int l = 0; l < 3; l++)
+				{
+					if(faces[k].vertices[l] == end && faces[k].vertices[(l + 1) % 3] == start)
+					{
+						bordersVisible = 1;
+						break;
+					}
+				}
+			}
+
+			if(!bordersVisible)
+			{
+				DynamicArray_Append(horizon, &start);
+				DynamicArray_Append(horizon, &end);
+			}
+		}
+	}
+
+	//Remove the visible faces, keeping the points outside of them to hand to the new faces
+	DynamicArray* orphans = DynamicArray_Allocate();
+	DynamicArray_Initialize(orphans, sizeof(unsigned int));
+	unsigned int numKept = 0;
+	for(unsigned int i = 0; i < numFaces; i++)
+	{
+		if(faces[i].visible)
+		{
+			unsigned int* outside = (unsigned int*)faces[i].outside->data;
+			for(unsigned int j = 0; j < faces[i].outside->size; j++)
+			{
+				if(outside[j] != eye) DynamicArray_Append(orphans, outside + j);
+			}
+			DynamicArray_Free(faces[i].outside);
+		}
+		else
+		{
+			faces[numKept++] = faces[i];
+		}
+	}
+	hull->faces->size = numKept;
+
+	//Join each edge of the horizon to the new point
+	unsigned int* edges = (unsigned int*)horizon->data;
+	for(unsigned int i = 0; i < horizon->size; i += 2)
+	{
+		QuickHull_Face face;
+		QuickHull_InitializeFace(&face, hull->points, edges[i], edges[i + 1], eye);
+		DynamicArray_Append(hull->faces, &face);
+	}
+
+	QuickHull_AssignPoints(hull, orphans, numKept);
+
+	DynamicArray_Free(horizon);
+	DynamicArray_Free(orphans);
+}
+
+///
+//Counts the points of the cloud which are corners of the hull
+//
+//Parameters:
+//	hull: A pointer to the hull
+//
+//Returns:
+//	The number of corners of the hull
+static unsigned int QuickHull_CountVertices(const QuickHull* hull)
+{
+	unsigned char* isVertex = (unsigned char*)calloc(hull->numPoints, sizeof(unsigned char));
+	unsigned int numVertices = 0;
+
+	const QuickHull_Face* faces = (const QuickHull_Face*)hull->faces->data;
+	for(unsigned int i = 0; i < hull->faces->size; i++)
+	{
+		for(int j = 0; j < 3; j++)
+		{
+			if(!isVertex[faces[i].vertices[j]])
+			{
+				isVertex[faces[i].vertices[j]] = 1;
+				numVertices++;
+			}
+		}
+	}
+
+	free(isVertex);
+	return numVertices;
+}
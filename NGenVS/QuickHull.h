@@ -0,0 +1,135 @@
+#ifndef QUICKHULL_H
+#define QUICKHULL_H
+
+#include "DynamicArray.h"
+
+//Points are only considered outside of a face when they are further than this from it, relative to the size of the point cloud
+#define QuickHull_TOLERANCE_SCALE 0.00001f
+
+//A triangular face of a convex hull built by the quickhull algorithm
+typedef struct QuickHull_Face
+{
+	unsigned int vertices[3];		//Indices of the corners of the face in the point cloud, wound counter clockwise when seen from outside the hull
+	float normal[3];				//Unit normal of the face pointing out of the hull
+	float distance;					//Distance from the origin to the plane of the face along the normal
+	DynamicArray* outside;			//Indices of the points of the cloud outside of the face which have not been added to the hull
+	unsigned int furthest;			//Index of the outside point furthest from the face
+	float furthestDistance;			//Distance of the furthest outside point from the face, 0 if there are no outside points
+	unsigned char visible;			//Can the point being added to the hull see the face
+} QuickHull_Face;
+
+//A convex hull of a cloud of points
+typedef struct QuickHull
+{
+	const float* points;			//The point cloud, each three consecutive floats form a point
+	unsigned int numPoints;			//Number of points in the cloud
+	float tolerance;				//Distance a point must be beyond a face to be outside of it
+
+	DynamicArray* faces;			//QuickHull_Faces of the hull stored by value
+	unsigned int numVertices;		//Number of points of the cloud which are corners of the hull
+} QuickHull;
+
+///
+//Internals
+///
+
+///
+//Initializes a face of the hull, taking it's plane from it's corners
+//
+//Parameters:
+//	face: A pointer to the face to initialize
+//	points: The point cloud
+//	a: Index of the first corner of the face
+//	b: Index of the second corner of the face
+//	c: Index of the third corner of the face
+static void QuickHull_InitializeFace(QuickHull_Face* face, const float* points, unsigned int a, unsigned int b, unsigned int c);
+
+///
+//Builds the tetrahedron the hull grows from out of four extreme points of the cloud
+//
+//Parameters:
+//	hull: A pointer to the hull to build the tetrahedron of
+//	candidates: A dynamic array to store the indices of every other point of the cloud in
+//
+//Returns:
+//	0 if the points of the cloud do not span a volume, else 1
+static unsigned char QuickHull_BuildTetrahedron(QuickHull* hull, DynamicArray* candidates);
+
+///
+//Gives each point to the first face it is outside of, points outside of none are inside the hull and dropped
+//
+//Parameters:
+//	hull: A pointer to the hull
+//	points: A dynamic array of the indices of the points to assign
+//	firstFace: Index of the first face of the hull which may take the points
+static void QuickHull_AssignPoints(QuickHull* hull, const DynamicArray* points, unsigned int firstFace);
+
+///
+//Adds a point outside of the hull to it, replacing every face the point can see with faces joining the point to the horizon
+//
+//Parameters:
+//	hull: A pointer to the hull
+//	eye: Index of the point to add
+static void QuickHull_AddPoint(QuickHull* hull, unsigned int eye);
+
+///
+//Counts the points of the cloud which are corners of the hull
+//
+//Parameters:
+//	hull: A pointer to the hull
+//
+//Returns:
+//	The number of corners of the hull
+static unsigned int QuickHull_CountVertices(const QuickHull* hull);
+
+///
+//Functions
+///
+
+///
+//Allocates memory for a new hull
+//
+//Returns:
+//	A pointer to a newly allocated hull
+QuickHull* QuickHull_Allocate(void);
+
+///
+//Initializes a hull without any faces
+//
+//Parameters:
+//	hull: A pointer to the hull to initialize
+void QuickHull_Initialize(QuickHull* hull);
+
+///
+//Frees a hull
+//
+//Parameters:
+//	hull: A pointer to the hull to free
+void QuickHull_Free(QuickHull* hull);
+
+///
+//Builds the convex hull of a cloud of points with the quickhull algorithm.
+//The point furthest outside of the hull is added until none are left or the hull has as many corners as allowed,
+//so a hull cut short by the budget holds the points which matter most to it's shape.
+//
+//Parameters:
+//	hull: A pointer to an initialized hull to build
+//	points: The point cloud, each three consecutive floats form a point. Must outlive the hull.
+//	numPoints: The number of points in the cloud
+//	maxVertices: The most corners the hull may have, at least 4
+//
+//Returns:
+//	0 if the points do not span a volume & no hull could be built, else 1
+unsigned char QuickHull_Build(QuickHull* hull, const float* points, unsigned int numPoints, unsigned int maxVertices);
+
+///
+//Computes the volume enclosed by a hull
+//
+//Parameters:
+//	hull: A pointer to the hull
+//
+//Returns:
+//	The volume of the hull, 0 if no hull has been built
+float QuickHull_ComputeVolume(const QuickHull* hull);
+
+#endif
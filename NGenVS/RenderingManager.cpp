@@ -186,7 +186,7 @@ void RenderingManager_Render(LinkedList* gameObjects)
 	}
 
 	//Render the oct tree
-	if(renderingBuffer->debugOctTree)
+	if(renderingBuffer->debugOctTree && ObjectManager_GetObjectBuffer().octTree != NULL)
 	{
 		//Set the color matrix
 		Matrix octTreeColor;
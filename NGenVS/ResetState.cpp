@@ -79,25 +79,22 @@ void State_Reset_Update(GObject* GO, State* state)
 	//Get members
 	struct State_Reset_Members* members = (struct State_Reset_Members*)state->members;
 
-	if(GO->collider->currentCollisions->size > 0 && members->currentTime > members->resetTime)
+	if(GO->collider->numCollisions > 0 && members->currentTime > members->resetTime)
 	{
 
 		//Loop through the collisions which occurred previous frame
-		LinkedList_Node* current = GO->collider->currentCollisions->head;
 		Collision* currentCollision;
-		while(current != NULL)
+		for(unsigned int i = 0; i < GO->collider->numCollisions; i++)
 		{
 			//Check if any of the objects involved in the collision are a bullet
 			//TODO: MAke a tagging system so this doesn't need to happen
-			currentCollision = (Collision*)current->data;
+			currentCollision = CollisionManager_GetObjectCollision(GO->collider, i);
 			//Bullets are the only thing with a scale of 0.3
 			if(currentCollision->obj1->frameOfReference->scale->components[0] == 0.9f || currentCollision->obj2->frameOfReference->scale->components[0] == 0.9f)
 			{
 				members->currentTime = 0.0f;
 				break;
 			}
-			current = current->next;
-
 		}
 	}
 	else if(members->currentTime < members->resetTime)
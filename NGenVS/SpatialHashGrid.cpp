@@ -0,0 +1,291 @@
+#include "SpatialHashGrid.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+///
+//Allocates memory for a new spatial hash grid
+//
+//Returns:
+//	Pointer to a newly allocated spatial hash grid
+SpatialHashGrid* SpatialHashGrid_Allocate(void)
+{
+	SpatialHashGrid* grid = (SpatialHashGrid*)malloc(sizeof(SpatialHashGrid));
+	return grid;
+}
+
+///
+//Initializes a spatial hash grid
+//
+//Parameters:
+//	grid: A pointer to the spatial hash grid to initialize
+//	cellSize: The width of each cell along every axis
+void SpatialHashGrid_Initialize(SpatialHashGrid* grid, float cellSize)
+{
+	grid->proxies = DynamicArray_Allocate();
+	DynamicArray_Initialize(grid->proxies, sizeof(SpatialHashGrid_Proxy));
+
+	grid->cellSize = cellSize;
+
+	grid->numBuckets = 64;
+	grid->bucketStarts = (unsigned int*)calloc(grid->numBuckets + 1, sizeof(unsigned int));
+
+	grid->entries = DynamicArray_Allocate();
+	DynamicArray_Initialize(grid->entries, sizeof(SpatialHashGrid_Entry));
+
+	grid->built = 0;
+}
+
+///
+//Frees resources allocated by a spatial hash grid
+//Does not free the objects being tracked.
+//
+//Parameters:
+//	grid: A pointer to the spatial hash grid to free
+void SpatialHashGrid_Free(SpatialHashGrid* grid)
+{
+	DynamicArray_Free(grid->proxies);
+	free(grid->bucketStarts);
+	DynamicArray_Free(grid->entries);
+	free(grid);
+}
+
+///
+//Adds an object to a spatial hash grid
+//
+//Parameters:
+//	grid: A pointer to the spatial hash grid to add the object to
+//	obj: A pointer to the object to add (Must have collider attached)
+void SpatialHashGrid_Add(SpatialHashGrid* grid, GObject* obj)
+{
+	SpatialHashGrid_Proxy proxy;
+	proxy.obj = obj;
+	SpatialHashGrid_UpdateProxy(grid, &proxy);
+
+	DynamicArray_Append(grid->proxies, &proxy);
+	grid->built = 0;
+}
+
+///
+//Removes an object from a spatial hash grid
+//
+//Parameters:
+//	grid: A pointer to the spatial hash grid to remove the object from
+//	obj: A pointer to the object to remove
+void SpatialHashGrid_Remove(SpatialHashGrid* grid, GObject* obj)
+{
+	SpatialHashGrid_Proxy* proxies = (SpatialHashGrid_Proxy*)grid->proxies->data;
+
+	unsigned int index;
+	for(index = 0; index < grid->proxies->size; index++)
+	{
+		if(proxies[index].obj == obj) break;
+	}
+	if(index == grid->proxies->size) return;
+
+	//The last proxy is moved into the removed proxy's place
+	proxies[index] = proxies[grid->proxies->size - 1];
+	grid->proxies->size--;
+	grid->built = 0;
+}
+
+///
+//Updates the bounds of all objects in a spatial hash grid and rebuilds the grid
+//
+//Parameters:
+//	grid: A pointer to the spatial hash grid to update
+void SpatialHashGrid_Update(SpatialHashGrid* grid)
+{
+	SpatialHashGrid_Proxy* proxies = (SpatialHashGrid_Proxy*)grid->proxies->data;
+	for(unsigned int i = 0; i < grid->proxies->size; i++)
+	{
+		SpatialHashGrid_UpdateProxy(grid, proxies + i);
+	}
+
+	SpatialHashGrid_Rebuild(grid);
+}
+
+///
+//Finds all pairs of objects in a spatial hash grid whose bounds overlap
+//
+//Parameters:
+//	grid: A pointer to the spatial hash grid to query
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to,
+//		each two consecutive objects appended form a pair
+void SpatialHashGrid_QueryPairs(SpatialHashGrid* grid, DynamicArray* dest)
+{
+	//Objects were added or removed since the last rebuild
+	if(!grid->built)
+	{
+		SpatialHashGrid_Rebuild(grid);
+	}
+
+	const SpatialHashGrid_Proxy* proxies = (SpatialHashGrid_Proxy*)grid->proxies->data;
+	const SpatialHashGrid_Entry* entries = (SpatialHashGrid_Entry*)grid->entries->data;
+
+	for(unsigned int bucket = 0; bucket < grid->numBuckets; bucket++)
+	{
+		unsigned int end = grid->bucketStarts[bucket + 1];
+		for(unsigned int i = grid->bucketStarts[bucket]; i < end; i++)
+		{
+			const SpatialHashGrid_Entry* entry1 = entries + i;
+			const SpatialHashGrid_Proxy* proxy1 = proxies + entry1->proxy;
+
+			for(unsigned int j = i + 1; j < end; j++)
+			{
+				const SpatialHashGrid_Entry* entry2 = entries + j;
+
+				//Different cells may be hashed into the same bucket
+				if(entry1->cell[0] != entry2->cell[0] || entry1->cell[1] != entry2->cell[1] || entry1->cell[2] != entry2->cell[2]) continue;
+
+				const SpatialHashGrid_Proxy* proxy2 = proxies + entry2->proxy;
+
+				//The objects share every cell their bounds overlap in,
+				//only report the pair from the cell containing the minimum corner of the overlap
+				unsigned char report = 1;
+				for(int k = 0; k < 3; k++)
+				{
+					if(proxy1->bounds[2 * k] > proxy2->bounds[2 * k + 1] || proxy2->bounds[2 * k] > proxy1->bounds[2 * k + 1])
+					{
+						report = 0;
+						break;
+					}
+
+					int minCell = proxy1->cellBounds[2 * k] > proxy2->cellBounds[2 * k] ? proxy1->cellBounds[2 * k] : proxy2->cellBounds[2 * k];
+					if(entry1->cell[k] != minCell)
+					{
+						report = 0;
+						break;
+					}
+				}
+
+				if(report)
+				{
+					DynamicArray_Append(dest, (void*)&proxy1->obj);
+					DynamicArray_Append(dest, (void*)&proxy2->obj);
+				}
+			}
+		}
+	}
+}
+
+///
+//Lays out the entries of all proxies into the buckets of a spatial hash grid
+//
+//Parameters:
+//	grid: A pointer to the spatial hash grid to rebuild
+static void SpatialHashGrid_Rebuild(SpatialHashGrid* grid)
+{
+	SpatialHashGrid_Proxy* proxies = (SpatialHashGrid_Proxy*)grid->proxies->data;
+
+	//Count the total number of entries
+	unsigned int numEntries = 0;
+	for(unsigned int i = 0; i < grid->proxies->size; i++)
+	{
+		const int* cellBounds = proxies[i].cellBounds;
+		numEntries += (cellBounds[1] - cellBounds[0] + 1) * (cellBounds[3] - cellBounds[2] + 1) * (cellBounds[5] - cellBounds[4] + 1);
+	}
+
+	//Keep at least two buckets per entry to keep unrelated cells from sharing buckets
+	if(grid->numBuckets < 2 * numEntries)
+	{
+		while(grid->numBuckets < 2 * numEntries) grid->numBuckets *= 2;
+		free(grid->bucketStarts);
+		grid->bucketStarts = (unsigned int*)malloc((grid->numBuckets + 1) * sizeof(unsigned int));
+	}
+	while(grid->entries->capacity < numEntries)
+	{
+		DynamicArray_Grow(grid->entries);
+	}
+	grid->entries->size = numEntries;
+
+	//Count the entries of each bucket
+	memset(grid->bucketStarts, 0, (grid->numBuckets + 1) * sizeof(unsigned int));
+	for(unsigned int i = 0; i < grid->proxies->size; i++)
+	{
+		const int* cellBounds = proxies[i].cellBounds;
+		for(int x = cellBounds[0]; x <= cellBounds[1]; x++)
+		{
+			for(int y = cellBounds[2]; y <= cellBounds[3]; y++)
+			{
+				for(int z = cellBounds[4]; z <= cellBounds[5]; z++)
+				{
+					grid->bucketStarts[SpatialHashGrid_GetBucket(grid, x, y, z) + 1]++;
+				}
+			}
+		}
+	}
+
+	//Turn the counts into the starts of each bucket
+	for(unsigned int i = 0; i < grid->numBuckets; i++)
+	{
+		grid->bucketStarts[i + 1] += grid->bucketStarts[i];
+	}
+
+	//Place each entry at the end of it's bucket, moving the start of the bucket along.
+	//Afterwards the start of each bucket has been moved to the start of the following bucket.
+	SpatialHashGrid_Entry* entries = (SpatialHashGrid_Entry*)grid->entries->data;
+	for(unsigned int i = 0; i < grid->proxies->size; i++)
+	{
+		const int* cellBounds = proxies[i].cellBounds;
+		for(int x = cellBounds[0]; x <= cellBounds[1]; x++)
+		{
+			for(int y = cellBounds[2]; y <= cellBounds[3]; y++)
+			{
+				for(int z = cellBounds[4]; z <= cellBounds[5]; z++)
+				{
+					SpatialHashGrid_Entry* entry = entries + grid->bucketStarts[SpatialHashGrid_GetBucket(grid, x, y, z)]++;
+					entry->proxy = i;
+					entry->cell[0] = x;
+					entry->cell[1] = y;
+					entry->cell[2] = z;
+				}
+			}
+		}
+	}
+
+	//Shift the starts back by one bucket
+	for(unsigned int i = grid->numBuckets; i > 0; i--)
+	{
+		grid->bucketStarts[i] = grid->bucketStarts[i - 1];
+	}
+	grid->bucketStarts[0] = 0;
+
+	grid->built = 1;
+}
+
+///
+//Determines the bucket a cell is hashed into
+//
+//Parameters:
+//	grid: A pointer to the spatial hash grid containing the cell
+//	x: The X coordinate of the cell
+//	y: The Y coordinate of the cell
+//	z: The Z coordinate of the cell
+//
+//Returns:
+//	The index of the bucket
+static unsigned int SpatialHashGrid_GetBucket(const SpatialHashGrid* grid, int x, int y, int z)
+{
+	unsigned int hash = ((unsigned int)x * 73856093u) ^ ((unsigned int)y * 19349663u) ^ ((unsigned int)z * 83492791u);
+	return hash & (grid->numBuckets - 1);
+}
+
+///
+//Determines the world space bounds of a proxy's object and the range of cells they overlap
+//
+//Parameters:
+//	grid: A pointer to the spatial hash grid containing the proxy
+//	proxy: A pointer to the proxy to update
+static void SpatialHashGrid_UpdateProxy(const SpatialHashGrid* grid, SpatialHashGrid_Proxy* proxy)
+{
+	GObject* obj = proxy->obj;
+	FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+	Collider_GetWorldBounds(proxy->bounds, obj->collider, frame);
+
+	for(int i = 0; i < 6; i++)
+	{
+		proxy->cellBounds[i] = (int)floorf(proxy->bounds[i] / grid->cellSize);
+	}
+}
@@ -0,0 +1,130 @@
+#ifndef SPATIALHASHGRID_H
+#define SPATIALHASHGRID_H
+
+#include "GObject.h"
+#include "DynamicArray.h"
+
+//An object tracked by a spatial hash grid
+typedef struct SpatialHashGrid_Proxy
+{
+	GObject* obj;			//The object being tracked (Must have collider attached)
+	float bounds[6];		//World space bounds of the object's collider in the order minX, maxX, minY, maxY, minZ, maxZ
+	int cellBounds[6];		//Range of cells overlapped by the bounds in the order minX, maxX, minY, maxY, minZ, maxZ
+} SpatialHashGrid_Proxy;
+
+//An entry of a proxy in one of the cells it overlaps
+typedef struct SpatialHashGrid_Entry
+{
+	unsigned int proxy;		//Index of the proxy
+	int cell[3];			//Coordinates of the cell
+} SpatialHashGrid_Entry;
+
+//A uniform grid of cells which are hashed into a fixed number of buckets.
+//The entries of all buckets are laid out in one flat array with a counting sort each time the grid is rebuilt,
+//so a rebuild takes linear time and allocates nothing once the arrays have grown large enough.
+//Works best when the tracked objects are of a similar size to the cells.
+typedef struct SpatialHashGrid
+{
+	DynamicArray* proxies;			//Proxies of the tracked objects, stored by value
+
+	float cellSize;					//The width of each cell along every axis
+
+	unsigned int numBuckets;		//The number of buckets the cells are hashed into, always a power of two
+	unsigned int* bucketStarts;		//Start of the range of each bucket in entries, bucket i ends where bucket i + 1 starts
+	DynamicArray* entries;			//Entries of all buckets grouped by bucket
+
+	unsigned char built;			//Are the entries up to date with the proxies
+} SpatialHashGrid;
+
+///
+//Internals
+///
+
+///
+//Lays out the entries of all proxies into the buckets of a spatial hash grid
+//
+//Parameters:
+//	grid: A pointer to the spatial hash grid to rebuild
+static void SpatialHashGrid_Rebuild(SpatialHashGrid* grid);
+
+///
+//Determines the bucket a cell is hashed into
+//
+//Parameters:
+//	grid: A pointer to the spatial hash grid containing the cell
+//	x: The X coordinate of the cell
+//	y: The Y coordinate of the cell
+//	z: The Z coordinate of the cell
+//
+//Returns:
+//	The index of the bucket
+static unsigned int SpatialHashGrid_GetBucket(const SpatialHashGrid* grid, int x, int y, int z);
+
+///
+//Determines the world space bounds of a proxy's object and the range of cells they overlap
+//
+//Parameters:
+//	grid: A pointer to the spatial hash grid containing the proxy
+//	proxy: A pointer to the proxy to update
+static void SpatialHashGrid_UpdateProxy(const SpatialHashGrid* grid, SpatialHashGrid_Proxy* proxy);
+
+///
+//Functions
+///
+
+///
+//Allocates memory for a new spatial hash grid
+//
+//Returns:
+//	Pointer to a newly allocated spatial hash grid
+SpatialHashGrid* SpatialHashGrid_Allocate(void);
+
+///
+//Initializes a spatial hash grid
+//
+//Parameters:
+//	grid: A pointer to the spatial hash grid to initialize
+//	cellSize: The width of each cell along every axis
+void SpatialHashGrid_Initialize(SpatialHashGrid* grid, float cellSize);
+
+///
+//Frees resources allocated by a spatial hash grid
+//Does not free the objects being tracked.
+//
+//Parameters:
+//	grid: A pointer to the spatial hash grid to free
+void SpatialHashGrid_Free(SpatialHashGrid* grid);
+
+///
+//Adds an object to a spatial hash grid
+//
+//Parameters:
+//	grid: A pointer to the spatial hash grid to add the object to
+//	obj: A pointer to the object to add (Must have collider attached)
+void SpatialHashGrid_Add(SpatialHashGrid* grid, GObject* obj);
+
+///
+//Removes an object from a spatial hash grid
+//
+//Parameters:
+//	grid: A pointer to the spatial hash grid to remove the object from
+//	obj: A pointer to the object to remove
+void SpatialHashGrid_Remove(SpatialHashGrid* grid, GObject* obj);
+
+///
+//Updates the bounds of all objects in a spatial hash grid and rebuilds the grid
+//
+//Parameters:
+//	grid: A pointer to the spatial hash grid to update
+void SpatialHashGrid_Update(SpatialHashGrid* grid);
+
+///
+//Finds all pairs of objects in a spatial hash grid whose bounds overlap
+//
+//Parameters:
+//	grid: A pointer to the spatial hash grid to query
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to,
+//		each two consecutive objects appended form a pair
+void SpatialHashGrid_QueryPairs(SpatialHashGrid* grid, DynamicArray* dest);
+
+#endif
@@ -0,0 +1,279 @@
+#include "SweepAndPrune.h"
+
+#include <stdlib.h>
+
+///
+//Allocates memory for a new sweep and prune broadphase
+//
+//Returns:
+//	Pointer to a newly allocated sweep and prune broadphase
+SweepAndPrune* SweepAndPrune_Allocate(void)
+{
+	SweepAndPrune* sap = (SweepAndPrune*)malloc(sizeof(SweepAndPrune));
+	return sap;
+}
+
+///
+//Initializes a sweep and prune broadphase
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune broadphase to initialize
+//	numAxes: The number of axes to keep sorted, 1 to only sweep along X or 3 to sweep along the axis of greatest variance
+void SweepAndPrune_Initialize(SweepAndPrune* sap, unsigned int numAxes)
+{
+	sap->proxies = DynamicArray_Allocate();
+	DynamicArray_Initialize(sap->proxies, sizeof(SweepAndPrune_Proxy));
+
+	sap->numAxes = numAxes == 3 ? 3 : 1;
+	for(unsigned int i = 0; i < 3; i++)
+	{
+		sap->sorted[i] = NULL;
+	}
+	for(unsigned int i = 0; i < sap->numAxes; i++)
+	{
+		sap->sorted[i] = DynamicArray_Allocate();
+		DynamicArray_Initialize(sap->sorted[i], sizeof(unsigned int));
+	}
+
+	sap->sweepAxis = 0;
+}
+
+///
+//Frees resources allocated by a sweep and prune broadphase
+//Does not free the objects being tracked.
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune broadphase to free
+void SweepAndPrune_Free(SweepAndPrune* sap)
+{
+	DynamicArray_Free(sap->proxies);
+	for(unsigned int i = 0; i < sap->numAxes; i++)
+	{
+		DynamicArray_Free(sap->sorted[i]);
+	}
+	free(sap);
+}
+
+///
+//Adds an object to a sweep and prune broadphase
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune broadphase to add the object to
+//	obj: A pointer to the object to add (Must have collider attached)
+void SweepAndPrune_Add(SweepAndPrune* sap, GObject* obj)
+{
+	SweepAndPrune_Proxy proxy;
+	proxy.obj = obj;
+	SweepAndPrune_UpdateProxy(&proxy);
+
+	unsigned int index = sap->proxies->size;
+	DynamicArray_Append(sap->proxies, &proxy);
+
+	//Insert the new proxy into place along each axis
+	for(unsigned int i = 0; i < sap->numAxes; i++)
+	{
+		DynamicArray_Append(sap->sorted[i], &index);
+		SweepAndPrune_SortLast(sap, i);
+	}
+}
+
+///
+//Removes an object from a sweep and prune broadphase
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune broadphase to remove the object from
+//	obj: A pointer to the object to remove
+void SweepAndPrune_Remove(SweepAndPrune* sap, GObject* obj)
+{
+	SweepAndPrune_Proxy* proxies = (SweepAndPrune_Proxy*)sap->proxies->data;
+
+	unsigned int index;
+	for(index = 0; index < sap->proxies->size; index++)
+	{
+		if(proxies[index].obj == obj) break;
+	}
+	if(index == sap->proxies->size) return;
+
+	//The last proxy is moved into the removed proxy's place
+	unsigned int last = sap->proxies->size - 1;
+	proxies[index] = proxies[last];
+	sap->proxies->size--;
+
+	//Remove the index from each sorted array keeping it's order, and rename the index of the moved proxy
+	for(unsigned int i = 0; i < sap->numAxes; i++)
+	{
+		unsigned int* sorted = (unsigned int*)sap->sorted[i]->data;
+		unsigned int removeAt = 0;
+		for(unsigned int j = 0; j < sap->sorted[i]->size; j++)
+		{
+			if(sorted[j] == index) removeAt = j;
+			else if(sorted[j] == last) sorted[j] = index;
+		}
+		DynamicArray_Remove(sap->sorted[i], removeAt);
+	}
+}
+
+///
+//Updates the bounds of all objects in a sweep and prune broadphase and re-sorts them
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune broadphase to update
+void SweepAndPrune_Update(SweepAndPrune* sap)
+{
+	SweepAndPrune_Proxy* proxies = (SweepAndPrune_Proxy*)sap->proxies->data;
+	for(unsigned int i = 0; i < sap->proxies->size; i++)
+	{
+		SweepAndPrune_UpdateProxy(proxies + i);
+	}
+
+	for(unsigned int i = 0; i < sap->numAxes; i++)
+	{
+		SweepAndPrune_SortAxis(sap, i);
+	}
+
+	if(sap->numAxes == 3)
+	{
+		sap->sweepAxis = SweepAndPrune_ChooseSweepAxis(sap);
+	}
+}
+
+///
+//Finds all pairs of objects in a sweep and prune broadphase whose bounds overlap
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune broadphase to query
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to,
+//		each two consecutive objects appended form a pair
+void SweepAndPrune_QueryPairs(const SweepAndPrune* sap, DynamicArray* dest)
+{
+	const SweepAndPrune_Proxy* proxies = (SweepAndPrune_Proxy*)sap->proxies->data;
+	const unsigned int* sorted = (unsigned int*)sap->sorted[sap->sweepAxis]->data;
+	unsigned int numProxies = sap->sorted[sap->sweepAxis]->size;
+
+	//The other two axes to check for overlap once the sweep axis overlaps
+	unsigned int minAxis = 2 * sap->sweepAxis;
+	unsigned int otherAxis1 = 2 * ((sap->sweepAxis + 1) % 3);
+	unsigned int otherAxis2 = 2 * ((sap->sweepAxis + 2) % 3);
+
+	for(unsigned int i = 0; i < numProxies; i++)
+	{
+		const SweepAndPrune_Proxy* proxy1 = proxies + sorted[i];
+
+		//Every proxy following this one in the sweep overlaps it along the sweep axis until one starts after this one ends
+		for(unsigned int j = i + 1; j < numProxies; j++)
+		{
+			const SweepAndPrune_Proxy* proxy2 = proxies + sorted[j];
+			if(proxy2->bounds[minAxis] > proxy1->bounds[minAxis + 1]) break;
+
+			if(proxy1->bounds[otherAxis1] <= proxy2->bounds[otherAxis1 + 1] && proxy2->bounds[otherAxis1] <= proxy1->bounds[otherAxis1 + 1] &&
+				proxy1->bounds[otherAxis2] <= proxy2->bounds[otherAxis2 + 1] && proxy2->bounds[otherAxis2] <= proxy1->bounds[otherAxis2 + 1])
+			{
+				DynamicArray_Append(dest, (void*)&proxy1->obj);
+				DynamicArray_Append(dest, (void*)&proxy2->obj);
+			}
+		}
+	}
+}
+
+///
+//Moves the last index of a sorted array of proxy indices backwards until the array is sorted
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune broadphase containing the array
+//	axis: The axis of the sorted array
+static void SweepAndPrune_SortLast(SweepAndPrune* sap, unsigned int axis)
+{
+	SweepAndPrune_Proxy* proxies = (SweepAndPrune_Proxy*)sap->proxies->data;
+	unsigned int* sorted = (unsigned int*)sap->sorted[axis]->data;
+
+	unsigned int j = sap->sorted[axis]->size - 1;
+	unsigned int index = sorted[j];
+	float min = proxies[index].bounds[2 * axis];
+	while(j > 0 && proxies[sorted[j - 1]].bounds[2 * axis] > min)
+	{
+		sorted[j] = sorted[j - 1];
+		j--;
+	}
+	sorted[j] = index;
+}
+
+///
+//Sorts an array of proxy indices by the minimum bounds of the proxies along an axis.
+//Uses an insertion sort to take advantage of the order kept from the previous frame.
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune broadphase containing the array
+//	axis: The axis of the sorted array
+static void SweepAndPrune_SortAxis(SweepAndPrune* sap, unsigned int axis)
+{
+	SweepAndPrune_Proxy* proxies = (SweepAndPrune_Proxy*)sap->proxies->data;
+	unsigned int* sorted = (unsigned int*)sap->sorted[axis]->data;
+	unsigned int numProxies = sap->sorted[axis]->size;
+
+	for(unsigned int i = 1; i < numProxies; i++)
+	{
+		unsigned int index = sorted[i];
+		float min = proxies[index].bounds[2 * axis];
+
+		unsigned int j = i;
+		while(j > 0 && proxies[sorted[j - 1]].bounds[2 * axis] > min)
+		{
+			sorted[j] = sorted[j - 1];
+			j--;
+		}
+		sorted[j] = index;
+	}
+}
+
+///
+//Determines the axis along which the centers of all proxies vary the most.
+//Sweeping along this axis leaves the fewest bounds overlapping in the sweep.
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune broadphase to choose the axis of
+//
+//Returns:
+//	The index of the axis with the greatest variance
+static unsigned int SweepAndPrune_ChooseSweepAxis(const SweepAndPrune* sap)
+{
+	const SweepAndPrune_Proxy* proxies = (SweepAndPrune_Proxy*)sap->proxies->data;
+
+	float sum[3] = { 0.0f, 0.0f, 0.0f };
+	float sumSquared[3] = { 0.0f, 0.0f, 0.0f };
+	for(unsigned int i = 0; i < sap->proxies->size; i++)
+	{
+		for(unsigned int j = 0; j < 3; j++)
+		{
+			float center = (proxies[i].bounds[2 * j] + proxies[i].bounds[2 * j + 1]) * 0.5f;
+			sum[j] += center;
+			sumSquared[j] += center * center;
+		}
+	}
+
+	//Variance scaled by the number of proxies, n * var = sum(c^2) - sum(c)^2 / n
+	unsigned int axis = 0;
+	float maxVariance = -1.0f;
+	for(unsigned int j = 0; j < 3; j++)
+	{
+		float variance = sumSquared[j] - sum[j] * sum[j] / (sap->proxies->size > 0 ? sap->proxies->size : 1);
+		if(variance > maxVariance)
+		{
+			maxVariance = variance;
+			axis = j;
+		}
+	}
+
+	return axis;
+}
+
+///
+//Determines the world space bounds of a proxy's object
+//
+//Parameters:
+//	proxy: A pointer to the proxy to update the bounds of
+static void SweepAndPrune_UpdateProxy(SweepAndPrune_Proxy* proxy)
+{
+	GObject* obj = proxy->obj;
+	FrameOfReference* frame = obj->body != NULL ? obj->body->frame : obj->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+	Collider_GetWorldBounds(proxy->bounds, obj->collider, frame);
+}
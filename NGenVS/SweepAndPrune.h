@@ -0,0 +1,124 @@
+#ifndef SWEEPANDPRUNE_H
+#define SWEEPANDPRUNE_H
+
+#include "GObject.h"
+#include "DynamicArray.h"
+
+//An object tracked by a sweep and prune broadphase along with it's world space bounds
+typedef struct SweepAndPrune_Proxy
+{
+	GObject* obj;			//The object being tracked (Must have collider attached)
+	float bounds[6];		//World space bounds of the object's collider in the order minX, maxX, minY, maxY, minZ, maxZ
+} SweepAndPrune_Proxy;
+
+//A broadphase which sorts objects by the minimum of their bounds along an axis
+//and sweeps along that axis to find the pairs of objects whose bounds overlap.
+//The sorted orders are kept between frames, and since objects move little from one frame to the next
+//they are re-sorted with an insertion sort which runs in nearly linear time on nearly sorted data.
+typedef struct SweepAndPrune
+{
+	DynamicArray* proxies;		//Proxies of the tracked objects, stored by value
+	DynamicArray* sorted[3];	//Indices into proxies sorted by the minimum bound along the X, Y, and Z axes
+	unsigned int numAxes;		//The number of axes kept sorted, 1 (X only) or 3
+	unsigned int sweepAxis;		//The axis being swept along when querying pairs
+} SweepAndPrune;
+
+///
+//Internals
+///
+
+///
+//Moves the last index of a sorted array of proxy indices backwards until the array is sorted
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune broadphase containing the array
+//	axis: The axis of the sorted array
+static void SweepAndPrune_SortLast(SweepAndPrune* sap, unsigned int axis);
+
+///
+//Sorts an array of proxy indices by the minimum bounds of the proxies along an axis.
+//Uses an insertion sort to take advantage of the order kept from the previous frame.
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune broadphase containing the array
+//	axis: The axis of the sorted array
+static void SweepAndPrune_SortAxis(SweepAndPrune* sap, unsigned int axis);
+
+///
+//Determines the axis along which the centers of all proxies vary the most.
+//Sweeping along this axis leaves the fewest bounds overlapping in the sweep.
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune broadphase to choose the axis of
+//
+//Returns:
+//	The index of the axis with the greatest variance
+static unsigned int SweepAndPrune_ChooseSweepAxis(const SweepAndPrune* sap);
+
+///
+//Determines the world space bounds of a proxy's object
+//
+//Parameters:
+//	proxy: A pointer to the proxy to update the bounds of
+static void SweepAndPrune_UpdateProxy(SweepAndPrune_Proxy* proxy);
+
+///
+//Functions
+///
+
+///
+//Allocates memory for a new sweep and prune broadphase
+//
+//Returns:
+//	Pointer to a newly allocated sweep and prune broadphase
+SweepAndPrune* SweepAndPrune_Allocate(void);
+
+///
+//Initializes a sweep and prune broadphase
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune broadphase to initialize
+//	numAxes: The number of axes to keep sorted, 1 to only sweep along X or 3 to sweep along the axis of greatest variance
+void SweepAndPrune_Initialize(SweepAndPrune* sap, unsigned int numAxes);
+
+///
+//Frees resources allocated by a sweep and prune broadphase
+//Does not free the objects being tracked.
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune broadphase to free
+void SweepAndPrune_Free(SweepAndPrune* sap);
+
+///
+//Adds an object to a sweep and prune broadphase
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune broadphase to add the object to
+//	obj: A pointer to the object to add (Must have collider attached)
+void SweepAndPrune_Add(SweepAndPrune* sap, GObject* obj);
+
+///
+//Removes an object from a sweep and prune broadphase
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune broadphase to remove the object from
+//	obj: A pointer to the object to remove
+void SweepAndPrune_Remove(SweepAndPrune* sap, GObject* obj);
+
+///
+//Updates the bounds of all objects in a sweep and prune broadphase and re-sorts them
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune broadphase to update
+void SweepAndPrune_Update(SweepAndPrune* sap);
+
+///
+//Finds all pairs of objects in a sweep and prune broadphase whose bounds overlap
+//
+//Parameters:
+//	sap: A pointer to the sweep and prune broadphase to query
+//	dest: A pointer to a dynamic array of GObject pointers to append the pairs to,
+//		each two consecutive objects appended form a pair
+void SweepAndPrune_QueryPairs(const SweepAndPrune* sap, DynamicArray* dest);
+
+#endif
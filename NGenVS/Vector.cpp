@@ -246,6 +246,21 @@ void Vector_CrossProduct(Vector* dest, ...)
 	free(vectors);
 }
 
+///
+//Gets the cross product of two vectors of dimension 3.
+//Does the same as Vector_CrossProductArray for 3 dimensions without allocating.
+//
+//Parameters:
+//	dest: The destination of the cross product result, must not be either operand
+//	vec1: The left operand
+//	vec2: The right operand
+void Vector_CrossProduct3Array(float* dest, const float* vec1, const float* vec2)
+{
+	dest[0] = vec1[1] * vec2[2] - vec1[2] * vec2[1];
+	dest[1] = vec1[2] * vec2[0] - vec1[0] * vec2[2];
+	dest[2] = vec1[0] * vec2[1] - vec1[1] * vec2[0];
+}
+
 ///
 //Calculates the angle between two equally dimensioned arrays
 //
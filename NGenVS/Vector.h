@@ -165,6 +165,16 @@ void Vector_CrossProductArray(float* dest, const unsigned int dim, float** vecto
 //	...: dest->dim - 1 vectors of dimension dest->dim
 void Vector_CrossProduct(Vector* dest, ...);
 
+///
+//Gets the cross product of two vectors of dimension 3.
+//Does the same as Vector_CrossProductArray for 3 dimensions without allocating.
+//
+//Parameters:
+//	dest: The destination of the cross product result, must not be either operand
+//	vec1: The left operand
+//	vec2: The right operand
+void Vector_CrossProduct3Array(float* dest, const float* vec1, const float* vec2);
+
 ///
 //Calculates the angle between two equally dimensioned arrays
 //
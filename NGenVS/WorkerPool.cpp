@@ -0,0 +1,236 @@
+#include "WorkerPool.h"
+
+#include <stdlib.h>
+
+///
+//Allocates memory for a new worker pool
+//
+//Returns:
+//	Pointer to a newly allocated worker pool
+WorkerPool* WorkerPool_Allocate(void)
+{
+	WorkerPool* pool = (WorkerPool*)malloc(sizeof(WorkerPool));
+	return pool;
+}
+
+///
+//Initializes a worker pool, starting it's threads
+//
+//Parameters:
+//	pool: A pointer to the worker pool to initialize
+//	numWorkers: The number of workers including the calling thread, 0 to use one per hardware thread
+void WorkerPool_Initialize(WorkerPool* pool, unsigned int numWorkers)
+{
+	if(numWorkers == 0)
+	{
+		numWorkers = std::thread::hardware_concurrency();
+		//The number of hardware threads could not be determined
+		if(numWorkers == 0) numWorkers = 1;
+	}
+	pool->numWorkers = numWorkers;
+
+	pool->queues = new WorkerPool_Queue[numWorkers];
+	for(unsigned int i = 0; i < numWorkers; i++)
+	{
+		pool->queues[i].begin = pool->queues[i].end = 0;
+	}
+
+	pool->lock = new std::mutex();
+	pool->started = new std::condition_variable();
+	pool->finished = new std::condition_variable();
+
+	pool->job = NULL;
+	pool->data = NULL;
+	pool->batchSize = 1;
+	pool->generation = 0;
+	pool->numBusy = 0;
+	pool->running = 1;
+
+	pool->threads = numWorkers > 1 ? new std::thread[numWorkers - 1] : NULL;
+	for(unsigned int i = 1; i < numWorkers; i++)
+	{
+		pool->threads[i - 1] = std::thread(WorkerPool_Work, pool, i);
+	}
+}
+
+///
+//Stops the threads of a worker pool and frees it's resources
+//
+//Parameters:
+//	pool: A pointer to the worker pool to free
+void WorkerPool_Free(WorkerPool* pool)
+{
+	pool->lock->lock();
+	pool->running = 0;
+	pool->lock->unlock();
+	pool->started->notify_all();
+
+	for(unsigned int i = 1; i < pool->numWorkers; i++)
+	{
+		pool->threads[i - 1].join();
+	}
+	delete[] pool->threads;
+	delete[] pool->queues;
+
+	delete pool->lock;
+	delete pool->started;
+	delete pool->finished;
+	free(pool);
+}
+
+///
+//Runs a job on a worker pool, returning once every item has been processed.
+//The items are passed to the job in ranges of at most batchSize items,
+//a job with no more than batchSize items is run on the calling thread alone.
+//
+//Parameters:
+//	pool: A pointer to the worker pool to run the job on
+//	job: The job to run
+//	data: A pointer to the data to pass to each range of the job
+//	numItems: The number of items to split between the workers
+//	batchSize: The most items to pass to a single call of the job
+void WorkerPool_Run(WorkerPool* pool, WorkerPool_Job job, void* data, unsigned int numItems, unsigned int batchSize)
+{
+	//Waking the threads costs more than a single batch
+	if(pool->numWorkers == 1 || numItems <= batchSize)
+	{
+		for(unsigned int begin = 0; begin < numItems; begin += batchSize)
+		{
+			job(data, begin, numItems - begin < batchSize ? numItems : begin + batchSize, 0);
+		}
+		return;
+	}
+
+	//Start each worker with an even slice of the items.
+	//No thread is processing a job, so the queues can be filled without their locks.
+	for(unsigned int i = 0; i < pool->numWorkers; i++)
+	{
+		pool->queues[i].begin = (unsigned int)((unsigned long long)numItems * i / pool->numWorkers);
+		pool->queues[i].end = (unsigned int)((unsigned long long)numItems * (i + 1) / pool->numWorkers);
+	}
+
+	pool->lock->lock();
+	pool->job = job;
+	pool->data = data;
+	pool->batchSize = batchSize;
+	pool->numBusy = pool->numWorkers - 1;
+	pool->generation++;
+	pool->lock->unlock();
+	pool->started->notify_all();
+
+	WorkerPool_Process(pool, 0);
+
+	std::unique_lock<std::mutex> guard(*pool->lock);
+	while(pool->numBusy != 0)
+	{
+		pool->finished->wait(guard);
+	}
+}
+
+///
+//Loop run by each thread of a worker pool, waiting for jobs and processing it's part of them
+//
+//Parameters:
+//	pool: A pointer to the worker pool the thread belongs to
+//	worker: The index of the worker the thread runs as
+static void WorkerPool_Work(WorkerPool* pool, unsigned int worker)
+{
+	unsigned int generation = 0;
+	while(1)
+	{
+		std::unique_lock<std::mutex> guard(*pool->lock);
+		while(pool->running && pool->generation == generation)
+		{
+			pool->started->wait(guard);
+		}
+		if(!pool->running) return;
+		generation = pool->generation;
+		guard.unlock();
+
+		WorkerPool_Process(pool, worker);
+
+		guard.lock();
+		pool->numBusy--;
+		guard.unlock();
+		pool->finished->notify_one();
+	}
+}
+
+///
+//Processes batches of the current job of a worker pool as a worker until no items are left to take or steal
+//
+//Parameters:
+//	pool: A pointer to the worker pool
+//	worker: The index of the worker to process the job as
+static void WorkerPool_Process(WorkerPool* pool, unsigned int worker)
+{
+	unsigned int begin, end;
+	do
+	{
+		while(WorkerPool_Take(pool, worker, &begin, &end))
+		{
+			pool->job(pool->data, begin, end, worker);
+		}
+	}
+	while(WorkerPool_Steal(pool, worker));
+}
+
+///
+//Takes a batch of items from the front of a worker's queue
+//
+//Parameters:
+//	pool: A pointer to the worker pool
+//	worker: The index of the worker taking the batch
+//	begin: A pointer to store the index of the first item of the batch in
+//	end: A pointer to store the index one past the last item of the batch in
+//
+//Returns:
+//	1 if a batch was taken, 0 if the worker's queue is empty
+static unsigned char WorkerPool_Take(WorkerPool* pool, unsigned int worker, unsigned int* begin, unsigned int* end)
+{
+	WorkerPool_Queue* queue = pool->queues + worker;
+	std::lock_guard<std::mutex> guard(queue->lock);
+
+	if(queue->begin == queue->end) return 0;
+
+	*begin = queue->begin;
+	*end = queue->end - queue->begin < pool->batchSize ? queue->end : queue->begin + pool->batchSize;
+	queue->begin = *end;
+	return 1;
+}
+
+///
+//Steals the back half of the items left in another worker's queue into a worker's queue
+//
+//Parameters:
+//	pool: A pointer to the worker pool
+//	worker: The index of the worker stealing the items
+//
+//Returns:
+//	1 if any items were stolen, 0 if every other worker's queue is empty
+static unsigned char WorkerPool_Steal(WorkerPool* pool, unsigned int worker)
+{
+	//Start with the next worker so thieves spread out over their victims
+	for(unsigned int i = 1; i < pool->numWorkers; i++)
+	{
+		WorkerPool_Queue* victim = pool->queues + (worker + i) % pool->numWorkers;
+
+		victim->lock.lock();
+		unsigned int end = victim->end;
+		unsigned int begin = victim->end - (victim->end - victim->begin + 1) / 2;
+		victim->end = begin;
+		victim->lock.unlock();
+
+		if(begin != end)
+		{
+			//Only the worker itself takes from it's queue, which is empty, but thieves may be looking at it
+			WorkerPool_Queue* queue = pool->queues + worker;
+			std::lock_guard<std::mutex> guard(queue->lock);
+			queue->begin = begin;
+			queue->end = end;
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,132 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+//A job which processes a contiguous range of items
+//
+//Parameters:
+//	data: A pointer to the data shared by every range of the job
+//	begin: The index of the first item of the range
+//	end: The index one past the last item of the range
+//	worker: The index of the worker processing the range, the calling thread is worker 0
+typedef void (*WorkerPool_Job)(void* data, unsigned int begin, unsigned int end, unsigned int worker);
+
+//The items of the current job which a worker has yet to process
+typedef struct WorkerPool_Queue
+{
+	std::mutex lock;						//Guards the range, the owner takes batches from the front while other workers steal from the back
+	unsigned int begin;						//Index of the first item left to process
+	unsigned int end;						//Index one past the last item left to process
+} WorkerPool_Queue;
+
+//A fixed set of threads which split the items of a job between them.
+//The thread running a job takes part as worker 0, so a pool of one worker starts no threads.
+//Each worker starts with an even slice of the items which it processes in batches,
+//once it runs out it steals half of the remaining items of another worker.
+//Items which cost very different amounts to process are balanced across the workers this way,
+//but there is no telling which worker will process an item, so jobs must key their results by item rather than worker.
+typedef struct WorkerPool
+{
+	unsigned int numWorkers;				//Number of workers including the calling thread
+	std::thread* threads;					//Threads of workers 1 through numWorkers - 1
+	WorkerPool_Queue* queues;				//Items left to process by each worker
+
+	std::mutex* lock;						//Guards the state of the current job
+	std::condition_variable* started;		//Signalled when a job is started or the pool is freed
+	std::condition_variable* finished;		//Signalled when a worker finishes it's part of a job
+
+	WorkerPool_Job job;						//The current job
+	void* data;								//The data of the current job
+	unsigned int batchSize;					//The most items of the current job processed by a single call
+	unsigned int generation;				//Incremented each time a job is started
+	unsigned int numBusy;					//Number of threads which have not finished the current job
+	unsigned char running;					//Cleared when the pool is being freed
+} WorkerPool;
+
+///
+//Internals
+///
+
+///
+//Loop run by each thread of a worker pool, waiting for jobs and processing it's part of them
+//
+//Parameters:
+//	pool: A pointer to the worker pool the thread belongs to
+//	worker: The index of the worker the thread runs as
+static void WorkerPool_Work(WorkerPool* pool, unsigned int worker);
+
+///
+//Processes batches of the current job of a worker pool as a worker until no items are left to take or steal
+//
+//Parameters:
+//	pool: A pointer to the worker pool
+//	worker: The index of the worker to process the job as
+static void WorkerPool_Process(WorkerPool* pool, unsigned int worker);
+
+///
+//Takes a batch of items from the front of a worker's queue
+//
+//Parameters:
+//	pool: A pointer to the worker pool
+//	worker: The index of the worker taking the batch
+//	begin: A pointer to store the index of the first item of the batch in
+//	end: A pointer to store the index one past the last item of the batch in
+//
+//Returns:
+//	1 if a batch was taken, 0 if the worker's queue is empty
+static unsigned char WorkerPool_Take(WorkerPool* pool, unsigned int worker, unsigned int* begin, unsigned int* end);
+
+///
+//Steals the back half of the items left in another worker's queue into a worker's queue
+//
+//Parameters:
+//	pool: A pointer to the worker pool
+//	worker: The index of the worker stealing the items
+//
+//Returns:
+//	1 if any items were stolen, 0 if every other worker's queue is empty
+static unsigned char WorkerPool_Steal(WorkerPool* pool, unsigned int worker);
+
+///
+//Functions
+///
+
+///
+//Allocates memory for a new worker pool
+//
+//Returns:
+//	Pointer to a newly allocated worker pool
+WorkerPool* WorkerPool_Allocate(void);
+
+///
+//Initializes a worker pool, starting it's threads
+//
+//Parameters:
+//	pool: A pointer to the worker pool to initialize
+//	numWorkers: The number of workers including the calling thread, 0 to use one per hardware thread
+void WorkerPool_Initialize(WorkerPool* pool, unsigned int numWorkers);
+
+///
+//Stops the threads of a worker pool and frees it's resources
+//
+//Parameters:
+//	pool: A pointer to the worker pool to free
+void WorkerPool_Free(WorkerPool* pool);
+
+///
+//Runs a job on a worker pool, returning once every item has been processed.
+//The items are passed to the job in ranges of at most batchSize items,
+//a job with no more than batchSize items is run on the calling thread alone.
+//
+//Parameters:
+//	pool: A pointer to the worker pool to run the job on
+//	job: The job to run
+//	data: A pointer to the data to pass to each range of the job
+//	numItems: The number of items to split between the workers
+//	batchSize: The most items to pass to a single call of the job
+void WorkerPool_Run(WorkerPool* pool, WorkerPool_Job job, void* data, unsigned int numItems, unsigned int batchSize);
+
+#endif
@@ -109,7 +109,8 @@ void AddBottle(GObject* obj, float x, float z, int pointValue)
 	obj->collider = Collider_Allocate();
 	ConvexHullCollider_Initialize(obj->collider);
 	//ConvexHullCollider_MakeCubeCollider(obj->collider->data->convexHullData, 2.0f);
-	ConvexHullCollider_MakeRectangularCollider(obj->collider->data->convexHullData, 0.8f, 2.0f, 0.8f);
+	//ConvexHullCollider_MakeRectangularCollider(obj->collider->data->convexHullData, 0.8f, 2.0f, 0.8f);
+	ConvexHullCollider_MakeCachedMeshCollider(obj->collider->data->convexHullData, obj->mesh, 24, "./Assets/Models/bottle.hull");
 
 	// Hardcode Vector 
 	Vector vector;
@@ -670,7 +671,7 @@ void Init(void)
 	InputManager_Initialize();
 	RenderingManager_Initialize();
 	AssetManager_Initialize();
-	ObjectManager_Initialize();
+	ObjectManager_Initialize(BROADPHASE_OCTTREE);
 	CollisionManager_Initialize();
 	PhysicsManager_Initialize();
 
@@ -817,7 +818,7 @@ void CalculateOctTreeCollisions(OctTree_Node* node)
 	{
 		if(node->data->size != 0)
 		{
-			LinkedList* collisions = CollisionManager_UpdateArray((GObject**)node->data->data, node->data->size);
+			DynamicArray* collisions = CollisionManager_UpdateArray((GObject**)node->data->data, node->data->size);
 			PhysicsManager_ResolveCollisions(collisions);
 		}
 	}
@@ -889,15 +890,36 @@ void Update(void)
 
 	PhysicsManager_Update(ObjectManager_GetObjectBuffer().gameObjects);
 
-	//Update the oct tree
-	ObjectManager_UpdateOctTree();
+	//Update the broadphase structure
+	ObjectManager_UpdateBroadphase();
 
-	//LinkedList* collisions = CollisionManager_UpdateList(ObjectManager_GetObjectBuffer().gameObjects);
+	//DynamicArray* collisions = CollisionManager_UpdateList(ObjectManager_GetObjectBuffer().gameObjects);
 
 	//OctTree_Node* octTreeRoot = ObjectManager_GetObjectBuffer().octTree->root;
 	//CalculateOctTreeCollisions(octTreeRoot);
 
-	LinkedList* collisions = CollisionManager_UpdateOctTree(ObjectManager_GetObjectBuffer().octTree);
+	ObjectBuffer objects = ObjectManager_GetObjectBuffer();
+	DynamicArray* collisions = NULL;
+	switch(objects.broadphase)
+	{
+	case BROADPHASE_OCTTREE:
+	case BROADPHASE_LOOSEOCTTREE:
+		collisions = CollisionManager_UpdateOctTree(objects.octTree);
+		break;
+	case BROADPHASE_SWEEPANDPRUNE_1AXIS:
+	case BROADPHASE_SWEEPANDPRUNE_3AXES:
+		collisions = CollisionManager_UpdateSweepAndPrune(objects.sweepAndPrune);
+		break;
+	case BROADPHASE_AABBTREE:
+		collisions = CollisionManager_UpdateAABBTree(objects.aabbTree);
+		break;
+	case BROADPHASE_SPATIALHASHGRID:
+		collisions = CollisionManager_UpdateSpatialHashGrid(objects.spatialHashGrid);
+		break;
+	case BROADPHASE_LINEAROCTTREE:
+		collisions = CollisionManager_UpdateLinearOctTree(objects.linearOctTree);
+		break;
+	}
 
 
 	//Pass collisions to physics manager to be resolved
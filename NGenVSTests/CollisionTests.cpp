@@ -0,0 +1,851 @@
+#include "CollisionTests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+///
+//Compares the convex tests on hulls oriented into the scratch memory of the testing thread
+//against the same tests on hulls read from their world space caches.
+//Both orient the hulls the same way the tests did when they allocated every oriented vector, so the results must match bit for bit.
+//
+//Parameters:
+//	arrow: A pointer to the mesh of the arrow
+//	bottle: A pointer to the mesh of the bottle
+//
+//Returns:
+//	The number of poses on which the results differ
+unsigned int CollisionTests_CheckScratch(const Mesh* arrow, const Mesh* bottle)
+{
+	//Two of each hull so each hull is also tested against itself, & a sphere & box to test against the hulls
+	const unsigned int numObjects = 6;
+	GObject* objects[6];
+	objects[0] = CollisionTests_AllocateObject(COLLIDER_SPHERE, NULL);
+	objects[1] = CollisionTests_AllocateObject(COLLIDER_AABB, NULL);
+	objects[2] = CollisionTests_AllocateObject(COLLIDER_CONVEXHULL, arrow);
+	objects[3] = CollisionTests_AllocateObject(COLLIDER_CONVEXHULL, arrow);
+	objects[4] = CollisionTests_AllocateObject(COLLIDER_CONVEXHULL, bottle);
+	objects[5] = CollisionTests_AllocateObject(COLLIDER_CONVEXHULL, bottle);
+
+	Collision collision;
+	memset(&collision, 0, sizeof(Collision));
+
+	//The results of SAT & GJK on hulls oriented into scratch memory, then on hulls read from their caches
+	CollisionTests_Contact contacts[2][2];
+
+	unsigned int numColliding = 0;
+	unsigned int failures = 0;
+	for(unsigned int i = 0; i < CollisionTests_NUM_POSES; i++)
+	{
+		unsigned int index1, index2;
+		CollisionTests_PickPair(&index1, &index2, numObjects);
+		GObject* obj1 = objects[index1];
+		GObject* obj2 = objects[index2];
+
+		CollisionTests_Pose(obj1, 0.6f);
+		CollisionTests_Pose(obj2, 0.6f);
+
+		//GJK only tests colliders with points, so it can't test the sphere
+		unsigned char testGJK = obj1->collider->type != COLLIDER_SPHERE;
+
+		for(unsigned int cached = 0; cached < 2; cached++)
+		{
+			CollisionTests_SetWorldCache(obj1, cached);
+			CollisionTests_SetWorldCache(obj2, cached);
+
+			CollisionTests_TestPairDirectly(&collision, obj1, obj2);
+			CollisionTests_GetContact(&contacts[cached][0], &collision);
+
+			if(testGJK)
+			{
+				CollisionManager_TestGJKCollision(&collision, obj1, obj1->frameOfReference, obj2, obj2->frameOfReference);
+				CollisionTests_GetContact(&contacts[cached][1], &collision);
+			}
+		}
+
+		if(contacts[1][0].obj1 != NULL)
+		{
+			numColliding++;
+		}
+
+		if(!CollisionTests_AreContactsIdentical(&contacts[0][0], &contacts[1][0]) || (testGJK && !CollisionTests_AreContactsIdentical(&contacts[0][1], &contacts[1][1])))
+		{
+			failures++;
+			printf("CollisionTests: Scratch & cached hulls differ on objects %u & %u, scratch overlap %.9g, cached overlap %.9g\n",
+				index1, index2, contacts[0][0].overlap, contacts[1][0].overlap);
+		}
+	}
+
+	for(unsigned int i = 0; i < numObjects; i++)
+	{
+		GObject_Free(objects[i]);
+	}
+
+	printf("CollisionTests: Scratch vs cached hulls, %u poses, %u colliding, %u failures\n", CollisionTests_NUM_POSES, numColliding, failures);
+	return failures;
+}
+
+///
+//Compares SAT against GJK & EPA on random poses of the arrow & bottle hulls & of a box against them
+//
+//Parameters:
+//	arrow: A pointer to the mesh of the arrow
+//	bottle: A pointer to the mesh of the bottle
+//
+//Returns:
+//	The number of poses on which the algorithms disagree
+unsigned int CollisionTests_CheckConvexAlgorithms(const Mesh* arrow, const Mesh* bottle)
+{
+	//Two of each hull so each hull is also tested against itself, & a box to test against the hulls
+	const unsigned int numObjects = 5;
+	GObject* objects[5];
+	objects[0] = CollisionTests_AllocateObject(COLLIDER_AABB, NULL);
+	objects[1] = CollisionTests_AllocateObject(COLLIDER_CONVEXHULL, arrow);
+	objects[2] = CollisionTests_AllocateObject(COLLIDER_CONVEXHULL, arrow);
+	objects[3] = CollisionTests_AllocateObject(COLLIDER_CONVEXHULL, bottle);
+	objects[4] = CollisionTests_AllocateObject(COLLIDER_CONVEXHULL, bottle);
+
+	Collision SATCollision;
+	Collision GJKCollision;
+	memset(&SATCollision, 0, sizeof(Collision));
+	memset(&GJKCollision, 0, sizeof(Collision));
+
+	CollisionTests_Contact SATContact;
+	CollisionTests_Contact GJKContact;
+
+	unsigned int numColliding = 0;
+	unsigned int failures = 0;
+	for(unsigned int i = 0; i < CollisionTests_NUM_POSES; i++)
+	{
+		unsigned int index1, index2;
+		CollisionTests_PickPair(&index1, &index2, numObjects);
+		GObject* obj1 = objects[index1];
+		GObject* obj2 = objects[index2];
+
+		CollisionTests_Pose(obj1, 0.6f);
+		CollisionTests_Pose(obj2, 0.6f);
+
+		//Test both algorithms on the world space hulls, as the collision manager does
+		CollisionTests_SetWorldCache(obj1, 1);
+		CollisionTests_SetWorldCache(obj2, 1);
+
+		CollisionTests_TestPairDirectly(&SATCollision, obj1, obj2);
+		CollisionManager_TestGJKCollision(&GJKCollision, obj1, obj1->frameOfReference, obj2, obj2->frameOfReference);
+
+		CollisionTests_GetContact(&SATContact, &SATCollision);
+		CollisionTests_GetContact(&GJKContact, &GJKCollision);
+
+		unsigned char agree;
+		if(SATContact.obj1 != NULL && GJKContact.obj1 != NULL)
+		{
+			numColliding++;
+			agree = CollisionTests_DoContactsAgree(&SATContact, &GJKContact, CollisionTests_EPA_TOLERANCE, CollisionTests_EPA_MIN_DOT);
+		}
+		else
+		{
+			//Objects which are only touching may be found colliding by one algorithm & not the other
+			agree = (SATContact.obj1 == NULL || SATContact.overlap < CollisionTests_TOUCHING) && (GJKContact.obj1 == NULL || GJKContact.overlap < CollisionTests_TOUCHING);
+		}
+
+		if(!agree)
+		{
+			failures++;
+			printf("CollisionTests: SAT & GJK disagree on objects %u & %u, SAT overlap %f normal (%f, %f, %f), GJK overlap %f normal (%f, %f, %f)\n",
+				index1, index2,
+				SATContact.overlap, SATContact.normal[0], SATContact.normal[1], SATContact.normal[2],
+				GJKContact.overlap, GJKContact.normal[0], GJKContact.normal[1], GJKContact.normal[2]);
+		}
+	}
+
+	for(unsigned int i = 0; i < numObjects; i++)
+	{
+		GObject_Free(objects[i]);
+	}
+
+	printf("CollisionTests: SAT vs GJK, %u poses, %u colliding, %u failures\n", CollisionTests_NUM_POSES, numColliding, failures);
+	return failures;
+}
+
+///
+//Moves a scene of objects around a sweep and prune broadphase for a number of frames,
+//comparing the collisions the collision manager finds each frame against testing every pair of objects directly.
+//The collision manager prefilters pairs by their bounds & tests pairs of spheres & pairs of AABBs in batches,
+//testing every pair directly does neither.
+//
+//Parameters:
+//	name: The name of the scene to print the results under
+//	hullMeshes: An array of pointers to the meshes to build the convex hulls of the scene from
+//	numHullMeshes: The number of meshes in the array, the scene has only spheres & AABBs if there are none
+//
+//Returns:
+//	The number of collisions which differ between the collision manager & testing every pair directly
+unsigned int CollisionTests_CheckScene(const char* name, const Mesh** hullMeshes, unsigned int numHullMeshes)
+{
+	const float spread = 3.0f;
+
+	SweepAndPrune* sweepAndPrune = SweepAndPrune_Allocate();
+	SweepAndPrune_Initialize(sweepAndPrune, 3);
+
+	GObject* objects[CollisionTests_NUM_OBJECTS];
+	for(unsigned int i = 0; i < CollisionTests_NUM_OBJECTS; i++)
+	{
+		unsigned int numTypes = numHullMeshes > 0 ? 3 : 2;
+		switch(i % numTypes)
+		{
+		case 0:
+			objects[i] = CollisionTests_AllocateObject(COLLIDER_SPHERE, NULL);
+			break;
+		case 1:
+			objects[i] = CollisionTests_AllocateObject(COLLIDER_AABB, NULL);
+			break;
+		default:
+			objects[i] = CollisionTests_AllocateObject(COLLIDER_CONVEXHULL, hullMeshes[(i / numTypes) % numHullMeshes]);
+			break;
+		}
+
+		CollisionTests_Pose(objects[i], spread);
+		SweepAndPrune_Add(sweepAndPrune, objects[i]);
+	}
+
+	DynamicArray* managerContacts = DynamicArray_Allocate();
+	DynamicArray_Initialize(managerContacts, sizeof(CollisionTests_Contact));
+	DynamicArray* directContacts = DynamicArray_Allocate();
+	DynamicArray_Initialize(directContacts, sizeof(CollisionTests_Contact));
+
+	Collision collision;
+	memset(&collision, 0, sizeof(Collision));
+
+	CollisionTests_Contact contact;
+
+	unsigned int numCollisions = 0;
+	unsigned int failures = 0;
+	for(unsigned int frame = 0; frame < CollisionTests_NUM_FRAMES; frame++)
+	{
+		//Move a third of the objects each frame, the pairs of objects which stay still reuse their last result
+		if(frame > 0)
+		{
+			for(unsigned int i = frame % 3; i < CollisionTests_NUM_OBJECTS; i += 3)
+			{
+				CollisionTests_Pose(objects[i], spread);
+			}
+		}
+
+		SweepAndPrune_Update(sweepAndPrune);
+		DynamicArray* collisions = CollisionManager_UpdateSweepAndPrune(sweepAndPrune);
+
+		managerContacts->size = 0;
+		for(unsigned int i = 0; i < collisions->size; i++)
+		{
+			CollisionTests_GetContact(&contact, (Collision*)DynamicArray_Index(collisions, i));
+			DynamicArray_Append(managerContacts, &contact);
+		}
+
+		directContacts->size = 0;
+		for(unsigned int i = 0; i < CollisionTests_NUM_OBJECTS; i++)
+		{
+			for(unsigned int j = i + 1; j < CollisionTests_NUM_OBJECTS; j++)
+			{
+				CollisionTests_TestPairDirectly(&collision, objects[i], objects[j]);
+				if(collision.obj1 != NULL)
+				{
+					CollisionTests_GetContact(&contact, &collision);
+					DynamicArray_Append(directContacts, &contact);
+				}
+			}
+		}
+		numCollisions += directContacts->size;
+
+		//Every collision found directly must be found by the collision manager, unless the objects are only touching
+		for(unsigned int i = 0; i < directContacts->size; i++)
+		{
+			CollisionTests_Contact* directContact = (CollisionTests_Contact*)DynamicArray_Index(directContacts, i);
+			CollisionTests_Contact* managerContact = CollisionTests_FindContact(managerContacts, directContact->obj1, directContact->obj2);
+
+			unsigned char agree;
+			if(managerContact != NULL)
+			{
+				agree = CollisionTests_DoContactsAgree(directContact, managerContact, CollisionTests_TOLERANCE, 1.0f - CollisionTests_TOLERANCE);
+			}
+			else
+			{
+				agree = directContact->overlap < CollisionTests_TOUCHING;
+			}
+
+			if(!agree)
+			{
+				failures++;
+				printf("CollisionTests: %s frame %u, collision manager %s objects %u & %u, direct overlap %f\n",
+					name, frame, managerContact != NULL ? "disagrees on" : "missed",
+					directContact->obj1->id, directContact->obj2->id, directContact->overlap);
+			}
+		}
+
+		//& the collision manager must not find any collision which isn't found directly
+		for(unsigned int i = 0; i < managerContacts->size; i++)
+		{
+			CollisionTests_Contact* managerContact = (CollisionTests_Contact*)DynamicArray_Index(managerContacts, i);
+			if(managerContact->overlap >= CollisionTests_TOUCHING && CollisionTests_FindContact(directContacts, managerContact->obj1, managerContact->obj2) == NULL)
+			{
+				failures++;
+				printf("CollisionTests: %s frame %u, collision manager found objects %u & %u colliding, overlap %f\n",
+					name, frame, managerContact->obj1->id, managerContact->obj2->id, managerContact->overlap);
+			}
+		}
+	}
+
+	//Run the broadphase once more without any objects so the pair cache lets go of the scene before it's freed
+	for(unsigned int i = 0; i < CollisionTests_NUM_OBJECTS; i++)
+	{
+		SweepAndPrune_Remove(sweepAndPrune, objects[i]);
+	}
+	SweepAndPrune_Update(sweepAndPrune);
+	CollisionManager_UpdateSweepAndPrune(sweepAndPrune);
+
+	for(unsigned int i = 0; i < CollisionTests_NUM_OBJECTS; i++)
+	{
+		GObject_Free(objects[i]);
+	}
+	SweepAndPrune_Free(sweepAndPrune);
+	DynamicArray_Free(managerContacts);
+	DynamicArray_Free(directContacts);
+
+	printf("CollisionTests: %s, %u frames, %u collisions, %u failures\n", name, CollisionTests_NUM_FRAMES, numCollisions, failures);
+	return failures;
+}
+
+///
+//Saves the hulls of the arrow & bottle to a cache & loads them back,
+//checking the loaded hulls match the saved hulls exactly & that a cache of a different budget is refused
+//
+//Parameters:
+//	arrow: A pointer to the mesh of the arrow
+//	bottle: A pointer to the mesh of the bottle
+//
+//Returns:
+//	The number of hulls which did not survive the round trip
+unsigned int CollisionTests_CheckHullCache(const Mesh* arrow, const Mesh* bottle)
+{
+	const Mesh* meshes[2] = { arrow, bottle };
+	const char* names[2] = { "arrow", "bottle" };
+
+	unsigned int failures = 0;
+	for(unsigned int i = 0; i < 2; i++)
+	{
+		ColliderData_ConvexHull* built = ConvexHullCollider_AllocateData();
+		ColliderData_ConvexHull* loaded = ConvexHullCollider_AllocateData();
+		ColliderData_ConvexHull* stale = ConvexHullCollider_AllocateData();
+		ConvexHullCollider_InitializeData(built);
+		ConvexHullCollider_InitializeData(loaded);
+		ConvexHullCollider_InitializeData(stale);
+
+		unsigned char passed =
+			ConvexHullCollider_MakeMeshCollider(built, meshes[i], CollisionTests_HULL_BUDGET) &&
+			ConvexHullCollider_SaveCache(built, meshes[i], CollisionTests_HULL_BUDGET, CollisionTests_CACHE_PATH) &&
+			ConvexHullCollider_LoadCache(loaded, meshes[i], CollisionTests_HULL_BUDGET, CollisionTests_CACHE_PATH) &&
+			CollisionTests_AreHullsEqual(built, loaded);
+
+		//A cache built with another budget holds another hull, it must be refused without touching the collider
+		if(ConvexHullCollider_LoadCache(stale, meshes[i], CollisionTests_HULL_BUDGET + 1, CollisionTests_CACHE_PATH) || stale->points->size > 0)
+		{
+			passed = 0;
+		}
+
+		if(!passed)
+		{
+			failures++;
+			printf("CollisionTests: Hull cache of the %s did not survive the round trip\n", names[i]);
+		}
+
+		remove(CollisionTests_CACHE_PATH);
+		ConvexHullCollider_FreeData(built);
+		ConvexHullCollider_FreeData(loaded);
+		ConvexHullCollider_FreeData(stale);
+	}
+
+	printf("CollisionTests: Hull cache round trip, 2 hulls, %u failures\n", failures);
+	return failures;
+}
+
+///
+//Compares every part of two convex hull colliders exactly
+//
+//Parameters:
+//	hull1: A pointer to the first convex hull collider
+//	hull2: A pointer to the second convex hull collider
+//
+//Returns:
+//	1 if the colliders have the same points, axes, edges, arcs & neighbours, else 0
+static unsigned char CollisionTests_AreHullsEqual(const ColliderData_ConvexHull* hull1, const ColliderData_ConvexHull* hull2)
+{
+	if(!CollisionTests_AreVectorListsEqual(hull1->points, hull2->points)) return 0;
+	if(!CollisionTests_AreVectorListsEqual(hull1->axes, hull2->axes)) return 0;
+	if(!CollisionTests_AreVectorListsEqual(hull1->edges, hull2->edges)) return 0;
+
+	if(hull1->arcs->size != hull2->arcs->size) return 0;
+	if(memcmp(hull1->arcs->data, hull2->arcs->data, hull1->arcs->size * sizeof(ConvexHullCollider_Arc)) != 0) return 0;
+
+	if(hull1->neighbours->size != hull2->neighbours->size) return 0;
+	for(unsigned int i = 0; i < hull1->neighbours->size; i++)
+	{
+		DynamicArray* neighbours1 = *(DynamicArray**)DynamicArray_Index(hull1->neighbours, i);
+		DynamicArray* neighbours2 = *(DynamicArray**)DynamicArray_Index(hull2->neighbours, i);
+		if(neighbours1->size != neighbours2->size) return 0;
+		if(memcmp(neighbours1->data, neighbours2->data, neighbours1->size * neighbours1->dataSize) != 0) return 0;
+	}
+
+	return 1;
+}
+
+///
+//Compares the vectors of two linked lists exactly
+//
+//Parameters:
+//	list1: A pointer to the first linked list of vectors
+//	list2: A pointer to the second linked list of vectors
+//
+//Returns:
+//	1 if the lists hold the same number of vectors with the same components, else 0
+static unsigned char CollisionTests_AreVectorListsEqual(const LinkedList* list1, const LinkedList* list2)
+{
+	if(list1->size != list2->size) return 0;
+
+	LinkedList_Node* node1 = list1->head;
+	LinkedList_Node* node2 = list2->head;
+	while(node1 != NULL && node2 != NULL)
+	{
+		const Vector* vector1 = (Vector*)node1->data;
+		const Vector* vector2 = (Vector*)node2->data;
+		if(vector1->dimension != vector2->dimension) return 0;
+		if(memcmp(vector1->components, vector2->components, sizeof(float) * vector1->dimension) != 0) return 0;
+
+		node1 = node1->next;
+		node2 = node2->next;
+	}
+
+	return 1;
+}
+
+///
+//Compares the compound narrow phase against testing every piece of the compound directly,
+//on random poses of a compound collider decomposed from a concave mesh & a sphere, box & arrow hull around it.
+//The deepest collision with any piece is the collision with the compound.
+//
+//Parameters:
+//	concave: A pointer to the concave mesh to decompose into the compound collider
+//	arrow: A pointer to the mesh of the arrow
+//
+//Returns:
+//	The number of poses on which the compound narrow phase & the pieces disagree
+unsigned int CollisionTests_CheckCompound(const Mesh* concave, const Mesh* arrow)
+{
+	GObject* compoundObj = CollisionTests_AllocateObject(COLLIDER_COMPOUND, concave);
+	const DynamicArray* pieces = compoundObj->collider->data->compoundData->pieces;
+	unsigned int numPieces = pieces->size;
+
+	const unsigned int numProbes = 3;
+	GObject* probes[3];
+	probes[0] = CollisionTests_AllocateObject(COLLIDER_SPHERE, NULL);
+	probes[1] = CollisionTests_AllocateObject(COLLIDER_AABB, NULL);
+	probes[2] = CollisionTests_AllocateObject(COLLIDER_CONVEXHULL, arrow);
+
+	//Each piece is tested directly as though it were the collider of the compound object
+	GObject proxy = *compoundObj;
+
+	Collision collision;
+	memset(&collision, 0, sizeof(Collision));
+
+	CollisionTests_Contact compoundContact;
+	CollisionTests_Contact pieceContact;
+	CollisionTests_Contact deepestContact;
+
+	unsigned int numColliding = 0;
+	unsigned int failures = 0;
+	for(unsigned int i = 0; i < CollisionTests_NUM_POSES; i++)
+	{
+		GObject* probe = probes[rand() % numProbes];
+
+		CollisionTests_Pose(compoundObj, 0.0f);
+		CollisionTests_Pose(probe, 1.5f);
+
+		CollisionManager_TestCollision(&collision, compoundObj, compoundObj->frameOfReference, probe, probe->frameOfReference);
+		CollisionTests_GetContact(&compoundContact, &collision);
+
+		deepestContact.obj1 = NULL;
+		deepestContact.overlap = 0.0f;
+		for(unsigned int j = 0; j < numPieces; j++)
+		{
+			proxy.collider = *(Collider**)DynamicArray_Index(pieces, j);
+			CollisionTests_TestPairDirectly(&collision, &proxy, probe);
+			CollisionTests_GetContact(&pieceContact, &collision);
+
+			if(pieceContact.obj1 != NULL && (deepestContact.obj1 == NULL || pieceContact.overlap > deepestContact.overlap))
+			{
+				deepestContact = pieceContact;
+			}
+		}
+
+		//Report the compound object itself rather than the proxy
+		if(deepestContact.obj1 == &proxy) deepestContact.obj1 = compoundObj;
+		if(deepestContact.obj2 == &proxy) deepestContact.obj2 = compoundObj;
+
+		unsigned char agree;
+		if(compoundContact.obj1 != NULL && deepestContact.obj1 != NULL)
+		{
+			numColliding++;
+			agree = CollisionTests_DoContactsAgree(&compoundContact, &deepestContact, CollisionTests_TOLERANCE, 1.0f - CollisionTests_TOLERANCE);
+		}
+		else
+		{
+			//Objects which are only touching may be found colliding by one test & not the other
+			agree = (compoundContact.obj1 == NULL || compoundContact.overlap < CollisionTests_TOUCHING) && (deepestContact.obj1 == NULL || deepestContact.overlap < CollisionTests_TOUCHING);
+		}
+
+		if(!agree)
+		{
+			failures++;
+			printf("CollisionTests: Compound & pieces disagree against a probe of type %d, compound overlap %f, deepest piece overlap %f\n",
+				probe->collider->type, compoundContact.overlap, deepestContact.overlap);
+		}
+	}
+
+	GObject_Free(compoundObj);
+	for(unsigned int i = 0; i < numProbes; i++)
+	{
+		GObject_Free(probes[i]);
+	}
+
+	printf("CollisionTests: Compound vs pieces, %u pieces, %u poses, %u colliding, %u failures\n", numPieces, CollisionTests_NUM_POSES, numColliding, failures);
+	return failures;
+}
+
+///
+//Compares testing pairs through the collision manager, which skips the narrow phase of pairs whose bounds don't overlap,
+//against testing every pair directly on random poses of spheres, boxes & the arrow & bottle hulls.
+//Both run the same narrow phase on the pairs the bounds let through, so those results must match bit for bit.
+//
+//Parameters:
+//	arrow: A pointer to the mesh of the arrow
+//	bottle: A pointer to the mesh of the bottle
+//
+//Returns:
+//	The number of poses on which the prefiltered & direct tests disagree
+unsigned int CollisionTests_CheckPrefilter(const Mesh* arrow, const Mesh* bottle)
+{
+	const unsigned int numObjects = 6;
+	GObject* objects[6];
+	objects[0] = CollisionTests_AllocateObject(COLLIDER_SPHERE, NULL);
+	objects[1] = CollisionTests_AllocateObject(COLLIDER_AABB, NULL);
+	objects[2] = CollisionTests_AllocateObject(COLLIDER_CONVEXHULL, arrow);
+	objects[3] = CollisionTests_AllocateObject(COLLIDER_CONVEXHULL, arrow);
+	objects[4] = CollisionTests_AllocateObject(COLLIDER_CONVEXHULL, bottle);
+	objects[5] = CollisionTests_AllocateObject(COLLIDER_CONVEXHULL, bottle);
+
+	Collision collision;
+	memset(&collision, 0, sizeof(Collision));
+
+	CollisionTests_Contact prefilteredContact;
+	CollisionTests_Contact directContact;
+
+	unsigned int numColliding = 0;
+	unsigned int failures = 0;
+	for(unsigned int i = 0; i < CollisionTests_NUM_POSES; i++)
+	{
+		unsigned int index1, index2;
+		CollisionTests_PickPair(&index1, &index2, numObjects);
+		GObject* obj1 = objects[index1];
+		GObject* obj2 = objects[index2];
+
+		//Spread the objects far enough apart that the bounds of many pairs don't overlap
+		CollisionTests_Pose(obj1, 1.5f);
+		CollisionTests_Pose(obj2, 1.5f);
+
+		CollisionManager_TestCollision(&collision, obj1, obj1->frameOfReference, obj2, obj2->frameOfReference);
+		CollisionTests_GetContact(&prefilteredContact, &collision);
+
+		CollisionTests_TestPairDirectly(&collision, obj1, obj2);
+		CollisionTests_GetContact(&directContact, &collision);
+
+		if(directContact.obj1 != NULL)
+		{
+			numColliding++;
+		}
+
+		//The bounds may only turn away pairs which are at most touching
+		unsigned char agree = CollisionTests_AreContactsIdentical(&prefilteredContact, &directContact) ||
+			(prefilteredContact.obj1 == NULL && directContact.overlap < CollisionTests_TOUCHING);
+
+		if(!agree)
+		{
+			failures++;
+			printf("CollisionTests: Prefiltered & direct tests disagree on objects %u & %u, prefiltered overlap %.9g, direct overlap %.9g\n",
+				index1, index2, prefilteredContact.overlap, directContact.overlap);
+		}
+	}
+
+	for(unsigned int i = 0; i < numObjects; i++)
+	{
+		GObject_Free(objects[i]);
+	}
+
+	printf("CollisionTests: Prefiltered vs direct, %u poses, %u colliding, %u failures\n", CollisionTests_NUM_POSES, numColliding, failures);
+	return failures;
+}
+
+///
+//Allocates & initializes a game object with a collider of a given type & a random size
+//
+//Parameters:
+//	type: The type of collider to attach, sphere, AABB, convex hull or compound
+//	mesh: A pointer to the mesh to build a convex hull or compound collider from, NULL for other types
+//
+//Returns:
+//	A pointer to the newly allocated game object
+static GObject* CollisionTests_AllocateObject(enum ColliderType type, const Mesh* mesh)
+{
+	GObject* obj = GObject_Allocate();
+	GObject_Initialize(obj);
+
+	obj->collider = Collider_Allocate();
+	switch(type)
+	{
+	case COLLIDER_SPHERE:
+		SphereCollider_Initialize(obj->collider, CollisionTests_Random(0.3f, 0.8f));
+		break;
+	case COLLIDER_AABB:
+		AABBCollider_Initialize(obj->collider, CollisionTests_Random(0.4f, 1.5f), CollisionTests_Random(0.4f, 1.5f), CollisionTests_Random(0.4f, 1.5f), &Vector_ZERO);
+		break;
+	case COLLIDER_CONVEXHULL:
+		ConvexHullCollider_Initialize(obj->collider);
+		ConvexHullCollider_MakeMeshCollider(obj->collider->data->convexHullData, mesh, CollisionTests_HULL_BUDGET);
+		break;
+	default:
+		CompoundCollider_Initialize(obj->collider);
+		CompoundCollider_MakeMeshCollider(obj->collider->data->compoundData, mesh, CollisionTests_COMPOUND_PIECES, CollisionTests_HULL_BUDGET);
+		break;
+	}
+
+	return obj;
+}
+
+///
+//Moves a game object to a random position & turns it by a random rotation,
+//AABBs are never rotated
+//
+//Parameters:
+//	obj: A pointer to the game object to pose
+//	spread: The furthest the object may be placed from the origin along each axis
+static void CollisionTests_Pose(GObject* obj, float spread)
+{
+	Vector position;
+	Vector_INIT_ON_STACK(position, 3);
+	position.components[0] = CollisionTests_Random(-spread, spread);
+	position.components[1] = CollisionTests_Random(-spread, spread);
+	position.components[2] = CollisionTests_Random(-spread, spread);
+	GObject_SetPosition(obj, &position);
+
+	if(obj->collider->type != COLLIDER_AABB)
+	{
+		GObject_Rotate(obj, &Vector_E1, CollisionTests_Random(0.0f, 6.28f));
+		GObject_Rotate(obj, &Vector_E2, CollisionTests_Random(0.0f, 6.28f));
+		GObject_Rotate(obj, &Vector_E3, CollisionTests_Random(0.0f, 6.28f));
+	}
+}
+
+///
+//Picks a random pair of different objects from an array, ordered by their index in the array
+//
+//Parameters:
+//	index1: A pointer to store the index of the first object of the pair in
+//	index2: A pointer to store the index of the second object of the pair in
+//	numObjects: The number of objects to pick from
+static void CollisionTests_PickPair(unsigned int* index1, unsigned int* index2, unsigned int numObjects)
+{
+	*index1 = rand() % numObjects;
+	*index2 = (*index1 + 1 + rand() % (numObjects - 1)) % numObjects;
+	if(*index2 < *index1)
+	{
+		unsigned int temp = *index1;
+		*index1 = *index2;
+		*index2 = temp;
+	}
+}
+
+///
+//Tests a pair of objects with the test for their types directly,
+//without the bounds test, pair cache or batches the collision manager would use
+//
+//Parameters:
+//	dest: A pointer to the collision to store the result in, it's pair must be NULL
+//	obj1: A pointer to the first object of the pair
+//	obj2: A pointer to the second object of the pair
+static void CollisionTests_TestPairDirectly(Collision* dest, GObject* obj1, GObject* obj2)
+{
+	//Order the pair by type so each test gets the types it expects first
+	if(obj2->collider->type < obj1->collider->type)
+	{
+		GObject* temp = obj1;
+		obj1 = obj2;
+		obj2 = temp;
+	}
+
+	FrameOfReference* frame1 = obj1->body != NULL ? obj1->body->frame : obj1->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+	FrameOfReference* frame2 = obj2->body != NULL ? obj2->body->frame : obj2->frameOfReference;		//If there is a rigidbody use that frame of reference, else use the objects
+
+	switch(obj1->collider->type)
+	{
+	case COLLIDER_SPHERE:
+		switch(obj2->collider->type)
+		{
+		case COLLIDER_SPHERE:
+			CollisionManager_TestSphereCollision(dest, obj1, frame1, obj2, frame2);
+			break;
+		case COLLIDER_AABB:
+			CollisionManager_TestAABBSphereCollision(dest, obj2, frame2, obj1, frame1);
+			break;
+		default:
+			CollisionManager_TestConvexSphereCollision(dest, obj2, frame2, obj1, frame1);
+			break;
+		}
+		break;
+	case COLLIDER_AABB:
+		switch(obj2->collider->type)
+		{
+		case COLLIDER_AABB:
+			CollisionManager_TestAABBCollision(dest, obj1, frame1, obj2, frame2);
+			break;
+		default:
+			CollisionManager_TestAABBConvexCollision(dest, obj1, frame1, obj2, frame2);
+			break;
+		}
+		break;
+	default:
+		CollisionManager_TestConvexCollision(dest, obj1, frame1, obj2, frame2);
+		break;
+	}
+}
+
+///
+//Sets the world space caches of an object's convex hull collider current, or marks them out of date
+//
+//Parameters:
+//	obj: A pointer to the object whose collider's caches are set, objects without a convex hull collider are left alone
+//	current: 1 to refresh the caches, 0 to invalidate them
+static void CollisionTests_SetWorldCache(GObject* obj, unsigned char current)
+{
+	if(obj->collider->type != COLLIDER_CONVEXHULL)
+	{
+		return;
+	}
+
+	if(current)
+	{
+		ConvexHullCollider_RefreshWorldCache(obj->collider->data->convexHullData, obj->frameOfReference);
+	}
+	else
+	{
+		ConvexHullCollider_InvalidateWorldCache(obj->collider->data->convexHullData);
+	}
+}
+
+///
+//Finds the contact of a pair of objects among an array of contacts
+//
+//Parameters:
+//	contacts: A pointer to a dynamic array of contacts to search
+//	obj1: A pointer to one object of the pair
+//	obj2: A pointer to the other object of the pair
+//
+//Returns:
+//	A pointer to the contact between the objects, or NULL if there is none
+static CollisionTests_Contact* CollisionTests_FindContact(DynamicArray* contacts, const GObject* obj1, const GObject* obj2)
+{
+	for(unsigned int i = 0; i < contacts->size; i++)
+	{
+		CollisionTests_Contact* contact = (CollisionTests_Contact*)DynamicArray_Index(contacts, i);
+		if((contact->obj1 == obj1 && contact->obj2 == obj2) || (contact->obj1 == obj2 && contact->obj2 == obj1))
+		{
+			return contact;
+		}
+	}
+
+	return NULL;
+}
+
+///
+//Compares two contacts of the same pair of objects
+//
+//Parameters:
+//	contact1: A pointer to the first contact
+//	contact2: A pointer to the second contact, the pair may be stored in either order
+//	depthTolerance: The largest difference allowed between the overlaps of the contacts
+//	minDot: The smallest dot product allowed between the normals of the contacts
+//
+//Returns:
+//	1 if the contacts agree, else 0
+static unsigned char CollisionTests_DoContactsAgree(const CollisionTests_Contact* contact1, const CollisionTests_Contact* contact2, float depthTolerance, float minDot)
+{
+	float dot = Vector_DotProductArray(contact1->normal, contact2->normal, 3);
+
+	//The normal points towards the first object, so it's flipped when the pair is stored the other way around
+	if(contact1->obj1 != contact2->obj1)
+	{
+		dot = -dot;
+	}
+
+	return fabsf(contact1->overlap - contact2->overlap) <= depthTolerance && dot >= minDot;
+}
+
+///
+//Compares two contacts bit for bit
+//
+//Parameters:
+//	contact1: A pointer to the first contact
+//	contact2: A pointer to the second contact
+//
+//Returns:
+//	1 if the contacts hold the same objects in the same order, & the same normal & overlap down to the last bit, else 0
+static unsigned char CollisionTests_AreContactsIdentical(const CollisionTests_Contact* contact1, const CollisionTests_Contact* contact2)
+{
+	return contact1->obj1 == contact2->obj1 && contact1->obj2 == contact2->obj2 &&
+		memcmp(contact1->normal, contact2->normal, sizeof(float) * 3) == 0 &&
+		memcmp(&contact1->overlap, &contact2->overlap, sizeof(float)) == 0;
+}
+
+///
+//Stores the result of a collision test as a contact
+//
+//Parameters:
+//	dest: A pointer to the contact to store the result in
+//	collision: A pointer to the collision holding the result of the test
+static void CollisionTests_GetContact(CollisionTests_Contact* dest, const Collision* collision)
+{
+	dest->obj1 = collision->obj1;
+	dest->obj2 = collision->obj2;
+
+	//The normal is left over from whatever the test last tried when there is no collision
+	if(collision->obj1 != NULL)
+	{
+		memcpy(dest->normal, collision->minimumTranslationVector, sizeof(float) * 3);
+		dest->overlap = collision->overlap;
+	}
+	else
+	{
+		memset(dest->normal, 0, sizeof(float) * 3);
+		dest->overlap = 0.0f;
+	}
+}
+
+///
+//Gets a random number within a range
+//
+//Parameters:
+//	min: The lowest number which may be returned
+//	max: The highest number which may be returned
+//
+//Returns:
+//	A random number between min & max
+static float CollisionTests_Random(float min, float max)
+{
+	return min + (max - min) * ((float)rand() / (float)RAND_MAX);
+}
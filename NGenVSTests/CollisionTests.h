@@ -0,0 +1,242 @@
+#ifndef COLLISIONTESTS_H
+#define COLLISIONTESTS_H
+
+#include "CollisionManager.h"
+#include "Mesh.h"
+
+//Most points the hulls built from meshes for the checks may keep, the same budget the bottle uses in game
+#define CollisionTests_HULL_BUDGET 24
+//Most pieces the compound colliders built from meshes for the checks may be decomposed into
+#define CollisionTests_COMPOUND_PIECES 16
+//Number of random poses each pair of algorithms is compared on
+#define CollisionTests_NUM_POSES 4000
+//Number of objects in each scene run through the broadphase
+#define CollisionTests_NUM_OBJECTS 64
+//Number of frames each scene is moved & tested for
+#define CollisionTests_NUM_FRAMES 60
+//Objects overlapping by less than this are only touching, either answer is right for them
+#define CollisionTests_TOUCHING 0.001f
+//Largest difference allowed between two tests which must give the same overlap
+#define CollisionTests_TOLERANCE 0.0001f
+//Largest difference allowed between the overlap found by SAT & the overlap EPA settles on
+#define CollisionTests_EPA_TOLERANCE 0.01f
+//Smallest dot product allowed between the normal found by SAT & the normal EPA settles on
+#define CollisionTests_EPA_MIN_DOT 0.99f
+//Where the hull cache round trip writes it's cache, removed once the check is done
+#define CollisionTests_CACHE_PATH "./Assets/Models/collisiontests.hull"
+
+//The result of testing a pair of objects, stored by value for comparing against another test of the same pair
+typedef struct CollisionTests_Contact
+{
+	GObject* obj1;					//Object the normal points towards
+	GObject* obj2;					//Object the normal points away from
+	float normal[3];				//Normalized minimum translation vector of the collision
+	float overlap;					//Magnitude of the overlap along the normal
+} CollisionTests_Contact;
+
+///
+//Compares the convex tests on hulls oriented into the scratch memory of the testing thread
+//against the same tests on hulls read from their world space caches.
+//Both orient the hulls the same way the tests did when they allocated every oriented vector, so the results must match bit for bit.
+//
+//Parameters:
+//	arrow: A pointer to the mesh of the arrow
+//	bottle: A pointer to the mesh of the bottle
+//
+//Returns:
+//	The number of poses on which the results differ
+unsigned int CollisionTests_CheckScratch(const Mesh* arrow, const Mesh* bottle);
+
+///
+//Compares SAT against GJK & EPA on random poses of the arrow & bottle hulls & of a box against them
+//
+//Parameters:
+//	arrow: A pointer to the mesh of the arrow
+//	bottle: A pointer to the mesh of the bottle
+//
+//Returns:
+//	The number of poses on which the algorithms disagree
+unsigned int CollisionTests_CheckConvexAlgorithms(const Mesh* arrow, const Mesh* bottle);
+
+///
+//Moves a scene of objects around a sweep and prune broadphase for a number of frames,
+//comparing the collisions the collision manager finds each frame against testing every pair of objects directly.
+//The collision manager prefilters pairs by their bounds & tests pairs of spheres & pairs of AABBs in batches,
+//testing every pair directly does neither.
+//
+//Parameters:
+//	name: The name of the scene to print the results under
+//	hullMeshes: An array of pointers to the meshes to build the convex hulls of the scene from
+//	numHullMeshes: The number of meshes in the array, the scene has only spheres & AABBs if there are none
+//
+//Returns:
+//	The number of collisions which differ between the collision manager & testing every pair directly
+unsigned int CollisionTests_CheckScene(const char* name, const Mesh** hullMeshes, unsigned int numHullMeshes);
+
+///
+//Saves the hulls of the arrow & bottle to a cache & loads them back,
+//checking the loaded hulls match the saved hulls exactly & that a cache of a different budget is refused
+//
+//Parameters:
+//	arrow: A pointer to the mesh of the arrow
+//	bottle: A pointer to the mesh of the bottle
+//
+//Returns:
+//	The number of hulls which did not survive the round trip
+unsigned int CollisionTests_CheckHullCache(const Mesh* arrow, const Mesh* bottle);
+
+///
+//Compares the compound narrow phase against testing every piece of the compound directly,
+//on random poses of a compound collider decomposed from a concave mesh & a sphere, box & arrow hull around it.
+//The deepest collision with any piece is the collision with the compound.
+//
+//Parameters:
+//	concave: A pointer to the concave mesh to decompose into the compound collider
+//	arrow: A pointer to the mesh of the arrow
+//
+//Returns:
+//	The number of poses on which the compound narrow phase & the pieces disagree
+unsigned int CollisionTests_CheckCompound(const Mesh* concave, const Mesh* arrow);
+
+///
+//Compares testing pairs through the collision manager, which skips the narrow phase of pairs whose bounds don't overlap,
+//against testing every pair directly on random poses of spheres, boxes & the arrow & bottle hulls.
+//Both run the same narrow phase on the pairs the bounds let through, so those results must match bit for bit.
+//
+//Parameters:
+//	arrow: A pointer to the mesh of the arrow
+//	bottle: A pointer to the mesh of the bottle
+//
+//Returns:
+//	The number of poses on which the prefiltered & direct tests disagree
+unsigned int CollisionTests_CheckPrefilter(const Mesh* arrow, const Mesh* bottle);
+
+///
+//Internals
+///
+
+///
+//Compares every part of two convex hull colliders exactly
+//
+//Parameters:
+//	hull1: A pointer to the first convex hull collider
+//	hull2: A pointer to the second convex hull collider
+//
+//Returns:
+//	1 if the colliders have the same points, axes, edges, arcs & neighbours, else 0
+static unsigned char CollisionTests_AreHullsEqual(const ColliderData_ConvexHull* hull1, const ColliderData_ConvexHull* hull2);
+
+///
+//Compares the vectors of two linked lists exactly
+//
+//Parameters:
+//	list1: A pointer to the first linked list of vectors
+//	list2: A pointer to the second linked list of vectors
+//
+//Returns:
+//	1 if the lists hold the same number of vectors with the same components, else 0
+static unsigned char CollisionTests_AreVectorListsEqual(const LinkedList* list1, const LinkedList* list2);
+
+///
+//Allocates & initializes a game object with a collider of a given type & a random size
+//
+//Parameters:
+//	type: The type of collider to attach, sphere, AABB, convex hull or compound
+//	mesh: A pointer to the mesh to build a convex hull or compound collider from, NULL for other types
+//
+//Returns:
+//	A pointer to the newly allocated game object
+static GObject* CollisionTests_AllocateObject(enum ColliderType type, const Mesh* mesh);
+
+///
+//Moves a game object to a random position & turns it by a random rotation,
+//AABBs are never rotated
+//
+//Parameters:
+//	obj: A pointer to the game object to pose
+//	spread: The furthest the object may be placed from the origin along each axis
+static void CollisionTests_Pose(GObject* obj, float spread);
+
+///
+//Picks a random pair of different objects from an array, ordered by their index in the array
+//
+//Parameters:
+//	index1: A pointer to store the index of the first object of the pair in
+//	index2: A pointer to store the index of the second object of the pair in
+//	numObjects: The number of objects to pick from
+static void CollisionTests_PickPair(unsigned int* index1, unsigned int* index2, unsigned int numObjects);
+
+///
+//Tests a pair of objects with the test for their types directly,
+//without the bounds test, pair cache or batches the collision manager would use
+//
+//Parameters:
+//	dest: A pointer to the collision to store the result in, it's pair must be NULL
+//	obj1: A pointer to the first object of the pair
+//	obj2: A pointer to the second object of the pair
+static void CollisionTests_TestPairDirectly(Collision* dest, GObject* obj1, GObject* obj2);
+
+///
+//Sets the world space caches of an object's convex hull collider current, or marks them out of date
+//
+//Parameters:
+//	obj: A pointer to the object whose collider's caches are set, objects without a convex hull collider are left alone
+//	current: 1 to refresh the caches, 0 to invalidate them
+static void CollisionTests_SetWorldCache(GObject* obj, unsigned char current);
+
+///
+//Finds the contact of a pair of objects among an array of contacts
+//
+//Parameters:
+//	contacts: A pointer to a dynamic array of contacts to search
+//	obj1: A pointer to one object of the pair
+//	obj2: A pointer to the other object of the pair
+//
+//Returns:
+//	A pointer to the contact between the objects, or NULL if there is none
+static CollisionTests_Contact* CollisionTests_FindContact(DynamicArray* contacts, const GObject* obj1, const GObject* obj2);
+
+///
+//Compares two contacts of the same pair of objects
+//
+//Parameters:
+//	contact1: A pointer to the first contact
+//	contact2: A pointer to the second contact, the pair may be stored in either order
+//	depthTolerance: The largest difference allowed between the overlaps of the contacts
+//	minDot: The smallest dot product allowed between the normals of the contacts
+//
+//Returns:
+//	1 if the contacts agree, else 0
+static unsigned char CollisionTests_DoContactsAgree(const CollisionTests_Contact* contact1, const CollisionTests_Contact* contact2, float depthTolerance, float minDot);
+
+///
+//Compares two contacts bit for bit
+//
+//Parameters:
+//	contact1: A pointer to the first contact
+//	contact2: A pointer to the second contact
+//
+//Returns:
+//	1 if the contacts hold the same objects in the same order, & the same normal & overlap down to the last bit, else 0
+static unsigned char CollisionTests_AreContactsIdentical(const CollisionTests_Contact* contact1, const CollisionTests_Contact* contact2);
+
+///
+//Stores the result of a collision test as a contact
+//
+//Parameters:
+//	dest: A pointer to the contact to store the result in
+//	collision: A pointer to the collision holding the result of the test
+static void CollisionTests_GetContact(CollisionTests_Contact* dest, const Collision* collision);
+
+///
+//Gets a random number within a range
+//
+//Parameters:
+//	min: The lowest number which may be returned
+//	max: The highest number which may be returned
+//
+//Returns:
+//	A random number between min & max
+static float CollisionTests_Random(float min, float max);
+
+#endif
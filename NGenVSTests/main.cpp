@@ -0,0 +1,71 @@
+///
+//NGenVSTests checks that the different paths through the collision engine of NGenVS agree with each other.
+//It must be run from the NGenVS project directory so the assets can be found.
+//Prints the result of each check & exits with 1 if any check failed, else 0.
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#endif
+
+#include <GL\glew.h>
+#include <GL\freeglut.h>
+
+#include "AssetManager.h"
+#include "CollisionManager.h"
+
+#include "CollisionTests.h"
+
+int main(int argc, char* argv[])
+{
+	//Loading the meshes needs an OpenGL context, so create one the same way the game does
+	glutInit(&argc, argv);
+	glutInitDisplayMode(GLUT_RGBA);
+	glutInitContextVersion(4, 3);
+	glutInitContextProfile(GLUT_CORE_PROFILE);
+
+	int win = glutCreateWindow("NGenVS Tests");
+	glutHideWindow();
+
+	glewExperimental = GL_TRUE;
+	if (glewInit() != GLEW_OK) { return -1; }
+
+	//Initialize only the managers the checks use
+	AssetManager_Initialize();
+	CollisionManager_Initialize();
+
+	AssetManager_LoadAssets();
+
+	const Mesh* arrow = AssetManager_LookupMesh("Arrow");
+	const Mesh* bottle = AssetManager_LookupMesh("Bottle");
+	const Mesh* pipe = AssetManager_LookupMesh("Pipe");
+
+	//Seed the random poses so every run checks the same ones
+	srand(1);
+
+	//Pairs are tested directly with SAT, so the collision manager must test them with SAT as well
+	CollisionManager_SetConvexAlgorithm(COLLIDER_CONVEXHULL, COLLIDER_CONVEXHULL, CONVEXALGORITHM_SAT);
+	CollisionManager_SetConvexAlgorithm(COLLIDER_AABB, COLLIDER_CONVEXHULL, CONVEXALGORITHM_SAT);
+
+	const Mesh* hullMeshes[2] = { arrow, bottle };
+
+	unsigned int failures = 0;
+	failures += CollisionTests_CheckScratch(arrow, bottle);
+	failures += CollisionTests_CheckScene("Spheres & AABBs", NULL, 0);
+	failures += CollisionTests_CheckConvexAlgorithms(arrow, bottle);
+	failures += CollisionTests_CheckHullCache(arrow, bottle);
+	failures += CollisionTests_CheckCompound(pipe, arrow);
+	failures += CollisionTests_CheckPrefilter(arrow, bottle);
+	failures += CollisionTests_CheckScene("Spheres, AABBs & hulls", hullMeshes, 2);
+
+	printf("NGenVSTests: %u failures\n", failures);
+
+	glutDestroyWindow(win);
+
+	AssetManager_Free();
+	CollisionManager_Free();
+
+	return failures == 0 ? 0 : 1;
+}